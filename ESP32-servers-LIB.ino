@@ -1,737 +1,1349 @@
-/*
-
-    Esp32_web_ftp_telnet_server_template.ino
-
-    This file is part of the Esp32_web_ftp_telnet_server_template project:
-    https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
-
-    Compile this code with Arduino for:
-        - one of the ESP32 boards (Tools | Board), and
-        - one of the SPIFFS partition schemes (Tools | Partition Scheme).
-
-    This template uses the following libraries (can be included in the Arduino IDE):
-        - ESP32_Multitasking_Network_Suite: https://github.com/BojanJurca/Multitasking-Http-Ftp-Telnet-Ntp-Smtp-Servers-and-clients-for-ESP32-Arduino-Library
-        - ThreadSafePing: https://github.com/BojanJurca/Thread-safe-ping-Arduino-library-for-ESP32
-        - ThreadSafeFS: https://github.com/BojanJurca/Thread-safe-file-sytem-wrapper-Arduino-library-for-ESP32
-        - LightweightSTL: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
-        - cronDaemon: https://github.com/BojanJurca/Cron-Daemon-for-Arduino
-
-    Please note that this file is only a template. You can include or exclude
-    the functionalities you don't need. Some parts of the code are provided
-    merely for demonstration purposes.
-
-    May 22, 2026, Bojan Jurca
-
-*/
-
-#include <WiFi.h>
-
-
-// Configure the servers you want to use in server_config.h before including their header files.
-#include "server_config.h" // first inclusion - configuration part
-
-
-#ifdef LOCALE
-    // Arduino library: LightweightSTL
-    // https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
-    #include <locale.hpp>
-#endif
-#include <ostream.hpp>          // convenience wrapper for using cout instead of Serial.print
-#include <Cstring.hpp>          // C-style strings with C++ operators that reside on the stack (no heap allocation)
-
-// Arduino library: ThreadSafePing
-// https://github.com/BojanJurca/Thread-safe-ping-Arduino-library-for-ESP32
-#include <ThreadSafePing.h>     // used in this template to periodically verify WiFi connectivity
-
-// Arduino library: ThreadSafeFS
-// https://github.com/BojanJurca/Thread-safe-file-sytem-wrapper-Arduino-library-for-ESP32
-#include <LittleFS.h>               // or SPIFFS or FFat, ...
-#include <threadSafeFS.h>           // thread-safe wrapper file system wrapper
-threadSafeFS::FS TSFS (LittleFS);   // use thread-safe wrapper arround selected LittleFS
-using File = threadSafeFS::File;    // use thread-safe wrapper for all file operations in your code from now on
-
-// Arduino library: cronDaemon
-// https://github.com/BojanJurca/Cron-Daemon-for-Arduino
-// if cronDaemon.h is included after threadSafeFS.h it will create /etc/crontab file
-#include <cronDaemon.h>         // used in this template to periodically synchronize the internal clock with NTP servers or check WiFi connectivity
-// Create a cronDaemon process that reads the crontab and calls
-// cronHandlerCallback whenever scheduled events occur.
-//
-// The third argument (bool runCronDaemonInItsOwnTask = true) tells cronDaemon
-// whether it should run in its own FreeRTOS task or be hosted inside the
-// main setup/loop task.
-//
-// If you set this argument to false (as in this example), cronDaemon will NOT
-// create its own task. This saves approximately 8 KB of RAM, but requires you
-// to manually call cronDaemon.nextRun() from the loop() function.
-void cronHandlerCallback (const char *cronCommand);
-cronDaemon_t *cronDaemon = NULL;
-
-// Arduino library: ESP32_Multitasking_Network_Suite
-// https://github.com/BojanJurca/Multitasking-Http-Ftp-Telnet-Ntp-Smtp-Servers-and-clients-for-ESP32-Arduino-Library
-#include <dmesg.hpp>
-
-
-// Create the default configuration files and read from them
-#include "server_config.h" // second inclusion - implementation part
-
-// include the servers
-#include <ntpClient.h>
-
-#include <ftpServer.h>
-    ftpServer_t *ftpServer = NULL;
-
-#include <httpServer.h>
-    httpServer_t *httpServer = NULL;
-
-/*
-#include <httpsServer.h>
-    httpsServer_t *httpsServer = NULL;    
-*/
-
-#include "webSessionTokens.h"
-    webSessionTokens_t *webSessionTokens = NULL;
-
-
-// Include oscilloscope
-// #define USE_I2S_INTERFACE             // I2S interface improves web based oscilloscope analog sampling (of a single signal) if ESP32 board has one
-// check INVERT_ADC1_GET_RAW and INVERT_I2S_READ #definitions in oscilloscope.h if the signals are inverted
-#include "oscilloscope.h"
-
-// Provide help text for Telnet user-defined commands
-#ifdef POWER_SAVING
-    #define USER_DEFINED_TELNET_HELP_TEXT   "\r\n  user management:" \
-                                            "\r\n       useradd -d <userHomeDirectory> <userName>" \
-                                            "\r\n       userdel <userName>" \
-                                            "\r\n       passwd [<userName>]" \
-                                            "\r\n  power saving:" \
-                                            "\r\n       power saving" \
-                                            "\r\n       power saving on" \
-                                            "\r\n       power saving off"
-#else
-    #define USER_DEFINED_TELNET_HELP_TEXT   "\r\n  user management:" \
-                                            "\r\n       useradd -d <userHomeDirectory> <userName>" \
-                                            "\r\n       userdel <userName>" \
-                                            "\r\n       passwd [<userName>]"
-#endif
-#include <telnetServer.h>
-    telnetServer_t *telnetServer = NULL;
-
-
-#ifdef USE_mDNS
-    #include <ESPmDNS.h>
-#endif
-
-
-#ifdef USE_OTA
-    #include <ESPmDNS.h>
-    #include <NetworkUdp.h>
-    #include <ArduinoOTA.h>
-    uint32_t last_ota_time = 0;
-#endif
-
-// UNIX-like user management
-#include "userManagement.h"
-userManagement_t *userManagement;
-
-
-// ----- handle user-defined Telnet commands -----
-
-String telnetCommandHandlerCallback (int argc, char *argv [], telnetServer_t::telnetConnection_t *tcn) {
-
-    // Must be reentrant !!!
-
-
-    #define argv0is(X) (argc > 0 && !strcmp (argv[0], X))  
-    #define argv1is(X) (argc > 1 && !strcmp (argv[1], X))
-    #define argv2is(X) (argc > 2 && !strcmp (argv[2], X))
-
-    // ----- UNIX-like user management -----
-    if (argv0is ("useradd"))        { 
-                                        if (strcmp (tcn->getUserName (), "root"))   return "Only root may add users";
-                                        if (argc == 4 && argv1is ("-d"))            return userManagement->userAdd (argv [3], argv [2]);
-                                                                                    return "Wrong syntax, use useradd -d userHomeDirectory userName";
-                                    }
-
-    else if (argv0is ("userdel"))   {
-                                            if (strcmp (tcn->getUserName (), "root"))   return "Only root may delete users";
-                                            if (argc != 2)                              return "Wrong syntax. Use userdel userName";
-                                            if (!strcmp (argv [1], "root"))             return "You don't really want to to this";
-                                                                                        return userManagement->userDel (argv [1]);
-                                    }
-
-    else if (argv0is ("passwd"))    {
-                                            const char *forUser = tcn->getUserName (); // usually, but may be changed later
-                                            if (argc == 1) { // user changing password for himself
-                                                // read current password
-                                                tcn->dontEcho ();
-                                                if (tcn->sendString ("Enter current password: ") <= 0) 
-                                                    return "\r"; 
-                                                char password [USER_PASSWORD_MAX_LENGTH + 1];
-                                                if (tcn->recvLine (password, sizeof (password), true) != 13) { // the line is not ended with Enter
-                                                    tcn->doEcho ();                  
-                                                    return "\r\nPassword not changed"; 
-                                                }
-                                                tcn->doEcho (); 
-                                                // check if password is valid for user
-                                                if (!userManagement->checkUserNameAndPassword (tcn->getUserName (), password))
-                                                    return "Wrong password";                                                     
-                                            }
-                                            if (argc == 2) {
-                                                forUser = argv [1];
-                                                if (!strcmp (tcn->getUserName (), argv [1])) { // user changing password for himself
-                                                    // read current password
-                                                    tcn->dontEcho ();
-                                                    if (tcn->sendString ("Enter current password: ") <= 0) 
-                                                        return "\r";
-                                                    char password [USER_PASSWORD_MAX_LENGTH + 1];
-                                                    if (tcn->recvLine (password, sizeof (password), true) != 13) { // the line is not ended with Enter
-                                                        tcn->doEcho ();                  
-                                                        return "\r\nPassword not changed"; 
-                                                    }
-                                                    tcn->doEcho (); 
-                                                    // check if password is valid for user
-                                                    if (!userManagement->checkUserNameAndPassword (argv [1], password))
-                                                        return "Wrong password";                                                     
-                                                } else if (!strcmp (tcn->getUserName (), "root")) { // root is changing password for another user
-                                                    // check if user exists with getUserHomeDirectory
-                                                    Cstring<255> homeDirectory = userManagement->getHomeDirectory (argv [1]);
-                                                    if (homeDirectory == "")       
-                                                        return "User does not exist";
-                                                } else {
-                                                    return "You may change only your own password";
-                                                }
-                                            }
-
-                                            // it is OK to change the password now, read it twice
-                                            char password1 [USER_PASSWORD_MAX_LENGTH + 1];
-                                            char password2 [USER_PASSWORD_MAX_LENGTH + 1];
-                                            tcn->dontEcho ();
-                                            if (tcn->sendString ("\r\nEnter new password: ") <= 0)
-                                                return "\r"; 
-                                            if (tcn->recvLine (password1, sizeof (password1), true) != 13) { // the line is not ended with Enter
-                                                tcn->doEcho ();
-                                                return "\r\nPassword not changed"; 
-                                            }
-                                            if (tcn->sendString ("\r\nRe-enter new password: ") <= 0)
-                                                return "\r"; 
-                                            if (tcn->recvLine (password2, sizeof (password2), true) != 13) { // the line is not ended with Enter
-                                                tcn->doEcho ();
-                                                return "\r\nPassword not changed"; 
-                                            }
-                                            tcn->doEcho ();
-                                            // check passwords
-                                            if (strcmp (password1, password2))
-                                                return "\r\nPasswords do not match";
-                                            // change password
-                                            if (userManagement->passwd (forUser, password1))
-                                                return "\r\nPassword changed";
-                                            else
-                                                return "\r\nError changing password";  
-                                    }
-    #ifdef POWER_SAVING
-
-        // ----- WiFi POWER SAVING -----
-
-        if (argv0is ("power"))      {
-                                        if (argv1is ("saving")) {
-                                            if (argc == 2) {
-                                                wifi_ps_type_t ps_type;
-                                                esp_err_t err = esp_wifi_get_ps (&ps_type);
-                                                if (err == ESP_OK)
-                                                    if (ps_type == WIFI_PS_NONE)
-                                                        return "power saving is off";
-                                                    else
-                                                        return "power saving is on";
-                                                else
-                                                    return "Couldn't get power saving mode";
-                                            } else if (argc == 3) {
-                                                if (argv2is ("on")) {
-                                                    esp_err_t err = esp_wifi_set_ps (POWER_SAVING);
-                                                    if (err == ESP_OK)
-                                                        return "power saving is on";
-                                                    else
-                                                        return "Couldn't set power saving mode";
-                                                } else if (argv2is ("off")) {
-                                                    esp_err_t err = esp_wifi_set_ps (WIFI_PS_NONE);
-                                                    if (err == ESP_OK)
-                                                        return "power saving is off";
-                                                    else
-                                                        return "Couldn't set power saving mode";
-                                                }                                                
-                                            }
-                                        }
-                                        return "Wrong syntax, use power saving [on | off]";
-                                    }
-    #endif
-
-    return ""; // telnetCommand has not been handled by telnetCommandHandler - tell telnetServer to handle it internally by returning ""
-}
-
-
-// ----- for demonstration only - you may freely delete the following definitions -----
-
-#include "measurements.hpp"
-measurements<60> freeHeap60;        // measure free heap each minute for possible memory leaks
-measurements<24> freeHeap24;        // measure free heap each hour for possible memory leaks
-measurements<24> freeBlock24;       // measure max free block of memory each hour
-measurements<60> httpRequestCount;  // measure how many web connections arrive each minute
-#undef LED_BUILTIN
-#define LED_BUILTIN 2               // built-in led
-
-
-// ----- handle HTTP requests -----
-
-String httpRequestHandlerCallback (const char *httpRequest, httpServer_t::httpConnection_t *hcn) { 
-
-    // Must be reentrant !!!
-
-
-    #define httpRequestIs(X) (strstr(httpRequest,X)==httpRequest)
-
-    httpRequestCount.increase_valueCounter (); // gether statistics
-
-    // REST API
-    if (httpRequestIs ("GET /builtInLed "))             { 
-                                                        getBuiltInLed:
-                                                            return "{\"id\":\"" HOSTNAME "\",\"builtInLed\":\"" + String (digitalRead (LED_BUILTIN) ? "on" : "off") + "\"}\r\n";
-                                                        }                                                                    
-    else if (httpRequestIs ("PUT /builtInLed/on "))     {
-                                                            digitalWrite (LED_BUILTIN, HIGH);
-                                                            goto getBuiltInLed;
-                                                        }
-    else if (httpRequestIs ("PUT /builtInLed/off "))    {
-                                                            digitalWrite (LED_BUILTIN, LOW);
-                                                            goto getBuiltInLed;
-                                                        }
-    else if (httpRequestIs ("GET /state "))             {
-                                                            time_t t = ntpClient_t ().getUpTime (); // t holds seconds
-                                                            int seconds = t % 60; t /= 60;          // t now holds minutes
-                                                            int minutes = t % 60; t /= 60;          // t now holds hours
-                                                            int hours = t % 24;   t /= 24;          // t now holds days
-                                                            char upTime [25]; 
-                                                            *upTime = 0;
-                                                            if (t) 
-                                                            sprintf (upTime, "%lu days, ", (unsigned long) t);
-                                                            sprintf (upTime + strlen (upTime), "%02i:%02i:%02i", hours, minutes, seconds);
-
-                                                            return "{\"id\":\"" HOSTNAME "\","
-                                                                    "\"upTime\":\"" + String (upTime) + "\","
-                                                                    "\"httpRequestCount\": " + httpRequestCount.toJson () + ","
-                                                                    "\"freeHeap60\": " + freeHeap60.toJson () + ","
-                                                                    "\"freeHeap24\": " + freeHeap24.toJson () + ","
-                                                                    "\"freeBlock24\": " + freeBlock24.toJson () + ""
-                                                                    "}";
-                                                        }
-
-    // ----- entering restricted part - check authorization -----
-
-    Cstring<300> token = hcn->getHttpRequestCookie ("session");
-    Cstring<64> userName;
-    const char *cipherName = hcn->cipherName ();
-
-    if (token != "" && webSessionTokens)
-        userName = webSessionTokens->getUserNameFromToken (token);
-
-    // login-logout REST API
-    if (httpRequestIs ("POST /login/"))                 {   // POST login/username/password ...
-                                                            if (*cipherName == 0)
-                                                                return "Login is alowed through secure HTTPS protocol only";
-                                                            // parse URL to get userName and password
-                                                            Cstring<64>userName;
-                                                            Cstring<64>password;
-                                                            if (sscanf (httpRequest + 12, "%64[^/]/%64s", (char *) &userName, (char *) &password) != 2)
-                                                                return "Missing username or password";
-
-                                                            // TO DO: implement your user management
-
-                                                            if (userName != "user" && password != "password")
-                                                                return "Wrong username or password";
-                                                            // create new session token
-                                                            token = "";
-                                                            if (webSessionTokens && time (NULL) > 1600000000) // 1600000000 ~2020
-                                                                token = webSessionTokens->newToken (userName, time (NULL) + 86400); // 86400 = 1 day
-                                                            if (token == "")
-                                                                return "Couldn't create session token";
-                                                            // clean up token store every now and then
-                                                            webSessionTokens->deleteExpiredTokens ();
-                                                            // pass the token to session cookie
-                                                            hcn->setHttpReplyCookie ("session", token, time (NULL) + 86400);
-                                                            return "OK";
-                                                        } 
-    else if (httpRequestIs ("POST /logout "))           {
-                                                            // delete session cookie
-                                                            hcn->setHttpReplyCookie ("session", "", 1); // 0 means that the cookie never expires, 1 will always expire 
-                                                            if (webSessionTokens) {            
-                                                                // delete session token
-                                                                webSessionTokens->deleteToken (token);
-                                                                // clean up token store every now and then
-                                                                webSessionTokens->deleteExpiredTokens ();
-                                                            }
-                                                            return "OK";
-                                                        }
-
-    // ----- protect some pages if userName != "" the token is valid, proceed, if not redirect to login.html -----
-    if (userName == "") {
-      
-        if (httpRequestIs ("GET /administration.html")) {   // do not include space after ...html since users may also pass parameters: ...html?...
-                                                            hcn->setHttpReplyHeaderField ("Location", "/login.html?redirect=/administration.html");
-                                                            hcn->setHttpReplyStatus ("307 Login required"); // 307 = redirect
-                                                            return "Login required"; // whatever
-                                                        }
-
-    } else {
-
-        // ----- restrictes part for logged-in users only -----
-
-        // you may also want to check userName rights at this point
-
-        // TO DO: put your restricted access code here 
-
-    }
-
-    // ----- unrestricted part again - HTTP server will process all requests to files if they were not redirected above -----
-
-    return ""; // httpRequestHandler did not handle the request - tell httpServer to handle it internally by returning ""
-}
-
-void wsRequestHandlerCallback (const char *httpRequest, httpServer_t::webSocket_t *webSck) {
-
-    // Must be reentrant !!!
-    
-
-    #define httpRequestIs(X) (strstr(httpRequest,X)==httpRequest)
-    
-    #ifdef __OSCILLOSCOPE__
-          if (httpRequestIs ("GET /runOscilloscope"))      runOscilloscope (webSck);      // used by oscilloscope.html
-    #endif
-
-    if (httpRequestIs ("GET /rssiReader"))  { 
-                                                char c;
-                                                do {
-                                                    delay (100);
-                                                    int i = WiFi.RSSI ();
-                                                    c = (char) i;
-                                                } while (webSck->sendBlock ((byte *) &c, sizeof (c))); // keep sending RSSI information as long as web browser is receiving it
-                                            }
-}
-
-
-// ----- firewalll -----
-
-bool firewallCallback (char *clientIP, char *serverIP) {
-
-    // Must be reentrant !!!
-    
-
-    return true; // return false to refuse the connection for certain clientIP or serverIP 
-}
-
-
-// ----- cron handler -----
-
-static bool timeAlreadySynchronized = false;
-
-void cronHandlerCallback (const char *cronCommand) {
-
-    // Does not have to reentrant but keep in mind that cronHandlerCallback may be running in a different task than setup-loop
-
-
-    #define cronCommandIs(X) (!strcmp (cronCommand, X))
-
-    // There are three special cronCommands: ONCE A MINUTE, ONCE AN HOUR, and ONCE A DAY.
-    // These run at fixed intervals regardless of whether the ESP32 has already
-    // obtained the correct time from NTP servers.
-    // All other cronCommands run only after the correct time has been set.
-
-        if (cronCommandIs ("ONCE A MINUTE"))    {   
-                                                    // As long as the ESP32 has not yet obtained the correct time from
-                                                    // NTP servers, try synchronizing once per minute.
-                                                    if (!timeAlreadySynchronized) // 1600000000 ~2020
-                                                        timeAlreadySynchronized = *(ntpClient_t ().syncTime ()) == 0; // syncTime did not return error message
-                                                }
-    else if (cronCommandIs ("ONCE A DAY"))      {
-                                                    // Once the time is set, synchronize the internal clock with NTP servers daily.
-                                                    // if (time (NULL) > 1600000000) // 1600000000 ~2020
-                                                    ntpClient_t ().syncTime ();                                                                                    
-                                                } 
-    else if (cronCommandIs ("ONCE AN HOUR"))    {   
-                                                    // Check once per hour whether the router is reachable.
-                                                    wifi_mode_t wifiMode = WIFI_OFF;
-                                                    if (esp_wifi_get_mode (&wifiMode) != ESP_OK) {
-                                                        cout << ( dmesgQueue << "[cronHandlerCallback] " "couldn't get WiFi mode" );
-                                                    } else {
-                                                        if (wifiMode & WIFI_STA) { // WiFi works in STAtion mode  
-                                                            ThreadSafePing_t routerPing (WiFi.gatewayIP ());
-                                                            routerPing.ping (4);
-                                                            if (!routerPing.received ()) {
-                                                                cout << ( dmesgQueue << "[cronHandlerCallback] " "ping of router failed, reconnecting WiFi STAtion" );
-                                                                WiFi.disconnect ();
-                                                                WiFi.reconnect ();
-                                                            }
-                                                        }
-                                                    }
-                                                }
-
-    // The following cronCommands can be provided either programmatically
-    // (via cronTab.insert) or through the /etc/crontab file.
-
-    else if (cronCommandIs ("gotTime"))         {
-                                                    // "* * * * * * gotTime" is triggered only once — the moment the ESP32
-                                                    // obtains the correct time from NTP servers for the first time.
-                                                    time_t t = time (NULL);
-                                                    struct tm st;
-                                                    localtime_r (&t, &st);
-                                                    cout << "Got time at " << st << " (local time), do whatever needs to be done the first time the time is known" << endl;
-                                                }
-    else if (cronCommandIs ("onMinute"))        {
-                                                    // "0 * * * * * onMinute" occurs at the beginning of every minute.
-                                                    // This is a good moment to update our demonstration measurement queues.
-                                                    time_t t = time (NULL);
-                                                    struct tm st;
-                                                    localtime_r (&t, &st);
-                                                    freeHeap60.push_back ( { (unsigned char) st.tm_min, (int16_t) (ESP.getFreeHeap () / 1024) } );                                                    
-                                                    // Number of HTTP requests received during the last minute.
-                                                    httpRequestCount.push_back_and_reset_valueCounter ((int16_t) st.tm_min);
-                                                }
-    else if (cronCommandIs ("onHour"))          {
-                                                    // "0 0 * * * * onHour" occurs at the beginning of every hour.
-                                                    // Another good moment to update hourly measurement queues.
-                                                    time_t t = time (NULL);
-                                                    struct tm st;
-                                                    localtime_r (&t, &st);
-                                                    freeHeap24.push_back ( { (unsigned char) st.tm_hour, (int16_t) (ESP.getFreeHeap () / 1024) } );
-                                                    freeBlock24.push_back ( { (unsigned char) st.tm_hour, (int16_t) (heap_caps_get_largest_free_block (MALLOC_CAP_DEFAULT) / 1024) } );
-                                                }
-}
-
-
-// returns        "/" for full access
-// something like "/home/name" for limited access
-//                "" for no access
-Cstring<255> getUserHomeDirectoryCallback (const Cstring<64>& userName, const Cstring<64>& password) {
-
-    // Must be reentrant !!!
-
-
-    Cstring<255> retVal;
-    // check if userName and password are correct
-    if (userManagement && userManagement->checkUserNameAndPassword (userName, password))
-        return userManagement->getHomeDirectory (userName);
-    // else
-    return "";  // access (login) denyed
-}
-
-
-void setup () {
-
-    pinMode (LED_BUILTIN, OUTPUT | INPUT);
-    digitalWrite (LED_BUILTIN, LOW);
-
-
-    // Initialize console output.
-    // Optional arguments: waitForSerial=false, waitAfterSerial=100 ms, serialSpeed=115200.
-    cinit ();
-    cout << showpoint;
-
-
-    #ifdef LOCALE
-        if (setlocale (lc_all, LOCALE))
-            cout << ( dmesgQueue << "[locale] " "set to " << LOCALE );
-        else
-            cout << ( dmesgQueue << "[locale] " "could not set " << LOCALE );
-    #endif
-
-
-    // If a file system is used, mount it now.
-    LittleFS.begin (true);
-    // LittleFS.format ();
-
-
-    // Create the userManagement instance.
-    userManagement = new (std::nothrow) userManagement_t (TSFS);
-
-
-    // Configure time zone prior to inserting events into cronTab for cronDaemon works with local time.
-    ntpClient_t (TSFS, DEFAULT_NTP_SERVER_1, DEFAULT_NTP_SERVER_2, DEFAULT_NTP_SERVER_3);
-    setenv ("TZ", zoneinfo (TSFS, DEFAULT_TZ), 1);
-    tzset ();
-    const char* tz = getenv ("TZ");
-    if (tz)
-        cout << ( dmesgQueue << "[time] TZ set to " << tz );
-    else
-        cout << ( dmesgQueue << "[time] TZ not set" );
-
-    // ----- Demonstration entries — feel free to remove them -----
-    cronTab.insert ("* * * * * * gotTime");   // triggers once — when ESP32 obtains time from NTP for the first time
-    cronTab.insert ("0 * * * * * onMinute");  // triggers every minute at second 0
-    cronTab.insert ("0 0 * * * * onHour");    // triggers every hour at 00:00
-    //               | | | | | | |
-    //               | | | | | | |___ cron command, this information will be passed to cronHandlerCallback when the time comes
-    //               | | | | | |___ day of week (0 - 7 or *; Sunday=0 and also 7)
-    //               | | | | |___ month (1 - 12 or *)
-    //               | | | |___ day (1 - 31 or *)
-    //               | | |___ hour (0 - 23 or *)
-    //               | |___ minute (0 - 59 or *)
-    //               |___ second (0 - 59 or *)
-
-    cronDaemon = new (std::nothrow) cronDaemon_t (TSFS, cronHandlerCallback, false);
-    if (!cronDaemon)
-        cout << ( dmesgQueue << "[cronDaemon] " "did not run" );
-
-    // Connect to the WiFi router.
-    WiFi.onEvent ([] (WiFiEvent_t event, WiFiEventInfo_t info) {
-        if (event == ARDUINO_EVENT_WIFI_STA_CONNECTED) {
-            cout << ( dmesgQueue << "[WiFi][STA] " "connected" );
-            #ifdef POWER_SAVING
-                esp_err_t err = esp_wifi_set_ps (POWER_SAVING);
-                if (err == ESP_OK)
-                    cout << ( dmesgQueue << "[power saving] " "is on" );
-                else
-                    cout << ( dmesgQueue << "[power saving] " "couldn't set power saving" );
-            #endif
-        } else if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
-            cout << ( dmesgQueue << "[WiFi][STA] " "got IP address: " << WiFi.localIP () );
-            timeAlreadySynchronized = *(ntpClient_t ().syncTime ()) == 0; // syncTime did not return error message
-
-            #ifdef USE_mDNS
-                if (MDNS.begin (HOSTNAME))
-                    cout << ( dmesgQueue << "[mDNS] started for " << HOSTNAME );
-                else
-                    cout << ( dmesgQueue << "[mDNS] did not start" );
-                MDNS.addService ("ftp", "tcp", 21);            
-                MDNS.addService ("telnet", "tcp", 23);
-                MDNS.addService ("http", "tcp", 80);
-                MDNS.addService ("https", "tcp", 443);
-            #endif            
-        }
-    });
-    // read WiFi settings from configuration files which are stored on TSFS
-    WiFi_start (TSFS); // if not file system is used skip TSFS argument
-    // if no file system is used call WiFi_start () with no arguments which uses DEFAULT_ ... definitions instead,
-    // or simply call WiFi.begin ("YOUR STA SSID", "YOUR STA PASSWORD");
-
-
-    // Start HTTP server. All the arguments are optional.
-    httpServer = new (std::nothrow) httpServer_t (TSFS,                         // threadSafeFS::FS& fileSystem,
-                                                  httpRequestHandlerCallback,   // String httpRequestHandlerCallback (const char *httpRequest, httpServer_t::httpConnection_t *hcn) = NULL,
-                                                  wsRequestHandlerCallback);    // void (*wsRequestHandlerCallback) (const char *httpRequest, httpServer_t::webSocket_t *webSck) = NULL,
-                                                                                // int serverPort = 80,
-                                                                                // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
-                                                                                // bool runListenerInItsOwnTask = true
-
-    if (httpServer && *httpServer)
-        cout << ( dmesgQueue << "[httpServer] " "started" );
-    else
-        cout << ( dmesgQueue << "[httpServer] " "did not start" );
-
-    // Start HTTPS server. All the arguments are optional.
-/*
-    httpsServer = new (std::nothrow) httpsServer_t (TSFS,                         // threadSafeFS::FS& fileSystem,
-                                                    httpRequestHandlerCallback,   // String httpRequestHandlerCallback (const char *httpRequest, httpServer_t::httpConnection_t *hcn) = NULL,
-                                                    wsRequestHandlerCallback);    // void (*wsRequestHandlerCallback) (const char *httpRequest, httpServer_t::webSocket_t *webSck) = NULL,
-                                                                                  // int serverPort = 443,
-                                                                                  // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
-                                                                                  // bool runListenerInItsOwnTask = true
-
-    if (httpsServer && *httpsServer)
-        cout << ( dmesgQueue << "[httpsServer] " "started" );
-    else
-        cout << ( dmesgQueue << "[httpsServer] " "did not start" );
-*/
-
-    webSessionTokens = new (std::nothrow) webSessionTokens_t (TSFS);
-    if (!webSessionTokens)
-        cout << (dmesgQueue << "[webSessionTokens] " "not created");
-
-
-    // Start the FTP server. To save ~3 KB of RAM, the listener can run inside the
-    // setup/loop task instead of its own task.
-    // In this mode you must call ftpServer->accept() manually from loop().
-    ftpServer = new (std::nothrow) ftpServer_t (TSFS,                           // threadSafeFS::FS& fileSystem,
-                                                                                // Optional arguments:
-                                                getUserHomeDirectoryCallback,   // Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL
-                                                21,                             // int serverPort = 21
-                                                firewallCallback,               // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL
-                                                false);                         // bool runListenerInItsOwnTask = true
-
-    if (ftpServer && *ftpServer)
-        cout << ( dmesgQueue << "[ftpServer] " "started" );
-    else
-        cout << ( dmesgQueue << "[ftpServer] " "did not start" );
-
-    // Start the Telnet server. To save ~3 KB of RAM, the listener can run inside the
-    // setup/loop task instead of its own task.
-    // In this mode you must call telnetServer->accept() manually from loop().
-    telnetServer = new (std::nothrow) telnetServer_t (TSFS,                         // threadSafeFS::FS& fileSystem,
-                                                      getUserHomeDirectoryCallback, // Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL
-                                                      telnetCommandHandlerCallback, // String (*telnetCommandHandlerCallback) (int argc, char *argv [], telnetConnection_t *tcn) = NULL
-                                                      23,                           // int serverPort = 23
-                                                      firewallCallback,             // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL
-                                                      false);                       // bool runListenerInItsOwnTask = true
-
-    if (telnetServer && *telnetServer)
-        cout << (dmesgQueue << "[telnetServer] " "started");
-    else
-        cout << (dmesgQueue << "[telnetServer] " "did not start");
-
-
-    #ifdef USE_OTA
-        ArduinoOTA
-            .onStart([]() {
-                String type;
-                if (ArduinoOTA.getCommand() == U_FLASH) {
-                    type = "sketch";
-                } else {  // U_SPIFFS
-                    type = "filesystem";
-                }
-
-                // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
-                Serial.println("Start updating " + type);
-            })
-            .onEnd([]() {
-                Serial.println("\nEnd");
-            })
-            .onProgress([](unsigned int progress, unsigned int total) {
-                if (millis() - last_ota_time > 500) {
-                    Serial.printf("Progress: %u%%\n", (progress / (total / 100)));
-                    last_ota_time = millis();
-                }
-            })
-            .onError([](ota_error_t error) {
-                Serial.printf("Error[%u]: ", error);
-                if (error == OTA_AUTH_ERROR) {
-                    Serial.println("Auth Failed");
-                } else if (error == OTA_BEGIN_ERROR) {
-                    Serial.println("Begin Failed");
-                } else if (error == OTA_CONNECT_ERROR) {
-                    Serial.println("Connect Failed");
-                } else if (error == OTA_RECEIVE_ERROR) {
-                    Serial.println("Receive Failed");
-                } else if (error == OTA_END_ERROR) {
-                    Serial.println("End Failed");
-                }
-            });
-
-        ArduinoOTA.begin();
-
-        Serial.println("Ready");
-        Serial.print("IP address: ");
-        Serial.println(WiFi.localIP());
-    #endif
-}
-
-void loop () {
-    if (ftpServer) ftpServer->accept();      // Running without its own listening task, so call accept() here.
-    if (telnetServer) telnetServer->accept(); // Same: no dedicated listening task, accept() must be called manually.
-    // httpServer has its own listening task, so accept() is not called here.
-    // httpsServer has its own listening task, so accept() is not called here.
-    if (cronDaemon) cronDaemon->nextRun (); // we run cronDaemon without its own task so call nextRun () here
-
-    // Do not block loop() for too long; otherwise accept() may miss incoming connections.
-
-
-    #ifdef USE_OTA
-        ArduinoOTA.handle ();
-    #endif
-}
+/*
+
+    Esp32_web_ftp_telnet_server_template.ino
+
+    This file is part of the Esp32_web_ftp_telnet_server_template project:
+    https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Compile this code with Arduino for:
+        - one of the ESP32 boards (Tools | Board), and
+        - one of the SPIFFS partition schemes (Tools | Partition Scheme).
+
+    This template uses the following libraries (can be included in the Arduino IDE):
+        - ESP32_Multitasking_Network_Suite: https://github.com/BojanJurca/Multitasking-Http-Ftp-Telnet-Ntp-Smtp-Servers-and-clients-for-ESP32-Arduino-Library
+        - ThreadSafePing: https://github.com/BojanJurca/Thread-safe-ping-Arduino-library-for-ESP32
+        - ThreadSafeFS: https://github.com/BojanJurca/Thread-safe-file-sytem-wrapper-Arduino-library-for-ESP32
+        - LightweightSTL: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+
+    Please note that this file is only a template. You can include or exclude
+    the functionalities you don't need. Some parts of the code are provided
+    merely for demonstration purposes.
+
+    May 22, 2026, Bojan Jurca
+
+*/
+
+#include <WiFi.h>
+
+
+// Configure the servers you want to use in server_config.h before including their header files.
+#include "server_config.h" // first inclusion - configuration part
+
+
+#ifdef LOCALE
+    // Arduino library: LightweightSTL
+    // https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+    #include <locale.hpp>
+#endif
+#include <ostream.hpp>          // convenience wrapper for using cout instead of Serial.print
+#include <Cstring.hpp>          // C-style strings with C++ operators that reside on the stack (no heap allocation)
+
+// Arduino library: ThreadSafePing
+// https://github.com/BojanJurca/Thread-safe-ping-Arduino-library-for-ESP32
+#include <ThreadSafePing.h>     // used in this template to periodically verify WiFi connectivity
+
+// Arduino library: ThreadSafeFS
+// https://github.com/BojanJurca/Thread-safe-file-sytem-wrapper-Arduino-library-for-ESP32
+#include <LittleFS.h>               // or SPIFFS or FFat, ...
+#include <threadSafeFS.h>           // thread-safe wrapper file system wrapper
+threadSafeFS::FS TSFS (LittleFS);   // use thread-safe wrapper arround selected LittleFS
+using File = threadSafeFS::File;    // use thread-safe wrapper for all file operations in your code from now on
+
+// cronScheduler reads /etc/crontab (and creates it if it doesn't exist yet) and calls
+// cronHandlerCallback whenever scheduled events occur.
+//
+// It runs inside the setup/loop task, which saves the RAM of its own task:
+// eventLoop calls cronScheduler.run () exactly when the next entry is due
+// and sleeps until then (see cronScheduler.h).
+#include "cronScheduler.h"      // used in this template to periodically synchronize the internal clock with NTP servers or check WiFi connectivity
+void cronHandlerCallback (const char *cronCommand);
+cronScheduler_t cronScheduler (cronHandlerCallback);
+
+// Arduino library: ESP32_Multitasking_Network_Suite
+// https://github.com/BojanJurca/Multitasking-Http-Ftp-Telnet-Ntp-Smtp-Servers-and-clients-for-ESP32-Arduino-Library
+#include <dmesg.hpp>
+
+// DMESG (format, ...) stores binary records into a lock-free ring, they are formatted into dmesgQueue when dmesg is read or from loop (),
+// the ring survives software, panic and watchdog resets and the previous run's records are shown by dmesg -p
+#include "dmesgRing.h"
+dmesgRing_t dmesgRing;
+
+#ifdef USE_SYSLOG_EXPORTER
+    // DMESG messages are also sent to the syslog collector set in /etc/syslog.conf
+    #include "syslogExporter.h"
+    syslogExporter_t syslogExporter;
+#endif
+
+void dmesgRingOutput (const char *text) {
+    cout << ( dmesgQueue << text );
+    #ifdef USE_SYSLOG_EXPORTER
+        syslogExporter.add (text);
+    #endif
+}
+
+
+// setup () runs the initialization steps in parallel tasks, each one as soon as its dependencies are ready
+#include "startupScheduler.h"
+startupScheduler_t startupScheduler;
+
+// loop () sleeps in select () until a connection waits on FTP or Telnet listener or the next timer is due
+#include "eventLoop.h"
+eventLoop_t eventLoop;
+
+// BOOTCHART_PHASE, BOOTCHART_MARK, ... record the timing of setup () phases, shown by bootchart Telnet command and GET /bootchart
+#include "bootChart.h"
+#ifdef USE_BOOTCHART
+    bootChart_t bootChart;
+#endif
+
+// firewallCallback accepts or refuses each HTTP, FTP and Telnet connection by the CIDR rules and per client IP rate limit from /etc/firewall.conf
+#include "firewall.h"
+firewall_t firewall;
+
+// WiFi and timezone settings are parsed from their text files only when the files change, otherwise they are loaded from NVS
+#include "configSnapshot.h"
+configSnapshot_t configSnapshot;
+int64_t firstHttpResponseTime = 0; // us since boot, shows the effect of configSnapshot
+
+// Create the default configuration files and read from them
+#include "server_config.h" // second inclusion - implementation part
+
+// include the servers
+#include <ntpClient.h>
+
+#include <ftpServer.h>
+    ftpServer_t *ftpServer = NULL;
+
+#include <httpServer.h>
+    httpServer_t *httpServer = NULL;
+
+#ifdef USE_EVENT_HTTP_SERVER
+    #include "eventHttpServer.h"
+    eventHttpServer_t *eventHttpServer = NULL;
+#endif
+
+/*
+#include <httpsServer.h>
+    httpsServer_t *httpsServer = NULL;    
+*/
+
+#include "webSessionTokens.h"
+    webSessionTokens_t *webSessionTokens = NULL;
+
+
+// Include oscilloscope
+// #define USE_I2S_INTERFACE             // I2S interface improves web based oscilloscope analog sampling (of a single signal) if ESP32 board has one
+// check INVERT_ADC1_GET_RAW and INVERT_I2S_READ #definitions in oscilloscope.h if the signals are inverted
+#include "oscilloscope.h"
+
+// Provide help text for Telnet user-defined commands
+#ifdef POWER_SAVING
+    #define POWER_SAVING_TELNET_HELP_TEXT   "\r\n  power saving:" \
+                                            "\r\n       power saving" \
+                                            "\r\n       power saving on" \
+                                            "\r\n       power saving off"
+#else
+    #define POWER_SAVING_TELNET_HELP_TEXT   ""
+#endif
+#define USER_DEFINED_TELNET_HELP_TEXT   "\r\n  user management:" \
+                                        "\r\n       useradd -d <userHomeDirectory> <userName>" \
+                                        "\r\n       userdel <userName>" \
+                                        "\r\n       passwd [<userName>]" \
+                                        "\r\n       passwdbench [<target login ms>]" \
+                                        "\r\n  performance:" \
+                                        "\r\n       httpstat [reset | bench]" \
+                                        "\r\n       top" \
+                                        "\r\n       assetcache [on | off | clear]" \
+                                        "\r\n       htmlbundle" \
+                                        "\r\n       crypto [hardware | software]" \
+                                        "\r\n       cryptobench" \
+                                        "\r\n       transfers" \
+                                        "\r\n       telnetout" \
+                                        "\r\n       dmesg -p" \
+                                        "\r\n       dmesgbench" \
+                                        "\r\n       syslog" \
+                                        "\r\n       configsnapshot [on | off | clear]" \
+                                        "\r\n       bootchart" \
+                                        "\r\n       startup" \
+                                        "\r\n       eventloop" \
+                                        "\r\n       crontab" \
+                                        "\r\n       firewall" \
+                                        POWER_SAVING_TELNET_HELP_TEXT
+#include <telnetServer.h>
+    telnetServer_t *telnetServer = NULL;
+
+
+#ifdef USE_mDNS
+    #include <ESPmDNS.h>
+#endif
+
+
+#ifdef USE_OTA
+    #include <ESPmDNS.h>
+    #include <NetworkUdp.h>
+    #include <ArduinoOTA.h>
+    uint32_t last_ota_time = 0;
+#endif
+
+// UNIX-like user management
+#include "userManagement.h"
+userManagement_t *userManagement;
+
+// Prometheus/OpenMetrics registry, scraped through GET /metrics
+#include "metrics.h"
+metrics_t metrics;
+metrics_t::metric_t& httpRequestsTotal = metrics.addCounter ("esp32_http_requests", "HTTP requests passed to httpRequestHandlerCallback");
+metrics_t::metric_t& cronTicksTotal = metrics.addCounter ("esp32_cron_ticks", "Events passed to cronHandlerCallback");
+
+// Per-route latency of HTTP requests and WebSockets, shown by httpstat Telnet command and GET /httpstat
+#include "httpLatency.h"
+httpLatency_t httpLatency;
+
+// CPU usage and stack high-water marks of FreeRTOS tasks, shown by top Telnet command and GET /top
+#include "taskProfiler.h"
+taskProfiler_t taskProfiler;
+
+// SHA-256 and AES-GCM through the hardware accelerators or in software, measured by cryptobench Telnet command
+#include "cryptoBackend.h"
+
+// Large files are streamed between TSFS and sockets with double buffering (GET /download/..., PUT /upload/...), statistics are shown by transfers Telnet command
+#include "fileTransfer.h"
+fileTransfer_t fileTransfer;
+
+// Telnet command output is collected into full TCP segments, cat <absolute path> uses it, statistics are shown by telnetout Telnet command
+#include "telnetOutputStream.h"
+
+// Small, frequently requested files from /var/www/html are kept in RAM (or PSRAM)
+#include "staticAssetCache.h"
+staticAssetCache_t staticAssetCache (TSFS);
+
+#ifdef USE_HTML_BUNDLE
+    // Files from html/ compiled into the firmware with tools/bundleHtml.py
+    #include "htmlBundle.h"
+    htmlBundle_t htmlBundle;
+#endif
+
+
+// ----- access to files -----
+
+// true if path is homeDirectory or a file or directory inside it, /var/www/html2 is not inside /var/www/html
+bool isInHomeDirectory (const char *path, const char *homeDirectory) {
+    size_t l = strlen (homeDirectory);
+    if (!l || strncmp (path, homeDirectory, l) || strstr (path, ".."))
+        return false;
+    return homeDirectory [l - 1] == '/' || path [l] == '/' || path [l] == 0;
+}
+
+
+// ----- handle user-defined Telnet commands -----
+
+// the last cat sent through telnetOutputStream_t, shown by telnetout Telnet command, Telnet sessions run in their own tasks so it is only accessed in lastCatMux critical sections
+struct lastCat_t {
+    size_t bytes;
+    size_t segments;
+    size_t lines;   // each line would be a separate send without coalescing
+    unsigned long milliseconds;
+} lastCat = {};
+portMUX_TYPE lastCatMux = portMUX_INITIALIZER_UNLOCKED;
+
+// cat <absolute path>, with line ends converted to \r\n and the output coalesced into full TCP segments
+String coalescedCat (const char *path, telnetServer_t::telnetConnection_t *tcn) {
+    if (strcmp (tcn->getUserName (), "root")) {
+        Cstring<255> homeDirectory = userManagement->getHomeDirectory (tcn->getUserName ());
+        if (!isInHomeDirectory (path, homeDirectory))
+            return "Access denied";
+    }
+    threadSafeFS::File f = TSFS.open (path, "r");
+    if (!f || f.isDirectory ())
+        return "Can't read " + String (path);
+
+    telnetOutputStream_t<telnetServer_t::telnetConnection_t> out (tcn);
+    char buf [512];
+    char converted [2 * sizeof (buf)];
+    size_t lines = 0;
+    char previous = 0;
+    int l;
+    while ((l = f.read ((uint8_t *) buf, sizeof (buf))) > 0) {
+        size_t j = 0;
+        for (int i = 0; i < l; i++) {
+            if (buf [i] == '\n') {
+                if (previous != '\r')
+                    converted [j++] = '\r';
+                lines ++;
+            }
+            converted [j++] = previous = buf [i];
+        }
+        if (!out.write (converted, j))
+            break;
+    }
+    f.close ();
+    String s = out.end ();
+    portENTER_CRITICAL (&lastCatMux);
+        lastCat = { out.bytes (), out.segments (), lines, out.milliseconds () };
+    portEXIT_CRITICAL (&lastCatMux);
+    return s;
+}
+
+String telnetCommandHandlerCallback (int argc, char *argv [], telnetServer_t::telnetConnection_t *tcn) {
+
+    // Must be reentrant !!!
+
+
+    #define argv0is(X) (argc > 0 && !strcmp (argv[0], X))  
+    #define argv1is(X) (argc > 1 && !strcmp (argv[1], X))
+    #define argv2is(X) (argc > 2 && !strcmp (argv[2], X))
+
+    // ----- UNIX-like user management -----
+    if (argv0is ("useradd"))        { 
+                                        if (strcmp (tcn->getUserName (), "root"))   return "Only root may add users";
+                                        if (argc == 4 && argv1is ("-d"))            { return userManagement->userAdd (argv [3], argv [2]); }
+                                                                                    return "Wrong syntax, use useradd -d userHomeDirectory userName";
+                                    }
+
+    else if (argv0is ("userdel"))   {
+                                            if (strcmp (tcn->getUserName (), "root"))   return "Only root may delete users";
+                                            if (argc != 2)                              return "Wrong syntax. Use userdel userName";
+                                            if (!strcmp (argv [1], "root"))             { return "You don't really want to to this"; }
+                                                                                        return userManagement->userDel (argv [1]);
+                                    }
+
+    else if (argv0is ("passwd"))    {
+                                            const char *forUser = tcn->getUserName (); // usually, but may be changed later
+                                            if (argc == 1) { // user changing password for himself
+                                                // read current password
+                                                tcn->dontEcho ();
+                                                if (tcn->sendString ("Enter current password: ") <= 0) 
+                                                    return "\r"; 
+                                                char password [USER_PASSWORD_MAX_LENGTH + 1];
+                                                if (tcn->recvLine (password, sizeof (password), true) != 13) { // the line is not ended with Enter
+                                                    tcn->doEcho ();                  
+                                                    return "\r\nPassword not changed"; 
+                                                }
+                                                tcn->doEcho (); 
+                                                // check if password is valid for user
+                                                if (!userManagement->checkUserNameAndPassword (tcn->getUserName (), password))
+                                                    return "Wrong password";                                                     
+                                            }
+                                            if (argc == 2) {
+                                                forUser = argv [1];
+                                                if (!strcmp (tcn->getUserName (), argv [1])) { // user changing password for himself
+                                                    // read current password
+                                                    tcn->dontEcho ();
+                                                    if (tcn->sendString ("Enter current password: ") <= 0) 
+                                                        return "\r";
+                                                    char password [USER_PASSWORD_MAX_LENGTH + 1];
+                                                    if (tcn->recvLine (password, sizeof (password), true) != 13) { // the line is not ended with Enter
+                                                        tcn->doEcho ();                  
+                                                        return "\r\nPassword not changed"; 
+                                                    }
+                                                    tcn->doEcho (); 
+                                                    // check if password is valid for user
+                                                    if (!userManagement->checkUserNameAndPassword (argv [1], password))
+                                                        return "Wrong password";                                                     
+                                                } else if (!strcmp (tcn->getUserName (), "root")) { // root is changing password for another user
+                                                    // check if user exists with getUserHomeDirectory
+                                                    Cstring<255> homeDirectory = userManagement->getHomeDirectory (argv [1]);
+                                                    if (homeDirectory == "")       
+                                                        return "User does not exist";
+                                                } else {
+                                                    return "You may change only your own password";
+                                                }
+                                            }
+
+                                            // it is OK to change the password now, read it twice
+                                            char password1 [USER_PASSWORD_MAX_LENGTH + 1];
+                                            char password2 [USER_PASSWORD_MAX_LENGTH + 1];
+                                            tcn->dontEcho ();
+                                            if (tcn->sendString ("\r\nEnter new password: ") <= 0)
+                                                return "\r"; 
+                                            if (tcn->recvLine (password1, sizeof (password1), true) != 13) { // the line is not ended with Enter
+                                                tcn->doEcho ();
+                                                return "\r\nPassword not changed"; 
+                                            }
+                                            if (tcn->sendString ("\r\nRe-enter new password: ") <= 0)
+                                                return "\r"; 
+                                            if (tcn->recvLine (password2, sizeof (password2), true) != 13) { // the line is not ended with Enter
+                                                tcn->doEcho ();
+                                                return "\r\nPassword not changed"; 
+                                            }
+                                            tcn->doEcho ();
+                                            // check passwords
+                                            if (strcmp (password1, password2))
+                                                return "\r\nPasswords do not match";
+                                            // change password
+                                            if (userManagement->passwd (forUser, password1))
+                                                return "\r\nPassword changed";
+                                            else
+                                                return "\r\nError changing password";  
+                                    }
+
+    else if (argv0is ("passwdbench")) {
+                                            if (argc == 1)                              return userManagement->bench ();
+                                            if (argc == 2) {
+                                                if (strcmp (tcn->getUserName (), "root")) return "Only root may change the password hashing rounds";
+                                                int ms = atoi (argv [1]);
+                                                if (ms <= 0)                            return "Wrong syntax, use passwdbench [<target login ms>]";
+                                                if (!userManagement->setRounds (userManagement->calibrate (ms)))
+                                                                                        return "Can't write /etc/login.defs";
+                                                return String ("New passwords will be hashed with ") + String (userManagement->getRounds ()) + " rounds\r\n" + userManagement->bench ();
+                                            }
+                                                                                        return "Wrong syntax, use passwdbench [<target login ms>]";
+                                    }
+
+    // ----- performance -----
+    else if (argv0is ("httpstat"))  {
+                                        if (argc == 1)                              return httpLatency.toText ();
+                                        if (argc == 2 && argv1is ("reset"))         { httpLatency.reset (); return "HTTP statistics reset"; }
+                                        if (argc == 2 && argv1is ("bench"))         { return httpLatency.benchmark (); }
+                                                                                    return "Wrong syntax, use httpstat [reset | bench]";
+                                    }
+    else if (argv0is ("top"))       {
+                                        if (argc == 1)                              { return taskProfiler.toText (); }
+                                                                                    return "Wrong syntax, use top";
+                                    }
+    else if (argv0is ("assetcache")) {
+                                        if (argc == 1)                              return staticAssetCache.toText ();
+                                        if (argc == 2 && argv1is ("on"))            { staticAssetCache.setEnabled (true); return "static asset cache is on"; }
+                                        if (argc == 2 && argv1is ("off"))           { staticAssetCache.setEnabled (false); return "static asset cache is off"; }
+                                        if (argc == 2 && argv1is ("clear"))         { staticAssetCache.clear (); return "static asset cache cleared"; }
+                                                                                    return "Wrong syntax, use assetcache [on | off | clear]";
+                                    }
+    else if (argv0is ("htmlbundle")) {
+                                        #ifdef USE_HTML_BUNDLE
+                                            if (argc == 1)                          { return htmlBundle.toText (); }
+                                                                                    return "Wrong syntax, use htmlbundle";
+                                        #else
+                                                                                    return "html bundle is not compiled in, #define USE_HTML_BUNDLE in server_config.h";
+                                        #endif
+                                    }
+    else if (argv0is ("crypto"))     {
+                                        if (argc == 2 && argv1is ("hardware"))      { cryptoBackend_t::setBackend (cryptoBackend_t::HARDWARE); }
+                                        else if (argc == 2 && argv1is ("software")) { cryptoBackend_t::setBackend (cryptoBackend_t::SOFTWARE); }
+                                        else if (argc != 1)                         { return "Wrong syntax, use crypto [hardware | software]"; }
+                                                                                    return cryptoBackend_t::getBackend () == cryptoBackend_t::HARDWARE ? "crypto backend is hardware" : "crypto backend is software";
+                                    }
+    else if (argv0is ("cryptobench")) {
+                                        if (argc == 1)                              { return cryptoBackend_t::bench (); }
+                                                                                    return "Wrong syntax, use cryptobench";
+                                    }
+    else if (argv0is ("transfers"))  {
+                                        if (argc == 1)                              { return fileTransfer.toText (); }
+                                                                                    return "Wrong syntax, use transfers";
+                                    }
+    else if (argv0is ("cat") && argc == 2 && argv [1][0] == '/') {
+                                                                                    return coalescedCat (argv [1], tcn); // relative paths are left to telnetServer_t
+                                    }
+    else if (argv0is ("telnetout"))  {
+                                        if (argc == 1) {
+                                            portENTER_CRITICAL (&lastCatMux);
+                                                lastCat_t c = lastCat;
+                                            portEXIT_CRITICAL (&lastCatMux);
+                                            char s [256];
+                                            snprintf (s, sizeof (s), "Telnet output: %llu bytes in %llu segments\r\nlast cat: %u bytes in %u segments (%u lines) in %lu ms",
+                                                      (unsigned long long) telnetOutputBytes, (unsigned long long) telnetOutputSegments,
+                                                      (unsigned) c.bytes, (unsigned) c.segments, (unsigned) c.lines, c.milliseconds);
+                                                                                    return s;
+                                        }
+                                                                                    return "Wrong syntax, use telnetout";
+                                    }
+    else if (argv0is ("dmesg"))      {
+                                        if (argc == 2 && argv1is ("-p"))            return dmesgRing.previousRun ();
+                                        dmesgRing.drain (dmesgRingOutput);          // format DMESG records into dmesgQueue before telnetServer_t shows it
+                                        return "";
+                                    }
+    else if (argv0is ("dmesgbench")) {
+                                        if (argc == 1)                              { return dmesgRing.benchmark ([] (int i) { cout << ( dmesgQueue << "[dmesgbench] formatted record " << i ); }, dmesgRingOutput); }
+                                                                                    return "Wrong syntax, use dmesgbench";
+                                    }
+    else if (argv0is ("syslog"))     {
+                                        #ifdef USE_SYSLOG_EXPORTER
+                                            if (argc == 1)                          return syslogExporter.toText ();
+                                                                                    return "Wrong syntax, use syslog";
+                                        #else
+                                                                                    return "syslog exporter is not compiled in, #define USE_SYSLOG_EXPORTER in server_config.h";
+                                        #endif
+                                    }
+    else if (argv0is ("configsnapshot")) {
+                                        if (argc == 1)                              { char s [64]; snprintf (s, sizeof (s), "\r\nfirst HTTP response %lu ms after boot", (unsigned long) (firstHttpResponseTime / 1000)); return configSnapshot.toText () + s; }
+                                        if (argc == 2 && argv1is ("on"))            { configSnapshot.setEnabled (true); return "configuration snapshots are on"; }
+                                        if (argc == 2 && argv1is ("off"))           { configSnapshot.setEnabled (false); return "configuration snapshots are off, the files will be parsed at each boot"; }
+                                        if (argc == 2 && argv1is ("clear"))         { configSnapshot.clear (); return "configuration snapshots removed, the files will be parsed at the next boot"; }
+                                                                                    return "Wrong syntax, use configsnapshot [on | off | clear]";
+                                    }
+    else if (argv0is ("bootchart"))  {
+                                        #ifdef USE_BOOTCHART
+                                            if (argc == 1)                          return bootChart.toText ();
+                                                                                    return "Wrong syntax, use bootchart";
+                                        #else
+                                                                                    return "boot chart is not compiled in, #define USE_BOOTCHART in server_config.h";
+                                        #endif
+                                    }
+    else if (argv0is ("startup"))    {
+                                        if (argc == 1)                              { return startupScheduler.toText (); }
+                                                                                    return "Wrong syntax, use startup";
+                                    }
+    else if (argv0is ("eventloop"))  {
+                                        if (argc == 1)                              { return eventLoop.toText (); }
+                                                                                    return "Wrong syntax, use eventloop";
+                                    }
+    else if (argv0is ("crontab"))    {
+                                        if (argc == 1)                              { return cronScheduler.toText (); }
+                                                                                    return "Wrong syntax, use crontab";
+                                    }
+    else if (argv0is ("firewall"))   {
+                                        if (argc == 1)                              { return firewall.toText (); }
+                                                                                    return "Wrong syntax, use firewall";
+                                    }
+
+    #ifdef POWER_SAVING
+
+        // ----- WiFi POWER SAVING -----
+
+        if (argv0is ("power"))      {
+                                        if (argv1is ("saving")) {
+                                            if (argc == 2) {
+                                                wifi_ps_type_t ps_type;
+                                                esp_err_t err = esp_wifi_get_ps (&ps_type);
+                                                if (err == ESP_OK)
+                                                    if (ps_type == WIFI_PS_NONE)
+                                                        return "power saving is off";
+                                                    else
+                                                        return "power saving is on";
+                                                else
+                                                    return "Couldn't get power saving mode";
+                                            } else if (argc == 3) {
+                                                if (argv2is ("on")) {
+                                                    esp_err_t err = esp_wifi_set_ps (POWER_SAVING);
+                                                    if (err == ESP_OK)
+                                                        return "power saving is on";
+                                                    else
+                                                        return "Couldn't set power saving mode";
+                                                } else if (argv2is ("off")) {
+                                                    esp_err_t err = esp_wifi_set_ps (WIFI_PS_NONE);
+                                                    if (err == ESP_OK)
+                                                        return "power saving is off";
+                                                    else
+                                                        return "Couldn't set power saving mode";
+                                                }                                                
+                                            }
+                                        }
+                                        return "Wrong syntax, use power saving [on | off]";
+                                    }
+    #endif
+
+    return ""; // telnetCommand has not been handled by telnetCommandHandler - tell telnetServer to handle it internally by returning ""
+}
+
+
+// ----- for demonstration only - you may freely delete the following definitions -----
+
+#include "measurements.hpp"
+measurements<60> freeHeap60;        // measure free heap each minute for possible memory leaks
+measurements<24> freeHeap24;        // measure free heap each hour for possible memory leaks
+measurements<24> freeBlock24;       // measure max free block of memory each hour
+measurements<60> httpRequestCount;  // measure how many web connections arrive each minute
+#undef LED_BUILTIN
+#define LED_BUILTIN 2               // built-in led
+
+String stateJson () {
+    time_t t = ntpClient_t ().getUpTime (); // t holds seconds
+    int seconds = t % 60; t /= 60;          // t now holds minutes
+    int minutes = t % 60; t /= 60;          // t now holds hours
+    int hours = t % 24;   t /= 24;          // t now holds days
+    char upTime [25]; 
+    *upTime = 0;
+    if (t) 
+    sprintf (upTime, "%lu days, ", (unsigned long) t);
+    sprintf (upTime + strlen (upTime), "%02i:%02i:%02i", hours, minutes, seconds);
+
+    return "{\"id\":\"" HOSTNAME "\","
+            "\"upTime\":\"" + String (upTime) + "\","
+            "\"httpRequestCount\": " + httpRequestCount.toJson () + ","
+            "\"freeHeap60\": " + freeHeap60.toJson () + ","
+            "\"freeHeap24\": " + freeHeap24.toJson () + ","
+            "\"freeBlock24\": " + freeBlock24.toJson () + ""
+            "}";
+}
+
+
+// ----- large file transfers -----
+
+// GET /download/<path> sends a file from TSFS, PUT /upload/<path> writes the request body to it (the client must send Expect: 100-continue,
+// so that the body is not read by the server before the file is opened). Like with FTP and Telnet, the logged-in user can only reach the files in
+// their home directory (from /etc/passwd), and never the files in /etc, for example:
+//     curl -b session=<token> -T firmware.bin -H "Expect: 100-continue" http://<ESP32>/upload/firmware.bin
+// Interrupted transfers can be resumed: downloads with Range: bytes=<from>-, uploads with Content-Range: bytes <from>-<to>/<size>, the ranges
+// that have already been uploaded are returned by HEAD /upload/<path> in X-Received-Ranges. Parts of the same file can also be uploaded
+// through several connections at once, they are merged when all of them have been received.
+template<class connection_t> String fileTransferRequest (const char *httpRequest, connection_t *hcn, const char *userName) {
+    // eventHttpServer_t's handlers must not block and httpsServer_t's sockets are encrypted
+    if (!std::is_same<connection_t, httpServer_t::httpConnection_t>::value || *hcn->cipherName ())
+        return "File transfers are only available through httpServer_t";
+
+    bool download = !strncmp (httpRequest, "GET /download/", 14);
+    bool upload = !strncmp (httpRequest, "PUT /upload/", 12);
+    char path [256];
+    size_t i = 0;
+    const char *p = httpRequest + (download ? 13 : upload ? 11 : 12); // keep the leading /
+    for (; *p > ' ' && *p != '?' && i < sizeof (path) - 1; p++)
+        path [i++] = *p;
+    path [i] = 0;
+    if ((*p > ' ' && *p != '?') || !strcmp (path, "/") || strstr (path, "..")) { // too long or not a file
+        hcn->setHttpReplyStatus ("400 Bad request");
+        return "Wrong path";
+    }
+    Cstring<255> homeDirectory;
+    if (userManagement)
+        homeDirectory = userManagement->getHomeDirectory (userName);
+    if (!isInHomeDirectory (path, homeDirectory) || isInHomeDirectory (path, "/etc")) { // /etc/passwd, /etc/shadow, ... are not reachable through HTTP even for root
+        hcn->setHttpReplyStatus ("403 Forbidden");
+        return "Access denied";
+    }
+
+    if (download) {
+        threadSafeFS::File f = TSFS.open (path, "r");
+        if (!f || f.isDirectory ()) {
+            hcn->setHttpReplyStatus ("404 Not found");
+            return "File not found";
+        }
+        unsigned size = f.size ();
+        unsigned from = 0, to = size - 1;
+        Cstring<64> range = hcn->getHttpRequestHeaderField ("Range");
+        if (range != "" && (sscanf (range, "bytes=%u-%u", &from, &to) < 1 || from > to || to >= size)) {
+            f.close ();
+            hcn->setHttpReplyStatus ("416 Range not satisfiable");
+            return "Wrong range";
+        }
+        char contentRange [64] = "";
+        if (range != "")
+            snprintf (contentRange, sizeof (contentRange), "Content-Range: bytes %u-%u/%u\r\n", from, to, size);
+        httpReplyStream_t<connection_t> reply (hcn);
+        if (f.seek (from) && reply.sendHeader (range != "" ? "206 Partial content" : "200 OK", "application/octet-stream", to + 1 - from, contentRange) && reply.flush ())
+            fileTransfer.sendFile (f, hcn->getSocket (), to + 1 - from, path);
+        f.close ();
+        return reply.end ();
+    }
+
+    if (!upload) { // HEAD /upload/<path>
+        httpReplyStream_t<connection_t> reply (hcn);
+        reply.sendHeader ("200 OK", "text/plain", 0, ("X-Received-Ranges: " + fileTransfer.receivedParts (TSFS, path) + "\r\n").c_str ());
+        return reply.end ();
+    }
+
+    Cstring<16> contentLength = hcn->getHttpRequestHeaderField ("Content-Length");
+    Cstring<16> expect = hcn->getHttpRequestHeaderField ("Expect");
+    Cstring<64> contentRange = hcn->getHttpRequestHeaderField ("Content-Range");
+    if (contentLength == "") {
+        hcn->setHttpReplyStatus ("411 Length required");
+        return "Content-Length is required";
+    }
+    if (expect != "100-continue") {
+        hcn->setHttpReplyStatus ("417 Expectation failed");
+        return "Expect: 100-continue is required";
+    }
+    size_t length = atol (contentLength);
+    long received;
+
+    if (contentRange != "") {
+        // a part of the file
+        unsigned from, to, size;
+        if (sscanf (contentRange, "bytes %u-%u/%u", &from, &to, &size) != 3 || from > to || to >= size || to + 1 - from != length) {
+            hcn->setHttpReplyStatus ("416 Range not satisfiable");
+            return "Wrong range";
+        }
+        if (!fileTransfer.canReceivePart (TSFS, path, from)) {
+            hcn->setHttpReplyStatus ("507 Insufficient storage");
+            return "Too many parts, send the missing ranges in larger parts";
+        }
+        hcn->sendString ("HTTP/1.1 100 Continue\r\n\r\n");
+        received = fileTransfer.receivePart (hcn->getSocket (), TSFS, path, from, length, size);
+    } else {
+        // the whole file, received into path.tmp which replaces path only when it is complete, so a failed upload leaves the old file as it was
+        char tmpPath [sizeof (path) + 4];
+        snprintf (tmpPath, sizeof (tmpPath), "%s.tmp", path);
+        threadSafeFS::File f = TSFS.open (tmpPath, "w");
+        if (!f) {
+            hcn->setHttpReplyStatus ("500 Internal server error");
+            return "Can't write " + String (path);
+        }
+        hcn->sendString ("HTTP/1.1 100 Continue\r\n\r\n");
+        received = fileTransfer.receiveFile (hcn->getSocket (), f, length, path);
+        f.close ();
+        if (received >= 0 && !TSFS.rename (tmpPath, path)) { // LittleFS replaces the old file atomically, the other file systems need it removed first
+            TSFS.remove (path);
+            if (!TSFS.rename (tmpPath, path))
+                received = -1;
+        }
+        if (received < 0)
+            TSFS.remove (tmpPath);
+    }
+    if (received < 0) {
+        hcn->setHttpReplyStatus ("500 Internal server error");
+        return "Upload failed";
+    }
+    return "OK";
+}
+
+
+// ----- diagnostics -----
+
+// GET /metrics, /httpstat, /top and /bootchart, returns "" if httpRequest is none of them (see PUBLIC_DIAGNOSTICS in server_config.h)
+template<class connection_t> String diagnosticsRequest (const char *httpRequest, connection_t *hcn) {
+    if (!strncmp (httpRequest, "GET /metrics ", 13))
+        return metrics.writeOpenMetrics (hcn); // streams the reply directly to the socket
+    if (!strncmp (httpRequest, "GET /httpstat ", 14))
+        return httpLatency.toJson ();
+    if (!strncmp (httpRequest, "GET /top ", 9))
+        return taskProfiler.toJson ();
+    #ifdef USE_BOOTCHART
+        if (!strncmp (httpRequest, "GET /bootchart ", 15))
+            return bootChart.toJson ();
+    #endif
+    return "";
+}
+
+
+// ----- handle HTTP requests -----
+
+// connection_t is httpServer_t::httpConnection_t or eventHttpServer_t::connection_t, the same code serves both servers
+template<class connection_t> String httpRequestHandlerCallback (const char *httpRequest, connection_t *hcn) { 
+
+    // Must be reentrant !!!
+
+
+    #define httpRequestIs(X) (strstr(httpRequest,X)==httpRequest)
+
+    httpLatency_t::timer_t latencyTimer (httpLatency, httpRequest); // measure the latency of this request until the function returns
+
+    httpRequestCount.increase_valueCounter (); // gether statistics
+    httpRequestsTotal.increase ();
+    if (!firstHttpResponseTime) {
+        firstHttpResponseTime = esp_timer_get_time ();
+        BOOTCHART_MARK ("first HTTP request");
+    }
+
+    // REST API
+    if (httpRequestIs ("GET /builtInLed "))             { 
+                                                        getBuiltInLed:
+                                                            return "{\"id\":\"" HOSTNAME "\",\"builtInLed\":\"" + String (digitalRead (LED_BUILTIN) ? "on" : "off") + "\"}\r\n";
+                                                        }                                                                    
+    else if (httpRequestIs ("PUT /builtInLed/on "))     {
+                                                            digitalWrite (LED_BUILTIN, HIGH);
+                                                            goto getBuiltInLed;
+                                                        }
+    else if (httpRequestIs ("PUT /builtInLed/off "))    {
+                                                            digitalWrite (LED_BUILTIN, LOW);
+                                                            goto getBuiltInLed;
+                                                        }
+    else if (httpRequestIs ("GET /state "))             {
+                                                            return stateJson ();
+                                                        }
+    #ifdef PUBLIC_DIAGNOSTICS
+        String diagnosticsReply = diagnosticsRequest (httpRequest, hcn);
+        if (diagnosticsReply != "")
+            return diagnosticsReply;
+    #endif
+
+    // ----- entering restricted part - check authorization -----
+
+    Cstring<300> token = hcn->getHttpRequestCookie ("session");
+    Cstring<64> userName;
+    const char *cipherName = hcn->cipherName ();
+
+    if (token != "" && webSessionTokens)
+        userName = webSessionTokens->getUserNameFromToken (token);
+
+    // login-logout REST API
+    if (httpRequestIs ("POST /login/"))                 {   // POST login/username/password ...
+                                                            if (*cipherName == 0)
+                                                                return "Login is alowed through secure HTTPS protocol only";
+                                                            // parse URL to get userName and password
+                                                            Cstring<64>userName;
+                                                            Cstring<64>password;
+                                                            if (sscanf (httpRequest + 12, "%64[^/]/%64s", (char *) &userName, (char *) &password) != 2)
+                                                                return "Missing username or password";
+
+                                                            // TO DO: implement your user management
+
+                                                            if (userName != "user" && password != "password")
+                                                                return "Wrong username or password";
+                                                            // create new session token
+                                                            token = "";
+                                                            if (webSessionTokens && time (NULL) > 1600000000) // 1600000000 ~2020
+                                                                token = webSessionTokens->newToken (userName, time (NULL) + 86400); // 86400 = 1 day
+                                                            if (token == "")
+                                                                return "Couldn't create session token";
+                                                            // clean up token store every now and then
+                                                            webSessionTokens->deleteExpiredTokens ();
+                                                            // pass the token to session cookie
+                                                            hcn->setHttpReplyCookie ("session", token, time (NULL) + 86400);
+                                                            return "OK";
+                                                        } 
+    else if (httpRequestIs ("POST /logout "))           {
+                                                            // delete session cookie
+                                                            hcn->setHttpReplyCookie ("session", "", 1); // 0 means that the cookie never expires, 1 will always expire 
+                                                            if (webSessionTokens) {            
+                                                                // delete session token
+                                                                webSessionTokens->deleteToken (token);
+                                                                // clean up token store every now and then
+                                                                webSessionTokens->deleteExpiredTokens ();
+                                                            }
+                                                            return "OK";
+                                                        }
+
+    // ----- protect some pages if userName != "" the token is valid, proceed, if not redirect to login.html -----
+    if (userName == "") {
+      
+        if (httpRequestIs ("GET /administration.html")) {   // do not include space after ...html since users may also pass parameters: ...html?...
+                                                            hcn->setHttpReplyHeaderField ("Location", "/login.html?redirect=/administration.html");
+                                                            hcn->setHttpReplyStatus ("307 Login required"); // 307 = redirect
+                                                            return "Login required"; // whatever
+                                                        }
+
+    } else {
+
+        // ----- restrictes part for logged-in users only -----
+
+        // you may also want to check userName rights at this point
+
+        // TO DO: put your restricted access code here 
+
+        if (httpRequestIs ("GET /download/") || httpRequestIs ("PUT /upload/") || httpRequestIs ("HEAD /upload/"))
+                                                        return fileTransferRequest (httpRequest, hcn, userName);
+
+        #ifndef PUBLIC_DIAGNOSTICS
+            String diagnosticsReply = diagnosticsRequest (httpRequest, hcn);
+            if (diagnosticsReply != "")
+                return diagnosticsReply;
+        #endif
+
+    }
+
+    // ----- unrestricted part again - HTTP server will process all requests to files if they were not redirected above -----
+
+    #ifdef USE_HTML_BUNDLE
+        // send the files compiled into the firmware directly from flash
+        const char *bundledReply = htmlBundle.reply (httpRequest, hcn);
+        if (bundledReply)
+            return bundledReply;
+    #endif
+
+    // send small static files from RAM if they are cached, otherwise let HTTP server read them from the file system
+    const char *cachedReply = staticAssetCache.reply (httpRequest, hcn);
+    if (cachedReply)
+        return cachedReply;
+
+    return ""; // httpRequestHandler did not handle the request - tell httpServer to handle it internally by returning ""
+}
+
+void wsRequestHandlerCallback (const char *httpRequest, httpServer_t::webSocket_t *webSck) {
+
+    // Must be reentrant !!!
+    
+
+    #define httpRequestIs(X) (strstr(httpRequest,X)==httpRequest)
+
+    httpLatency_t::timer_t latencyTimer (httpLatency, httpRequest); // measure how long the WebSocket stays open
+    
+    #ifdef __OSCILLOSCOPE__
+          if (httpRequestIs ("GET /runOscilloscope"))      runOscilloscope (webSck);      // used by oscilloscope.html
+    #endif
+
+    if (httpRequestIs ("GET /rssiReader"))  { 
+                                                char c;
+                                                do {
+                                                    delay (100);
+                                                    int i = WiFi.RSSI ();
+                                                    c = (char) i;
+                                                } while (webSck->sendBlock ((byte *) &c, sizeof (c))); // keep sending RSSI information as long as web browser is receiving it
+                                            }
+}
+
+
+#ifdef USE_EVENT_HTTP_SERVER
+
+    // WebSockets of eventHttpServer_t: called with each message and every EVENT_HTTP_SERVER_WS_TICK ms with message = NULL, must not block, return false to close
+    bool wsEventHandlerCallback (const char *httpRequest, eventHttpServer_t::connection_t *webSck, const char *message, size_t messageLength) {
+
+        #define httpRequestIs(X) (strstr(httpRequest,X)==httpRequest)
+
+        if (httpRequestIs ("GET /rssiReader"))  {
+                                                    if (message)
+                                                        return true; // index.html does not send anything
+                                                    char c = (char) WiFi.RSSI (); // every EVENT_HTTP_SERVER_WS_TICK = 100 ms
+                                                    return webSck->sendBlock ((byte *) &c, sizeof (c)) > 0;
+                                                }
+
+        return false; // the oscilloscope can not run in this mode, it needs its own task
+    }
+
+#endif
+
+
+// ----- firewalll -----
+
+bool firewallCallback (char *clientIP, char *serverIP) {
+
+    // Must be reentrant !!!
+    // firewall.allow checks clientIP against the allow and deny rules and the rate limit from /etc/firewall.conf
+
+    return firewall.allow (clientIP); // return false to refuse the connection for certain clientIP or serverIP 
+}
+
+
+// ----- cron handler -----
+
+static bool timeAlreadySynchronized = false;
+
+void cronHandlerCallback (const char *cronCommand) {
+
+    // Does not have to reentrant but keep in mind that cronHandlerCallback may be running in a different task than setup-loop
+
+
+    #define cronCommandIs(X) (!strcmp (cronCommand, X))
+
+    cronTicksTotal.increase ();
+
+    // There are three special cronCommands: ONCE A MINUTE, ONCE AN HOUR, and ONCE A DAY.
+    // These run at fixed intervals regardless of whether the ESP32 has already
+    // obtained the correct time from NTP servers.
+    // All other cronCommands run only after the correct time has been set.
+
+        if (cronCommandIs ("ONCE A MINUTE"))    {   
+                                                    // As long as the ESP32 has not yet obtained the correct time from
+                                                    // NTP servers, try synchronizing once per minute.
+                                                    if (!timeAlreadySynchronized) // 1600000000 ~2020
+                                                        timeAlreadySynchronized = *(ntpClient_t ().syncTime ()) == 0; // syncTime did not return error message
+                                                }
+    else if (cronCommandIs ("ONCE A DAY"))      {
+                                                    // Once the time is set, synchronize the internal clock with NTP servers daily.
+                                                    // if (time (NULL) > 1600000000) // 1600000000 ~2020
+                                                    ntpClient_t ().syncTime ();                                                                                    
+                                                } 
+    else if (cronCommandIs ("ONCE AN HOUR"))    {   
+                                                    // Check once per hour whether the router is reachable.
+                                                    wifi_mode_t wifiMode = WIFI_OFF;
+                                                    if (esp_wifi_get_mode (&wifiMode) != ESP_OK) {
+                                                        DMESG ("[cronHandlerCallback] " "couldn't get WiFi mode");
+                                                    } else {
+                                                        if (wifiMode & WIFI_STA) { // WiFi works in STAtion mode  
+                                                            ThreadSafePing_t routerPing (WiFi.gatewayIP ());
+                                                            routerPing.ping (4);
+                                                            if (!routerPing.received ()) {
+                                                                DMESG ("[cronHandlerCallback] " "ping of router failed, reconnecting WiFi STAtion");
+                                                                WiFi.disconnect ();
+                                                                WiFi.reconnect ();
+                                                            }
+                                                        }
+                                                    }
+                                                }
+
+    // The following cronCommands can be provided either programmatically
+    // (via cronScheduler.insert) or through the /etc/crontab file.
+
+    else if (cronCommandIs ("gotTime"))         {
+                                                    // "* * * * * * gotTime" is triggered only once — the moment the ESP32
+                                                    // obtains the correct time from NTP servers for the first time.
+                                                    time_t t = time (NULL);
+                                                    struct tm st;
+                                                    localtime_r (&t, &st);
+                                                    cout << "Got time at " << st << " (local time), do whatever needs to be done the first time the time is known" << endl;
+                                                }
+    else if (cronCommandIs ("onMinute"))        {
+                                                    // "0 * * * * * onMinute" occurs at the beginning of every minute.
+                                                    // This is a good moment to update our demonstration measurement queues.
+                                                    time_t t = time (NULL);
+                                                    struct tm st;
+                                                    localtime_r (&t, &st);
+                                                    freeHeap60.push_back ( { (unsigned char) st.tm_min, (int16_t) (ESP.getFreeHeap () / 1024) } );                                                    
+                                                    // Number of HTTP requests received during the last minute.
+                                                    httpRequestCount.push_back_and_reset_valueCounter ((int16_t) st.tm_min);
+                                                }
+    else if (cronCommandIs ("onHour"))          {
+                                                    // "0 0 * * * * onHour" occurs at the beginning of every hour.
+                                                    // Another good moment to update hourly measurement queues.
+                                                    time_t t = time (NULL);
+                                                    struct tm st;
+                                                    localtime_r (&t, &st);
+                                                    freeHeap24.push_back ( { (unsigned char) st.tm_hour, (int16_t) (ESP.getFreeHeap () / 1024) } );
+                                                    freeBlock24.push_back ( { (unsigned char) st.tm_hour, (int16_t) (heap_caps_get_largest_free_block (MALLOC_CAP_DEFAULT) / 1024) } );
+                                                }
+}
+
+
+// returns        "/" for full access
+// something like "/home/name" for limited access
+//                "" for no access
+Cstring<255> getUserHomeDirectoryCallback (const Cstring<64>& userName, const Cstring<64>& password) {
+
+    // Must be reentrant !!!
+
+
+    Cstring<255> retVal;
+    // check if userName and password are correct
+    if (userManagement && userManagement->checkUserNameAndPassword (userName, password))
+        return userManagement->getHomeDirectory (userName);
+    // else
+    return "";  // access (login) denyed
+}
+
+
+void setup () {
+
+    pinMode (LED_BUILTIN, OUTPUT | INPUT);
+    digitalWrite (LED_BUILTIN, LOW);
+
+
+    // Initialize console output.
+    // Optional arguments: waitForSerial=false, waitAfterSerial=100 ms, serialSpeed=115200.
+    cinit ();
+    cout << showpoint;
+
+    BOOTCHART_PHASE ("metrics");
+
+    if (dmesgRing.previousRunRecords ())
+        DMESG ("[dmesg] %i records of the previous run survived reset reason %i, see dmesg -p", dmesgRing.previousRunRecords (), (int) esp_reset_reason ());
+
+
+    // Register server internals with the metrics registry, they can be scraped through GET /metrics.
+    metrics.addGauge ("esp32_free_heap_bytes", "Free heap", [] () -> double { return ESP.getFreeHeap (); });
+    metrics.addGauge ("esp32_largest_free_block_bytes", "Largest free block of heap", [] () -> double { return heap_caps_get_largest_free_block (MALLOC_CAP_DEFAULT); });
+    metrics.addGauge ("esp32_http_connections", "Active HTTP connections", [] () -> double { return metrics_t::tcpConnections (80); });
+    metrics.addGauge ("esp32_ftp_connections", "Active FTP control connections", [] () -> double { return metrics_t::tcpConnections (21); });
+    metrics.addGauge ("esp32_telnet_connections", "Active Telnet connections", [] () -> double { return metrics_t::tcpConnections (23); });
+    // Demonstration measurements — remove these together with the measurements.
+    metrics.addGauge ("esp32_free_heap_60m_average_kb", "Free heap measured each minute, average of the last hour", [] () -> double { return freeHeap60.average (); });
+    metrics.addGauge ("esp32_free_heap_24h_average_kb", "Free heap measured each hour, average of the last day", [] () -> double { return freeHeap24.average (); });
+    metrics.addGauge ("esp32_free_block_24h_average_kb", "Largest free block measured each hour, average of the last day", [] () -> double { return freeBlock24.average (); });
+    metrics.addGauge ("esp32_http_requests_per_minute_60m_average", "HTTP requests per minute, average of the last hour", [] () -> double { return httpRequestCount.average (); });
+    metrics.addCounter ("esp32_static_asset_cache_hits", "Static files sent from RAM", [] () -> double { return staticAssetCache.hits (); });
+    metrics.addCounter ("esp32_static_asset_cache_misses", "Static files not found in RAM", [] () -> double { return staticAssetCache.misses (); });
+    metrics.addCounter ("esp32_static_asset_cache_not_found", "Static file requests for files that don't exist", [] () -> double { return staticAssetCache.notFound (); });
+    metrics.addCounter ("esp32_static_asset_cache_too_large", "Static file requests for files too large to cache", [] () -> double { return staticAssetCache.tooLarge (); });
+    metrics.addGauge ("esp32_static_asset_cache_bytes", "RAM used by static asset cache", [] () -> double { return staticAssetCache.bytesUsed (); });
+    metrics.addCounter ("esp32_file_transfer_sent_bytes", "Bytes sent by GET /download/", [] () -> double { return fileTransfer.bytesSent (); });
+    metrics.addCounter ("esp32_file_transfer_received_bytes", "Bytes received by PUT /upload/", [] () -> double { return fileTransfer.bytesReceived (); });
+    metrics.addCounter ("esp32_telnet_output_bytes", "Bytes sent through telnetOutputStream_t", [] () -> double { return telnetOutputBytes; });
+    metrics.addCounter ("esp32_telnet_output_segments", "Sends of telnetOutputStream_t", [] () -> double { return telnetOutputSegments; });
+    metrics.addGauge ("esp32_first_http_response_ms", "Time from boot to the first HTTP request being handled", [] () -> double { return firstHttpResponseTime / 1000.0; });
+    metrics.addGauge ("esp32_loop_idle_percent", "Time loop () spent waiting in select (), last 10 s", [] () -> double { return eventLoop.idlePercent (); });
+    metrics.addGauge ("esp32_accept_latency_average_ms", "Time from a connection waiting on FTP or Telnet listener until it is accepted, last 10 s", [] () -> double { return eventLoop.acceptLatencyAverage (); });
+    metrics.addGauge ("esp32_accept_latency_max_ms", "Longest time from a connection waiting on FTP or Telnet listener until it is accepted, last 10 s", [] () -> double { return eventLoop.acceptLatencyMax (); });
+    metrics.addCounter ("esp32_cron_recalculations", "Times the clock was set and cronScheduler calculated all the next fire times again", [] () -> double { return cronScheduler.recalculations (); });
+    metrics.addCounter ("esp32_logins", "User name and password checks", [] () -> double { return userManagement ? userManagement->logins () : 0; });
+    metrics.addCounter ("esp32_login_cache_hits", "Logins verified by the credential cache instead of SHA-crypt", [] () -> double { return userManagement ? userManagement->cacheHits () : 0; });
+    metrics.addCounter ("esp32_firewall_allowed", "Connections accepted by the firewall", [] () -> double { return firewall.allowed (); });
+    metrics.addCounter ("esp32_firewall_denied_rule", "Connections refused by a deny rule or the default policy", [] () -> double { return firewall.deniedByRule (); });
+    metrics.addCounter ("esp32_firewall_denied_rate", "Connections refused because their client IP exceeded its rate", [] () -> double { return firewall.deniedByRate (); });
+    metrics.addCounter ("esp32_dmesg_ring_records", "Records logged with DMESG", [] () -> double { return dmesgRing.logged (); });
+    metrics.addCounter ("esp32_dmesg_ring_dropped", "DMESG records dropped because the ring was full", [] () -> double { return dmesgRing.dropped (); });
+    #ifdef USE_SYSLOG_EXPORTER
+        metrics.addCounter ("esp32_syslog_sent", "Messages sent to the syslog collector", [] () -> double { return syslogExporter.sent (); });
+        metrics.addCounter ("esp32_syslog_dropped_rate_limit", "Messages not sent because their subsystem exceeded its rate", [] () -> double { return syslogExporter.droppedRateLimit (); });
+        metrics.addCounter ("esp32_syslog_dropped_queue_full", "Messages not sent because the queue was full", [] () -> double { return syslogExporter.droppedQueueFull (); });
+        metrics.addCounter ("esp32_syslog_send_errors", "Messages lost because sendto failed", [] () -> double { return syslogExporter.sendErrors (); });
+    #endif
+    #ifdef USE_EVENT_HTTP_SERVER
+        metrics.addCounter ("esp32_http_connections_accepted", "Connections accepted by eventHttpServer", [] () -> double { return eventHttpServer ? eventHttpServer->connectionsAccepted () : 0; });
+        metrics.addGauge ("esp32_http_requests_per_connection", "HTTP requests served through each eventHttpServer connection, on average (keep-alive reuse)", [] () -> double { return eventHttpServer && eventHttpServer->connectionsAccepted () ? (double) eventHttpServer->requestsHandled () / eventHttpServer->connectionsAccepted () : NAN; });
+    #endif
+
+    // Routes that httpLatency measures separately, all the other requests (mostly files) are measured together.
+    httpLatency.addRoute ("GET /builtInLed ");
+    httpLatency.addRoute ("PUT /builtInLed/");
+    httpLatency.addRoute ("GET /state ");
+    httpLatency.addRoute ("GET /metrics ");
+    httpLatency.addRoute ("GET /httpstat ");
+    httpLatency.addRoute ("POST /login/");
+    httpLatency.addRoute ("POST /logout ");
+    httpLatency.addRoute ("GET /runOscilloscope");  // WebSocket
+    httpLatency.addRoute ("GET /rssiReader");       // WebSocket
+
+
+    #ifdef LOCALE
+        BOOTCHART_PHASE ("locale");
+        if (setlocale (lc_all, LOCALE))
+            cout << ( dmesgQueue << "[locale] " "set to " << LOCALE );
+        else
+            cout << ( dmesgQueue << "[locale] " "could not set " << LOCALE );
+    #endif
+
+
+    // Connect to the WiFi router.
+    WiFi.onEvent ([] (WiFiEvent_t event, WiFiEventInfo_t info) {
+        if (event == ARDUINO_EVENT_WIFI_STA_CONNECTED) {
+            BOOTCHART_MARK ("WiFi connected");
+            DMESG ("[WiFi][STA] " "connected");
+            #ifdef POWER_SAVING
+                esp_err_t err = esp_wifi_set_ps (POWER_SAVING);
+                if (err == ESP_OK)
+                    DMESG ("[power saving] " "is on");
+                else
+                    DMESG ("[power saving] " "couldn't set power saving, error %i", err);
+            #endif
+        } else if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+            BOOTCHART_MARK ("WiFi got IP address");
+            IPAddress ip = WiFi.localIP ();
+            DMESG ("[WiFi][STA] " "got IP address: %u.%u.%u.%u", ip [0], ip [1], ip [2], ip [3]);
+            timeAlreadySynchronized = *(ntpClient_t ().syncTime ()) == 0; // syncTime did not return error message
+
+            #ifdef USE_mDNS
+                if (MDNS.begin (HOSTNAME))
+                    DMESG ("[mDNS] started for %s", HOSTNAME);
+                else
+                    DMESG ("[mDNS] did not start");
+                MDNS.addService ("ftp", "tcp", 21);            
+                MDNS.addService ("telnet", "tcp", 23);
+                MDNS.addService ("http", "tcp", 80);
+                MDNS.addService ("https", "tcp", 443);
+            #endif            
+        }
+    });
+
+    // Run the remaining initialization in parallel tasks (see startupScheduler.h), each step as soon as the steps it depends on
+    // are done, so the servers start accepting connections as soon as they can. The network steps run on core 0 together with
+    // WiFi and lwIP, the file system steps on core 1.
+    BOOTCHART_PHASE ("parallel startup");
+
+    // If a file system is used, mount it now.
+    startupScheduler_t::step_t fs = startupScheduler.add ("LittleFS", [] () {
+        BOOTCHART_SPAN ("LittleFS");
+        LittleFS.begin (true);
+        // LittleFS.format ();
+    }, 0, 1);
+
+    // Create the userManagement instance.
+    startupScheduler_t::step_t users = startupScheduler.add ("userManagement", [] () {
+        BOOTCHART_SPAN ("userManagement");
+        userManagement = new (std::nothrow) userManagement_t (TSFS);
+    }, fs, 1);
+
+    // Configure time zone prior to inserting events into cronScheduler for it works with local time.
+    startupScheduler_t::step_t timeZone = startupScheduler.add ("NTP and TZ", [] () {
+        BOOTCHART_SPAN ("NTP and TZ");
+        ntpClient_t (TSFS, DEFAULT_NTP_SERVER_1, DEFAULT_NTP_SERVER_2, DEFAULT_NTP_SERVER_3);
+        setenv ("TZ", zoneinfo (TSFS, DEFAULT_TZ), 1);
+        tzset ();
+        const char* tz = getenv ("TZ");
+        if (tz)
+            cout << ( dmesgQueue << "[time] TZ set to " << tz );
+        else
+            cout << ( dmesgQueue << "[time] TZ not set" );
+    }, fs, 1);
+
+    // cronScheduler reads /etc/crontab and works with local time
+    startupScheduler.add ("cronScheduler", [] () {
+        BOOTCHART_SPAN ("cronScheduler");
+        // ----- Demonstration entries — feel free to remove them -----
+        cronScheduler.insert ("* * * * * * gotTime");   // triggers once — when ESP32 obtains time from NTP for the first time
+        cronScheduler.insert ("0 * * * * * onMinute");  // triggers every minute at second 0
+        cronScheduler.insert ("0 0 * * * * onHour");    // triggers every hour at 00:00
+        //               | | | | | | |
+        //               | | | | | | |___ cron command, this information will be passed to cronHandlerCallback when the time comes
+        //               | | | | | |___ day of week (0 - 7 or *; Sunday=0 and also 7)
+        //               | | | | |___ month (1 - 12 or *)
+        //               | | | |___ day (1 - 31 or *)
+        //               | | |___ hour (0 - 23 or *)
+        //               | |___ minute (0 - 59 or *)
+        //               |___ second (0 - 59 or *)
+
+        if (!cronScheduler.readCrontab (TSFS))
+            cout << ( dmesgQueue << "[cronScheduler] " "couldn't read /etc/crontab" );
+    }, fs | timeZone, 1);
+
+    // read WiFi settings from configuration files which are stored on TSFS, after NTP and TZ are set, since the WiFi event handler
+    // synchronizes the time with the configured NTP servers as soon as it gets the IP address
+    startupScheduler_t::step_t wifi = startupScheduler.add ("WiFi", [] () {
+        BOOTCHART_SPAN ("WiFi");
+        WiFi_start (TSFS); // if not file system is used skip TSFS argument
+        // if no file system is used call WiFi_start () with no arguments which uses DEFAULT_ ... definitions instead,
+        // or simply call WiFi.begin ("YOUR STA SSID", "YOUR STA PASSWORD");
+    }, fs | timeZone, 0);
+
+    #ifdef USE_SYSLOG_EXPORTER
+        startupScheduler.add ("syslogExporter", [] () {
+            BOOTCHART_SPAN ("syslogExporter");
+            if (syslogExporter.begin (TSFS, HOSTNAME))
+                DMESG ("[syslog] " "exporting to the collector from /etc/syslog.conf");
+            else
+                DMESG ("[syslog] " "no collector in /etc/syslog.conf");
+        }, fs | wifi, 0);
+    #endif
+
+    // the servers start after the firewall rules are loaded
+    startupScheduler_t::step_t firewallRules = startupScheduler.add ("firewall", [] () {
+        BOOTCHART_SPAN ("firewall");
+        if (!firewall.begin (TSFS))
+            cout << ( dmesgQueue << "[firewall] " "/etc/firewall.conf is not valid, check the firewall Telnet command" );
+    }, fs, 1);
+
+    startupScheduler_t::step_t tokens = startupScheduler.add ("webSessionTokens", [] () {
+        BOOTCHART_SPAN ("webSessionTokens");
+        webSessionTokens = new (std::nothrow) webSessionTokens_t (TSFS);
+        if (!webSessionTokens)
+            cout << (dmesgQueue << "[webSessionTokens] " "not created");
+    }, fs, 1);
+
+    startupScheduler.add ("httpServer", [] () {
+        BOOTCHART_SPAN ("httpServer");
+        #ifdef USE_EVENT_HTTP_SERVER
+            // Start event-driven HTTP server. All the arguments are optional.
+            eventHttpServer = new (std::nothrow) eventHttpServer_t (TSFS,                                                       // threadSafeFS::FS& fileSystem,
+                                                                    httpRequestHandlerCallback<eventHttpServer_t::connection_t>,  // String httpRequestHandlerCallback (const char *httpRequest, eventHttpServer_t::connection_t *hcn) = NULL,
+                                                                    wsEventHandlerCallback,                                     // bool (*wsRequestHandlerCallback) (const char *httpRequest, eventHttpServer_t::connection_t *webSck, const char *message, size_t messageLength) = NULL,
+                                                                    80,                                                         // int serverPort = 80,
+                                                                    firewallCallback);                                          // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                                                                                                                                // bool runInItsOwnTask = true
+
+            if (eventHttpServer && *eventHttpServer)
+                cout << ( dmesgQueue << "[eventHttpServer] " "started" );
+            else
+                cout << ( dmesgQueue << "[eventHttpServer] " "did not start" );
+        #else
+            // Start HTTP server. All the arguments are optional.
+            httpServer = new (std::nothrow) httpServer_t (TSFS,                                                         // threadSafeFS::FS& fileSystem,
+                                                          httpRequestHandlerCallback<httpServer_t::httpConnection_t>,   // String httpRequestHandlerCallback (const char *httpRequest, httpServer_t::httpConnection_t *hcn) = NULL,
+                                                          wsRequestHandlerCallback,                                     // void (*wsRequestHandlerCallback) (const char *httpRequest, httpServer_t::webSocket_t *webSck) = NULL,
+                                                          80,                                                           // int serverPort = 80,
+                                                          firewallCallback);                                            // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                                                                                                                        // bool runListenerInItsOwnTask = true
+
+            if (httpServer && *httpServer)
+                cout << ( dmesgQueue << "[httpServer] " "started" );
+            else
+                cout << ( dmesgQueue << "[httpServer] " "did not start" );
+        #endif
+    }, fs | wifi | users | tokens | firewallRules, 0);
+
+    // Start HTTPS server. All the arguments are optional.
+/*
+    startupScheduler.add ("httpsServer", [] () {
+        BOOTCHART_SPAN ("httpsServer");
+        httpsServer = new (std::nothrow) httpsServer_t (TSFS,                         // threadSafeFS::FS& fileSystem,
+                                                        httpRequestHandlerCallback<httpServer_t::httpConnection_t>, // String httpRequestHandlerCallback (const char *httpRequest, httpServer_t::httpConnection_t *hcn) = NULL,
+                                                        wsRequestHandlerCallback,     // void (*wsRequestHandlerCallback) (const char *httpRequest, httpServer_t::webSocket_t *webSck) = NULL,
+                                                        443,                          // int serverPort = 443,
+                                                        firewallCallback);            // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                                                                                      // bool runListenerInItsOwnTask = true
+
+        if (httpsServer && *httpsServer)
+            cout << ( dmesgQueue << "[httpsServer] " "started" );
+        else
+            cout << ( dmesgQueue << "[httpsServer] " "did not start" );
+    }, fs | wifi | users | tokens | firewallRules, 0);
+*/
+
+    // Start the FTP server. To save ~3 KB of RAM, the listener can run inside the
+    // setup/loop task instead of its own task.
+    // In this mode you must call ftpServer->accept() manually from loop().
+    startupScheduler.add ("ftpServer", [] () {
+        BOOTCHART_SPAN ("ftpServer");
+        ftpServer = new (std::nothrow) ftpServer_t (TSFS,                           // threadSafeFS::FS& fileSystem,
+                                                                                    // Optional arguments:
+                                                    getUserHomeDirectoryCallback,   // Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL
+                                                    21,                             // int serverPort = 21
+                                                    firewallCallback,               // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL
+                                                    false);                         // bool runListenerInItsOwnTask = true
+
+        if (ftpServer && *ftpServer)
+            cout << ( dmesgQueue << "[ftpServer] " "started" );
+        else
+            cout << ( dmesgQueue << "[ftpServer] " "did not start" );
+    }, fs | wifi | users | firewallRules, 0);
+
+    // Start the Telnet server. To save ~3 KB of RAM, the listener can run inside the
+    // setup/loop task instead of its own task.
+    // In this mode you must call telnetServer->accept() manually from loop().
+    startupScheduler.add ("telnetServer", [] () {
+        BOOTCHART_SPAN ("telnetServer");
+        telnetServer = new (std::nothrow) telnetServer_t (TSFS,                         // threadSafeFS::FS& fileSystem,
+                                                          getUserHomeDirectoryCallback, // Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL
+                                                          telnetCommandHandlerCallback, // String (*telnetCommandHandlerCallback) (int argc, char *argv [], telnetConnection_t *tcn) = NULL
+                                                          23,                           // int serverPort = 23
+                                                          firewallCallback,             // bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL
+                                                          false);                       // bool runListenerInItsOwnTask = true
+
+        if (telnetServer && *telnetServer)
+            cout << (dmesgQueue << "[telnetServer] " "started");
+        else
+            cout << (dmesgQueue << "[telnetServer] " "did not start");
+    }, fs | wifi | users | firewallRules, 0);
+
+    startupScheduler.run ();
+
+
+    #ifdef USE_OTA
+        BOOTCHART_PHASE ("OTA");
+        ArduinoOTA
+            .onStart([]() {
+                String type;
+                if (ArduinoOTA.getCommand() == U_FLASH) {
+                    type = "sketch";
+                } else {  // U_SPIFFS
+                    type = "filesystem";
+                }
+
+                // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
+                Serial.println("Start updating " + type);
+            })
+            .onEnd([]() {
+                Serial.println("\nEnd");
+            })
+            .onProgress([](unsigned int progress, unsigned int total) {
+                if (millis() - last_ota_time > 500) {
+                    Serial.printf("Progress: %u%%\n", (progress / (total / 100)));
+                    last_ota_time = millis();
+                }
+            })
+            .onError([](ota_error_t error) {
+                Serial.printf("Error[%u]: ", error);
+                if (error == OTA_AUTH_ERROR) {
+                    Serial.println("Auth Failed");
+                } else if (error == OTA_BEGIN_ERROR) {
+                    Serial.println("Begin Failed");
+                } else if (error == OTA_CONNECT_ERROR) {
+                    Serial.println("Connect Failed");
+                } else if (error == OTA_RECEIVE_ERROR) {
+                    Serial.println("Receive Failed");
+                } else if (error == OTA_END_ERROR) {
+                    Serial.println("End Failed");
+                }
+            });
+
+        ArduinoOTA.begin();
+
+        Serial.println("Ready");
+        Serial.print("IP address: ");
+        Serial.println(WiFi.localIP());
+    #endif
+
+
+    // Instead of polling everything on each pass, loop () waits in a single select () for the connections on the
+    // listeners hosted in the loop task and for the earliest of the timers below.
+    if (ftpServer && *ftpServer)
+        if (!eventLoop.addListener (21, [] () { ftpServer->accept (); }))
+            cout << ( dmesgQueue << "[eventLoop] " "FTP listening socket not found, it will be polled" );
+    if (telnetServer && *telnetServer)
+        if (!eventLoop.addListener (23, [] () { telnetServer->accept (); }))
+            cout << ( dmesgQueue << "[eventLoop] " "Telnet listening socket not found, it will be polled" );
+    eventLoop.addTimer ([] () -> unsigned long { return cronScheduler.run (); }); // returns when the next crontab entry is due
+    eventLoop.addTimer ([] () -> unsigned long { taskProfiler.sample (); return TASK_PROFILER_SAMPLE_INTERVAL; });
+    eventLoop.addTimer ([] () -> unsigned long { dmesgRing.drainIfNeeded (dmesgRingOutput); return 100; }); // often enough for the ring not to fill up
+    #ifdef USE_SYSLOG_EXPORTER
+        eventLoop.addTimer ([] () -> unsigned long { syslogExporter.sendIfNeeded (); return 100; });
+    #endif
+    #ifdef USE_OTA
+        eventLoop.addTimer ([] () -> unsigned long { ArduinoOTA.handle (); return 100; });
+    #endif
+
+    BOOTCHART_DONE ();
+}
+
+void loop () {
+    // ftpServer and telnetServer run without their own listening tasks, cronScheduler without its own task, so eventLoop
+    // calls their accept () and run () (and the other periodic work registered in setup ()) when they have something to do.
+    // httpServer (or eventHttpServer) and httpsServer have their own listening tasks.
+    eventLoop.run ();
+
+    // Do not block the callbacks for too long; the connections wait to be accepted meanwhile (see esp32_accept_latency_max_ms).
+}
@@ -0,0 +1,109 @@
+/*
+
+    bootChart.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Records how long each phase of setup () takes, shown by bootchart Telnet command and GET /bootchart.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "bootChart.h"
+#include <esp_timer.h>
+
+
+int bootChart_t::begin (const char *name) {
+    int64_t now = esp_timer_get_time ();
+    int slot = __count__.fetch_add (1);
+    if (slot >= BOOTCHART_MAX_SPANS)
+        return -1;
+    __spans__ [slot].start = now;
+    __spans__ [slot].core = xPortGetCoreID ();
+    __spans__ [slot].name = name; // the last, toText skips the slots without a name
+    return slot;
+}
+
+void bootChart_t::end (int slot) {
+    if (slot >= 0)
+        __spans__ [slot].end = esp_timer_get_time ();
+}
+
+void bootChart_t::mark (const char *name) {
+    int slot = begin (name);
+    if (slot >= 0)
+        __spans__ [slot].end = __spans__ [slot].start;
+}
+
+void bootChart_t::phase (const char *name) {
+    end (__phase__);
+    __phase__ = begin (name);
+}
+
+void bootChart_t::done () {
+    end (__phase__);
+    __phase__ = -1;
+    __done__ = esp_timer_get_time ();
+}
+
+String bootChart_t::toText () {
+    int count = __count__;
+    if (count > BOOTCHART_MAX_SPANS)
+        count = BOOTCHART_MAX_SPANS;
+
+    // the chart spans from boot to the end of the latest span
+    int64_t total = __done__;
+    for (int i = 0; i < count; i++)
+        if (__spans__ [i].end > total)
+            total = __spans__ [i].end;
+    if (!total)
+        return "nothing recorded yet";
+
+    char line [128];
+    snprintf (line, sizeof (line), "%-24s %9s %9s core  0 ms%*s%.0f ms", "phase", "start ms", "took ms", BOOTCHART_BAR_WIDTH - 5, "", total / 1000.0);
+    String s = line;
+    for (int i = 0; i < count; i++) {
+        const __span__& sp = __spans__ [i];
+        if (!sp.name)
+            continue;
+        char bar [BOOTCHART_BAR_WIDTH + 1];
+        int from = sp.start * BOOTCHART_BAR_WIDTH / total;
+        int to = sp.end ? sp.end * BOOTCHART_BAR_WIDTH / total : BOOTCHART_BAR_WIDTH;
+        if (from >= BOOTCHART_BAR_WIDTH)
+            from = BOOTCHART_BAR_WIDTH - 1;
+        for (int c = 0; c < BOOTCHART_BAR_WIDTH; c++)
+            bar [c] = c < from ? ' ' : c <= to ? (sp.end == sp.start ? '|' : '#') : ' ';
+        bar [BOOTCHART_BAR_WIDTH] = 0;
+        if (sp.end)
+            snprintf (line, sizeof (line), "\r\n%-24.24s %9.1f %9.1f %4i  %s", sp.name, sp.start / 1000.0, (sp.end - sp.start) / 1000.0, sp.core, bar);
+        else
+            snprintf (line, sizeof (line), "\r\n%-24.24s %9.1f   running %4i  %s", sp.name, sp.start / 1000.0, sp.core, bar);
+        s += line;
+    }
+    if (__count__ > BOOTCHART_MAX_SPANS)
+        s += "\r\n(" + String ((int) __count__ - BOOTCHART_MAX_SPANS) + " spans not recorded, increase BOOTCHART_MAX_SPANS)";
+    return s;
+}
+
+String bootChart_t::toJson () {
+    int count = __count__;
+    if (count > BOOTCHART_MAX_SPANS)
+        count = BOOTCHART_MAX_SPANS;
+
+    String s = "{\"done\":" + String ((unsigned long) __done__) + ",\"spans\":[";
+    bool first = true;
+    for (int i = 0; i < count; i++) {
+        const __span__& sp = __spans__ [i];
+        if (!sp.name)
+            continue;
+        char buf [128];
+        snprintf (buf, sizeof (buf), "%s{\"name\":\"%s\",\"start\":%lu,\"end\":%lu,\"core\":%i}",
+                                     first ? "" : ",", sp.name, (unsigned long) sp.start, (unsigned long) sp.end, sp.core);
+        s += buf;
+        first = false;
+    }
+    s += "]}\r\n";
+    return s;
+}
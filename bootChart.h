@@ -0,0 +1,102 @@
+/*
+
+    bootChart.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Records how long each phase of setup () takes, shown by bootchart Telnet command and GET /bootchart.
+
+    The spans are kept in a static array, with the name (a string literal), the start and end time in microseconds
+    since boot and the core it ran on. setup () marks the beginning of each phase, which also ends the previous one:
+
+        BOOTCHART_PHASE ("LittleFS");
+        LittleFS.begin (true);
+        BOOTCHART_PHASE ("userManagement");
+        ...
+        BOOTCHART_DONE ();
+
+    A span that overlaps the phases (for example a task started from setup ()) is measured with BOOTCHART_SPAN ("name")
+    until the end of the enclosing block and a single moment (WiFi got its IP address) with BOOTCHART_MARK ("name").
+    All of them can be used from any task.
+
+    The macros expand to nothing unless USE_BOOTCHART is defined in server_config.h.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __BOOT_CHART_H__
+    #define __BOOT_CHART_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+
+
+    // TUNING PARAMETERS
+    #define BOOTCHART_MAX_SPANS 32          // phases, spans and marks together, the later ones are not recorded
+    #define BOOTCHART_BAR_WIDTH 40          // characters of the chart shown by toText
+
+
+    class bootChart_t {
+
+        public:
+
+            // measures the span from its construction until the end of the enclosing block
+            class span_t {
+                public:
+                    span_t (bootChart_t& bootChart, const char *name) : __bootChart__ (bootChart), __slot__ (bootChart.begin (name)) {}
+                    ~span_t () { __bootChart__.end (__slot__); }
+                private:
+                    bootChart_t& __bootChart__;
+                    int __slot__;
+            };
+
+            // returns the slot to be passed to end, or -1 if the array is full
+            int begin (const char *name);
+            void end (int slot);
+
+            // a span of zero length
+            void mark (const char *name);
+
+            // ends the current phase (if any) and begins the next one, used from setup () only
+            void phase (const char *name);
+
+            // ends the last phase
+            void done ();
+
+            String toText ();
+            String toJson ();
+
+        private:
+
+            struct __span__ {
+                const char *name;
+                int64_t start;      // us since boot
+                int64_t end;        // us since boot, 0 while the span is running
+                int8_t core;
+            };
+
+            __span__ __spans__ [BOOTCHART_MAX_SPANS] = {};
+            std::atomic<int> __count__ = {0};
+            int __phase__ = -1;
+            int64_t __done__ = 0;
+    };
+
+
+    #ifdef USE_BOOTCHART
+        #define __BOOTCHART_CONCAT__(a, b) a ## b
+        #define __BOOTCHART_SPAN_NAME__(line) __BOOTCHART_CONCAT__ (__bootChartSpan, line)
+        #define BOOTCHART_PHASE(name) bootChart.phase (name)
+        #define BOOTCHART_SPAN(name) bootChart_t::span_t __BOOTCHART_SPAN_NAME__ (__LINE__) (bootChart, name)
+        #define BOOTCHART_MARK(name) bootChart.mark (name)
+        #define BOOTCHART_DONE() bootChart.done ()
+    #else
+        #define BOOTCHART_PHASE(name)
+        #define BOOTCHART_SPAN(name)
+        #define BOOTCHART_MARK(name)
+        #define BOOTCHART_DONE()
+    #endif
+
+#endif
@@ -0,0 +1,175 @@
+/*
+
+    configSnapshot.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Binary snapshots of parsed configuration files in NVS, so they don't have to be parsed again at each boot.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "configSnapshot.h"
+#include <sys/stat.h>
+#include <esp_timer.h>
+#if __has_include (<Preferences.h>)
+    #include <Preferences.h>
+#else
+    // host builds keep the snapshots in RAM
+    #include <map>
+    #include <string>
+    #include <vector>
+    class Preferences {
+        public:
+            bool begin (const char *, bool = false) { return true; }
+            void end () {}
+            size_t getBytesLength (const char *key) { return __store__ ().count (key) ? __store__ () [key].size () : 0; }
+            size_t getBytes (const char *key, void *buf, size_t len) { auto& v = __store__ () [key]; if (len > v.size ()) len = v.size (); memcpy (buf, v.data (), len); return len; }
+            size_t putBytes (const char *key, const void *buf, size_t len) { __store__ () [key].assign ((const uint8_t *) buf, (const uint8_t *) buf + len); return len; }
+            bool clear () { __store__ ().clear (); return true; }
+        private:
+            static std::map<std::string, std::vector<uint8_t>>& __store__ () { static std::map<std::string, std::vector<uint8_t>> s; return s; }
+    };
+#endif
+
+
+configSnapshot_t::configSnapshot_t (const char *mountPoint) : __mountPoint__ (mountPoint) {}
+
+bool configSnapshot_t::load (const char *name, void *data, size_t size, const char *const sources [], int count) {
+    int64_t start = esp_timer_get_time ();
+
+    __header__ current;
+    bool hit = false;
+    if (isEnabled () && __fingerprints__ (current, size, sources, count)) {
+        Preferences preferences;
+        if (preferences.begin (CONFIG_SNAPSHOT_NAMESPACE, true)) {
+            size_t headerSize = sizeof (current) - (CONFIG_SNAPSHOT_MAX_SOURCES - count) * sizeof (__fingerprint__);
+            if (preferences.getBytesLength (name) == headerSize + size) {
+                uint8_t *blob = (uint8_t *) malloc (headerSize + size);
+                if (blob) {
+                    if (preferences.getBytes (name, blob, headerSize + size) == headerSize + size && !memcmp (blob, &current, headerSize)) {
+                        memcpy (data, blob + headerSize, size);
+                        hit = true;
+                    }
+                    free (blob);
+                }
+            }
+            preferences.end ();
+        }
+    }
+
+    __statistics__ *st = __statisticsOf__ (name);
+    if (st) {
+        st->hit = hit;
+        st->start = start;
+        st->microseconds = esp_timer_get_time () - start;
+    }
+    return hit;
+}
+
+bool configSnapshot_t::save (const char *name, const void *data, size_t size, const char *const sources [], int count) {
+    __header__ current;
+    if (!__fingerprints__ (current, size, sources, count))
+        return false;
+    size_t headerSize = sizeof (current) - (CONFIG_SNAPSHOT_MAX_SOURCES - count) * sizeof (__fingerprint__);
+    uint8_t *blob = (uint8_t *) malloc (headerSize + size);
+    if (!blob)
+        return false;
+    memcpy (blob, &current, headerSize);
+    memcpy (blob + headerSize, data, size);
+
+    bool saved = false;
+    Preferences preferences;
+    if (preferences.begin (CONFIG_SNAPSHOT_NAMESPACE, false)) {
+        saved = preferences.putBytes (name, blob, headerSize + size) == headerSize + size;
+        preferences.end ();
+    }
+    free (blob);
+
+    __statistics__ *st = __statisticsOf__ (name);
+    if (st && st->start)
+        st->microseconds = esp_timer_get_time () - st->start; // parsing included
+    return saved;
+}
+
+void configSnapshot_t::clear () {
+    bool enabled = isEnabled ();
+    Preferences preferences;
+    if (preferences.begin (CONFIG_SNAPSHOT_NAMESPACE, false)) {
+        preferences.clear ();
+        preferences.end ();
+    }
+    if (!enabled)
+        setEnabled (false); // keep the setting
+}
+
+bool configSnapshot_t::isEnabled () {
+    if (__enabled__ < 0) {
+        uint8_t disabled = 0;
+        Preferences preferences;
+        if (preferences.begin (CONFIG_SNAPSHOT_NAMESPACE, true)) {
+            if (preferences.getBytesLength ("disabled") == 1)
+                preferences.getBytes ("disabled", &disabled, 1);
+            preferences.end ();
+        }
+        __enabled__ = !disabled;
+    }
+    return __enabled__;
+}
+
+void configSnapshot_t::setEnabled (bool enabled) {
+    uint8_t disabled = !enabled;
+    Preferences preferences;
+    if (preferences.begin (CONFIG_SNAPSHOT_NAMESPACE, false)) {
+        preferences.putBytes ("disabled", &disabled, 1);
+        preferences.end ();
+    }
+    __enabled__ = enabled;
+}
+
+// size and modification time of each source, false if any of them doesn't exist
+bool configSnapshot_t::__fingerprints__ (__header__& header, size_t dataSize, const char *const sources [], int count) {
+    if (count > CONFIG_SNAPSHOT_MAX_SOURCES)
+        return false;
+    memset (&header, 0, sizeof (header)); // padding too, the header is compared with memcmp
+    header.version = CONFIG_SNAPSHOT_VERSION;
+    header.count = count;
+    header.dataSize = dataSize;
+    for (int i = 0; i < count; i++) {
+        char path [128];
+        snprintf (path, sizeof (path), "%s%s", __mountPoint__, sources [i]);
+        struct stat st;
+        if (stat (path, &st) != 0)
+            return false;
+        header.sources [i].modified = st.st_mtime;
+        header.sources [i].size = st.st_size;
+    }
+    return true;
+}
+
+configSnapshot_t::__statistics__ *configSnapshot_t::__statisticsOf__ (const char *name) {
+    __statistics__ *unused = NULL;
+    for (__statistics__& st : __last__) {
+        if (!strcmp (st.name, name))
+            return &st;
+        if (!unused && !*st.name)
+            unused = &st;
+    }
+    if (unused)
+        strncpy (unused->name, name, sizeof (unused->name) - 1);
+    return unused;
+}
+
+String configSnapshot_t::toText () {
+    String s = isEnabled () ? "configuration snapshots are on" : "configuration snapshots are off";
+    for (const __statistics__& l : __last__) {
+        if (!*l.name)
+            continue;
+        char line [96];
+        snprintf (line, sizeof (line), "\r\n%-15s %s in %lu us", l.name, l.hit ? "loaded from snapshot" : "parsed from text files", (unsigned long) l.microseconds);
+        s += line;
+    }
+    return s;
+}
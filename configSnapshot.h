@@ -0,0 +1,94 @@
+/*
+
+    configSnapshot.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Binary snapshots of parsed configuration files in NVS, so they don't have to be parsed again at each boot.
+
+    Each snapshot holds a struct (the parsed settings) together with the size and modification time of each
+    text file it was parsed from. load () only stats the files, and if they are all the same as when the
+    snapshot was saved it fills the struct from NVS, otherwise the caller parses the files and calls save ():
+
+        static const char *sources [] = { "/etc/wpa_supplicant.conf", "/network/interfaces" };
+        if (!configSnapshot.load ("wifi", &settings, sizeof (settings), sources, 2)) {
+            ... parse the files into settings ...
+            configSnapshot.save ("wifi", &settings, sizeof (settings), sources, 2);
+        }
+
+    A change of the struct's size invalidates the snapshot, so does CONFIG_SNAPSHOT_VERSION, which should be
+    increased when the meaning of the fields changes. The files are stat-ed through the VFS mount point of the
+    file system, so LittleFS must keep modification times (CONFIG_LITTLEFS_USE_MTIME, default in Arduino-ESP32).
+    An edit that keeps the same size within the same second is not noticed, configsnapshot clear Telnet command
+    removes all snapshots in this case.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __CONFIG_SNAPSHOT_H__
+    #define __CONFIG_SNAPSHOT_H__
+
+    #include <Arduino.h>
+
+
+    // TUNING PARAMETERS
+    #define CONFIG_SNAPSHOT_VERSION 1               // increase when the layout of any snapshot changes
+    #define CONFIG_SNAPSHOT_MAX_SOURCES 8           // text files per snapshot
+    #define CONFIG_SNAPSHOT_NAMESPACE "cfgsnap"     // NVS namespace
+
+
+    class configSnapshot_t {
+
+        public:
+
+            // mountPoint is the VFS path of the file system, the one passed to LittleFS.begin
+            configSnapshot_t (const char *mountPoint = "/littlefs");
+
+            // fills data from the snapshot name (max 15 characters) if all the sources have the same size and modification time as when it was saved
+            bool load (const char *name, void *data, size_t size, const char *const sources [], int count);
+
+            bool save (const char *name, const void *data, size_t size, const char *const sources [], int count);
+
+            // removes all the snapshots, the files are parsed again at the next boot
+            void clear ();
+
+            // the setting is kept in NVS, when disabled the files are parsed at each boot
+            bool isEnabled ();
+            void setEnabled (bool enabled);
+
+            String toText ();
+
+        private:
+
+            struct __fingerprint__ {
+                int64_t modified;
+                uint32_t size;
+            };
+
+            struct __header__ {
+                uint16_t version;
+                uint16_t count;
+                uint32_t dataSize;
+                __fingerprint__ sources [CONFIG_SNAPSHOT_MAX_SOURCES];
+            };
+
+            const char *__mountPoint__;
+            int8_t __enabled__ = -1;   // not read from NVS yet
+
+            // the last load of each name, shown by toText
+            struct __statistics__ {
+                char name [16];
+                bool hit;
+                int64_t start;          // of load
+                uint32_t microseconds;  // load, or load + parsing + save if the snapshot is not valid
+            };
+            __statistics__ __last__ [4] = {};
+
+            bool __fingerprints__ (__header__& header, size_t dataSize, const char *const sources [], int count);
+            __statistics__ *__statisticsOf__ (const char *name);
+    };
+
+#endif
@@ -0,0 +1,332 @@
+/*
+
+    cronScheduler.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Deadline-driven cron: calls the handler with the command of each crontab entry when its time comes and tells the caller
+    how long it may sleep until the next one.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "cronScheduler.h"
+#include <sys/time.h>
+
+
+cronScheduler_t::cronScheduler_t (void (*handler) (const char *command)) : __handler__ (handler) {
+    __semaphore__ = xSemaphoreCreateMutex ();
+    __lastMinute__ = __lastHour__ = __lastDay__ = millis ();
+}
+
+cronScheduler_t::~cronScheduler_t () {
+    vSemaphoreDelete (__semaphore__);
+}
+
+bool cronScheduler_t::insert (const char *line) {
+    char field [6][32];
+    int commandStart = 0;
+    if (sscanf (line, "%31s %31s %31s %31s %31s %31s %n", field [0], field [1], field [2], field [3], field [4], field [5], &commandStart) < 6 || !commandStart || !line [commandStart])
+        return false;
+
+    __entry__ e = {};
+    uint64_t hours, days, months, daysOfWeek;
+    if (!__parseField__ (field [0], 0, 59, e.seconds) || !__parseField__ (field [1], 0, 59, e.minutes) ||
+        !__parseField__ (field [2], 0, 23, hours) || !__parseField__ (field [3], 1, 31, days) ||
+        !__parseField__ (field [4], 1, 12, months) || !__parseField__ (field [5], 0, 7, daysOfWeek))
+        return false;
+    e.hours = hours;
+    e.days = days;
+    e.months = months >> 1; // January = bit 0, like tm_mon
+    e.daysOfWeek = (daysOfWeek | daysOfWeek >> 7) & 0x7F; // 7 = Sunday = 0
+    e.dayRestricted = strcmp (field [3], "*");
+    e.dayOfWeekRestricted = strcmp (field [5], "*");
+    e.whenTimeIsSet = true;
+    for (int i = 0; i < 6; i++)
+        if (strcmp (field [i], "*"))
+            e.whenTimeIsSet = false;
+    strncpy (e.command, line + commandStart, sizeof (e.command) - 1);
+    for (int i = strlen (e.command) - 1; i >= 0 && e.command [i] <= ' '; i--)
+        e.command [i] = 0; // right-trim
+
+    bool inserted = false;
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        if (__entryCount__ < CRON_MAX_ENTRIES) {
+            __entry__& n = __entries__ [__entryCount__ ++] = e;
+            time_t now = time (NULL);
+            if (!n.whenTimeIsSet && __timeWasSet__)
+                __schedule__ (n, now);
+            inserted = true;
+        }
+    xSemaphoreGive (__semaphore__);
+    return inserted;
+}
+
+void cronScheduler_t::remove (const char *command) {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        int j = 0;
+        for (int i = 0; i < __entryCount__; i++)
+            if (strcmp (__entries__ [i].command, command))
+                __entries__ [j ++] = __entries__ [i];
+        __entryCount__ = j;
+        __rebuild__ (__timeWasSet__ ? time (NULL) : 0); // the heap points to the entries that have moved
+    xSemaphoreGive (__semaphore__);
+}
+
+bool cronScheduler_t::readCrontab (threadSafeFS::FS& fileSystem, const char *path) {
+    if (!fileSystem.isFile (path)) {
+        if (!fileSystem.isDirectory ("/etc"))
+            fileSystem.mkdir ("/etc");
+        threadSafeFS::File f = fileSystem.open (path, "w");
+        if (f) {
+            f.print ("# scheduled tasks (in local time) - reboot for changes to take effect\r\n"
+                     "#\r\n"
+                     "# .------------------- second (0 - 59 or *)\r\n"
+                     "# |  .---------------- minute (0 - 59 or *)\r\n"
+                     "# |  |  .------------- hour (0 - 23 or *)\r\n"
+                     "# |  |  |  .---------- day of month (1 - 31 or *)\r\n"
+                     "# |  |  |  |  .------- month (1 - 12 or *)\r\n"
+                     "# |  |  |  |  |  .---- day of week (0 - 7 or *; Sunday=0 and also 7)\r\n"
+                     "# |  |  |  |  |  |\r\n"
+                     "# *  *  *  *  *  * cronCommand to be sent to cronHandlerCallback\r\n");
+            f.close ();
+        }
+    }
+
+    char *buffer = (char *) malloc (CRON_MAX_ENTRIES * 80);
+    if (!buffer)
+        return false;
+    bool read = fileSystem.readConfiguration (buffer, CRON_MAX_ENTRIES * 80 - 1, path);
+    if (read) {
+        char *last = NULL;
+        for (char *line = strtok_r (buffer, "\r\n", &last); line; line = strtok_r (NULL, "\r\n", &last))
+            if (*line && *line != '#' && !insert (line))
+                Serial.printf ("[cron] invalid entry in %s: %s\n", path, line);
+    }
+    free (buffer);
+    return read;
+}
+
+unsigned long cronScheduler_t::run () {
+    // the intervals since boot
+    unsigned long ms = millis ();
+    if (ms - __lastMinute__ >= 60000) { __lastMinute__ += 60000; __handler__ ("ONCE A MINUTE"); }
+    if (ms - __lastHour__ >= 3600000) { __lastHour__ += 3600000; __handler__ ("ONCE AN HOUR"); }
+    if (ms - __lastDay__ >= 86400000) { __lastDay__ += 86400000; __handler__ ("ONCE A DAY"); }
+
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    time_t now = tv.tv_sec;
+    ms = millis ();
+    unsigned long sleep = CRON_MAX_SLEEP;
+    if (60000 - (ms - __lastMinute__) < sleep)
+        sleep = 60000 - (ms - __lastMinute__);
+
+    if (now < CRON_TIME_SET_THRESHOLD)
+        return sleep < 1000 ? sleep : 1000; // check again in a second whether the time is set
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        if (!__timeWasSet__) {
+            // the time has just been set
+            __timeWasSet__ = true;
+            __rebuild__ (now);
+            __recalculations__ ++;
+            for (int i = 0; i < __entryCount__; i++) {
+                if (__entries__ [i].whenTimeIsSet) {
+                    char command [CRON_COMMAND_LENGTH];
+                    strcpy (command, __entries__ [i].command);
+                    xSemaphoreGive (__semaphore__);
+                        __handler__ (command);
+                        __fired__ ++;
+                    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+                }
+            }
+        } else {
+            // has the clock been set since the last run?
+            long expected = __expectedTime__ + (long) ((ms - __expectedAt__) / 1000);
+            if (now - expected > CRON_CLOCK_JUMP || expected - now > CRON_CLOCK_JUMP) {
+                __rebuild__ (now);
+                __recalculations__ ++;
+            }
+        }
+
+        // fire the entries that are due, each one once even if more than one of its times has passed
+        while (__heapCount__ && __heap__ [0]->next <= now) {
+            __entry__ *e = __pop__ ();
+            char command [CRON_COMMAND_LENGTH];
+            strcpy (command, e->command);
+            __schedule__ (*e, now);
+            xSemaphoreGive (__semaphore__);
+                __handler__ (command);
+                __fired__ ++;
+            xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        }
+
+        // how long until the next one
+        gettimeofday (&tv, NULL);
+        ms = millis ();
+        __expectedTime__ = tv.tv_sec;
+        __expectedAt__ = ms - tv.tv_usec / 1000; // millis when the current second began
+        if (__heapCount__) {
+            long long untilNext = ((long long) __heap__ [0]->next - tv.tv_sec) * 1000 - tv.tv_usec / 1000;
+            if (untilNext < 0)
+                untilNext = 0;
+            if (untilNext < (long long) sleep)
+                sleep = untilNext;
+        }
+    xSemaphoreGive (__semaphore__);
+    return sleep;
+}
+
+// "*", "5", "1-5", "0-59/15", "*/10", "5/15" (= 5-max/15), "1,15,30", ... into a bitmask
+bool cronScheduler_t::__parseField__ (const char *field, int min, int max, uint64_t& bits) {
+    bits = 0;
+    const char *p = field;
+    while (*p) {
+        int from, to, step = 1, n = 0;
+        if (*p == '*') {
+            from = min;
+            to = max;
+            p ++;
+        } else {
+            if (sscanf (p, "%d%n", &from, &n) != 1)
+                return false;
+            p += n;
+            to = *p == '/' ? max : from; // a/n steps from a to the end of the range
+            if (*p == '-') {
+                if (sscanf (p + 1, "%d%n", &to, &n) != 1)
+                    return false;
+                p += 1 + n;
+            }
+        }
+        if (*p == '/') {
+            if (sscanf (p + 1, "%d%n", &step, &n) != 1 || step < 1)
+                return false;
+            p += 1 + n;
+        }
+        if (from < min || to > max || from > to)
+            return false;
+        for (int i = from; i <= to; i += step)
+            bits |= (uint64_t) 1 << i;
+        if (*p == ',')
+            p ++;
+        else if (*p)
+            return false;
+    }
+    return bits != 0;
+}
+
+bool cronScheduler_t::__dayMatches__ (const __entry__& e, const struct tm& st) {
+    bool day = e.days >> st.tm_mday & 1;
+    bool dayOfWeek = e.daysOfWeek >> st.tm_wday & 1;
+    if (e.dayRestricted && e.dayOfWeekRestricted)
+        return day || dayOfWeek;
+    return day && dayOfWeek;
+}
+
+// the lowest set bit >= from, or -1
+static int __nextBit__ (uint64_t bits, int from) {
+    bits >>= from;
+    if (!bits)
+        return -1;
+    return from + __builtin_ctzll (bits);
+}
+
+// the first time after after that matches the entry, field by field from the month down, 0 if there is none within the search limit
+time_t cronScheduler_t::__nextTime__ (const __entry__& e, time_t after) {
+    time_t t = after + 1;
+    struct tm st;
+    for (int i = 0; i < 1000; i++) {
+        localtime_r (&t, &st);
+        int n;
+        if (!(e.months >> st.tm_mon & 1)) {
+            st.tm_mon ++; st.tm_mday = 1; st.tm_hour = st.tm_min = st.tm_sec = 0;
+        } else if (!__dayMatches__ (e, st)) {
+            st.tm_mday ++; st.tm_hour = st.tm_min = st.tm_sec = 0;
+        } else if ((n = __nextBit__ (e.hours, st.tm_hour)) != st.tm_hour) {
+            if (n < 0) { st.tm_mday ++; st.tm_hour = 0; } else { st.tm_hour = n; }
+            st.tm_min = st.tm_sec = 0;
+        } else if ((n = __nextBit__ (e.minutes, st.tm_min)) != st.tm_min) {
+            if (n < 0) { st.tm_hour ++; st.tm_min = 0; } else { st.tm_min = n; }
+            st.tm_sec = 0;
+        } else if ((n = __nextBit__ (e.seconds, st.tm_sec)) != st.tm_sec) {
+            if (n < 0) { st.tm_min ++; st.tm_sec = 0; } else { st.tm_sec = n; }
+        } else {
+            return t;
+        }
+        st.tm_isdst = -1;
+        time_t next = mktime (&st);
+        t = next > t ? next : t + 1; // always forward, also around DST changes
+    }
+    return 0;
+}
+
+void cronScheduler_t::__schedule__ (__entry__& e, time_t after) {
+    e.next = __nextTime__ (e, after);
+    if (e.next)
+        __push__ (&e);
+}
+
+void cronScheduler_t::__rebuild__ (time_t now) {
+    __heapCount__ = 0;
+    for (int i = 0; i < __entryCount__; i++) {
+        __entries__ [i].next = 0;
+        if (now && !__entries__ [i].whenTimeIsSet)
+            __schedule__ (__entries__ [i], now);
+    }
+}
+
+void cronScheduler_t::__push__ (__entry__ *e) {
+    int i = __heapCount__ ++;
+    while (i && __heap__ [(i - 1) / 2]->next > e->next) {
+        __heap__ [i] = __heap__ [(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    __heap__ [i] = e;
+}
+
+cronScheduler_t::__entry__ *cronScheduler_t::__pop__ () {
+    __entry__ *top = __heap__ [0];
+    __entry__ *last = __heap__ [-- __heapCount__];
+    int i = 0;
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= __heapCount__)
+            break;
+        if (child + 1 < __heapCount__ && __heap__ [child + 1]->next < __heap__ [child]->next)
+            child ++;
+        if (last->next <= __heap__ [child]->next)
+            break;
+        __heap__ [i] = __heap__ [child];
+        i = child;
+    }
+    if (__heapCount__)
+        __heap__ [i] = last;
+    return top;
+}
+
+String cronScheduler_t::toText () {
+    String s = "next run                  command";
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < __entryCount__; i++) {
+            const __entry__& e = __entries__ [i];
+            char next [32];
+            if (e.whenTimeIsSet) {
+                snprintf (next, sizeof (next), "when the time is set");
+            } else if (e.next) {
+                struct tm st;
+                localtime_r (&e.next, &st);
+                strftime (next, sizeof (next), "%Y/%m/%d %H:%M:%S", &st);
+            } else {
+                snprintf (next, sizeof (next), __timeWasSet__ ? "never" : "time is not set yet");
+            }
+            char line [96];
+            snprintf (line, sizeof (line), "\r\n%-25s %s", next, e.command);
+            s += line;
+        }
+    xSemaphoreGive (__semaphore__);
+    s += "\r\n" + String (__entryCount__) + " entries, " + String (__fired__) + " fired, recalculated " + String (__recalculations__) + " times";
+    return s;
+}
@@ -0,0 +1,122 @@
+/*
+
+    cronScheduler.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Deadline-driven cron: calls the handler with the command of each crontab entry when its time comes and tells the caller
+    how long it may sleep until the next one.
+
+    Each entry is compiled into bitmasks of seconds, minutes, hours, days, months and days of week when it is inserted,
+    and its next fire time is calculated field by field (not second by second). The entries are kept in a min-heap by
+    their next fire time, so run () only looks at the top of the heap and firing an entry costs O (log n), no matter how
+    many entries there are or how often run () is called. run () returns the ms until the earliest entry is due, which
+    is how long loop () can sleep (see eventLoop.h).
+
+    The crontab format is the same as cronDaemon's, with seconds in the first field (local time):
+
+        # second minute hour day month day_of_week command
+          0      0      *    *   *     *           onHour
+          0-59/15 *     8-16 *   *     1-5         every 15 seconds during working hours
+
+    with *, numbers, ranges (a-b), lists (a,b,c) and steps (a-b/n, a/n from a to the end of the range, or * followed
+    by /n). Day of week is 0 - 7, Sunday is 0 and 7. If both day and day of week are restricted the entry fires when
+    either of them matches. The entries are only scheduled after the time is set, except for two special cases:
+
+        - an entry with all six fields * fires once, when the time is set for the first time,
+        - "ONCE A MINUTE", "ONCE AN HOUR" and "ONCE A DAY" are passed to the handler at these intervals since boot,
+          whether the time is set or not.
+
+    If the clock is set (NTP) to a time that differs from what it was expected to be, the next fire times are calculated again.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __CRON_SCHEDULER_H__
+    #define __CRON_SCHEDULER_H__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <time.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+
+
+    // TUNING PARAMETERS
+    #define CRON_MAX_ENTRIES 32                 // crontab entries
+    #define CRON_COMMAND_LENGTH 48              // bytes, including the terminating 0
+    #define CRON_MAX_SLEEP 60000                // ms, run () is called at least this often (for ONCE A MINUTE and to notice clock changes)
+    #define CRON_TIME_SET_THRESHOLD 1600000000  // ~2020, time () below this means the time is not set yet
+    #define CRON_CLOCK_JUMP 2                   // s, a larger difference from the expected time recalculates all the entries
+
+
+    class cronScheduler_t {
+
+        public:
+
+            cronScheduler_t (void (*handler) (const char *command));
+            ~cronScheduler_t ();
+
+            // "second minute hour day month day_of_week command", returns false if the line is not valid or there is no space left
+            bool insert (const char *line);
+
+            // removes all the entries with this command
+            void remove (const char *command);
+
+            // inserts the entries from the crontab file (and creates the default one if it doesn't exist)
+            bool readCrontab (threadSafeFS::FS& fileSystem, const char *path = "/etc/crontab");
+
+            // calls the handler for the entries that are due and returns ms until the next one is due
+            unsigned long run ();
+
+            inline uint32_t fired () __attribute__((always_inline)) { return __fired__; }
+            inline uint32_t recalculations () __attribute__((always_inline)) { return __recalculations__; } // when the time is set or the clock jumps
+
+            // entries with their next fire times
+            String toText ();
+
+        private:
+
+            struct __entry__ {
+                uint64_t seconds;           // bit 0 - 59
+                uint64_t minutes;           // bit 0 - 59
+                uint32_t hours;             // bit 0 - 23
+                uint32_t days;              // bit 1 - 31
+                uint16_t months;            // bit 0 - 11
+                uint8_t daysOfWeek;         // bit 0 - 6, Sunday = 0
+                bool dayRestricted;
+                bool dayOfWeekRestricted;
+                bool whenTimeIsSet;         // all six fields are *
+                time_t next;                // 0 = not scheduled
+                char command [CRON_COMMAND_LENGTH];
+            };
+
+            void (*__handler__) (const char *command);
+            __entry__ __entries__ [CRON_MAX_ENTRIES];
+            int __entryCount__ = 0;
+            __entry__ *__heap__ [CRON_MAX_ENTRIES]; // min-heap of scheduled entries by next
+            int __heapCount__ = 0;
+            SemaphoreHandle_t __semaphore__ = NULL;
+
+            bool __timeWasSet__ = false;
+            time_t __expectedTime__ = 0;        // time at the last run () plus the ms passed since
+            unsigned long __expectedAt__ = 0;   // millis of the last run ()
+            unsigned long __lastMinute__, __lastHour__, __lastDay__; // millis
+
+            uint32_t __fired__ = 0;
+            uint32_t __recalculations__ = 0;
+
+            static bool __parseField__ (const char *field, int min, int max, uint64_t& bits);
+            static time_t __nextTime__ (const __entry__& e, time_t after);
+            static bool __dayMatches__ (const __entry__& e, const struct tm& st);
+
+            void __schedule__ (__entry__& e, time_t after);
+            void __rebuild__ (time_t now);
+            void __push__ (__entry__ *e);
+            __entry__ *__pop__ ();
+    };
+
+#endif
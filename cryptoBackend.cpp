@@ -0,0 +1,425 @@
+/*
+
+    cryptoBackend.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    SHA-256, AES-GCM and ECC with a selectable backend, and a benchmark of each, shown by the cryptobench Telnet command.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "cryptoBackend.h"
+
+#ifdef ESP_PLATFORM
+    #include <esp_random.h>
+    #include <mbedtls/sha256.h>
+    #include <mbedtls/gcm.h>
+    #include <mbedtls/ecdsa.h>
+#endif
+
+
+#ifdef ESP_PLATFORM
+    cryptoBackend_t::backend_t cryptoBackend_t::__backend__ = cryptoBackend_t::HARDWARE;
+#else
+    cryptoBackend_t::backend_t cryptoBackend_t::__backend__ = cryptoBackend_t::SOFTWARE;
+#endif
+
+
+void cryptoBackend_t::setBackend (backend_t backend) {
+    __backend__ = backend == HARDWARE && hardwareAvailable () ? HARDWARE : SOFTWARE;
+}
+
+cryptoBackend_t::backend_t cryptoBackend_t::getBackend () {
+    return __backend__;
+}
+
+bool cryptoBackend_t::hardwareAvailable () {
+    #ifdef ESP_PLATFORM
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+const char *cryptoBackend_t::hardwareUnits () {
+    return ""
+        #ifdef CONFIG_MBEDTLS_HARDWARE_AES
+            " AES"
+        #endif
+        #ifdef CONFIG_MBEDTLS_HARDWARE_GCM
+            " GCM"
+        #endif
+        #ifdef CONFIG_MBEDTLS_HARDWARE_SHA
+            " SHA"
+        #endif
+        #ifdef CONFIG_MBEDTLS_HARDWARE_MPI
+            " MPI"
+        #endif
+        #ifdef CONFIG_MBEDTLS_HARDWARE_ECC
+            " ECC"
+        #endif
+    ;
+}
+
+cryptoBackend_t::backend_t cryptoBackend_t::__resolve__ (backend_t backend) {
+    if (backend == DEFAULT)
+        backend = __backend__;
+    return backend == HARDWARE && hardwareAvailable () ? HARDWARE : SOFTWARE;
+}
+
+
+// ----- SHA-256 (FIPS 180-4) -----
+
+static const uint32_t __sha256K__ [64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t __ror__ (uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static void __sha256Block__ (uint32_t h [8], const uint8_t *p) {
+    uint32_t w [64];
+    for (int i = 0; i < 16; i++)
+        w [i] = (uint32_t) p [4 * i] << 24 | (uint32_t) p [4 * i + 1] << 16 | (uint32_t) p [4 * i + 2] << 8 | p [4 * i + 3];
+    for (int i = 16; i < 64; i++)
+        w [i] = w [i - 16] + (__ror__ (w [i - 15], 7) ^ __ror__ (w [i - 15], 18) ^ (w [i - 15] >> 3)) + w [i - 7] + (__ror__ (w [i - 2], 17) ^ __ror__ (w [i - 2], 19) ^ (w [i - 2] >> 10));
+
+    uint32_t a = h [0], b = h [1], c = h [2], d = h [3], e = h [4], f = h [5], g = h [6], k = h [7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = k + (__ror__ (e, 6) ^ __ror__ (e, 11) ^ __ror__ (e, 25)) + ((e & f) ^ (~e & g)) + __sha256K__ [i] + w [i];
+        uint32_t t2 = (__ror__ (a, 2) ^ __ror__ (a, 13) ^ __ror__ (a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        k = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+    }
+    h [0] += a; h [1] += b; h [2] += c; h [3] += d; h [4] += e; h [5] += f; h [6] += g; h [7] += k;
+}
+
+static void __softwareSha256__ (const uint8_t *data, size_t length, uint8_t hash [32]) {
+    uint32_t h [8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint64_t bits = (uint64_t) length * 8;
+    for (; length >= 64; data += 64, length -= 64)
+        __sha256Block__ (h, data);
+
+    // padding: 0x80, zeros, 64-bit length, in one or two blocks
+    uint8_t last [128] = {};
+    memcpy (last, data, length);
+    last [length] = 0x80;
+    size_t lastLength = length < 56 ? 64 : 128;
+    for (int i = 0; i < 8; i++)
+        last [lastLength - 1 - i] = (uint8_t) (bits >> (8 * i));
+    for (size_t i = 0; i < lastLength; i += 64)
+        __sha256Block__ (h, last + i);
+
+    for (int i = 0; i < 8; i++) {
+        hash [4 * i] = (uint8_t) (h [i] >> 24);
+        hash [4 * i + 1] = (uint8_t) (h [i] >> 16);
+        hash [4 * i + 2] = (uint8_t) (h [i] >> 8);
+        hash [4 * i + 3] = (uint8_t) h [i];
+    }
+}
+
+void cryptoBackend_t::sha256 (const void *data, size_t length, uint8_t hash [32], backend_t backend) {
+    #ifdef ESP_PLATFORM
+        if (__resolve__ (backend) == HARDWARE) {
+            mbedtls_sha256 ((const unsigned char *) data, length, hash, 0);
+            return;
+        }
+    #endif
+    __softwareSha256__ ((const uint8_t *) data, length, hash);
+}
+
+
+// ----- AES (FIPS 197), encryption only since GCM does not need the inverse cipher -----
+
+static const uint8_t __aesSbox__ [256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+struct __aesKey__ {
+    uint8_t roundKeys [240];
+    int rounds;
+};
+
+static bool __aesExpandKey__ (__aesKey__& k, const uint8_t *key, size_t keyLength) {
+    if (keyLength != 16 && keyLength != 24 && keyLength != 32)
+        return false;
+    int nk = keyLength / 4;
+    k.rounds = nk + 6;
+    memcpy (k.roundKeys, key, keyLength);
+    uint8_t rcon = 1;
+    for (int i = nk; i < 4 * (k.rounds + 1); i++) {
+        uint8_t t [4];
+        memcpy (t, k.roundKeys + 4 * (i - 1), 4);
+        if (i % nk == 0) {
+            uint8_t t0 = t [0];
+            t [0] = __aesSbox__ [t [1]] ^ rcon; t [1] = __aesSbox__ [t [2]]; t [2] = __aesSbox__ [t [3]]; t [3] = __aesSbox__ [t0];
+            rcon = (rcon << 1) ^ (rcon & 0x80 ? 0x1b : 0);
+        } else if (nk == 8 && i % nk == 4) {
+            for (int j = 0; j < 4; j++)
+                t [j] = __aesSbox__ [t [j]];
+        }
+        for (int j = 0; j < 4; j++)
+            k.roundKeys [4 * i + j] = k.roundKeys [4 * (i - nk) + j] ^ t [j];
+    }
+    return true;
+}
+
+static inline uint8_t __xtime__ (uint8_t x) { return (x << 1) ^ (x & 0x80 ? 0x1b : 0); }
+
+static void __aesEncryptBlock__ (const __aesKey__& k, const uint8_t in [16], uint8_t out [16]) {
+    uint8_t s [16];
+    for (int i = 0; i < 16; i++)
+        s [i] = in [i] ^ k.roundKeys [i];
+    for (int r = 1; r <= k.rounds; r++) {
+        // SubBytes and ShiftRows (the state is column major: s [4 * column + row])
+        uint8_t t [16];
+        for (int c = 0; c < 4; c++)
+            for (int row = 0; row < 4; row++)
+                t [4 * c + row] = __aesSbox__ [s [4 * ((c + row) & 3) + row]];
+        // MixColumns, except in the last round
+        if (r < k.rounds) {
+            for (int c = 0; c < 4; c++) {
+                uint8_t *a = t + 4 * c;
+                uint8_t all = a [0] ^ a [1] ^ a [2] ^ a [3], a0 = a [0];
+                a [0] ^= all ^ __xtime__ (a [0] ^ a [1]);
+                a [1] ^= all ^ __xtime__ (a [1] ^ a [2]);
+                a [2] ^= all ^ __xtime__ (a [2] ^ a [3]);
+                a [3] ^= all ^ __xtime__ (a [3] ^ a0);
+            }
+        }
+        for (int i = 0; i < 16; i++)
+            s [i] = t [i] ^ k.roundKeys [16 * r + i];
+    }
+    memcpy (out, s, 16);
+}
+
+
+// ----- GCM (NIST SP 800-38D), GHASH with 4-bit tables (Shoup's method) -----
+
+struct __ghashKey__ {
+    uint64_t hl [16];
+    uint64_t hh [16];
+};
+
+static inline uint64_t __get64__ (const uint8_t *p) { uint64_t v = 0; for (int i = 0; i < 8; i++) v = v << 8 | p [i]; return v; }
+static inline void __put64__ (uint8_t *p, uint64_t v) { for (int i = 7; i >= 0; i--) { p [i] = (uint8_t) v; v >>= 8; } }
+
+static void __ghashInit__ (__ghashKey__& g, const uint8_t h [16]) {
+    uint64_t vh = __get64__ (h), vl = __get64__ (h + 8);
+    g.hl [0] = g.hh [0] = 0;
+    g.hl [8] = vl;
+    g.hh [8] = vh;
+    for (int i = 4; i > 0; i >>= 1) {
+        uint32_t t = (vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t) t << 32);
+        g.hl [i] = vl;
+        g.hh [i] = vh;
+    }
+    for (int i = 2; i <= 8; i *= 2)
+        for (int j = 1; j < i; j++) {
+            g.hh [i + j] = g.hh [i] ^ g.hh [j];
+            g.hl [i + j] = g.hl [i] ^ g.hl [j];
+        }
+}
+
+// x = x * H
+static void __ghashMultiply__ (const __ghashKey__& g, uint8_t x [16]) {
+    static const uint64_t last4 [16] = { 0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0, 0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0 };
+    uint8_t lo = x [15] & 0xf;
+    uint64_t zh = g.hh [lo], zl = g.hl [lo];
+    for (int i = 15; i >= 0; i--) {
+        lo = x [i] & 0xf;
+        uint8_t hi = x [i] >> 4, rem;
+        if (i != 15) {
+            rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (last4 [rem] << 48) ^ g.hh [lo];
+            zl ^= g.hl [lo];
+        }
+        rem = zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (last4 [rem] << 48) ^ g.hh [hi];
+        zl ^= g.hl [hi];
+    }
+    __put64__ (x, zh);
+    __put64__ (x + 8, zl);
+}
+
+static void __ghashUpdate__ (const __ghashKey__& g, uint8_t x [16], const uint8_t *data, size_t length) {
+    for (; length; ) {
+        size_t n = length < 16 ? length : 16;
+        for (size_t i = 0; i < n; i++)
+            x [i] ^= data [i];
+        __ghashMultiply__ (g, x);
+        data += n;
+        length -= n;
+    }
+}
+
+bool cryptoBackend_t::__softwareAesGcm__ (bool encrypt, const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                          const uint8_t *input, size_t length, uint8_t *output, uint8_t tag [16]) {
+    __aesKey__ k;
+    if (!__aesExpandKey__ (k, key, keyLength))
+        return false;
+    __ghashKey__ g;
+    uint8_t h [16] = {};
+    __aesEncryptBlock__ (k, h, h);
+    __ghashInit__ (g, h);
+
+    // J0 = IV || 0^31 || 1, the counter of the first data block is J0 + 1
+    uint8_t j0 [16], counter [16], keyStream [16], x [16] = {};
+    memcpy (j0, iv, 12);
+    j0 [12] = j0 [13] = j0 [14] = 0; j0 [15] = 1;
+    memcpy (counter, j0, 16);
+
+    __ghashUpdate__ (g, x, aad, aadLength);
+    for (size_t done = 0; done < length; ) {
+        for (int i = 15; i >= 12 && !++counter [i]; i--);
+        __aesEncryptBlock__ (k, counter, keyStream);
+        size_t n = length - done < 16 ? length - done : 16;
+        if (!encrypt)
+            __ghashUpdate__ (g, x, input + done, n);
+        for (size_t i = 0; i < n; i++)
+            output [done + i] = input [done + i] ^ keyStream [i];
+        if (encrypt)
+            __ghashUpdate__ (g, x, output + done, n);
+        done += n;
+    }
+
+    uint8_t lengths [16];
+    __put64__ (lengths, (uint64_t) aadLength * 8);
+    __put64__ (lengths + 8, (uint64_t) length * 8);
+    __ghashUpdate__ (g, x, lengths, 16);
+
+    __aesEncryptBlock__ (k, j0, keyStream);
+    for (int i = 0; i < 16; i++)
+        tag [i] = x [i] ^ keyStream [i];
+    return true;
+}
+
+bool cryptoBackend_t::aesGcmEncrypt (const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                     const uint8_t *input, size_t length, uint8_t *output, uint8_t tag [16], backend_t backend) {
+    #ifdef ESP_PLATFORM
+        if (__resolve__ (backend) == HARDWARE) {
+            mbedtls_gcm_context ctx;
+            mbedtls_gcm_init (&ctx);
+            bool success = !mbedtls_gcm_setkey (&ctx, MBEDTLS_CIPHER_ID_AES, key, keyLength * 8) &&
+                           !mbedtls_gcm_crypt_and_tag (&ctx, MBEDTLS_GCM_ENCRYPT, length, iv, 12, aad, aadLength, input, output, 16, tag);
+            mbedtls_gcm_free (&ctx);
+            return success;
+        }
+    #endif
+    return __softwareAesGcm__ (true, key, keyLength, iv, aad, aadLength, input, length, output, tag);
+}
+
+bool cryptoBackend_t::aesGcmDecrypt (const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                     const uint8_t *input, size_t length, uint8_t *output, const uint8_t tag [16], backend_t backend) {
+    #ifdef ESP_PLATFORM
+        if (__resolve__ (backend) == HARDWARE) {
+            mbedtls_gcm_context ctx;
+            mbedtls_gcm_init (&ctx);
+            bool success = !mbedtls_gcm_setkey (&ctx, MBEDTLS_CIPHER_ID_AES, key, keyLength * 8) &&
+                           !mbedtls_gcm_auth_decrypt (&ctx, length, iv, 12, aad, aadLength, tag, 16, input, output);
+            mbedtls_gcm_free (&ctx);
+            return success;
+        }
+    #endif
+    uint8_t calculatedTag [16];
+    if (!__softwareAesGcm__ (false, key, keyLength, iv, aad, aadLength, input, length, output, calculatedTag))
+        return false;
+    uint8_t difference = 0;
+    for (int i = 0; i < 16; i++)
+        difference |= calculatedTag [i] ^ tag [i]; // constant time comparison
+    return !difference;
+}
+
+
+// ----- benchmark -----
+
+#ifdef ESP_PLATFORM
+    static int __rng__ (void *, unsigned char *buf, size_t len) {
+        esp_fill_random (buf, len);
+        return 0;
+    }
+#endif
+
+// calls f until CRYPTO_BENCH_DURATION ms have passed, returns the number of calls per second
+template<typename F> static float __measure__ (F f) {
+    unsigned long count = 0;
+    unsigned long start = micros (), elapsed;
+    do {
+        f ();
+        count ++;
+        elapsed = micros () - start;
+    } while (elapsed < CRYPTO_BENCH_DURATION * 1000UL);
+    delay (1); // let the idle task run between the measurements
+    return count * 1000000.0f / elapsed;
+}
+
+String cryptoBackend_t::bench () {
+    uint8_t *buf = (uint8_t *) malloc (CRYPTO_BENCH_BLOCK);
+    if (!buf)
+        return "Out of memory";
+    memset (buf, 0x5a, CRYPTO_BENCH_BLOCK);
+    uint8_t key [32] = {}, iv [12] = {}, out [32];
+
+    const float mb = CRYPTO_BENCH_BLOCK / 1048576.0f;
+    float sha [2], gcm128 [2], gcm256 [2];
+    for (int b = 0; b < 2; b++) {
+        backend_t backend = b ? SOFTWARE : HARDWARE;
+        if (backend == HARDWARE && !hardwareAvailable ()) {
+            sha [b] = gcm128 [b] = gcm256 [b] = -1;
+            continue;
+        }
+        sha [b] = mb * __measure__ ([&] { sha256 (buf, CRYPTO_BENCH_BLOCK, out, backend); });
+        gcm128 [b] = mb * __measure__ ([&] { aesGcmEncrypt (key, 16, iv, NULL, 0, buf, CRYPTO_BENCH_BLOCK, buf, out, backend); });
+        gcm256 [b] = mb * __measure__ ([&] { aesGcmEncrypt (key, 32, iv, NULL, 0, buf, CRYPTO_BENCH_BLOCK, buf, out, backend); });
+    }
+
+    float sign = -1, verify = -1;
+    #ifdef ESP_PLATFORM
+        mbedtls_ecdsa_context ecdsa;
+        mbedtls_ecdsa_init (&ecdsa);
+        uint8_t signature [MBEDTLS_ECDSA_MAX_LEN];
+        size_t signatureLength = 0;
+        if (!mbedtls_ecdsa_genkey (&ecdsa, MBEDTLS_ECP_DP_SECP256R1, __rng__, NULL) &&
+            !mbedtls_ecdsa_write_signature (&ecdsa, MBEDTLS_MD_SHA256, out, 32, signature, sizeof (signature), &signatureLength, __rng__, NULL)) {
+                sign = __measure__ ([&] { mbedtls_ecdsa_write_signature (&ecdsa, MBEDTLS_MD_SHA256, out, 32, signature, sizeof (signature), &signatureLength, __rng__, NULL); });
+                verify = __measure__ ([&] { mbedtls_ecdsa_read_signature (&ecdsa, out, 32, signature, signatureLength); });
+        }
+        mbedtls_ecdsa_free (&ecdsa);
+    #endif
+    free (buf);
+
+    auto cell = [] (float value, const char *unit) -> String {
+        char c [20];
+        if (value < 0)
+            snprintf (c, sizeof (c), "%15s", "n/a");
+        else
+            snprintf (c, sizeof (c), "%9.2f %-5s", value, unit);
+        return String (c);
+    };
+    char label [32], header [150];
+    snprintf (label, sizeof (label), "primitive (%i B blocks)", CRYPTO_BENCH_BLOCK);
+    snprintf (header, sizeof (header), "hardware units used by mbedTLS:%s\r\nbackend in use: %s\r\n%-28s %15s %15s", *hardwareUnits () ? hardwareUnits () : " none",
+                                       __backend__ == HARDWARE ? "hardware" : "software", label, "hardware", "software");
+    String s = String (header) +
+               "\r\nSHA-256                      " + cell (sha [0], "MB/s") + " " + cell (sha [1], "MB/s") +
+               "\r\nAES-128-GCM encrypt          " + cell (gcm128 [0], "MB/s") + " " + cell (gcm128 [1], "MB/s") +
+               "\r\nAES-256-GCM encrypt          " + cell (gcm256 [0], "MB/s") + " " + cell (gcm256 [1], "MB/s") +
+               "\r\nECDSA P-256 sign             " + cell (sign, "ops/s") + " " + cell (-1, "") +
+               "\r\nECDSA P-256 verify           " + cell (verify, "ops/s") + " " + cell (-1, "");
+    return s;
+}
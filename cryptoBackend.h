@@ -0,0 +1,72 @@
+/*
+
+    cryptoBackend.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    SHA-256, AES-GCM and ECC with a selectable backend, and a benchmark of each, shown by the cryptobench Telnet command.
+
+    The HARDWARE backend calls mbedTLS of ESP-IDF, which uses the on-chip AES, SHA and RSA/MPI (or ECC) accelerators
+    when it is built with CONFIG_MBEDTLS_HARDWARE_AES, _SHA, _MPI, _ECC, _GCM (the defaults of Arduino-ESP32 on the
+    chips that have them). The SOFTWARE backend is portable C++ in cryptoBackend.cpp, so the same code also runs
+    in host builds, where HARDWARE falls back to it. ECC is only available through mbedTLS.
+
+    WolfSSL (httpsServer_t) does not go through this backend, it uses the accelerators when it is built with
+    WOLFSSL_ESP32_CRYPT in its user_settings.h. The cryptobench results show what that is worth.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __CRYPTO_BACKEND_H__
+    #define __CRYPTO_BACKEND_H__
+
+    #include <Arduino.h>
+
+
+    // TUNING PARAMETERS
+    #define CRYPTO_BENCH_DURATION 300   // ms, how long each primitive is measured by cryptobench
+    #define CRYPTO_BENCH_BLOCK 1024     // bytes hashed or encrypted at a time by cryptobench
+
+
+    class cryptoBackend_t {
+
+        public:
+
+            enum backend_t { DEFAULT, HARDWARE, SOFTWARE }; // DEFAULT is the one set with setBackend
+
+            // HARDWARE if mbedTLS of ESP-IDF is available
+            static void setBackend (backend_t backend);
+            static backend_t getBackend ();
+
+            static bool hardwareAvailable ();
+
+            // accelerators that mbedTLS is configured to use, like "AES SHA MPI"
+            static const char *hardwareUnits ();
+
+            static void sha256 (const void *data, size_t length, uint8_t hash [32], backend_t backend = DEFAULT);
+
+            // key is 16, 24 or 32 bytes long, iv 12 bytes, output may be the same as input
+            static bool aesGcmEncrypt (const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                       const uint8_t *input, size_t length, uint8_t *output, uint8_t tag [16], backend_t backend = DEFAULT);
+
+            // returns false if the tag does not match, output is undefined in this case
+            static bool aesGcmDecrypt (const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                       const uint8_t *input, size_t length, uint8_t *output, const uint8_t tag [16], backend_t backend = DEFAULT);
+
+            // measures all the primitives with both backends, takes a few seconds
+            static String bench ();
+
+        private:
+
+            static backend_t __backend__;
+
+            static backend_t __resolve__ (backend_t backend);
+
+            static bool __softwareAesGcm__ (bool encrypt, const uint8_t *key, size_t keyLength, const uint8_t iv [12], const uint8_t *aad, size_t aadLength,
+                                            const uint8_t *input, size_t length, uint8_t *output, uint8_t tag [16]);
+    };
+
+#endif
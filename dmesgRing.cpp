@@ -0,0 +1,263 @@
+/*
+
+    dmesgRing.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Lock-free logging of binary records into a fixed ring, formatted into dmesgQueue later, off the caller's task.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "dmesgRing.h"
+#ifdef ESP_PLATFORM
+    #include <esp_app_desc.h>
+    #include <esp_memory_utils.h>
+#endif
+
+
+static_assert ((DMESG_RING_SIZE & (DMESG_RING_SIZE - 1)) == 0, "DMESG_RING_SIZE must be a power of 2");
+
+#define DMESG_RING_MAGIC 0x444d5347 // "DMSG"
+
+
+__NOINIT_ATTR dmesgRing_t::__persistent__ dmesgRing_t::__persistentStorage__;
+
+
+dmesgRing_t::dmesgRing_t () {
+    __persistent__& p = __persistentStorage__;
+    char elfSha [17];
+    __firmwareId__ (elfSha);
+
+    if (p.magic == DMESG_RING_MAGIC && p.ringSize == DMESG_RING_SIZE && p.crc == __headerCrc__ (p) && !strcmp (p.elfSha, elfSha)) {
+        // warm reset of the same firmware, collect the records that were completely written (published or already drained)
+        int valid [DMESG_RING_SIZE];
+        int count = 0;
+        uint32_t next = 0;
+        for (int i = 0; i < DMESG_RING_SIZE; i++) {
+            const __record__& r = __ring__ [i];
+            uint32_t sequence = r.sequence.load (std::memory_order_relaxed);
+            if ((r.claimedAt & (DMESG_RING_SIZE - 1)) != (uint32_t) i || (sequence != r.claimedAt + 1 && sequence != r.claimedAt + DMESG_RING_SIZE))
+                continue;
+            if (r.argc > DMESG_RING_MAX_ARGS || !__readable__ (r.format))
+                continue;
+            if (!count || (int32_t) (r.claimedAt + 1 - next) > 0)
+                next = r.claimedAt + 1;
+            valid [count++] = i;
+        }
+        // oldest first
+        for (int i = 1; i < count; i++)
+            for (int j = i; j > 0 && (int32_t) (__ring__ [valid [j]].claimedAt - __ring__ [valid [j - 1]].claimedAt) < 0; j--) {
+                int t = valid [j]; valid [j] = valid [j - 1]; valid [j - 1] = t;
+            }
+        if (count) {
+            __previous__ = (__record__ *) malloc (count * sizeof (__record__));
+            if (__previous__) {
+                for (int i = 0; i < count; i++)
+                    memcpy ((void *) &__previous__ [i], (const void *) &__ring__ [valid [i]], sizeof (__record__));
+                __previousCount__ = count;
+            }
+        }
+        __bootPosition__ = next;
+    }
+
+    // continue numbering after the previous run, so the ring is consistent, the old records are overwritten as the new ones arrive
+    for (uint32_t i = 0; i < DMESG_RING_SIZE; i++) {
+        uint32_t position = __bootPosition__ + ((i - __bootPosition__) & (DMESG_RING_SIZE - 1));
+        __ring__ [i].sequence.store (position, std::memory_order_relaxed);
+        __ring__ [i].claimedAt = position + 1; // doesn't belong to this record, so it is not taken for a written one at the next boot
+    }
+    __enqueuePosition__.store (__bootPosition__, std::memory_order_relaxed);
+    __dequeuePosition__.store (__bootPosition__, std::memory_order_relaxed);
+
+    p.magic = DMESG_RING_MAGIC;
+    p.ringSize = DMESG_RING_SIZE;
+    strcpy (p.elfSha, elfSha);
+    p.crc = __headerCrc__ (p);
+
+    __semaphore__ = xSemaphoreCreateMutex ();
+}
+
+size_t dmesgRing_t::drain (void (*output) (const char *text)) {
+    return __drain__ (output, NULL);
+}
+
+size_t dmesgRing_t::drainIfNeeded (void (*output) (const char *text)) {
+    // called from loop () very often, so check without locking first, it doesn't matter if the answer is a little late
+    uint32_t dequeuePosition = __dequeuePosition__.load (std::memory_order_acquire);
+    uint32_t waiting = __enqueuePosition__.load (std::memory_order_relaxed) - dequeuePosition;
+    if (waiting == 0 && __dropped__.load (std::memory_order_relaxed) == __droppedReported__.load (std::memory_order_relaxed))
+        return 0;
+    if (waiting < DMESG_RING_SIZE / 2) {
+        const __record__& oldest = __ring__ [dequeuePosition & (DMESG_RING_SIZE - 1)];
+        if (oldest.sequence.load (std::memory_order_acquire) != dequeuePosition + 1 || esp_timer_get_time () - oldest.time < DMESG_RING_DRAIN_TIME * 1000)
+            return 0;
+    }
+    return __drain__ (output, NULL);
+}
+
+size_t dmesgRing_t::__drain__ (void (*output) (const char *text), const char *skipFormat) {
+    char text [DMESG_RING_MAX_TEXT];
+    size_t count = 0;
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        uint32_t dropped = __dropped__.load (std::memory_order_relaxed);
+        uint32_t droppedReported = __droppedReported__.load (std::memory_order_relaxed);
+        if (dropped != droppedReported) {
+            snprintf (text, sizeof (text), "[dmesg] %lu messages dropped, the ring was full", (unsigned long) (dropped - droppedReported));
+            __droppedReported__.store (dropped, std::memory_order_relaxed);
+            output (text);
+        }
+        uint32_t position = __dequeuePosition__.load (std::memory_order_relaxed); // only changed under __semaphore__
+        while (true) {
+            __record__& r = __ring__ [position & (DMESG_RING_SIZE - 1)];
+            if (r.sequence.load (std::memory_order_acquire) != position + 1)
+                break; // empty or not published yet
+            bool skip = r.format == skipFormat;
+            __format__ (r, text, sizeof (text));
+            r.sequence.store (position + DMESG_RING_SIZE, std::memory_order_release); // free for the next round
+            __dequeuePosition__.store (++ position, std::memory_order_release);
+            if (!skip) {
+                output (text);
+                count ++;
+            }
+        }
+    xSemaphoreGive (__semaphore__);
+    return count;
+}
+
+String dmesgRing_t::previousRun () {
+    if (!__previousCount__)
+        return "No records of the previous run";
+    String s;
+    char text [DMESG_RING_MAX_TEXT + 16];
+    for (int i = 0; i < __previousCount__; i++) {
+        if (i)
+            s += "\r\n";
+        int l = snprintf (text, sizeof (text), "[%10lu] ", (unsigned long) (__previous__ [i].time / 1000));
+        __format__ (__previous__ [i], text + l, sizeof (text) - l, true);
+        s += text;
+    }
+    return s;
+}
+
+// printf with the arguments stored in the record, one conversion at a time
+void dmesgRing_t::__format__ (const __record__& r, char *buf, size_t size, bool previousRun) {
+    size_t l = 0;
+    int arg = 0;
+    const char *p = r.format;
+    while (*p && l < size - 1) {
+        if (*p != '%') {
+            buf [l++] = *p++;
+            continue;
+        }
+        if (p [1] == '%') {
+            buf [l++] = '%';
+            p += 2;
+            continue;
+        }
+        // copy one conversion specification, like %-8.3lf
+        char specification [16];
+        size_t s = 0;
+        specification [s++] = *p++;
+        while (*p && !strchr ("diouxXcsfFeEgGaAp", *p) && s < sizeof (specification) - 2)
+            specification [s++] = *p++;
+        if (*p)
+            specification [s++] = *p++;
+        specification [s] = 0;
+
+        int n;
+        if (arg >= r.argc) {
+            n = snprintf (buf + l, size - l, "%s", specification); // missing argument
+        } else {
+            if (previousRun && r.types [arg] == POINTER && strchr (specification, 's') && !__readable__ (r.args [arg].p))
+                n = snprintf (buf + l, size - l, "?"); // the string pointed to did not survive
+            else switch (r.types [arg]) {
+                case INT32:   n = snprintf (buf + l, size - l, specification, r.args [arg].i); break;
+                case INT64:   n = snprintf (buf + l, size - l, specification, r.args [arg].l); break;
+                case DOUBLE:  n = snprintf (buf + l, size - l, specification, r.args [arg].d); break;
+                default:      n = snprintf (buf + l, size - l, specification, r.args [arg].p); break;
+            }
+            arg ++;
+        }
+        if (n < 0)
+            break;
+        l += n;
+        if (l >= size)
+            l = size - 1;
+    }
+    buf [l] = 0;
+
+    // tell how late the message is if it waited in the ring
+    if (previousRun)
+        return;
+    int64_t delay = (esp_timer_get_time () - r.time) / 1000;
+    if (delay >= 10 && l < size - 1)
+        snprintf (buf + l, size - l, " (logged %lli ms earlier)", (long long) delay);
+}
+
+String dmesgRing_t::benchmark (void (*formatted) (int i), void (*output) (const char *text)) {
+    static const char *benchmarkFormat = "[dmesgRing] benchmark record %i";
+    const int ringCalls = 1024;
+    const int formattedCalls = 32;  // they stay in dmesgQueue, so don't push out too much of it
+
+    drain (output); // the records logged so far are kept
+
+    // DMESG, the ring is emptied between the batches so nothing is dropped
+    int64_t ringTime = 0;
+    int64_t drainTime = 0;
+    for (int i = 0; i < ringCalls; ) {
+        int64_t start = esp_timer_get_time ();
+        for (int j = 0; j < DMESG_RING_SIZE / 2; j++, i++)
+            log (benchmarkFormat, i);
+        ringTime += esp_timer_get_time () - start;
+        start = esp_timer_get_time ();
+        __drain__ (output, benchmarkFormat);
+        drainTime += esp_timer_get_time () - start;
+    }
+
+    // formatting and inserting on the calling task
+    int64_t start = esp_timer_get_time ();
+    for (int i = 0; i < formattedCalls; i++)
+        formatted (i);
+    int64_t formattedTime = esp_timer_get_time () - start;
+
+    char s [256];
+    snprintf (s, sizeof (s), "DMESG:              %8.3f us per call\r\n"
+                             "formatting later:   %8.3f us per record\r\n"
+                             "dmesgQueue <<:      %8.3f us per call",
+                             (double) ringTime / ringCalls, (double) drainTime / ringCalls, (double) formattedTime / formattedCalls);
+    return s;
+}
+
+uint32_t dmesgRing_t::__headerCrc__ (const __persistent__& p) {
+    // CRC-32 of the header fields, only calculated at boot
+    const uint8_t *b = (const uint8_t *) &p;
+    size_t length = (const uint8_t *) &p.crc - b;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= b [i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+void dmesgRing_t::__firmwareId__ (char elfSha [17]) {
+    #ifdef ESP_PLATFORM
+        esp_app_get_elf_sha256 (elfSha, 17);
+    #else
+        strcpy (elfSha, "host build");
+    #endif
+}
+
+// format strings and %s arguments of the previous run should be in flash, but the memory may have been overwritten by a crash
+bool dmesgRing_t::__readable__ (const void *p) {
+    #ifdef ESP_PLATFORM
+        return p && (esp_ptr_in_drom (p) || esp_ptr_byte_accessible (p));
+    #else
+        return p != NULL;
+    #endif
+}
@@ -0,0 +1,186 @@
+/*
+
+    dmesgRing.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Lock-free logging of binary records into a fixed ring, formatted into dmesgQueue later, off the caller's task.
+
+    cout << ( dmesgQueue << ... ) formats the message and inserts it under a lock on the calling task. DMESG only
+    stores the time, the format string pointer and up to DMESG_RING_MAX_ARGS arguments into the next free slot of
+    the ring, claimed with a single compare-and-swap, so it can be called from latency sensitive tasks (WiFi events,
+    HTTP handlers, ...):
+
+        DMESG ("[WiFi][STA] got IP address: %u.%u.%u.%u", ip [0], ip [1], ip [2], ip [3]);
+
+    The records are formatted by drain (), which is called before dmesg Telnet command shows dmesgQueue and from
+    loop () when the ring is half full or its oldest record is older than DMESG_RING_DRAIN_TIME. If the ring is full
+    the record is dropped and counted, the memory used is fixed.
+
+    The ring lives in no-init RAM, which is not cleared by software resets, panics and watchdog resets. Its header
+    holds the ELF SHA-256 of the firmware and a CRC, so at the next boot the records of the previous run are kept
+    (the format pointers are still valid if the firmware is the same) and shown by dmesg -p Telnet command. Logging
+    itself costs nothing extra, the header is only written at boot. After power-on the header is invalid and the ring
+    starts empty.
+
+    Since formatting is deferred, the format string and %s arguments must be string literals (or other strings
+    that live forever). Arguments may be integers, floating point numbers and pointers, formats are the same as
+    for printf. Messages with dynamic strings should still go to dmesgQueue directly.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __DMESG_RING_H__
+    #define __DMESG_RING_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <type_traits>
+    #include <esp_timer.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+    #ifdef ESP_PLATFORM
+        #include <esp_attr.h>
+    #endif
+    #ifndef __NOINIT_ATTR
+        #define __NOINIT_ATTR   // host builds, nothing survives a restart there
+    #endif
+
+
+    // TUNING PARAMETERS
+    #define DMESG_RING_SIZE 64                  // records, must be a power of 2, each takes 64 bytes
+    #define DMESG_RING_MAX_ARGS 4               // arguments stored with each record
+    #define DMESG_RING_DRAIN_TIME 1000          // ms, records older than this are formatted at the next drainIfNeeded ()
+    #define DMESG_RING_MAX_TEXT 160             // bytes, longer formatted messages are truncated
+
+
+    class dmesgRing_t {
+
+        public:
+
+            dmesgRing_t ();
+
+            // stores the record, returns false if the ring is full (the record is dropped), never blocks
+            template<typename... Args>
+            bool log (const char *format, Args... args) {
+                static_assert (sizeof... (Args) <= DMESG_RING_MAX_ARGS, "too many DMESG arguments");
+                int64_t now = esp_timer_get_time ();
+                __record__ *r = __claim__ ();
+                if (!r)
+                    return false;
+                r->time = now;
+                r->format = format;
+                r->argc = 0;
+                (__put__ (*r, args), ...);
+                r->sequence.store (r->claimedAt + 1, std::memory_order_release); // publish
+                return true;
+            }
+
+            // formats the records in the order they were logged and passes them to output, returns the number of records
+            size_t drain (void (*output) (const char *text));
+
+            // drains the ring if it is half full or its oldest record is older than DMESG_RING_DRAIN_TIME
+            size_t drainIfNeeded (void (*output) (const char *text));
+
+            // the records of the previous run that survived the reset, oldest first
+            String previousRun ();
+
+            inline int previousRunRecords () __attribute__((always_inline)) { return __previousCount__; }
+
+            inline uint32_t logged () __attribute__((always_inline)) { return __enqueuePosition__.load (std::memory_order_relaxed) - __bootPosition__; }
+            inline uint32_t dropped () __attribute__((always_inline)) { return __dropped__.load (std::memory_order_relaxed); }
+
+            // compares DMESG with formatting on the calling task, which is done by formatted (i), the records already in the ring are drained to output first
+            String benchmark (void (*formatted) (int i), void (*output) (const char *text));
+
+        private:
+
+            enum __argType__ : uint8_t { INT32, INT64, DOUBLE, POINTER };
+
+            struct __record__ {
+                std::atomic<uint32_t> sequence;     // == position: free, == position + 1: published
+                uint32_t claimedAt;                 // position of the record while it is being written
+                int64_t time;                       // esp_timer_get_time () at log ()
+                const char *format;
+                uint8_t argc;
+                __argType__ types [DMESG_RING_MAX_ARGS];
+                union {
+                    int32_t i;
+                    int64_t l;
+                    double d;
+                    const void *p;
+                } args [DMESG_RING_MAX_ARGS];
+            };
+
+            // kept in no-init RAM across resets
+            struct __persistent__ {
+                uint32_t magic;
+                uint32_t ringSize;
+                char elfSha [17];       // first 16 hex digits of the firmware's ELF SHA-256
+                uint32_t crc;           // of the fields above
+                __record__ ring [DMESG_RING_SIZE];
+            };
+            static __persistent__ __persistentStorage__;
+
+            __record__ *__ring__ = __persistentStorage__.ring;
+            uint32_t __bootPosition__ = 0;      // position of the first record of this run
+            __record__ *__previous__ = NULL;    // copies of the previous run's records, oldest first
+            int __previousCount__ = 0;
+            std::atomic<uint32_t> __enqueuePosition__ = {};
+            std::atomic<uint32_t> __dequeuePosition__ = {}; // written only under __semaphore__, drainIfNeeded reads it without
+            std::atomic<uint32_t> __dropped__ = {};
+            std::atomic<uint32_t> __droppedReported__ = {}; // the same
+            SemaphoreHandle_t __semaphore__ = NULL; // only one task drains at a time
+
+            inline __record__ *__claim__ () __attribute__((always_inline)) {
+                uint32_t position = __enqueuePosition__.load (std::memory_order_relaxed);
+                while (true) {
+                    __record__ *r = &__ring__ [position & (DMESG_RING_SIZE - 1)];
+                    int32_t difference = (int32_t) (r->sequence.load (std::memory_order_acquire) - position);
+                    if (difference == 0) {
+                        if (__enqueuePosition__.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) {
+                            r->claimedAt = position;
+                            return r;
+                        }
+                        // position has been updated by compare_exchange_weak
+                    } else if (difference < 0) { // the ring is full
+                        __dropped__.fetch_add (1, std::memory_order_relaxed);
+                        return NULL;
+                    } else { // another task has claimed this record in the meantime
+                        position = __enqueuePosition__.load (std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            template<typename T>
+            static inline __attribute__((always_inline)) void __put__ (__record__& r, T value) {
+                int i = r.argc ++;
+                if constexpr (std::is_floating_point<T>::value) {
+                    r.types [i] = DOUBLE; r.args [i].d = value;
+                } else if constexpr (std::is_pointer<T>::value || std::is_null_pointer<T>::value) {
+                    r.types [i] = POINTER; r.args [i].p = (const void *) value;
+                } else if constexpr (sizeof (T) > sizeof (int32_t)) {
+                    r.types [i] = INT64; r.args [i].l = (int64_t) value;
+                } else {
+                    static_assert (std::is_integral<T>::value || std::is_enum<T>::value, "DMESG arguments must be numbers or pointers");
+                    r.types [i] = INT32; r.args [i].i = (int32_t) value;
+                }
+            }
+
+            size_t __drain__ (void (*output) (const char *text), const char *skipFormat); // records with skipFormat are formatted but not output
+
+            static void __format__ (const __record__& r, char *buf, size_t size, bool previousRun = false);
+
+            static uint32_t __headerCrc__ (const __persistent__& p);
+            static void __firmwareId__ (char elfSha [17]);
+            static bool __readable__ (const void *p);
+    };
+
+
+    // logs a message into the global dmesgRing
+    #define DMESG(format, ...) dmesgRing.log (format, ##__VA_ARGS__)
+
+#endif
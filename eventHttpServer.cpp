@@ -0,0 +1,690 @@
+/*
+
+    eventHttpServer.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Event-driven HTTP server: a single task serves all the connections with select () and non-blocking sockets.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "eventHttpServer.h"
+#include "httpContentType.h"
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <mbedtls/sha1.h>
+#include <mbedtls/base64.h>
+
+
+// ----- connection -----
+
+bool eventHttpServer_t::connection_t::__append__ (const void *buf, size_t len) {
+    if (__outLength__ + len > __outCapacity__) {
+        size_t capacity = __outCapacity__ ? __outCapacity__ : 512;
+        while (capacity < __outLength__ + len)
+            capacity *= 2;
+        if (capacity > EVENT_HTTP_SERVER_MAX_REPLY_SIZE) {
+            if (__outLength__ + len > EVENT_HTTP_SERVER_MAX_REPLY_SIZE)
+                return false;
+            capacity = EVENT_HTTP_SERVER_MAX_REPLY_SIZE;
+        }
+        char *out = (char *) realloc (__out__, capacity);
+        if (!out)
+            return false;
+        __out__ = out;
+        __outCapacity__ = capacity;
+    }
+    memcpy (__out__ + __outLength__, buf, len);
+    __outLength__ += len;
+    return true;
+}
+
+bool eventHttpServer_t::connection_t::__appendFrame__ (uint8_t opcode, const void *buf, size_t len) {
+    uint8_t header [10] = { (uint8_t) (0x80 | opcode) }; // FIN, server frames are not masked
+    size_t headerLength;
+    if (len < 126) {
+        header [1] = len;
+        headerLength = 2;
+    } else if (len < 65536) {
+        header [1] = 126;
+        header [2] = len >> 8;
+        header [3] = len;
+        headerLength = 4;
+    } else {
+        header [1] = 127;
+        for (int i = 0; i < 8; i++)
+            header [9 - i] = (uint64_t) len >> (8 * i);
+        headerLength = 10;
+    }
+    if (__outLength__ - __outSent__ + headerLength + len > EVENT_HTTP_SERVER_MAX_REPLY_SIZE / 2) // the client is not reading fast enough
+        return false;
+    size_t outLength = __outLength__;
+    if (__append__ (header, headerLength) && __append__ (buf, len))
+        return true;
+    __outLength__ = outLength; // don't leave half of the frame in the buffer
+    return false;
+}
+
+int eventHttpServer_t::connection_t::sendBlock (const byte *buf, size_t len) {
+    if (__state__ == WEBSOCKET)
+        return __appendFrame__ (2, buf, len) ? len : 0;
+    if (__state__ != READING_REQUEST && __state__ != SENDING) // the reply can only be put into the buffer while the request is being handled
+        return -1;
+    return __append__ (buf, len) ? len : -1;
+}
+
+int eventHttpServer_t::connection_t::sendString (const char *s) {
+    if (__state__ == WEBSOCKET)
+        return __appendFrame__ (1, s, strlen (s)) ? strlen (s) : 0;
+    return sendBlock ((const byte *) s, strlen (s));
+}
+
+const char *eventHttpServer_t::connection_t::getHttpRequestHeaderField (const char *fieldName) {
+    *__field__ = 0;
+    if (!__in__)
+        return __field__;
+    size_t l = strlen (fieldName);
+    for (const char *line = strstr (__in__, "\r\n"); line && line [2] != '\r' && line [2]; line = strstr (line + 2, "\r\n"))
+        if (!strncasecmp (line + 2, fieldName, l) && line [2 + l] == ':') {
+            const char *v = line + 3 + l;
+            while (*v == ' ')
+                v++;
+            size_t i = 0;
+            while (v [i] && v [i] != '\r' && i < sizeof (__field__) - 1) {
+                __field__ [i] = v [i];
+                i++;
+            }
+            __field__ [i] = 0;
+            break;
+        }
+    return __field__;
+}
+
+const char *eventHttpServer_t::connection_t::getHttpRequestCookie (const char *cookieName) {
+    getHttpRequestHeaderField ("Cookie"); // name1=value1; name2=value2
+    size_t l = strlen (cookieName);
+    char *p = __field__;
+    while (*p) {
+        while (*p == ' ' || *p == ';')
+            p++;
+        char *end = strchr (p, ';');
+        if (!end)
+            end = p + strlen (p);
+        if (!strncmp (p, cookieName, l) && p [l] == '=') {
+            size_t valueLength = end - (p + l + 1);
+            memmove (__field__, p + l + 1, valueLength);
+            __field__ [valueLength] = 0;
+            return __field__;
+        }
+        p = end;
+    }
+    *__field__ = 0;
+    return __field__;
+}
+
+void eventHttpServer_t::connection_t::setHttpReplyHeaderField (const char *fieldName, const char *fieldValue) {
+    __replyHeaderFields__ += fieldName;
+    __replyHeaderFields__ += ": ";
+    __replyHeaderFields__ += fieldValue;
+    __replyHeaderFields__ += "\r\n";
+}
+
+void eventHttpServer_t::connection_t::setHttpReplyCookie (const char *cookieName, const char *cookieValue, time_t expires) {
+    __replyHeaderFields__ += "Set-Cookie: ";
+    __replyHeaderFields__ += cookieName;
+    __replyHeaderFields__ += "=";
+    __replyHeaderFields__ += cookieValue;
+    __replyHeaderFields__ += "; Path=/";
+    if (expires) {
+        char s [48];
+        struct tm st;
+        gmtime_r (&expires, &st);
+        strftime (s, sizeof (s), "; Expires=%a, %d %b %Y %H:%M:%S GMT", &st);
+        __replyHeaderFields__ += s;
+    }
+    __replyHeaderFields__ += "\r\n";
+}
+
+void eventHttpServer_t::connection_t::setHttpReplyStatus (const char *status) {
+    __replyStatus__ = status;
+}
+
+void eventHttpServer_t::connection_t::__free__ () {
+    free (__in__);
+    __in__ = NULL;
+    __inLength__ = 0;
+    free (__requestLine__);
+    __requestLine__ = NULL;
+    free (__out__);
+    __out__ = NULL;
+    __outLength__ = __outCapacity__ = __outSent__ = 0;
+    __replyStatus__ = "";
+    __replyHeaderFields__ = "";
+    __replySent__ = false;
+    __messageCount__ = 0;
+    __requestCount__ = 0;
+    __keepAlive__ = false;
+    if (__file__)
+        __file__.close ();
+}
+
+// a reply that the handler has put into the buffer itself can only be followed by the next one if the client can find its end
+bool eventHttpServer_t::connection_t::__replyAllowsKeepAlive__ () {
+    char header [512];
+    size_t l = __outLength__ < sizeof (header) - 1 ? __outLength__ : sizeof (header) - 1;
+    memcpy (header, __out__, l);
+    header [l] = 0;
+    char *endOfHeader = strstr (header, "\r\n\r\n");
+    if (!endOfHeader || strncmp (header, "HTTP/1.", 7))
+        return false;
+    endOfHeader [2] = 0;
+    if (strstr (header, "\r\nConnection: close\r\n"))
+        return false;
+    if (!strncmp (header + 9, "204", 3) || !strncmp (header + 9, "304", 3))
+        return true; // these replies never have content
+    return strstr (header, "\r\nContent-Length:") != NULL;
+}
+
+
+// ----- server -----
+
+eventHttpServer_t::eventHttpServer_t (threadSafeFS::FS& fileSystem, httpHandler_t httpRequestHandler, wsHandler_t wsRequestHandler, int serverPort, bool (*firewallCallback) (char *clientIP, char *serverIP), bool runInItsOwnTask)
+                                     : __fileSystem__ (fileSystem), __httpRequestHandler__ (httpRequestHandler), __wsRequestHandler__ (wsRequestHandler), __firewallCallback__ (firewallCallback) {
+    int opt = 1;
+    int s = socket (AF_INET6, SOCK_STREAM, 0); // dual-stack
+    if (s >= 0) {
+        int v6only = 0;
+        setsockopt (s, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof (opt));
+        setsockopt (s, IPPROTO_IPV6, IPV6_V6ONLY, &v6only, sizeof (v6only));
+        struct sockaddr_in6 serverAddress = {}; // :: (any)
+        serverAddress.sin6_family = AF_INET6;
+        serverAddress.sin6_port = htons (serverPort);
+        if (bind (s, (struct sockaddr *) &serverAddress, sizeof (serverAddress))) {
+            close (s);
+            s = -1;
+        }
+    }
+    if (s < 0) { // lwIP without IPv6
+        s = socket (AF_INET, SOCK_STREAM, 0);
+        if (s < 0)
+            return;
+        setsockopt (s, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof (opt));
+        struct sockaddr_in serverAddress = {};
+        serverAddress.sin_family = AF_INET;
+        serverAddress.sin_addr.s_addr = htonl (INADDR_ANY);
+        serverAddress.sin_port = htons (serverPort);
+        if (bind (s, (struct sockaddr *) &serverAddress, sizeof (serverAddress))) {
+            close (s);
+            return;
+        }
+    }
+    if (listen (s, EVENT_HTTP_SERVER_MAX_CONNECTIONS) || fcntl (s, F_SETFL, O_NONBLOCK) < 0) {
+        close (s);
+        return;
+    }
+    __listeningSocket__ = s;
+
+    if (runInItsOwnTask && xTaskCreate (__taskFunction__, "eventHttpServer", EVENT_HTTP_SERVER_STACK_SIZE, this, EVENT_HTTP_SERVER_PRIORITY, &__task__) != pdPASS) {
+        close (__listeningSocket__);
+        __listeningSocket__ = -1;
+    }
+}
+
+eventHttpServer_t::~eventHttpServer_t () {
+    if (__task__)
+        vTaskDelete (__task__);
+    for (connection_t& c : __connections__)
+        if (c.__state__ != connection_t::FREE)
+            __close__ (c);
+    if (__listeningSocket__ >= 0)
+        close (__listeningSocket__);
+}
+
+void eventHttpServer_t::__taskFunction__ (void *server) {
+    while (true)
+        ((eventHttpServer_t *) server)->accept (1000);
+}
+
+void eventHttpServer_t::accept (unsigned long timeout) {
+    if (__listeningSocket__ < 0)
+        return;
+
+    fd_set readSet, writeSet;
+    FD_ZERO (&readSet);
+    FD_ZERO (&writeSet);
+    int maxSocket = -1;
+    bool idleConnections = false;
+    for (connection_t& c : __connections__) {
+        if (c.__state__ == connection_t::FREE)
+            continue;
+        if (c.__idle__ ())
+            idleConnections = true;
+        if (c.__state__ == connection_t::READING_REQUEST || c.__state__ == connection_t::WEBSOCKET)
+            FD_SET (c.__socket__, &readSet);
+        if (c.__outSent__ < c.__outLength__ || c.__state__ == connection_t::SENDING_FILE || c.__state__ == connection_t::SENDING)
+            FD_SET (c.__socket__, &writeSet);
+        if (c.__socket__ > maxSocket)
+            maxSocket = c.__socket__;
+        if (c.__state__ == connection_t::WEBSOCKET && timeout > EVENT_HTTP_SERVER_WS_TICK)
+            timeout = EVENT_HTTP_SERVER_WS_TICK; // wake up in time to call wsHandler
+    }
+    if (__acceptFailed__ && millis () - __acceptFailed__ >= EVENT_HTTP_SERVER_ACCEPT_BACKOFF)
+        __acceptFailed__ = 0;
+    if ((__connectionCount__ < EVENT_HTTP_SERVER_MAX_CONNECTIONS || idleConnections) && !__acceptFailed__) { // when all the slots are used, leave new connections waiting in the backlog unless an idle connection can make room for them
+        FD_SET (__listeningSocket__, &readSet);
+        if (__listeningSocket__ > maxSocket)
+            maxSocket = __listeningSocket__;
+    }
+
+    struct timeval tv = { (time_t) (timeout / 1000), (suseconds_t) (timeout % 1000 * 1000) };
+    int ready = maxSocket >= 0 ? select (maxSocket + 1, &readSet, &writeSet, NULL, &tv) : 0;
+    if (ready < 0)
+        return;
+
+    if (ready > 0) {
+        if (FD_ISSET (__listeningSocket__, &readSet))
+            __accept__ ();
+        for (connection_t& c : __connections__) {
+            if (c.__state__ != connection_t::FREE && FD_ISSET (c.__socket__, &readSet))
+                __read__ (c);
+            if (c.__state__ != connection_t::FREE && FD_ISSET (c.__socket__, &writeSet))
+                __write__ (c);
+        }
+    }
+
+    // WebSocket ticks and timeouts
+    unsigned long now = millis ();
+    for (connection_t& c : __connections__) {
+        if (c.__state__ == connection_t::FREE)
+            continue;
+        if (c.__state__ == connection_t::WEBSOCKET) {
+            if (now - c.__lastTick__ >= EVENT_HTTP_SERVER_WS_TICK) {
+                c.__lastTick__ = now;
+                if (!__wsRequestHandler__ (c.__requestLine__, &c, NULL, 0)) {
+                    c.__appendFrame__ (8, "", 0); // close
+                    c.__state__ = connection_t::SENDING;
+                    c.__lastActive__ = now;
+                }
+            }
+            if (c.__outSent__ == c.__outLength__)
+                continue; // an open WebSocket does not time out while there is nothing to send, the handler decides when to close it
+        }
+        if (now - c.__lastActive__ > (c.__idle__ () ? EVENT_HTTP_SERVER_KEEP_ALIVE_TIMEOUT : EVENT_HTTP_SERVER_TIMEOUT))
+            __close__ (c);
+    }
+}
+
+// IPv4 clients of the dual-stack socket have IPv4-mapped addresses (::ffff:a.b.c.d), they are written as a.b.c.d
+static void __addressToString__ (const struct sockaddr_storage& address, char *s, size_t size) {
+    *s = 0;
+    if (address.ss_family == AF_INET) {
+        inet_ntop (AF_INET, &((const struct sockaddr_in *) &address)->sin_addr, s, size);
+    } else if (address.ss_family == AF_INET6) {
+        const uint8_t *a = (const uint8_t *) &((const struct sockaddr_in6 *) &address)->sin6_addr;
+        static const uint8_t v4mapped [12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff };
+        if (!memcmp (a, v4mapped, sizeof (v4mapped)))
+            inet_ntop (AF_INET, a + 12, s, size);
+        else
+            inet_ntop (AF_INET6, a, s, size);
+    }
+}
+
+void eventHttpServer_t::__accept__ () {
+    struct sockaddr_storage clientAddress;
+    socklen_t l = sizeof (clientAddress);
+    int s = ::accept (__listeningSocket__, (struct sockaddr *) &clientAddress, &l);
+    if (s < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && !__closeLongestIdle__ ()) // no free socket (ENFILE), the listening socket would stay readable
+            __acceptFailed__ = millis () | 1;
+        return;
+    }
+
+    char clientIP [46];
+    __addressToString__ (clientAddress, clientIP, sizeof (clientIP));
+    if (__firewallCallback__) {
+        struct sockaddr_storage serverAddress;
+        l = sizeof (serverAddress);
+        char serverIP [46] = "";
+        if (!getsockname (s, (struct sockaddr *) &serverAddress, &l))
+            __addressToString__ (serverAddress, serverIP, sizeof (serverIP));
+        if (!__firewallCallback__ (clientIP, serverIP)) {
+            close (s);
+            return;
+        }
+    }
+
+    if (__connectionCount__ == EVENT_HTTP_SERVER_MAX_CONNECTIONS)
+        __closeLongestIdle__ ();
+
+    for (connection_t& c : __connections__)
+        if (c.__state__ == connection_t::FREE) {
+            if (fcntl (s, F_SETFL, O_NONBLOCK) < 0) {
+                close (s);
+                return;
+            }
+            int noDelay = 1; // replies are assembled in the buffer, Nagle's algorithm would only delay the pipelined ones until the previous one is acknowledged
+            setsockopt (s, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof (noDelay));
+            c.__socket__ = s;
+            strcpy (c.__clientIP__, clientIP);
+            c.__state__ = connection_t::READING_REQUEST;
+            c.__lastActive__ = millis ();
+            __connectionCount__ ++;
+            __connectionsAccepted__ ++;
+            return;
+        }
+    close (s); // should not happen, the listening socket is not checked when all the slots are used by active connections
+}
+
+// closes the connection that has been waiting for its next request the longest, returns false if there is none
+bool eventHttpServer_t::__closeLongestIdle__ () {
+    connection_t *longestIdle = NULL;
+    unsigned long now = millis ();
+    for (connection_t& c : __connections__)
+        if (c.__idle__ () && (!longestIdle || now - c.__lastActive__ > now - longestIdle->__lastActive__))
+            longestIdle = &c;
+    if (!longestIdle)
+        return false;
+    __close__ (*longestIdle);
+    return true;
+}
+
+void eventHttpServer_t::__read__ (connection_t& c) {
+    if (!c.__in__) { // the buffer is only allocated while a request is being received
+        c.__in__ = (char *) malloc (EVENT_HTTP_SERVER_REQUEST_SIZE + 1);
+        if (!c.__in__) {
+            __close__ (c);
+            return;
+        }
+    }
+    int received = recv (c.__socket__, c.__in__ + c.__inLength__, EVENT_HTTP_SERVER_REQUEST_SIZE - c.__inLength__, 0);
+    if (received <= 0) {
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        __close__ (c); // closed by the client or error
+        return;
+    }
+    c.__inLength__ += received;
+    c.__in__ [c.__inLength__] = 0;
+    c.__lastActive__ = c.__lastReceived__ = millis ();
+
+    if (c.__state__ == connection_t::WEBSOCKET) {
+        __readWebSocketFrames__ (c);
+        return;
+    }
+
+    if (strstr (c.__in__, "\r\n\r\n")) {
+        __handleRequest__ (c);
+    } else if (c.__inLength__ == EVENT_HTTP_SERVER_REQUEST_SIZE) {
+        c.__state__ = connection_t::SENDING;
+        c.__keepAlive__ = false;
+        c.sendString ("HTTP/1.1 431 Request Header Fields Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    }
+}
+
+void eventHttpServer_t::__handleRequest__ (connection_t& c) {
+    char *endOfHeader = strstr (c.__in__, "\r\n\r\n");
+    size_t requestLength = endOfHeader + 4 - c.__in__; // the next pipelined request may follow
+    char *endOfRequestLine = strstr (c.__in__, "\r\n");
+    bool http11 = endOfRequestLine - c.__in__ >= 8 && !strncmp (endOfRequestLine - 8, "HTTP/1.1", 8);
+    *endOfHeader = 0; // the body, if any, is not passed to the handler
+
+    c.__requestCount__ ++;
+    __requestsHandled__ ++;
+    const char *connection = c.getHttpRequestHeaderField ("Connection");
+    c.__keepAlive__ = http11 ? strcasecmp (connection, "close") : !strcasecmp (connection, "keep-alive");
+    if (atol (c.getHttpRequestHeaderField ("Content-Length")) > 0 || *c.getHttpRequestHeaderField ("Transfer-Encoding"))
+        c.__keepAlive__ = false; // the body is not read, the next request would be looked for inside it
+    if (c.__requestCount__ >= EVENT_HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS)
+        c.__keepAlive__ = false;
+
+    const char *upgrade = c.getHttpRequestHeaderField ("Upgrade");
+    if (!strcasecmp (upgrade, "websocket") && __startWebSocket__ (c))
+        return;
+
+    String reply = __httpRequestHandler__ ? __httpRequestHandler__ (c.__in__, &c) : String ("");
+    c.__state__ = connection_t::SENDING;
+
+    if (reply == EVENT_HTTP_REPLY_ALREADY_SENT || c.__replySent__) {
+        // the handler has already put the whole reply into the buffer
+        if (c.__keepAlive__ && !c.__replyAllowsKeepAlive__ ())
+            c.__keepAlive__ = false;
+    } else if (reply != "" || c.__replyStatus__ != "") {
+        bool json = reply [0] == '{' || reply [0] == '[';
+        String header = "HTTP/1.1 " + (c.__replyStatus__ != "" ? c.__replyStatus__ : String ("200 OK")) + "\r\n";
+        if (c.__replyHeaderFields__.indexOf ("Content-Type:") < 0)
+            header += json ? "Content-Type: application/json\r\n" : "Content-Type: text/html\r\n";
+        header += c.__replyHeaderFields__;
+        header += "Content-Length: " + String (reply.length ()) + "\r\n" + c.__connectionField__ () + "\r\n";
+        if (!c.__append__ (header.c_str (), header.length ()) || !c.__append__ (reply.c_str (), reply.length ())) {
+            __close__ (c);
+            return;
+        }
+    } else {
+        __sendFile__ (c, c.__in__);
+    }
+
+    size_t pipelined = c.__inLength__ - requestLength;
+    if (c.__keepAlive__ && pipelined) { // keep the next request, it is handled when this reply is sent
+        memmove (c.__in__, c.__in__ + requestLength, pipelined + 1); // with the terminating 0
+        c.__inLength__ = pipelined;
+    } else { // only the reply is needed from now on
+        free (c.__in__);
+        c.__in__ = NULL;
+        c.__inLength__ = 0;
+    }
+}
+
+void eventHttpServer_t::__sendFile__ (connection_t& c, const char *httpRequest) {
+    char notFound [128];
+    snprintf (notFound, sizeof (notFound), "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: 14\r\n%s\r\nPage not found", c.__connectionField__ ());
+    if (strncmp (httpRequest, "GET /", 5)) {
+        char methodNotAllowed [96];
+        snprintf (methodNotAllowed, sizeof (methodNotAllowed), "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\n%s\r\n", c.__connectionField__ ());
+        c.sendString (methodNotAllowed);
+        return;
+    }
+
+    // GET /path?query HTTP/1.1
+    char fileName [256] = "/var/www/html";
+    size_t i = strlen (fileName);
+    for (const char *p = httpRequest + 4; *p > ' ' && *p != '?'; p++) {
+        if (i == sizeof (fileName) - 14) { // leave space for index.html.gz
+            c.sendString (notFound);
+            return;
+        }
+        fileName [i++] = *p;
+    }
+    fileName [i] = 0;
+    if (fileName [i - 1] == '/')
+        strcat (fileName, "index.html");
+    if (strstr (fileName, "..")) {
+        c.sendString (notFound);
+        return;
+    }
+    const char *contentType = httpContentType (fileName);
+
+    // send file.gz instead of file if it exists and the client accepts it, or if only file.gz exists
+    bool fileExists = __fileSystem__.isFile (fileName);
+    bool gzip = false;
+    if (!fileExists || strstr (c.getHttpRequestHeaderField ("Accept-Encoding"), "gzip")) {
+        strcat (fileName, ".gz");
+        gzip = __fileSystem__.isFile (fileName);
+        if (!gzip)
+            fileName [strlen (fileName) - 3] = 0;
+    }
+    if (!fileExists && !gzip) {
+        c.sendString (notFound);
+        return;
+    }
+
+    c.__file__ = __fileSystem__.open (fileName, "r");
+    if (!c.__file__ || c.__file__.isDirectory ()) {
+        c.sendString (notFound);
+        return;
+    }
+    char header [200];
+    snprintf (header, sizeof (header), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %u\r\n%sVary: Accept-Encoding\r\n%s\r\n", contentType, (unsigned) c.__file__.size (), gzip ? "Content-Encoding: gzip\r\n" : "", c.__connectionField__ ());
+    c.sendString (header);
+    c.__state__ = connection_t::SENDING_FILE;
+}
+
+void eventHttpServer_t::__write__ (connection_t& c) {
+    if (c.__outSent__ == c.__outLength__) {
+        c.__outSent__ = c.__outLength__ = 0;
+        if (c.__state__ == connection_t::SENDING_FILE) {
+            // the buffer has been sent, read the next chunk
+            if (c.__outCapacity__ < EVENT_HTTP_SERVER_FILE_CHUNK) {
+                char *out = (char *) realloc (c.__out__, EVENT_HTTP_SERVER_FILE_CHUNK);
+                if (!out) {
+                    __close__ (c);
+                    return;
+                }
+                c.__out__ = out;
+                c.__outCapacity__ = EVENT_HTTP_SERVER_FILE_CHUNK;
+            }
+            c.__outLength__ = c.__file__.read ((uint8_t *) c.__out__, EVENT_HTTP_SERVER_FILE_CHUNK);
+            if (c.__outLength__ == 0) {
+                __endOfReply__ (c); // end of file
+                return;
+            }
+        } else if (c.__state__ == connection_t::SENDING) {
+            __endOfReply__ (c); // the whole reply has been sent
+            return;
+        } else {
+            return;
+        }
+    }
+
+    int sent = send (c.__socket__, c.__out__ + c.__outSent__, c.__outLength__ - c.__outSent__, MSG_DONTWAIT);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+            __close__ (c);
+        return;
+    }
+    c.__outSent__ += sent;
+    c.__lastActive__ = millis ();
+    if (c.__outSent__ == c.__outLength__ && c.__state__ == connection_t::WEBSOCKET)
+        c.__outSent__ = c.__outLength__ = 0;
+}
+
+void eventHttpServer_t::__endOfReply__ (connection_t& c) {
+    if (!c.__keepAlive__) {
+        __close__ (c);
+        return;
+    }
+    // wait for the next request, an idle connection keeps no buffers
+    free (c.__out__);
+    c.__out__ = NULL;
+    c.__outLength__ = c.__outCapacity__ = c.__outSent__ = 0;
+    c.__replyStatus__ = "";
+    c.__replyHeaderFields__ = "";
+    c.__replySent__ = false;
+    if (c.__file__)
+        c.__file__.close ();
+    c.__state__ = connection_t::READING_REQUEST;
+    c.__lastActive__ = millis ();
+    if (c.__in__ && strstr (c.__in__, "\r\n\r\n"))
+        __handleRequest__ (c); // the next request has already arrived (pipelining)
+}
+
+bool eventHttpServer_t::__startWebSocket__ (connection_t& c) {
+    if (!__wsRequestHandler__)
+        return false;
+    const char *key = c.getHttpRequestHeaderField ("Sec-WebSocket-Key");
+    if (!*key)
+        return false;
+
+    char s [96];
+    snprintf (s, sizeof (s), "%s258EAFA5-E914-47DA-95CA-C5AB0DC85B11", key);
+    unsigned char sha1 [20];
+    mbedtls_sha1 ((const unsigned char *) s, strlen (s), sha1);
+    unsigned char accept [32];
+    size_t acceptLength = 0;
+    mbedtls_base64_encode (accept, sizeof (accept), &acceptLength, sha1, sizeof (sha1));
+    accept [acceptLength] = 0;
+
+    c.__requestLine__ = strdup (c.__in__); // the buffer is reused for incoming frames, the handler gets the request header from here
+    if (!c.__requestLine__) {
+        __close__ (c);
+        return true;
+    }
+    char header [160];
+    snprintf (header, sizeof (header), "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", (char *) accept);
+    c.__append__ (header, strlen (header));
+    c.__inLength__ = 0;
+    c.__state__ = connection_t::WEBSOCKET;
+    c.__lastReceived__ = c.__lastTick__ = millis ();
+    return true;
+}
+
+void eventHttpServer_t::__readWebSocketFrames__ (connection_t& c) {
+    while (c.__state__ == connection_t::WEBSOCKET && c.__inLength__ >= 2) {
+        uint8_t *in = (uint8_t *) c.__in__;
+        uint8_t opcode = in [0] & 0x0f;
+        size_t length = in [1] & 0x7f;
+        size_t offset = 2;
+        if (length == 126) {
+            if (c.__inLength__ < 4)
+                return;
+            length = (in [2] << 8) | in [3];
+            offset = 4;
+        } else if (length == 127) {
+            length = EVENT_HTTP_SERVER_REQUEST_SIZE; // too large anyway
+            offset = 10;
+        }
+        if (!(in [1] & 0x80) || !(in [0] & 0x80) || opcode == 0 || offset + 4 + length > EVENT_HTTP_SERVER_REQUEST_SIZE) { // unmasked, fragmented or too large frames are not supported
+            c.__appendFrame__ (8, "", 0);
+            c.__state__ = connection_t::SENDING;
+            return;
+        }
+        if (c.__inLength__ < offset + 4 + length)
+            return; // wait for the rest of the frame
+
+        uint8_t *mask = in + offset;
+        char *payload = (char *) in + offset + 4;
+        for (size_t i = 0; i < length; i++)
+            payload [i] ^= mask [i % 4];
+        char next = payload [length]; // terminate the payload for text messages, the next frame may already be there
+        payload [length] = 0;
+
+        switch (opcode) {
+            case 1: // text
+            case 2: // binary
+                        c.__messageCount__ ++;
+                        if (!__wsRequestHandler__ (c.__requestLine__, &c, payload, length)) {
+                            c.__appendFrame__ (8, "", 0);
+                            c.__state__ = connection_t::SENDING;
+                        }
+                        break;
+            case 8: // close
+                        c.__appendFrame__ (8, payload, length < 2 ? length : 2); // echo the status code
+                        c.__state__ = connection_t::SENDING;
+                        break;
+            case 9: // ping
+                        c.__appendFrame__ (10, payload, length);
+                        break;
+            default:    // pong
+                        break;
+        }
+
+        payload [length] = next;
+        size_t frameLength = offset + 4 + length;
+        memmove (c.__in__, c.__in__ + frameLength, c.__inLength__ - frameLength);
+        c.__inLength__ -= frameLength;
+    }
+}
+
+void eventHttpServer_t::__close__ (connection_t& c) {
+    shutdown (c.__socket__, SHUT_RDWR);
+    close (c.__socket__);
+    c.__socket__ = -1;
+    c.__free__ ();
+    c.__state__ = connection_t::FREE;
+    __connectionCount__ --;
+}
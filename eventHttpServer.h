@@ -0,0 +1,215 @@
+/*
+
+    eventHttpServer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Event-driven HTTP server: a single task serves all the connections with select () and non-blocking sockets.
+
+    httpServer_t creates a task (with its own stack) for each connection, which limits the number of concurrent
+    clients on boards with little RAM, like ESP32-S2. eventHttpServer_t keeps only a small state for each
+    connection and runs it through a state machine:
+
+        reading request -> calling httpRequestHandler -> sending reply (from the buffer or from the file) -> closed
+                                                                                                         -> reading request (keep-alive)
+                                                      -> WebSocket (frames in, wsHandler called, frames out) -> closed
+
+    The same httpRequestHandlerCallback can be used with both servers if it is written as a template over the
+    connection type. The replies are collected in a buffer and sent when the socket is ready, so the handlers
+    must not block. WebSocket handlers are cooperative: instead of running a loop for the whole session, the
+    wsHandler is called each time a message arrives and every EVENT_HTTP_SERVER_WS_TICK ms with message = NULL,
+    and returns false to close the WebSocket.
+
+    HTTP/1.1 connections are kept alive (HTTP/1.0 ones if they ask for it) so that a page that polls the server,
+    like index.html, reuses one connection instead of opening a new one for each request. Requests that the client
+    sends before the previous reply arrives (pipelining) wait in the input buffer and are handled in order. The
+    connection is closed after the reply if the client asks for it, if the request has a body, if the reply has
+    no Content-Length (so its end is marked by closing), after EVENT_HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS requests
+    or after EVENT_HTTP_SERVER_KEEP_ALIVE_TIMEOUT ms without a new request. When all the slots are used, the
+    connection that has been idle the longest is closed to make room for a new one.
+
+    The number of connections is also limited by lwIP's CONFIG_LWIP_MAX_SOCKETS, which is shared with the
+    other servers, so EVENT_HTTP_SERVER_MAX_CONNECTIONS follows it. If accept () still fails for lack of a free
+    socket (FTP and Telnet sessions use them too), the longest idle connection is closed, or, if there is none, new
+    connections wait in the backlog for EVENT_HTTP_SERVER_ACCEPT_BACKOFF ms.
+
+    The server listens on IPv6 and IPv4 through one dual-stack socket, or on IPv4 only if lwIP is built without
+    IPv6. IPv4 clients are passed to firewallCallback and getClientIP () as a.b.c.d, not as ::ffff:a.b.c.d.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __EVENT_HTTP_SERVER_H__
+    #define __EVENT_HTTP_SERVER_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <threadSafeFS.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+
+
+    // TUNING PARAMETERS
+    #ifdef CONFIG_LWIP_MAX_SOCKETS
+        #define EVENT_HTTP_SERVER_MAX_CONNECTIONS (CONFIG_LWIP_MAX_SOCKETS - 4) // lwIP's sockets minus the listening sockets of HTTP, FTP and Telnet servers and one UDP socket (NTP, syslog)
+    #else
+        #define EVENT_HTTP_SERVER_MAX_CONNECTIONS 12
+    #endif
+    #define EVENT_HTTP_SERVER_ACCEPT_BACKOFF 100        // ms, how long new connections wait in the backlog after accept () has failed for lack of sockets
+    #define EVENT_HTTP_SERVER_REQUEST_SIZE 1536         // bytes, the largest HTTP request header (or WebSocket message) that can be received
+    #define EVENT_HTTP_SERVER_MAX_REPLY_SIZE (32 * 1024) // bytes, how much a handler can put in the reply buffer
+    #define EVENT_HTTP_SERVER_FILE_CHUNK 1436           // bytes, files are read and sent in chunks of about one TCP segment
+    #define EVENT_HTTP_SERVER_TIMEOUT 5000              // ms, connections that do not make any progress are closed
+    #define EVENT_HTTP_SERVER_KEEP_ALIVE_TIMEOUT 10000  // ms, how long a kept-alive connection waits for the next request
+    #define EVENT_HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS 100 // requests served through one connection before it is closed
+    #define EVENT_HTTP_SERVER_WS_TICK 100               // ms, how often wsHandler is called if there are no messages
+    #define EVENT_HTTP_SERVER_STACK_SIZE (8 * 1024)     // the handlers run in this task
+    #define EVENT_HTTP_SERVER_PRIORITY 1
+
+
+    // httpRequestHandler returns this when the reply has already been put into the buffer (the same as HTTP_REPLY_ALREADY_SENT)
+    #define EVENT_HTTP_REPLY_ALREADY_SENT "\r"
+
+
+    class eventHttpServer_t {
+
+        public:
+
+            class connection_t {
+
+                friend class eventHttpServer_t;
+
+                public:
+
+                    // the same interface as httpServer_t::httpConnection_t, as far as the handlers in this project use it
+
+                    inline int getSocket () __attribute__((always_inline)) { return __socket__; }
+
+                    // puts the data into the reply buffer (or into a WebSocket binary frame), returns the number of bytes accepted or -1
+                    int sendBlock (const byte *buf, size_t len);
+
+                    // puts the text into the reply buffer (or into a WebSocket text frame)
+                    int sendString (const char *s);
+
+                    const char *getHttpRequestHeaderField (const char *fieldName);
+
+                    const char *getHttpRequestCookie (const char *cookieName);
+
+                    void setHttpReplyHeaderField (const char *fieldName, const char *fieldValue);
+
+                    void setHttpReplyCookie (const char *cookieName, const char *cookieValue, time_t expires = 0);
+
+                    void setHttpReplyStatus (const char *status);
+
+                    inline const char *cipherName () __attribute__((always_inline)) { return ""; } // no TLS
+
+                    inline const char *getClientIP () __attribute__((always_inline)) { return __clientIP__; }
+
+                    // called by httpReplyStream_t::end (): the whole reply is in the buffer
+                    inline void replyComplete () __attribute__((always_inline)) { __replySent__ = true; }
+
+                    // true if the connection stays open for the next request after this reply, the reply must then have Content-Length
+                    inline bool keepAlive () __attribute__((always_inline)) { return __keepAlive__; }
+
+                    // ms since the last WebSocket message has arrived
+                    inline unsigned long idleTime () __attribute__((always_inline)) { return millis () - __lastReceived__; }
+
+                    // number of WebSocket messages received so far, including the one being handled
+                    inline unsigned long messageCount () __attribute__((always_inline)) { return __messageCount__; }
+
+                private:
+
+                    enum state_t { FREE, READING_REQUEST, SENDING, SENDING_FILE, WEBSOCKET };
+
+                    state_t __state__ = FREE;
+                    int __socket__ = -1;
+                    char __clientIP__ [46] = "";
+                    unsigned long __lastActive__ = 0;       // for timeouts
+                    unsigned long __lastReceived__ = 0;
+                    unsigned long __lastTick__ = 0;
+                    unsigned long __messageCount__ = 0;
+                    unsigned long __requestCount__ = 0;     // requests served through this connection
+                    bool __keepAlive__ = false;
+
+                    char *__in__ = NULL;                    // request header or incoming WebSocket frames, EVENT_HTTP_SERVER_REQUEST_SIZE + 1 bytes
+                    size_t __inLength__ = 0;
+                    char *__requestLine__ = NULL;           // kept for WebSocket handler
+                    char __field__ [256];                   // the value returned by getHttpRequestHeaderField and getHttpRequestCookie
+
+                    char *__out__ = NULL;                   // reply buffer
+                    size_t __outLength__ = 0;
+                    size_t __outCapacity__ = 0;
+                    size_t __outSent__ = 0;
+
+                    String __replyStatus__;
+                    String __replyHeaderFields__;
+                    bool __replySent__ = false;
+                    threadSafeFS::File __file__;
+
+                    bool __append__ (const void *buf, size_t len);
+                    bool __appendFrame__ (uint8_t opcode, const void *buf, size_t len);
+                    void __free__ ();
+                    bool __replyAllowsKeepAlive__ ();
+
+                    inline const char *__connectionField__ () __attribute__((always_inline)) { return __keepAlive__ ? "Connection: keep-alive\r\n" : "Connection: close\r\n"; }
+
+                    // waiting for the next request on a kept-alive connection
+                    inline bool __idle__ () __attribute__((always_inline)) { return __state__ == READING_REQUEST && __requestCount__ && !__inLength__; }
+            };
+
+            typedef String (*httpHandler_t) (const char *httpRequest, connection_t *hcn);
+
+            // called with the next message or with message = NULL every EVENT_HTTP_SERVER_WS_TICK ms, returns false to close the WebSocket
+            typedef bool (*wsHandler_t) (const char *httpRequest, connection_t *webSck, const char *message, size_t messageLength);
+
+            eventHttpServer_t (threadSafeFS::FS& fileSystem,
+                               httpHandler_t httpRequestHandler = NULL,
+                               wsHandler_t wsRequestHandler = NULL,
+                               int serverPort = 80,
+                               bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                               bool runInItsOwnTask = true);
+
+            ~eventHttpServer_t ();
+
+            inline operator bool () __attribute__((always_inline)) { return __listeningSocket__ >= 0; }
+
+            // serves all the connections that are ready, waits at most timeout ms for them, call it from loop () if the server does not run in its own task
+            void accept (unsigned long timeout = 0);
+
+            inline int connectionCount () __attribute__((always_inline)) { return __connectionCount__; }
+
+            inline uint32_t connectionsAccepted () __attribute__((always_inline)) { return __connectionsAccepted__; }
+
+            inline uint32_t requestsHandled () __attribute__((always_inline)) { return __requestsHandled__; }
+
+        private:
+
+            threadSafeFS::FS& __fileSystem__;
+            httpHandler_t __httpRequestHandler__;
+            wsHandler_t __wsRequestHandler__;
+            bool (*__firewallCallback__) (char *clientIP, char *serverIP);
+            int __listeningSocket__ = -1;
+            TaskHandle_t __task__ = NULL;
+            connection_t __connections__ [EVENT_HTTP_SERVER_MAX_CONNECTIONS];
+            int __connectionCount__ = 0;
+            unsigned long __acceptFailed__ = 0;             // millis () when accept () last failed for lack of sockets, 0 if it didn't
+            std::atomic<uint32_t> __connectionsAccepted__ = {};
+            std::atomic<uint32_t> __requestsHandled__ = {};
+
+            static void __taskFunction__ (void *server);
+            void __accept__ ();
+            bool __closeLongestIdle__ ();
+            void __read__ (connection_t& c);
+            void __write__ (connection_t& c);
+            void __handleRequest__ (connection_t& c);
+            void __endOfReply__ (connection_t& c);
+            bool __startWebSocket__ (connection_t& c);
+            void __readWebSocketFrames__ (connection_t& c);
+            void __sendFile__ (connection_t& c, const char *httpRequest);
+            void __close__ (connection_t& c);
+    };
+
+#endif
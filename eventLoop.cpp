@@ -0,0 +1,185 @@
+/*
+
+    eventLoop.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Runs loop () in a single select () over the listening sockets of the servers hosted in loop () and the earliest timer.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "eventLoop.h"
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef LWIP_SOCKET_OFFSET // host builds
+    #define LWIP_SOCKET_OFFSET 0
+#endif
+#ifndef CONFIG_LWIP_MAX_SOCKETS
+    #define CONFIG_LWIP_MAX_SOCKETS 64
+#endif
+
+
+bool eventLoop_t::addListener (uint16_t port, void (*accept) ()) {
+    if (__listenerCount__ == EVENT_LOOP_MAX_LISTENERS || !accept)
+        return false;
+    __listener__& l = __listeners__ [__listenerCount__ ++];
+    l.port = port;
+    l.socket = listeningSocket (port);
+    l.accept = accept;
+    l.lastPoll = millis ();
+    return l.socket >= 0;
+}
+
+bool eventLoop_t::addTimer (unsigned long (*onDeadline) ()) {
+    if (__timerCount__ == EVENT_LOOP_MAX_TIMERS || !onDeadline)
+        return false;
+    __timers__ [__timerCount__].onDeadline = onDeadline;
+    __timers__ [__timerCount__].due = millis ();
+    __timerCount__ ++;
+    return true;
+}
+
+int eventLoop_t::listeningSocket (uint16_t port) {
+    for (int s = LWIP_SOCKET_OFFSET; s < LWIP_SOCKET_OFFSET + CONFIG_LWIP_MAX_SOCKETS; s++) {
+        int listening = 0;
+        socklen_t length = sizeof (listening);
+        if (getsockopt (s, SOL_SOCKET, SO_ACCEPTCONN, &listening, &length) != 0 || !listening)
+            continue;
+        struct sockaddr_storage address; // the servers listen on IPv4 or dual-stack IPv6 sockets
+        length = sizeof (address);
+        if (getsockname (s, (struct sockaddr *) &address, &length) != 0)
+            continue;
+        if (address.ss_family == AF_INET && ntohs (((struct sockaddr_in *) &address)->sin_port) == port)
+            return s;
+        if (address.ss_family == AF_INET6 && ntohs (((struct sockaddr_in6 *) &address)->sin6_port) == port)
+            return s;
+    }
+    return -1;
+}
+
+void eventLoop_t::run (unsigned long maxWait) {
+    // how long to wait
+    unsigned long now = millis ();
+    unsigned long timeout = maxWait;
+    for (int i = 0; i < __timerCount__; i++) {
+        long left = (long) (__timers__ [i].due - now);
+        if (left <= 0)
+            timeout = 0;
+        else if ((unsigned long) left < timeout)
+            timeout = left;
+    }
+
+    fd_set readSet;
+    FD_ZERO (&readSet);
+    int maxSocket = -1;
+    for (int i = 0; i < __listenerCount__; i++) {
+        if (__listeners__ [i].socket >= 0) {
+            FD_SET (__listeners__ [i].socket, &readSet);
+            if (__listeners__ [i].socket > maxSocket)
+                maxSocket = __listeners__ [i].socket;
+        } else if (timeout > EVENT_LOOP_POLL_INTERVAL) {
+            timeout = EVENT_LOOP_POLL_INTERVAL;
+        }
+    }
+
+    // wait
+    int64_t selectEntry = esp_timer_get_time ();
+    int ready = 0;
+    if (maxSocket >= 0) {
+        struct timeval tv = { (time_t) (timeout / 1000), (suseconds_t) (timeout % 1000 * 1000) };
+        ready = select (maxSocket + 1, &readSet, NULL, NULL, &tv);
+    } else if (timeout) {
+        vTaskDelay (pdMS_TO_TICKS (timeout));
+    }
+    if (ready < 0) {
+        // probably a closed listening socket, find the sockets again (a restarted server may have got another one)
+        bool changed = false;
+        for (int i = 0; i < __listenerCount__; i++) {
+            if (__listeners__ [i].socket >= 0) {
+                int s = listeningSocket (__listeners__ [i].port);
+                changed |= s != __listeners__ [i].socket;
+                __listeners__ [i].socket = s;
+            }
+        }
+        if (!changed) // select () fails for some other reason, don't spin
+            vTaskDelay (pdMS_TO_TICKS (EVENT_LOOP_POLL_INTERVAL));
+    }
+    int64_t selectExit = esp_timer_get_time ();
+    __idle__ += selectExit - selectEntry;
+
+    // accept the waiting connections
+    if (ready > 0) {
+        // if select returned at once the connection may have been waiting since the previous select returned
+        int64_t waitingSince = selectExit - selectEntry < 1000 && __lastSelectExit__ ? __lastSelectExit__ : selectExit;
+        for (int i = 0; i < __listenerCount__; i++) {
+            if (__listeners__ [i].socket >= 0 && FD_ISSET (__listeners__ [i].socket, &readSet)) {
+                __listeners__ [i].accept ();
+                int64_t latency = esp_timer_get_time () - waitingSince;
+                __latencySum__ += latency;
+                if (latency > __latencyMax__)
+                    __latencyMax__ = latency;
+                __latencyCount__ ++;
+                __accepted__ ++;
+            }
+        }
+    }
+
+    // poll the listeners whose sockets were not found
+    now = millis ();
+    for (int i = 0; i < __listenerCount__; i++) {
+        if (__listeners__ [i].socket < 0 && now - __listeners__ [i].lastPoll >= EVENT_LOOP_POLL_INTERVAL) {
+            __listeners__ [i].lastPoll = now;
+            __listeners__ [i].accept ();
+        }
+    }
+
+    // call the timers that are due
+    for (int i = 0; i < __timerCount__; i++) {
+        if ((long) (__timers__ [i].due - now) <= 0) {
+            unsigned long next = __timers__ [i].onDeadline ();
+            now = millis ();
+            __timers__ [i].due = now + next;
+        }
+    }
+
+    __lastSelectExit__ = selectExit;
+    __updateStatistics__ (esp_timer_get_time ());
+}
+
+void eventLoop_t::__updateStatistics__ (int64_t now) {
+    if (!__windowStart__) {
+        __windowStart__ = now;
+        return;
+    }
+    int64_t window = now - __windowStart__;
+    if (window < EVENT_LOOP_STATISTICS_WINDOW * 1000LL)
+        return;
+
+    __idlePercent__ = 100.0 * __idle__ / window;
+    __acceptLatencyAverage__ = __latencyCount__ ? __latencySum__ / 1000.0 / __latencyCount__ : NAN;
+    __acceptLatencyMax__ = __latencyCount__ ? __latencyMax__ / 1000.0 : NAN;
+
+    __windowStart__ = now;
+    __idle__ = __latencySum__ = __latencyMax__ = 0;
+    __latencyCount__ = 0;
+}
+
+String eventLoop_t::toText () {
+    char s [256];
+    int l = snprintf (s, sizeof (s), "idle:                    %.1f %%\r\n"
+                                     "accept latency:          %.2f ms average, %.2f ms max\r\n"
+                                     "connections accepted:    %lu\r\n"
+                                     "listeners:              ",
+                                     __idlePercent__, __acceptLatencyAverage__, __acceptLatencyMax__, (unsigned long) __accepted__);
+    for (int i = 0; i < __listenerCount__ && l < (int) sizeof (s); i++)
+        l += snprintf (s + l, sizeof (s) - l, " %u%s", __listeners__ [i].port, __listeners__ [i].socket >= 0 ? "" : " (polled)");
+    return s;
+}
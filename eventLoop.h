@@ -0,0 +1,108 @@
+/*
+
+    eventLoop.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Runs loop () in a single select () over the listening sockets of the servers hosted in loop () and the earliest timer.
+
+    Instead of calling ftpServer->accept (), telnetServer->accept (), cronScheduler.run (), ... one after another on
+    each pass of loop (), each of them is registered once, and run () sleeps until there is something to do:
+
+        eventLoop.addListener (21, [] () { ftpServer->accept (); });                  // called when a connection is waiting
+        eventLoop.addTimer ([] () -> unsigned long { return cronScheduler.run (); });  // returns ms until the next call
+        ...
+        void loop () { eventLoop.run (); }
+
+    The listening sockets are found by their local port, since the servers don't expose them. If a listener is not found
+    its callback is called every EVENT_LOOP_POLL_INTERVAL ms instead. If select () fails, because a server has closed its
+    listening socket (when it is stopped or restarted), the sockets are looked up again and the listeners whose sockets are
+    gone are polled.
+
+    The time spent in select () is the idle time. The accept latency is measured from when select () reported a waiting
+    connection until the callback returns. If select () returned at once, the connection may have been waiting since the
+    previous select () returned, so that time is included, which makes the latency an upper bound.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __EVENT_LOOP_H__
+    #define __EVENT_LOOP_H__
+
+    #include <Arduino.h>
+    #include <math.h>
+
+
+    // TUNING PARAMETERS
+    #define EVENT_LOOP_MAX_LISTENERS 4
+    #define EVENT_LOOP_MAX_TIMERS 8
+    #define EVENT_LOOP_MAX_WAIT 1000                // ms, the longest run () waits
+    #define EVENT_LOOP_POLL_INTERVAL 50             // ms, for the listeners whose socket is not found
+    #define EVENT_LOOP_STATISTICS_WINDOW 10000      // ms, idle percentage and accept latency are calculated over this window
+
+
+    class eventLoop_t {
+
+        public:
+
+            // calls accept when a connection is waiting on the listening socket on local port, returns false if the socket is not found (it is polled then)
+            bool addListener (uint16_t port, void (*accept) ());
+
+            // calls onDeadline at the next run () and then after as many ms as it returns each time
+            bool addTimer (unsigned long (*onDeadline) ());
+
+            // waits until a connection is waiting or the earliest timer is due (at most maxWait ms) and calls their callbacks
+            void run (unsigned long maxWait = EVENT_LOOP_MAX_WAIT);
+
+            // listening TCP socket (IPv4 or IPv6) on local port or -1
+            static int listeningSocket (uint16_t port);
+
+            // over the last EVENT_LOOP_STATISTICS_WINDOW
+            inline float idlePercent () __attribute__((always_inline)) { return __idlePercent__; }
+            inline float acceptLatencyAverage () __attribute__((always_inline)) { return __acceptLatencyAverage__; } // ms
+            inline float acceptLatencyMax () __attribute__((always_inline)) { return __acceptLatencyMax__; } // ms
+            inline uint32_t accepted () __attribute__((always_inline)) { return __accepted__; }
+
+            String toText ();
+
+        private:
+
+            struct __listener__ {
+                uint16_t port;
+                int socket;             // -1 if not found
+                void (*accept) ();
+                unsigned long lastPoll; // millis, when the socket is not found
+            };
+
+            struct __timer__ {
+                unsigned long (*onDeadline) ();
+                unsigned long due;      // millis
+            };
+
+            __listener__ __listeners__ [EVENT_LOOP_MAX_LISTENERS] = {};
+            int __listenerCount__ = 0;
+            __timer__ __timers__ [EVENT_LOOP_MAX_TIMERS] = {};
+            int __timerCount__ = 0;
+
+            int64_t __lastSelectExit__ = 0;     // us
+
+            // the current window
+            int64_t __windowStart__ = 0;        // us
+            int64_t __idle__ = 0;               // us
+            int64_t __latencySum__ = 0;         // us
+            int64_t __latencyMax__ = 0;         // us
+            uint32_t __latencyCount__ = 0;
+
+            // the last complete window
+            float __idlePercent__ = NAN;
+            float __acceptLatencyAverage__ = NAN;
+            float __acceptLatencyMax__ = NAN;
+            uint32_t __accepted__ = 0;
+
+            void __updateStatistics__ (int64_t now);
+    };
+
+#endif
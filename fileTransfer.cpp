@@ -0,0 +1,423 @@
+/*
+
+    fileTransfer.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Double-buffered streaming of large files between the file system and a socket, with throughput statistics.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "fileTransfer.h"
+#include <sys/socket.h>
+#include <sys/time.h>
+
+
+fileTransfer_t::fileTransfer_t () {
+    __semaphore__ = xSemaphoreCreateMutex ();
+    __freeBuffers__ = xSemaphoreCreateCounting (FILE_TRANSFER_MAX_TRANSFERS, FILE_TRANSFER_MAX_TRANSFERS);
+    __mergeSemaphore__ = xSemaphoreCreateMutex ();
+}
+
+// waits for a free pair of buffers and allocates it the first time, returns its index or -1
+int fileTransfer_t::__takeBuffers__ () {
+    if (xSemaphoreTake (__freeBuffers__, pdMS_TO_TICKS (FILE_TRANSFER_TIMEOUT)) != pdTRUE)
+        return -1;
+    int pair = -1;
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < FILE_TRANSFER_MAX_TRANSFERS && pair < 0; i++)
+            if (!__inUse__ [i]) {
+                for (int j = 0; j < 2; j++)
+                    if (!__buffers__ [i][j])
+                        __buffers__ [i][j] = (uint8_t *) heap_caps_aligned_alloc (4, FILE_TRANSFER_BUFFER_SIZE, MALLOC_CAP_8BIT);
+                if (__buffers__ [i][0] && __buffers__ [i][1]) {
+                    __inUse__ [i] = true;
+                    pair = i;
+                }
+                break; // if it couldn't be allocated now, the other pairs can't be either
+            }
+    xSemaphoreGive (__semaphore__);
+    if (pair < 0)
+        xSemaphoreGive (__freeBuffers__);
+    return pair;
+}
+
+void fileTransfer_t::__giveBuffers__ (int pair) {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __inUse__ [pair] = false;
+        if (pair >= 2) { // only keep the buffers that are needed most of the time
+            for (int j = 0; j < 2; j++) {
+                heap_caps_free (__buffers__ [pair][j]);
+                __buffers__ [pair][j] = NULL;
+            }
+        }
+    xSemaphoreGive (__semaphore__);
+    xSemaphoreGive (__freeBuffers__);
+}
+
+bool fileTransfer_t::__startJob__ (__job__& job, int pair, threadSafeFS::File& file, size_t length, TaskFunction_t helper) {
+    job.file = &file;
+    job.buffers [0] = __buffers__ [pair][0];
+    job.buffers [1] = __buffers__ [pair][1];
+    job.length = length;
+    job.abort = job.error = false;
+    job.full = xQueueCreate (3, sizeof (__item__));     // both buffers and the end of transfer, so sending to it never blocks
+    job.empty = xQueueCreate (2, sizeof (__item__));
+    job.done = xSemaphoreCreateBinary ();
+    if (job.full && job.empty && job.done) {
+        for (int8_t i = 0; i < 2; i++) {
+            __item__ item = { i, 0 };
+            xQueueSend (job.empty, &item, 0);
+        }
+        #if portNUM_PROCESSORS > 1
+            BaseType_t core = !xPortGetCoreID (); // the other core
+        #else
+            BaseType_t core = tskNO_AFFINITY;
+        #endif
+        if (xTaskCreatePinnedToCore (helper, "fileTransfer", FILE_TRANSFER_STACK_SIZE, &job, FILE_TRANSFER_PRIORITY, NULL, core) == pdPASS)
+            return true;
+    }
+    if (job.full) vQueueDelete (job.full);
+    if (job.empty) vQueueDelete (job.empty);
+    if (job.done) vSemaphoreDelete (job.done);
+    return false;
+}
+
+// stops the helper task if it is still running and waits until it does
+void fileTransfer_t::__endJob__ (__job__& job) {
+    job.abort = true;
+    xSemaphoreTake (job.done, portMAX_DELAY);
+    vQueueDelete (job.full);
+    vQueueDelete (job.empty);
+    vSemaphoreDelete (job.done);
+}
+
+// helper task for sendFile: reads the file into empty buffers and passes them to the caller
+void fileTransfer_t::__readerTask__ (void *p) {
+    __job__ *job = (__job__ *) p;
+    size_t remaining = job->length;
+    __item__ item;
+    while (remaining && !job->abort) {
+        if (xQueueReceive (job->empty, &item, pdMS_TO_TICKS (100)) != pdTRUE)
+            continue; // check abort every 100 ms
+        size_t n = remaining < FILE_TRANSFER_BUFFER_SIZE ? remaining : FILE_TRANSFER_BUFFER_SIZE;
+        item.length = job->file->read (job->buffers [item.buffer], n);
+        if (item.length <= 0) {
+            job->error = true;
+            break;
+        }
+        remaining -= item.length;
+        xQueueSend (job->full, &item, portMAX_DELAY);
+    }
+    item = { -1, 0 };
+    xQueueSend (job->full, &item, portMAX_DELAY);
+    xSemaphoreGive (job->done);
+    vTaskDelete (NULL);
+}
+
+// helper task for receiveFile: writes full buffers to the file and returns them to the caller
+void fileTransfer_t::__writerTask__ (void *p) {
+    __job__ *job = (__job__ *) p;
+    __item__ item;
+    while (true) {
+        if (xQueueReceive (job->full, &item, pdMS_TO_TICKS (100)) != pdTRUE) {
+            if (job->abort)
+                break;
+            continue;
+        }
+        if (item.length == 0)
+            break;
+        if (!job->error && job->file->write (job->buffers [item.buffer], item.length) != (size_t) item.length)
+            job->error = true;
+        xQueueSend (job->empty, &item, portMAX_DELAY);
+    }
+    xSemaphoreGive (job->done);
+    vTaskDelete (NULL);
+}
+
+long fileTransfer_t::sendFile (threadSafeFS::File& file, int socket, size_t length, const char *name) {
+    unsigned long start = millis ();
+    struct timeval tout = { FILE_TRANSFER_TIMEOUT / 1000, (FILE_TRANSFER_TIMEOUT % 1000) * 1000 };
+    setsockopt (socket, SOL_SOCKET, SO_SNDTIMEO, &tout, sizeof (tout));
+    int pair = __takeBuffers__ ();
+    if (pair < 0)
+        return -1;
+    __job__ job;
+    if (!__startJob__ (job, pair, file, length, __readerTask__)) {
+        __giveBuffers__ (pair);
+        return -1;
+    }
+
+    // send the buffers while the reader fills the other one
+    size_t sent = 0;
+    __item__ item;
+    while (!job.error) {
+        if (xQueueReceive (job.full, &item, pdMS_TO_TICKS (FILE_TRANSFER_TIMEOUT)) != pdTRUE) {
+            job.error = true;
+            break;
+        }
+        if (item.length == 0)
+            break;
+        for (int32_t i = 0; i < item.length && !job.error; ) {
+            int s = send (socket, job.buffers [item.buffer] + i, item.length - i, 0);
+            if (s <= 0)
+                job.error = true;
+            else
+                i += s;
+        }
+        if (!job.error) {
+            sent += item.length;
+            __bytesSent__ += item.length;
+        }
+        xQueueSend (job.empty, &item, 0);
+    }
+
+    __endJob__ (job);
+    __giveBuffers__ (pair);
+    bool success = !job.error && sent == length;
+    __addToHistory__ (name, false, success, sent, millis () - start);
+    return success ? (long) sent : -1;
+}
+
+long fileTransfer_t::receiveFile (int socket, threadSafeFS::File& file, size_t length, const char *name) {
+    unsigned long start = millis ();
+    struct timeval tout = { FILE_TRANSFER_TIMEOUT / 1000, (FILE_TRANSFER_TIMEOUT % 1000) * 1000 };
+    setsockopt (socket, SOL_SOCKET, SO_RCVTIMEO, &tout, sizeof (tout));
+    int pair = __takeBuffers__ ();
+    if (pair < 0)
+        return -1;
+    __job__ job;
+    if (!__startJob__ (job, pair, file, length, __writerTask__)) {
+        __giveBuffers__ (pair);
+        return -1;
+    }
+
+    // fill the buffers while the writer writes the other one
+    size_t received = 0;
+    __item__ item;
+    while (received < length && !job.error) {
+        if (xQueueReceive (job.empty, &item, pdMS_TO_TICKS (FILE_TRANSFER_TIMEOUT)) != pdTRUE) {
+            job.error = true;
+            break;
+        }
+        size_t n = length - received < FILE_TRANSFER_BUFFER_SIZE ? length - received : FILE_TRANSFER_BUFFER_SIZE;
+        size_t got = 0;
+        while (got < n) {
+            int r = recv (socket, job.buffers [item.buffer] + got, n - got, 0);
+            if (r <= 0)
+                break;
+            got += r;
+        }
+        if (got < n) {
+            job.error = true;
+            break;
+        }
+        item.length = n;
+        xQueueSend (job.full, &item, portMAX_DELAY);
+        received += n;
+        __bytesReceived__ += n;
+    }
+    item = { -1, 0 };
+    xQueueSend (job.full, &item, portMAX_DELAY);
+
+    __endJob__ (job);
+    __giveBuffers__ (pair);
+    bool success = !job.error && received == length;
+    __addToHistory__ (name, true, success, received, millis () - start);
+    return success ? (long) received : -1;
+}
+
+long fileTransfer_t::receivePart (int socket, threadSafeFS::FS& fileSystem, const char *path, size_t offset, size_t length, size_t total) {
+    if (offset + length > total || !canReceivePart (fileSystem, path, offset))
+        return -1;
+    char partName [300];
+    char tmpName [305];
+    snprintf (partName, sizeof (partName), "%s.part.%u", path, (unsigned) offset);
+    snprintf (tmpName, sizeof (tmpName), "%s.tmp", partName);
+
+    threadSafeFS::File f = fileSystem.open (tmpName, "w");
+    if (!f)
+        return -1;
+    long received = receiveFile (socket, f, length, path);
+    size_t written = f.position ();
+    f.close ();
+
+    // keep what has been written, unless an earlier attempt of the same part got further or other connections have filled the parts meanwhile
+    xSemaphoreTake (__mergeSemaphore__, portMAX_DELAY);
+        size_t earlier = 0;
+        threadSafeFS::File e = fileSystem.open (partName, "r");
+        bool exists = e;
+        if (exists) {
+            earlier = e.size ();
+            e.close ();
+        }
+        if (written > earlier && (exists || canReceivePart (fileSystem, path, offset))) {
+            fileSystem.remove (partName);
+            fileSystem.rename (tmpName, partName);
+        } else {
+            fileSystem.remove (tmpName);
+            if (!exists)
+                received = -1; // FILE_TRANSFER_MAX_PARTS reached while receiving
+        }
+    xSemaphoreGive (__mergeSemaphore__);
+
+    if (received >= 0)
+        __mergeParts__ (fileSystem, path, total);
+    return received;
+}
+
+bool fileTransfer_t::canReceivePart (threadSafeFS::FS& fileSystem, const char *path, size_t offset) {
+    __part__ parts [FILE_TRANSFER_MAX_PARTS];
+    int n = __listParts__ (fileSystem, path, parts);
+    if (n >= 0 && n < FILE_TRANSFER_MAX_PARTS)
+        return true;
+    for (int i = 0; i < n; i++)
+        if (parts [i].offset == offset)
+            return true;
+    return false;
+}
+
+String fileTransfer_t::receivedParts (threadSafeFS::FS& fileSystem, const char *path) {
+    __part__ parts [FILE_TRANSFER_MAX_PARTS];
+    int n = __listParts__ (fileSystem, path, parts);
+    String s;
+    for (int i = 0; i < n; i++)
+        if (parts [i].size) {
+            char range [24];
+            snprintf (range, sizeof (range), "%s%u-%u", s.length () ? "," : "", (unsigned) parts [i].offset, (unsigned) (parts [i].offset + parts [i].size - 1));
+            s += range;
+        }
+    return s;
+}
+
+// finds path.part.<offset> files and returns their number, sorted by offset, or -1 if there are more than FILE_TRANSFER_MAX_PARTS
+int fileTransfer_t::__listParts__ (threadSafeFS::FS& fileSystem, const char *path, __part__ parts []) {
+    const char *slash = strrchr (path, '/');
+    if (!slash)
+        return 0;
+    char directory [256];
+    size_t l = slash == path ? 1 : slash - path;
+    if (l >= sizeof (directory))
+        return 0;
+    memcpy (directory, path, l);
+    directory [l] = 0;
+    const char *base = slash + 1;
+    size_t baseLength = strlen (base);
+
+    int n = 0;
+    threadSafeFS::File d = fileSystem.open (directory, "r");
+    if (!d || !d.isDirectory ())
+        return 0;
+    for (threadSafeFS::File f = d.openNextFile (); f; f = d.openNextFile ()) {
+        const char *name = f.name ();
+        const char *s = strrchr (name, '/');
+        if (s)
+            name = s + 1;
+        unsigned offset;
+        int end = 0;
+        if (!strncmp (name, base, baseLength) && !strncmp (name + baseLength, ".part.", 6) && sscanf (name + baseLength + 6, "%u%n", &offset, &end) == 1 && !name [baseLength + 6 + end]) {
+            if (n == FILE_TRANSFER_MAX_PARTS) {
+                f.close ();
+                n = -1;
+                break;
+            }
+            int i = n++;
+            for (; i > 0 && parts [i - 1].offset > offset; i--) // insertion sort
+                parts [i] = parts [i - 1];
+            parts [i] = { offset, f.size () };
+        }
+        f.close ();
+    }
+    d.close ();
+    return n;
+}
+
+// if the parts cover the whole file, copies them into path.tmp, replaces path with it and deletes them, path stays as it was if the merge fails
+bool fileTransfer_t::__mergeParts__ (threadSafeFS::FS& fileSystem, const char *path, size_t total) {
+    bool merged = false;
+    xSemaphoreTake (__mergeSemaphore__, portMAX_DELAY);
+        __part__ parts [FILE_TRANSFER_MAX_PARTS];
+        int n = __listParts__ (fileSystem, path, parts);
+        size_t covered = 0;
+        for (int i = 0; i < n && parts [i].offset <= covered; i++)
+            if (parts [i].offset + parts [i].size > covered)
+                covered = parts [i].offset + parts [i].size;
+
+        uint8_t *buf;
+        if (n > 0 && covered >= total && (buf = (uint8_t *) malloc (FILE_TRANSFER_BUFFER_SIZE))) {
+            char partName [300];
+            char tmpName [305];
+            snprintf (tmpName, sizeof (tmpName), "%s.tmp", path);
+            threadSafeFS::File out = fileSystem.open (tmpName, "w");
+            merged = out;
+            covered = 0;
+            for (int i = 0; i < n && covered < total && merged; i++) {
+                size_t end = parts [i].offset + parts [i].size < total ? parts [i].offset + parts [i].size : total;
+                if (end <= covered)
+                    continue; // overlapped by the previous parts
+                snprintf (partName, sizeof (partName), "%s.part.%u", path, (unsigned) parts [i].offset);
+                threadSafeFS::File in = fileSystem.open (partName, "r");
+                merged = in && in.seek (covered - parts [i].offset);
+                while (merged && covered < end) {
+                    size_t toRead = end - covered < FILE_TRANSFER_BUFFER_SIZE ? end - covered : FILE_TRANSFER_BUFFER_SIZE;
+                    size_t r = in.read (buf, toRead);
+                    merged = r && out.write (buf, r) == r;
+                    covered += r;
+                }
+                if (in)
+                    in.close ();
+            }
+            if (out)
+                out.close ();
+            free (buf);
+
+            if (merged && !fileSystem.rename (tmpName, path)) { // LittleFS replaces the old file atomically, the other file systems need it removed first
+                fileSystem.remove (path);
+                merged = fileSystem.rename (tmpName, path);
+            }
+            if (merged) {
+                for (int i = 0; i < n; i++) {
+                    snprintf (partName, sizeof (partName), "%s.part.%u", path, (unsigned) parts [i].offset);
+                    fileSystem.remove (partName);
+                }
+            } else {
+                fileSystem.remove (tmpName); // the parts are still there, the merge will be attempted again after the next part
+            }
+        }
+    xSemaphoreGive (__mergeSemaphore__);
+    return merged;
+}
+
+void fileTransfer_t::__addToHistory__ (const char *name, bool upload, bool success, size_t bytes, unsigned long milliseconds) {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __newest__ = (__newest__ + 1) % FILE_TRANSFER_HISTORY;
+        __record__& r = __history__ [__newest__];
+        size_t l = strlen (name);
+        strcpy (r.name, l < sizeof (r.name) ? name : name + l - sizeof (r.name) + 1); // keep the end of long paths
+        r.upload = upload;
+        r.success = success;
+        r.bytes = bytes;
+        r.milliseconds = milliseconds;
+        if (__historyCount__ < FILE_TRANSFER_HISTORY)
+            __historyCount__ ++;
+    xSemaphoreGive (__semaphore__);
+}
+
+String fileTransfer_t::toText () {
+    char buf [120];
+    snprintf (buf, sizeof (buf), "file transfers: 2 x %i B buffers each, sent %llu B, received %llu B", FILE_TRANSFER_BUFFER_SIZE,
+                                 (unsigned long long) __bytesSent__, (unsigned long long) __bytesReceived__);
+    String s = buf;
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < __historyCount__; i++) {
+            __record__& r = __history__ [(__newest__ - i + FILE_TRANSFER_HISTORY) % FILE_TRANSFER_HISTORY];
+            snprintf (buf, sizeof (buf), "\r\n  %-39s %-8s %9u B %7lu ms %7.2f MB/s%s", r.name, r.upload ? "upload" : "download", (unsigned) r.bytes, r.milliseconds,
+                                         r.milliseconds ? r.bytes / 1048.576 / r.milliseconds : 0.0, r.success ? "" : " failed");
+            s += buf;
+        }
+    xSemaphoreGive (__semaphore__);
+    return s;
+}
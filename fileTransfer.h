@@ -0,0 +1,136 @@
+/*
+
+    fileTransfer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Double-buffered streaming of large files between the file system and a socket, with throughput statistics.
+
+    Sending a file one small chunk at a time waits for the flash while the socket is idle and for the socket while
+    the flash is idle. fileTransfer_t uses two large, word-aligned buffers (multiples of the LittleFS block size
+    and larger than the TCP window) and a helper task on the other core: while the caller sends one buffer to the
+    socket, the helper reads the next one from the file (or, when receiving, writes the previous one to the file
+    while the caller receives the next). The buffers are allocated at the first transfer and reused afterwards.
+
+    Interrupted transfers can be resumed and large files can be uploaded through several connections at once:
+    each part (byte range) of the file is received into its own <path>.part.<offset> file, which is renamed from
+    .tmp only when the connection ends, so it always holds complete data. When the parts cover the whole file
+    they are merged into <path>.tmp, which replaces <path> only if the merge succeeds, and deleted.
+    receivedParts () tells the client which ranges it doesn't have to send again. A file can have at most FILE_TRANSFER_MAX_PARTS parts at a time, a new part beyond that is refused
+    (the client can still resend the parts that already exist, or send the missing ranges in larger parts).
+
+    The caller's socket must be blocking, so this is used by the handlers of httpServer_t (GET /download/... and
+    PUT /upload/...), not by eventHttpServer_t.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __FILE_TRANSFER_H__
+    #define __FILE_TRANSFER_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <threadSafeFS.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include <freertos/queue.h>
+    #include <freertos/semphr.h>
+
+
+    // TUNING PARAMETERS
+    #define FILE_TRANSFER_BUFFER_SIZE (8 * 1024)    // bytes, a multiple of LittleFS block size (4 KB) and larger than the TCP send window
+    #define FILE_TRANSFER_MAX_TRANSFERS 4           // concurrent transfers, each one needs 2 buffers, only the first 2 stay allocated, the others wait
+    #define FILE_TRANSFER_MAX_PARTS 32              // parts of one file that can be merged
+    #define FILE_TRANSFER_TIMEOUT 5000              // ms, socket and helper task timeout
+    #define FILE_TRANSFER_STACK_SIZE (3 * 1024)     // helper task stack
+    #define FILE_TRANSFER_PRIORITY 2                // helper task priority
+    #define FILE_TRANSFER_HISTORY 8                 // number of the last transfers shown by transfers Telnet command
+
+
+    class fileTransfer_t {
+
+        public:
+
+            fileTransfer_t ();
+
+            // sends length bytes from the current position of file to the socket, returns the number of bytes sent or -1 on error
+            long sendFile (threadSafeFS::File& file, int socket, size_t length, const char *name);
+
+            // receives length bytes from the socket and writes them at the current position of file, returns the number of bytes written or -1 on error
+            long receiveFile (int socket, threadSafeFS::File& file, size_t length, const char *name);
+
+            // receives bytes offset .. offset + length - 1 of the file that is total bytes long, returns the number of bytes received or -1 on error,
+            // the bytes received before the error are kept, when all the parts have been received they are merged into path
+            long receivePart (int socket, threadSafeFS::FS& fileSystem, const char *path, size_t offset, size_t length, size_t total);
+
+            // false if path already has FILE_TRANSFER_MAX_PARTS parts and none of them starts at offset
+            bool canReceivePart (threadSafeFS::FS& fileSystem, const char *path, size_t offset);
+
+            // the ranges already received, like "0-1048575,2097152-2359295"
+            String receivedParts (threadSafeFS::FS& fileSystem, const char *path);
+
+            inline uint64_t bytesSent () __attribute__((always_inline)) { return __bytesSent__; }
+            inline uint64_t bytesReceived () __attribute__((always_inline)) { return __bytesReceived__; }
+
+            String toText ();
+
+        private:
+
+            struct __item__ {
+                int8_t buffer;      // index into __job__::buffers
+                int32_t length;     // 0 = end of transfer
+            };
+
+            // shared between the caller and the helper task
+            struct __job__ {
+                threadSafeFS::File *file;
+                uint8_t *buffers [2];
+                size_t length;
+                QueueHandle_t full;
+                QueueHandle_t empty;
+                SemaphoreHandle_t done;
+                volatile bool abort;
+                volatile bool error;
+            };
+
+            struct __part__ {
+                size_t offset;
+                size_t size;
+            };
+
+            struct __record__ {
+                char name [40];
+                bool upload;
+                bool success;
+                size_t bytes;
+                unsigned long milliseconds;
+            };
+
+            uint8_t *__buffers__ [FILE_TRANSFER_MAX_TRANSFERS][2] = {};
+            bool __inUse__ [FILE_TRANSFER_MAX_TRANSFERS] = {};
+            SemaphoreHandle_t __semaphore__ = NULL;         // protects __buffers__, __inUse__ and __history__
+            SemaphoreHandle_t __freeBuffers__ = NULL;       // counts free buffer pairs
+            SemaphoreHandle_t __mergeSemaphore__ = NULL;    // only one merge at a time
+
+            __record__ __history__ [FILE_TRANSFER_HISTORY] = {};
+            int __newest__ = -1;
+            int __historyCount__ = 0;
+            std::atomic<uint64_t> __bytesSent__ = {};
+            std::atomic<uint64_t> __bytesReceived__ = {};
+
+            int __takeBuffers__ ();
+            void __giveBuffers__ (int pair);
+            bool __startJob__ (__job__& job, int pair, threadSafeFS::File& file, size_t length, TaskFunction_t helper);
+            void __endJob__ (__job__& job);
+            void __addToHistory__ (const char *name, bool upload, bool success, size_t bytes, unsigned long milliseconds);
+            int __listParts__ (threadSafeFS::FS& fileSystem, const char *path, __part__ parts []);
+            bool __mergeParts__ (threadSafeFS::FS& fileSystem, const char *path, size_t total);
+
+            static void __readerTask__ (void *job);
+            static void __writerTask__ (void *job);
+    };
+
+#endif
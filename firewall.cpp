@@ -0,0 +1,285 @@
+/*
+
+    firewall.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Connection-level firewall: allow and deny CIDR rules in a binary prefix trie and per client IP token buckets in a bounded LRU table.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "firewall.h"
+#include <arpa/inet.h>
+
+
+firewall_t::firewall_t () {
+    __semaphore__ = xSemaphoreCreateMutex ();
+    __clear__ ();
+}
+
+firewall_t::~firewall_t () {
+    vSemaphoreDelete (__semaphore__);
+}
+
+void firewall_t::__clear__ () {
+    __ruleCount__ = 0;
+    __defaultAllow__ = true;
+    __nodes__ [0] = { { 0, 0 }, -1 };
+    __nodeCount__ = 1;
+    __bucketCount__ = 0;
+    __newest__ = __oldest__ = -1;
+    for (int i = 0; i < FIREWALL_RATE_TABLE; i++)
+        __hash__ [i] = -1;
+}
+
+bool firewall_t::begin (threadSafeFS::FS& fileSystem, const char *path) {
+    if (!fileSystem.isFile (path)) {
+        if (!fileSystem.isDirectory ("/etc"))
+            fileSystem.mkdir ("/etc");
+        threadSafeFS::File f = fileSystem.open (path, "w");
+        if (f) {
+            f.print ("# firewall - reboot for changes to take effect\r\n\r\n"
+                     "# allow or deny the connections from the addresses that no rule matches\r\n"
+                     "   default allow\r\n"
+                     "# allow or deny CIDR (IPv4 or IPv6), the longest matching prefix decides, for example:\r\n"
+                     "#  deny 10.0.0.0/8\r\n"
+                     "#  allow 10.18.1.0/24\r\n"
+                     "#  allow fe80::/10\r\n"
+                     "# connections per second and burst size for each client IP (rate 0 turns rate limiting off),\r\n"
+                     "# a client IP over the limit is refused, raise the limit for benchmarks or many clients behind one NAT address\r\n"
+                     "   rate 10\r\n"
+                     "   burst 40\r\n");
+            f.close ();
+        }
+    }
+
+    char *buffer = (char *) malloc (FIREWALL_MAX_RULES * 64 + 256);
+    if (!buffer)
+        return false;
+    bool read = fileSystem.readConfiguration (buffer, FIREWALL_MAX_RULES * 64 + 256 - 1, path);
+    bool valid = read;
+    if (read) {
+        xSemaphoreTake (__semaphore__, portMAX_DELAY);
+            __clear__ ();
+        xSemaphoreGive (__semaphore__);
+        float rate = FIREWALL_DEFAULT_RATE;
+        float burst = FIREWALL_DEFAULT_BURST;
+        char *last = NULL;
+        for (char *line = strtok_r (buffer, "\r\n", &last); line; line = strtok_r (NULL, "\r\n", &last)) {
+            char *comment = strchr (line, '#');
+            if (comment)
+                *comment = 0;
+            char keyword [8], value [64];
+            if (sscanf (line, " %7s %63s", keyword, value) != 2)
+                continue;
+            bool ok = true;
+            if (!strcmp (keyword, "default"))     setDefaultPolicy (strcmp (value, "deny") != 0);
+            else if (!strcmp (keyword, "allow"))  ok = addRule (value, true);
+            else if (!strcmp (keyword, "deny"))   ok = addRule (value, false);
+            else if (!strcmp (keyword, "rate"))   rate = atof (value);
+            else if (!strcmp (keyword, "burst"))  burst = atof (value);
+            else                                  ok = false;
+            if (!ok) {
+                Serial.printf ("[firewall] invalid line in %s: %s %s\n", path, keyword, value);
+                valid = false;
+            }
+        }
+        setRateLimit (rate, burst);
+    }
+    free (buffer);
+    return valid;
+}
+
+bool firewall_t::addRule (const char *cidr, bool allow) {
+    char ip [48];
+    const char *slash = strchr (cidr, '/');
+    size_t l = slash ? slash - cidr : strlen (cidr);
+    if (l >= sizeof (ip))
+        return false;
+    memcpy (ip, cidr, l);
+    ip [l] = 0;
+
+    __rule__ r;
+    if (!__parseAddress__ (ip, r.address))
+        return false;
+    bool ipv4 = strchr (ip, ':') == NULL;
+    int maxLength = ipv4 ? 32 : 128;
+    int length = maxLength;
+    if (slash) {
+        char *end;
+        length = strtol (slash + 1, &end, 10);
+        if (end == slash + 1 || *end || length < 0 || length > maxLength)
+            return false;
+    }
+    r.length = ipv4 ? 96 + length : length; // IPv4 rules are under ::ffff:0:0/96
+    r.allow = allow;
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        bool inserted = __ruleCount__ < FIREWALL_MAX_RULES && __insert__ (r);
+        if (inserted)
+            __rules__ [__ruleCount__ ++] = r;
+    xSemaphoreGive (__semaphore__);
+    return inserted;
+}
+
+void firewall_t::setDefaultPolicy (bool allow) {
+    __defaultAllow__ = allow;
+}
+
+void firewall_t::setRateLimit (float rate, float burst) {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __rate__ = rate > 0 ? rate : 0;
+        __burst__ = burst >= 1 ? burst : 1;
+    xSemaphoreGive (__semaphore__);
+}
+
+bool firewall_t::allow (const char *clientIP) {
+    uint8_t address [16];
+    bool parsed = __parseAddress__ (clientIP, address);
+    unsigned long now = millis ();
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        bool allowed = parsed && __matches__ (address);
+        if (!allowed)
+            __deniedByRule__ ++;
+        else if (__rate__ > 0 && !__takeToken__ (address, now)) {
+            allowed = false;
+            __deniedByRate__ ++;
+        } else
+            __allowed__ ++;
+    xSemaphoreGive (__semaphore__);
+    return allowed;
+}
+
+bool firewall_t::__parseAddress__ (const char *ip, uint8_t address [16]) {
+    if (strchr (ip, ':'))
+        return inet_pton (AF_INET6, ip, address) == 1;
+    // IPv4-mapped IPv6
+    memset (address, 0, 10);
+    address [10] = address [11] = 0xff;
+    return inet_pton (AF_INET, ip, address + 12) == 1;
+}
+
+uint32_t firewall_t::__hashOf__ (const uint8_t address [16]) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (int i = 0; i < 16; i++)
+        h = (h ^ address [i]) * 16777619u;
+    return h;
+}
+
+bool firewall_t::__insert__ (const __rule__& r) {
+    uint16_t n = 0;
+    for (int i = 0; i < r.length; i++) {
+        int bit = (r.address [i >> 3] >> (7 - (i & 7))) & 1;
+        if (!__nodes__ [n].child [bit]) {
+            if (__nodeCount__ == FIREWALL_MAX_NODES)
+                return false; // the nodes created so far stay, they don't change any verdict
+            __nodes__ [__nodeCount__] = { { 0, 0 }, -1 };
+            __nodes__ [n].child [bit] = __nodeCount__ ++;
+        }
+        n = __nodes__ [n].child [bit];
+    }
+    __nodes__ [n].verdict = r.allow;
+    return true;
+}
+
+bool firewall_t::__matches__ (const uint8_t address [16]) {
+    int verdict = __defaultAllow__;
+    uint16_t n = 0;
+    for (int i = 0; ; i++) {
+        if (__nodes__ [n].verdict >= 0)
+            verdict = __nodes__ [n].verdict; // the longest matching prefix so far
+        if (i == 128)
+            break;
+        n = __nodes__ [n].child [(address [i >> 3] >> (7 - (i & 7))) & 1];
+        if (!n)
+            break;
+    }
+    return verdict;
+}
+
+void firewall_t::__unlinkLru__ (int16_t i) {
+    __bucket__& b = __buckets__ [i];
+    if (b.newer >= 0) __buckets__ [b.newer].older = b.older; else __newest__ = b.older;
+    if (b.older >= 0) __buckets__ [b.older].newer = b.newer; else __oldest__ = b.newer;
+}
+
+bool firewall_t::__takeToken__ (const uint8_t address [16], unsigned long now) {
+    uint32_t h = __hashOf__ (address) & (FIREWALL_RATE_TABLE - 1);
+    int16_t i = __hash__ [h];
+    while (i >= 0 && memcmp (__buckets__ [i].address, address, 16))
+        i = __buckets__ [i].next;
+
+    if (i >= 0) {
+        __unlinkLru__ (i);
+    } else {
+        if (__bucketCount__ < FIREWALL_RATE_TABLE) {
+            i = __bucketCount__ ++;
+        } else {
+            // reuse the bucket of the least recently seen client
+            i = __oldest__;
+            __unlinkLru__ (i);
+            int16_t *p = &__hash__ [__hashOf__ (__buckets__ [i].address) & (FIREWALL_RATE_TABLE - 1)];
+            while (*p != i)
+                p = &__buckets__ [*p].next;
+            *p = __buckets__ [i].next;
+        }
+        __bucket__& b = __buckets__ [i];
+        memcpy (b.address, address, 16);
+        b.tokens = __burst__;
+        b.lastRefill = now;
+        b.next = __hash__ [h];
+        __hash__ [h] = i;
+    }
+
+    // make it the newest
+    __bucket__& b = __buckets__ [i];
+    b.newer = -1;
+    b.older = __newest__;
+    if (__newest__ >= 0) __buckets__ [__newest__].newer = i; else __oldest__ = i;
+    __newest__ = i;
+
+    b.tokens += (now - b.lastRefill) * __rate__ / 1000;
+    if (b.tokens > __burst__)
+        b.tokens = __burst__;
+    b.lastRefill = now;
+    if (b.tokens < 1)
+        return false;
+    b.tokens -= 1;
+    return true;
+}
+
+String firewall_t::toText () {
+    char s [160];
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        snprintf (s, sizeof (s), "default policy:          %s\r\n"
+                                 "rate limit:              ",
+                                 __defaultAllow__ ? "allow" : "deny");
+        String t = s;
+        if (__rate__ > 0)
+            snprintf (s, sizeof (s), "%.1f connections/s per client IP, burst %.0f, %i of %i client IPs tracked\r\n", __rate__, __burst__, __bucketCount__, FIREWALL_RATE_TABLE);
+        else
+            snprintf (s, sizeof (s), "off\r\n");
+        t += s;
+        snprintf (s, sizeof (s), "connections:             %lu allowed, %lu denied by rule, %lu denied by rate limit\r\n"
+                                 "rules:                   %i (%i of %i trie nodes used)",
+                                 (unsigned long) __allowed__, (unsigned long) __deniedByRule__, (unsigned long) __deniedByRate__,
+                                 __ruleCount__, __nodeCount__, FIREWALL_MAX_NODES);
+        t += s;
+        for (int i = 0; i < __ruleCount__; i++) {
+            const __rule__& r = __rules__ [i];
+            char ip [INET6_ADDRSTRLEN];
+            bool ipv4 = r.length >= 96 && !memcmp (r.address, "\0\0\0\0\0\0\0\0\0\0\xff\xff", 12);
+            if (ipv4)
+                inet_ntop (AF_INET, r.address + 12, ip, sizeof (ip));
+            else
+                inet_ntop (AF_INET6, r.address, ip, sizeof (ip));
+            snprintf (s, sizeof (s), "\r\n   %-5s %s/%i", r.allow ? "allow" : "deny", ip, ipv4 ? r.length - 96 : r.length);
+            t += s;
+        }
+    xSemaphoreGive (__semaphore__);
+    return t;
+}
@@ -0,0 +1,129 @@
+/*
+
+    firewall.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Connection-level firewall: allow and deny CIDR rules for IPv4 and IPv6 and per source IP rate limiting, checked by
+    firewallCallback before the servers spend anything on a connection.
+
+    The rules are read from /etc/firewall.conf into a binary prefix trie. IPv4 addresses are kept as IPv4-mapped IPv6
+    addresses (::ffff:a.b.c.d), so both share the same trie. allow () walks the trie along the bits of the client's
+    address and the longest matching prefix decides, if none matches the default policy does. The walk is at most
+    128 steps, regardless of the number of rules:
+
+        # default allow or deny, for the addresses that no rule matches
+           default allow
+           deny 10.0.0.0/8
+           allow 10.18.1.0/24        # the longer prefix wins
+           allow fe80::/10
+        # connections per second and burst size for each client IP (rate 0 turns rate limiting off)
+           rate 10
+           burst 40
+
+    Each allowed client IP has a token bucket. The buckets are kept in a hash table of FIREWALL_RATE_TABLE entries with
+    a least recently used list, so finding a client's bucket takes constant time and the table never grows: when it is
+    full, the bucket of the client that hasn't connected for the longest time is reused. The default limit is enough for
+    browsers and FTP or Telnet clients and refuses a flood early. Raise it in /etc/firewall.conf (or turn it off with
+    rate 0) for benchmarks or many clients behind one NAT address.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __FIREWALL_H__
+    #define __FIREWALL_H__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+
+
+    // TUNING PARAMETERS
+    #define FIREWALL_MAX_RULES 32               // allow and deny lines in /etc/firewall.conf
+    #define FIREWALL_MAX_NODES 512              // prefix trie nodes, an IPv4 rule takes at most 32 of them, an IPv6 rule at most 128
+    #define FIREWALL_RATE_TABLE 64              // client IPs with their own token bucket, must be a power of 2
+    #define FIREWALL_DEFAULT_RATE 10            // connections per second per client IP
+    #define FIREWALL_DEFAULT_BURST 40           // connections a client IP may open at once
+
+
+    class firewall_t {
+
+        public:
+
+            firewall_t ();
+            ~firewall_t ();
+
+            // reads /etc/firewall.conf (and creates the default one if it doesn't exist), returns false if it couldn't be read or a rule is not valid
+            bool begin (threadSafeFS::FS& fileSystem, const char *path = "/etc/firewall.conf");
+
+            // adds a rule, cidr is "a.b.c.d/n" or "x:x::x/n" (the whole address if /n is missing), returns false if it is not valid or there is no space left
+            bool addRule (const char *cidr, bool allow);
+
+            void setDefaultPolicy (bool allow);
+            void setRateLimit (float rate, float burst); // rate 0 turns rate limiting off
+
+            // decides whether the connection from clientIP is accepted, reentrant, can be called from any task
+            bool allow (const char *clientIP);
+
+            inline uint32_t allowed () __attribute__((always_inline)) { return __allowed__; }
+            inline uint32_t deniedByRule () __attribute__((always_inline)) { return __deniedByRule__; }
+            inline uint32_t deniedByRate () __attribute__((always_inline)) { return __deniedByRate__; }
+
+            // rules, settings and counters
+            String toText ();
+
+        private:
+
+            struct __rule__ {
+                uint8_t address [16];       // IPv6 or IPv4-mapped
+                uint8_t length;             // prefix length, 0 - 128
+                bool allow;
+            };
+
+            struct __node__ {
+                uint16_t child [2];         // 0 = none (the root is never a child)
+                int8_t verdict;             // -1 = no rule ends here, 0 = deny, 1 = allow
+            };
+
+            struct __bucket__ {
+                uint8_t address [16];
+                float tokens;
+                unsigned long lastRefill;   // millis
+                int16_t newer, older;       // LRU list, -1 = none
+                int16_t next;               // hash chain, -1 = none
+            };
+
+            __rule__ __rules__ [FIREWALL_MAX_RULES];
+            int __ruleCount__ = 0;
+            __node__ __nodes__ [FIREWALL_MAX_NODES];
+            int __nodeCount__ = 1;          // the root
+            bool __defaultAllow__ = true;
+
+            float __rate__ = FIREWALL_DEFAULT_RATE;
+            float __burst__ = FIREWALL_DEFAULT_BURST;
+            __bucket__ __buckets__ [FIREWALL_RATE_TABLE];
+            int16_t __hash__ [FIREWALL_RATE_TABLE];     // first bucket of each hash chain, -1 = none
+            int __bucketCount__ = 0;
+            int16_t __newest__ = -1, __oldest__ = -1;
+
+            SemaphoreHandle_t __semaphore__ = NULL;     // protects the trie and the buckets
+
+            uint32_t __allowed__ = 0;
+            uint32_t __deniedByRule__ = 0;
+            uint32_t __deniedByRate__ = 0;
+
+            static bool __parseAddress__ (const char *ip, uint8_t address [16]);
+            static uint32_t __hashOf__ (const uint8_t address [16]);
+
+            bool __insert__ (const __rule__& r);
+            bool __matches__ (const uint8_t address [16]);
+            bool __takeToken__ (const uint8_t address [16], unsigned long now);
+            void __unlinkLru__ (int16_t i);
+            void __clear__ ();
+    };
+
+#endif
@@ -0,0 +1,517 @@
+/*
+
+    benchmark.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: runs setup () and loop () of the sketch and measures its request handlers:
+
+        GET /state                      through eventHttpServer_t over the loopback interface, a new connection for each request
+        GET /index.html                 the same, a static file (from staticAssetCache_t, gzip)
+        GET /state keep-alive           through one kept-alive connection for each client thread
+        GET /state pipelined x4         the same, four requests at a time without waiting for the replies (one result counts all four)
+        POST /login/ + POST /logout     httpRequestHandlerCallback called with an in-memory HTTPS-like connection (see
+                                        httpServer.h), so that webSessionTokens_t creates and deletes the session token
+        FTP/Telnet login                getUserHomeDirectoryCallback, userManagement_t's SHA-crypt and credential cache
+        GET /download/, PUT /upload/    fileTransferRequest of webadmin (in httpServer_t's place, which the host build doesn't have)
+                                        streaming 1 KB to 1 MB files (BENCHMARK_TRANSFER_SIZES) to or from a loopback TCP connection
+                                        through fileTransfer_t's double buffers, the throughput is reported in MB/s too
+        lookup in N users               userManagement_t::getHomeDirectory of the last of N users added to /etc/passwd, through
+                                        /etc/passwd.idx, and then without it
+
+    For each one it reports requests/s, the median and the 99th percentile latency and heap allocations per request.
+    The clients don't allocate anything while they run (the latencies go into arrays reserved in advance), so the
+    allocations are the server's, although the server's background tasks (cron, task profiler, ...) are counted too.
+
+    The firewall would limit 127.0.0.1 to 10 connections/s (with a burst of 40), so its rate limit is turned off
+    while the benchmark runs.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_BENCHMARK_HPP__
+    #define __HOST_BENCHMARK_HPP__
+
+    #include <atomic>
+    #include <thread>
+    #include <vector>
+    #include <algorithm>
+    #include <dirent.h>
+    #include "hostAlloc.h"
+    #include "hostSocket.h"
+
+
+    // TUNING PARAMETERS
+    #define BENCHMARK_MAX_SAMPLES (1 << 20)     // latencies kept per scenario (in all the client threads together), the requests beyond are counted but not timed
+    #define BENCHMARK_WARM_UP 20                // requests before each measurement, they fill the caches
+    #define BENCHMARK_REPLY_BUFFER 8192         // bytes, the client reads the replies in chunks of this size
+    #define BENCHMARK_SETTLE 3500               // ms to wait after setup () and WiFi connection, so that the boot messages are printed before the results
+    #define BENCHMARK_PIPELINE 4                // requests sent at a time through a kept-alive connection, EVENT_HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS should be a multiple of it
+    #define BENCHMARK_TRANSFER_SIZES { 1, 4, 16, 64, 256, 1024 } // KB, the sizes of downloaded and uploaded files, each one is a scenario
+
+
+    // copies the files of html/ to /var/www/html/ if they are not there yet
+    static void __benchmarkInstallHtml__ () {
+        if (!TSFS.isDirectory ("/var")) TSFS.mkdir ("/var");
+        if (!TSFS.isDirectory ("/var/www")) TSFS.mkdir ("/var/www");
+        if (!TSFS.isDirectory ("/var/www/html")) TSFS.mkdir ("/var/www/html");
+
+        DIR *d = opendir (HOST_SKETCH_DIR "/html");
+        if (!d)
+            return;
+        struct dirent *e;
+        while ((e = readdir (d))) {
+            if (*e->d_name == '.')
+                continue;
+            char path [300];
+            snprintf (path, sizeof (path), "/var/www/html/%s", e->d_name);
+            if (TSFS.isFile (path))
+                continue;
+            char hostPath [600];
+            snprintf (hostPath, sizeof (hostPath), "%s/html/%s", HOST_SKETCH_DIR, e->d_name);
+            FILE *from = fopen (hostPath, "rb");
+            File to = TSFS.open (path, "w");
+            if (from && to) {
+                uint8_t buf [1024];
+                size_t l;
+                while ((l = fread (buf, 1, sizeof (buf), from)) > 0)
+                    to.write (buf, l);
+            }
+            if (from)
+                fclose (from);
+        }
+        closedir (d);
+    }
+
+
+    // ----- requests -----
+
+    // connects to eventHttpServer_t through the loopback interface
+    static int __benchmarkConnect__ () {
+        int s = socket (AF_INET, SOCK_STREAM, 0);
+        if (s < 0)
+            return -1;
+        struct sockaddr_in a = {};
+        a.sin_family = AF_INET;
+        a.sin_port = htons (80 + hostPortOffset ());
+        a.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+        if (connect (s, (struct sockaddr *) &a, sizeof (a))) {
+            close (s);
+            return -1;
+        }
+        return s;
+    }
+
+    // sends the request (with Connection: close) and reads the reply until the server closes the connection
+    static bool __benchmarkHttp__ (const char *request) {
+        int s = __benchmarkConnect__ ();
+        if (s < 0)
+            return false;
+        bool ok = false;
+        if (send (s, request, strlen (request), 0) == (ssize_t) strlen (request)) {
+            char buf [BENCHMARK_REPLY_BUFFER];
+            size_t received = 0;
+            ssize_t l;
+            while ((l = recv (s, buf, sizeof (buf), 0)) > 0) {
+                if (!received)
+                    ok = l >= 12 && !memcmp (buf, "HTTP/1.1 200", 12);
+                received += l;
+            }
+            ok = ok && l == 0;
+        }
+        close (s);
+        return ok;
+    }
+
+    static bool __benchmarkState__ () {
+        return __benchmarkHttp__ ("GET /state HTTP/1.1\r\nHost: " HOSTNAME "\r\nConnection: close\r\n\r\n");
+    }
+
+    static bool __benchmarkStaticFile__ () {
+        return __benchmarkHttp__ ("GET /index.html HTTP/1.1\r\nHost: " HOSTNAME "\r\nAccept-Encoding: gzip, deflate\r\nConnection: close\r\n\r\n");
+    }
+
+    // kept-alive connection of a client thread, opened again when the server closes it
+    struct __benchmarkKeepAlive__ {
+        int socket = -1;
+        char buf [BENCHMARK_REPLY_BUFFER];
+        size_t length = 0;                  // the replies that have been received but not read yet
+
+        void disconnect () {
+            if (socket >= 0)
+                close (socket);
+            socket = -1;
+            length = 0;
+        }
+
+        ~__benchmarkKeepAlive__ () { disconnect (); }
+    };
+
+    static thread_local __benchmarkKeepAlive__ __benchmarkConnection__;
+
+    // reads the next reply, which must fit into the buffer and have Content-Length, the replies after it stay in the buffer
+    static bool __benchmarkReadReply__ (__benchmarkKeepAlive__& c, bool& keepAlive) {
+        char *endOfHeader;
+        while (!(endOfHeader = (char *) memmem (c.buf, c.length, "\r\n\r\n", 4))) {
+            ssize_t l = recv (c.socket, c.buf + c.length, sizeof (c.buf) - 1 - c.length, 0);
+            if (l <= 0)
+                return false;
+            c.length += l;
+        }
+        endOfHeader [2] = 0; // only search the header
+        bool ok = !memcmp (c.buf, "HTTP/1.1 200", 12);
+        keepAlive = strstr (c.buf, "\r\nConnection: keep-alive\r\n") != NULL;
+        const char *contentLength = strstr (c.buf, "\r\nContent-Length: ");
+        endOfHeader [2] = '\r';
+        if (!contentLength)
+            return false;
+        size_t replyLength = endOfHeader + 4 - c.buf + atol (contentLength + 18);
+        if (replyLength >= sizeof (c.buf))
+            return false;
+        while (c.length < replyLength) {
+            ssize_t l = recv (c.socket, c.buf + c.length, sizeof (c.buf) - 1 - c.length, 0);
+            if (l <= 0)
+                return false;
+            c.length += l;
+        }
+        memmove (c.buf, c.buf + replyLength, c.length - replyLength);
+        c.length -= replyLength;
+        return ok;
+    }
+
+    // sends count requests through the kept-alive connection without waiting for the replies and then reads the replies
+    static bool __benchmarkKeepAliveRequests__ (int count) {
+        static const char *request = "GET /state HTTP/1.1\r\nHost: " HOSTNAME "\r\n\r\n";
+        __benchmarkKeepAlive__& c = __benchmarkConnection__;
+        int received = 0;
+        while (received < count) {
+            if (c.socket < 0 && (c.socket = __benchmarkConnect__ ()) < 0)
+                return false;
+            char requests [BENCHMARK_PIPELINE * 64];
+            size_t length = 0;
+            for (int i = received; i < count; i++) {
+                strcpy (requests + length, request);
+                length += strlen (request);
+            }
+            if (send (c.socket, requests, length, 0) != (ssize_t) length) {
+                c.disconnect ();
+                return false;
+            }
+            bool keepAlive = true;
+            while (received < count && keepAlive) {
+                if (!__benchmarkReadReply__ (c, keepAlive)) {
+                    c.disconnect ();
+                    return false;
+                }
+                received ++;
+            }
+            if (!keepAlive) // the server has closed the connection after EVENT_HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS, send the rest through a new one
+                c.disconnect ();
+        }
+        return true;
+    }
+
+    static bool __benchmarkStateKeepAlive__ () {
+        return __benchmarkKeepAliveRequests__ (1);
+    }
+
+    static bool __benchmarkStatePipelined__ () {
+        return __benchmarkKeepAliveRequests__ (BENCHMARK_PIPELINE);
+    }
+
+    // as if the requests came through HTTPS, POST /login/ is refused otherwise
+    static bool __benchmarkLogin__ () {
+        static const char *login = "POST /login/user/password HTTP/1.1\r\nHost: " HOSTNAME "\r\n\r\n";
+        httpServer_t::httpConnection_t loginConnection (login, "TLS_AES_128_GCM_SHA256");
+        if (httpRequestHandlerCallback<httpServer_t::httpConnection_t> (login, &loginConnection) != "OK")
+            return false;
+
+        // log out with the token from Set-Cookie: session=<token>; ..., so that the tokens don't pile up in /var/www/tokens
+        const char *token = strstr (loginConnection.replyHeaderFields (), "session=");
+        if (!token)
+            return false;
+        token += 8;
+        char logout [256];
+        snprintf (logout, sizeof (logout), "POST /logout HTTP/1.1\r\nHost: " HOSTNAME "\r\nCookie: session=%.*s\r\n\r\n", (int) strcspn (token, ";\r"), token);
+        httpServer_t::httpConnection_t logoutConnection (logout, "TLS_AES_128_GCM_SHA256");
+        return httpRequestHandlerCallback<httpServer_t::httpConnection_t> (logout, &logoutConnection) == "OK";
+    }
+
+    static bool __benchmarkUserLogin__ () {
+        return getUserHomeDirectoryCallback ("root", DEFAULT_ROOT_PASSWORD) != "";
+    }
+
+    // a connected pair of loopback TCP sockets, each client thread has its own listening socket so that the threads don't accept each other's connections
+    static bool __benchmarkLoopbackPair__ (int& serverSocket, int& clientSocket) {
+        static thread_local int listeningSocket = -1;
+        static thread_local struct sockaddr_in a = {};
+        if (listeningSocket < 0) {
+            listeningSocket = socket (AF_INET, SOCK_STREAM, 0);
+            a.sin_family = AF_INET;
+            a.sin_addr.s_addr = htonl (INADDR_LOOPBACK); // port 0, the system picks one
+            socklen_t l = sizeof (a);
+            if (listeningSocket < 0 || bind (listeningSocket, (struct sockaddr *) &a, sizeof (a)) || listen (listeningSocket, 1) || getsockname (listeningSocket, (struct sockaddr *) &a, &l)) {
+                if (listeningSocket >= 0)
+                    close (listeningSocket);
+                listeningSocket = -1;
+                return false;
+            }
+        }
+        clientSocket = socket (AF_INET, SOCK_STREAM, 0);
+        if (clientSocket < 0)
+            return false;
+        if (connect (clientSocket, (struct sockaddr *) &a, sizeof (a)) || (serverSocket = accept (listeningSocket, NULL, NULL)) < 0) {
+            close (clientSocket);
+            return false;
+        }
+        return true;
+    }
+
+    static size_t __benchmarkTransferSize__; // bytes of each download and upload in the current scenario
+
+    // runs fileTransferRequest in another thread, as httpServer_t's connection task would, while this thread is the client
+    static bool __benchmarkTransfer__ (const char *request, bool download) {
+        int serverSocket, clientSocket;
+        if (!__benchmarkLoopbackPair__ (serverSocket, clientSocket))
+            return false;
+        String result;
+        std::thread server ([&] () {
+            httpServer_t::httpConnection_t connection (request, "", "127.0.0.1", serverSocket);
+            result = fileTransferRequest (request, &connection, "webadmin");
+            shutdown (serverSocket, SHUT_WR);
+        });
+
+        bool ok = true;
+        char buf [BENCHMARK_REPLY_BUFFER];
+        if (!download) { // the request body
+            memset (buf, 'u', sizeof (buf));
+            for (size_t sent = 0; ok && sent < __benchmarkTransferSize__; ) {
+                ssize_t l = send (clientSocket, buf, std::min (sizeof (buf), __benchmarkTransferSize__ - sent), MSG_NOSIGNAL);
+                ok = l > 0;
+                sent += l;
+            }
+        }
+        size_t received = 0; // the reply, until the server shuts the connection down
+        ssize_t l;
+        while ((l = recv (clientSocket, buf, sizeof (buf), 0)) > 0)
+            received += l;
+        server.join ();
+        close (clientSocket);
+        close (serverSocket);
+        if (download)
+            return ok && received > __benchmarkTransferSize__ && received < __benchmarkTransferSize__ + 256; // header and file
+        return ok && result == "OK";
+    }
+
+    static bool __benchmarkDownload__ () {
+        return __benchmarkTransfer__ ("GET /download/var/www/html/benchmark.bin HTTP/1.1\r\nHost: " HOSTNAME "\r\n\r\n", true);
+    }
+
+    // each client thread uploads into its own file
+    static bool __benchmarkUpload__ () {
+        static std::atomic<int> threadCount (0);
+        static thread_local int thread = threadCount ++;
+        char request [256];
+        snprintf (request, sizeof (request), "PUT /upload/var/www/html/benchmark-%i.bin HTTP/1.1\r\nHost: " HOSTNAME "\r\nContent-Length: %u\r\nExpect: 100-continue\r\n\r\n", thread, (unsigned) __benchmarkTransferSize__);
+        return __benchmarkTransfer__ (request, false);
+    }
+
+    // the file for GET /download/, __benchmarkTransferSize__ bytes long
+    static bool __benchmarkInstallTransferFile__ () {
+        File f = TSFS.open ("/var/www/html/benchmark.bin", "w");
+        if (!f)
+            return false;
+        uint8_t buf [1024];
+        for (size_t i = 0; i < sizeof (buf); i++)
+            buf [i] = (uint8_t) i;
+        for (size_t written = 0; written < __benchmarkTransferSize__; written += sizeof (buf))
+            if (f.write (buf, sizeof (buf)) != sizeof (buf))
+                return false;
+        return true;
+    }
+
+    // the users are added to /etc/passwd only (they can't log in), the original /etc/passwd waits in /etc/passwd.bak
+    static userManagement_t *__benchmarkUsers__ = NULL;
+    static char __benchmarkLastUser__ [16]; // the last record, the longest full read
+
+    static bool __benchmarkAddUsers__ (int count) {
+        if (!TSFS.rename ("/etc/passwd", "/etc/passwd.bak"))
+            return false;
+        File from = TSFS.open ("/etc/passwd.bak", "r");
+        File to = TSFS.open ("/etc/passwd", "w");
+        bool ok = from && to;
+        uint8_t buf [512];
+        size_t l;
+        while (ok && (l = from.read (buf, sizeof (buf))))
+            ok = to.write (buf, l) == l;
+        for (int i = 0; ok && i < count; i++) {
+            snprintf (__benchmarkLastUser__, sizeof (__benchmarkLastUser__), "user%04i", i);
+            char record [64];
+            int r = snprintf (record, sizeof (record), "\r\n%s:::::/home/%s/:", __benchmarkLastUser__, __benchmarkLastUser__);
+            ok = to.write ((const uint8_t *) record, r) == (size_t) r;
+        }
+        to.close ();
+        if (ok)
+            __benchmarkUsers__ = new userManagement_t (TSFS); // indexes the new /etc/passwd
+        return ok;
+    }
+
+    static void __benchmarkRemoveUsers__ () {
+        delete __benchmarkUsers__;
+        __benchmarkUsers__ = NULL;
+        if (TSFS.isFile ("/etc/passwd.bak")) {
+            TSFS.remove ("/etc/passwd");
+            TSFS.rename ("/etc/passwd.bak", "/etc/passwd");
+        }
+        delete new userManagement_t (TSFS); // indexes the original /etc/passwd again
+    }
+
+    static bool __benchmarkUserLookup__ () {
+        return __benchmarkUsers__->getHomeDirectory (__benchmarkLastUser__) != "";
+    }
+
+
+    // ----- measurement -----
+
+    struct __benchmarkClient__ {
+        std::vector<float> latencies;   // ms
+        unsigned long requests = 0;
+        unsigned long errors = 0;
+    };
+
+    // bytesPerRequest, if given, adds the throughput in MB/s
+    static bool __benchmarkScenario__ (const char *name, bool (*request) (), double seconds, int threads, size_t bytesPerRequest = 0) {
+        for (int i = 0; i < BENCHMARK_WARM_UP; i++)
+            if (!request ()) {
+                printf ("%-30s  failed\n", name);
+                return false;
+            }
+
+        std::vector<__benchmarkClient__> clients (threads);
+        for (auto& c : clients)
+            c.latencies.reserve (BENCHMARK_MAX_SAMPLES / threads);
+
+        std::atomic<int> ready (0);
+        std::atomic<int> finished (0);
+        std::atomic<bool> go (false);
+        std::atomic<bool> stop (false);
+        std::vector<std::thread> t;
+        for (int i = 0; i < threads; i++)
+            t.emplace_back ([&, i] () {
+                __benchmarkClient__& c = clients [i];
+                ready ++;
+                while (!go)
+                    sched_yield ();
+                while (!stop) {
+                    int64_t start = esp_timer_get_time ();
+                    bool ok = request ();
+                    int64_t end = esp_timer_get_time ();
+                    c.requests ++;
+                    if (!ok)
+                        c.errors ++;
+                    else if (c.latencies.size () < c.latencies.capacity ())
+                        c.latencies.push_back ((end - start) / 1000.0f);
+                }
+                finished ++;
+            });
+        while (ready < threads)
+            sched_yield ();
+
+        uint64_t allocations = hostAllocations ();
+        int64_t start = esp_timer_get_time ();
+        go = true;
+        delay ((uint32_t) (seconds * 1000));
+        stop = true;
+        while (finished < threads)
+            sched_yield ();
+        int64_t end = esp_timer_get_time ();
+        allocations = hostAllocations () - allocations;
+        for (auto& th : t)
+            th.join ();
+
+        unsigned long requests = 0, errors = 0;
+        std::vector<float> latencies;
+        for (auto& c : clients) {
+            requests += c.requests;
+            errors += c.errors;
+            latencies.insert (latencies.end (), c.latencies.begin (), c.latencies.end ());
+        }
+        std::sort (latencies.begin (), latencies.end ());
+        auto percentile = [&] (double p) -> double { return latencies.empty () ? NAN : latencies [(size_t) (p * (latencies.size () - 1))]; };
+
+        double requestsPerSecond = requests / ((end - start) / 1000000.0);
+        printf ("%-30s  %12.1f  %9.3f  %9.3f  %13.1f", name, requestsPerSecond, percentile (0.5), percentile (0.99), requests ? (double) allocations / requests : NAN);
+        if (bytesPerRequest)
+            printf ("  %8.2f MB/s", requestsPerSecond * bytesPerRequest / 1048576);
+        if (errors)
+            printf ("  (%lu of %lu requests failed)", errors, requests);
+        printf ("\n");
+        return !errors;
+    }
+
+    static void __benchmarkLoopTask__ (void *) {
+        for (;;)
+            loop ();
+    }
+
+    // runs each scenario for the given number of seconds with the given number of client threads, returns the exit code
+    int benchmark (double seconds, int threads) {
+        setup ();
+        xTaskCreate (__benchmarkLoopTask__, "loop", 8192, NULL, 1, NULL);
+        __benchmarkInstallHtml__ ();
+        firewall.setRateLimit (0, 1); // all the requests come from 127.0.0.1
+
+        for (int i = 0; i < 50 && WiFi.status () != WL_CONNECTED; i++)
+            delay (100);
+        delay (BENCHMARK_SETTLE);
+        fflush (stdout);
+        printf ("\n%i client threads, %.1f s per scenario, %s\n\n", threads, seconds, HOST_SKETCH_DIR);
+        printf ("%-30s  %12s  %9s  %9s  %13s\n", "scenario", "requests/s", "p50 ms", "p99 ms", "allocs/request");
+
+        bool ok = true;
+        if (eventHttpServer && *eventHttpServer) {
+            ok &= __benchmarkScenario__ ("GET /state", __benchmarkState__, seconds, threads);
+            ok &= __benchmarkScenario__ ("GET /index.html", __benchmarkStaticFile__, seconds, threads);
+            ok &= __benchmarkScenario__ ("GET /state keep-alive", __benchmarkStateKeepAlive__, seconds, threads);
+            ok &= __benchmarkScenario__ ("GET /state pipelined x4", __benchmarkStatePipelined__, seconds, threads);
+        } else {
+            printf ("%-30s  eventHttpServer is not listening on port %i, run as root or set ESP32_HOST_PORT_OFFSET\n", "GET /state, GET /index.html", 80 + hostPortOffset ());
+            ok = false;
+        }
+        ok &= __benchmarkScenario__ ("POST /login/ + POST /logout", __benchmarkLogin__, seconds, threads);
+        ok &= __benchmarkScenario__ ("FTP/Telnet login", __benchmarkUserLogin__, seconds, threads);
+        for (int kilobytes : BENCHMARK_TRANSFER_SIZES) {
+            char name [2][32];
+            snprintf (name [0], sizeof (name [0]), "GET /download/ %i KB", kilobytes);
+            snprintf (name [1], sizeof (name [1]), "PUT /upload/ %i KB", kilobytes);
+            __benchmarkTransferSize__ = kilobytes * 1024;
+            if (!__benchmarkInstallTransferFile__ ()) {
+                printf ("%-30s  can't write /var/www/html/benchmark.bin\n", name [0]);
+                ok = false;
+                continue;
+            }
+            ok &= __benchmarkScenario__ (name [0], __benchmarkDownload__, seconds, threads, __benchmarkTransferSize__);
+            ok &= __benchmarkScenario__ (name [1], __benchmarkUpload__, seconds, threads, __benchmarkTransferSize__);
+        }
+        for (int users : { 10, 100, 1000 }) {
+            char name [2][32];
+            snprintf (name [0], sizeof (name [0]), "lookup in %i users", users);
+            snprintf (name [1], sizeof (name [1]), "lookup in %i users, no index", users);
+            if (!__benchmarkAddUsers__ (users)) {
+                printf ("%-30s  can't write /etc/passwd\n", name [0]);
+                __benchmarkRemoveUsers__ ();
+                ok = false;
+                continue;
+            }
+            ok &= __benchmarkScenario__ (name [0], __benchmarkUserLookup__, seconds, threads);
+            TSFS.remove ("/etc/passwd.idx"); // each lookup reads /etc/passwd up to the last record
+            ok &= __benchmarkScenario__ (name [1], __benchmarkUserLookup__, seconds, threads);
+            __benchmarkRemoveUsers__ ();
+        }
+        return ok ? 0 : 1;
+    }
+
+#endif
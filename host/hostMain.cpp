@@ -0,0 +1,63 @@
+/*
+
+    hostMain.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: runs the sketch on Linux, setup () once and then loop () forever, as Arduino-ESP32 does, the
+    benchmark of its request handlers or the tests.
+
+        esp32-servers-host [--fs <directory>] [bench [<seconds> [<client threads>]] | test]
+
+    The file system is the directory given with --fs (or ESP32_HOST_FS environment variable, ./littlefs by default).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+// oscilloscope.h is compiled as it comes with the Arduino sketch, where it compares ints with size_t, the sketch includes it again without effect
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+    #include "../oscilloscope.h"
+#pragma GCC diagnostic pop
+
+#include "../ESP32-servers-LIB.ino"
+#include "benchmark.hpp"
+#include "test.hpp"
+#include <signal.h>
+
+
+int main (int argc, char *argv []) {
+    int i = 1;
+    if (i + 1 < argc && !strcmp (argv [i], "--fs")) {
+        setenv ("ESP32_HOST_FS", argv [i + 1], 1);
+        i += 2;
+    }
+    bool bench = i < argc && !strcmp (argv [i], "bench");
+    bool tests = i < argc && !strcmp (argv [i], "test");
+    if ((i < argc && !bench && !tests) || argc > i + (tests ? 1 : 3)) {
+        fprintf (stderr, "usage: %s [--fs <directory>] [bench [<seconds> [<client threads>]] | test]\n", argv [0]);
+        return 1;
+    }
+
+    signal (SIGPIPE, SIG_IGN); // lwIP's send () fails with EPIPE when the other side has closed the connection, it doesn't raise a signal
+    hostHeapBaseline (); // the free heap is counted from here
+    if (bench) {
+        double seconds = i + 1 < argc ? atof (argv [i + 1]) : 5;
+        int threads = i + 2 < argc ? atoi (argv [i + 2]) : 4;
+        int result = benchmark (seconds > 0 ? seconds : 5, threads > 0 ? threads : 4);
+        fflush (stdout);
+        _exit (result); // the server's tasks are still running, don't destroy the global objects under them
+
+    }
+    if (tests) {
+        int result = test ();
+        fflush (stdout);
+        _exit (result ? 1 : 0);
+    }
+
+    setup ();
+    for (;;)
+        loop ();
+}
@@ -0,0 +1,219 @@
+/*
+
+    Arduino.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of Arduino-ESP32 core that the sketch uses, on top of POSIX. millis () and esp_timer_get_time ()
+    count from the start of the process (the "boot"), pins are kept in memory and analogRead reads the simulated ADC
+    (see driver/adc.h).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ARDUINO_H__
+    #define __HOST_ARDUINO_H__
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <stdarg.h>
+    #include <math.h>
+    #include <time.h>
+    #include <unistd.h>
+    #include <sched.h>
+    #include <sys/time.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <new>
+    #include <string>
+    #include <functional>
+    #include <algorithm>
+
+    #include <esp_timer.h>
+    #include <esp_random.h>
+    #include <esp_system.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include <freertos/semphr.h>
+    #include <freertos/queue.h>
+    #include <freertos/event_groups.h>
+
+
+    typedef uint8_t byte;
+    typedef bool boolean;
+
+    #define HIGH 1
+    #define LOW 0
+    #define INPUT 0x01
+    #define OUTPUT 0x03
+    #define INPUT_PULLUP 0x05
+    #define LED_BUILTIN 2
+
+    #define IRAM_ATTR
+    #define DRAM_ATTR
+    #define RTC_NOINIT_ATTR
+    #define PROGMEM
+    #define F(s) (s)
+
+
+    using std::min;
+    using std::max;
+
+    inline unsigned long millis () { return (unsigned long) (esp_timer_get_time () / 1000); }
+    inline unsigned long micros () { return (unsigned long) esp_timer_get_time (); }
+    inline void delay (uint32_t ms) { vTaskDelay (ms / portTICK_PERIOD_MS); }
+    inline void delayMicroseconds (uint32_t us) { usleep (us); }
+    inline void yield () { sched_yield (); }
+
+    void pinMode (uint8_t pin, uint8_t mode);
+    void digitalWrite (uint8_t pin, uint8_t value);
+    int digitalRead (uint8_t pin);
+    uint16_t analogRead (uint8_t pin); // the simulated ADC, 12 bits
+
+
+    // Arduino String over std::string, the sketch only uses a small part of its interface
+    class String {
+
+        public:
+
+            String () {}
+            String (const char *s) : __s__ (s ? s : "") {}
+            String (const std::string& s) : __s__ (s) {}
+            explicit String (char c) : __s__ (1, c) {}
+            explicit String (int i) : __s__ (std::to_string (i)) {}
+            explicit String (unsigned int i) : __s__ (std::to_string (i)) {}
+            explicit String (long i) : __s__ (std::to_string (i)) {}
+            explicit String (unsigned long i) : __s__ (std::to_string (i)) {}
+            explicit String (long long i) : __s__ (std::to_string (i)) {}
+            explicit String (unsigned long long i) : __s__ (std::to_string (i)) {}
+            explicit String (unsigned char i) : __s__ (std::to_string (i)) {}
+            explicit String (short i) : __s__ (std::to_string (i)) {}
+            explicit String (float f, unsigned int decimals = 2) { __format__ (f, decimals); }
+            explicit String (double f, unsigned int decimals = 2) { __format__ (f, decimals); }
+
+            inline const char *c_str () const { return __s__.c_str (); }
+            inline unsigned int length () const { return __s__.length (); }
+            inline bool reserve (unsigned int size) { __s__.reserve (size); return true; }
+            inline bool concat (const char *s, unsigned int length) { __s__.append (s, length); return true; }
+            inline bool concat (const char *s) { __s__.append (s); return true; }
+            inline int indexOf (const char *s) const { size_t i = __s__.find (s); return i == std::string::npos ? -1 : (int) i; }
+            inline int indexOf (char c) const { size_t i = __s__.find (c); return i == std::string::npos ? -1 : (int) i; }
+            inline String substring (unsigned int from) const { return from < __s__.length () ? String (__s__.substr (from)) : String (); }
+            inline String substring (unsigned int from, unsigned int to) const { return from < __s__.length () && from < to ? String (__s__.substr (from, to - from)) : String (); }
+            inline long toInt () const { return atol (__s__.c_str ()); }
+            inline bool isEmpty () const { return __s__.empty (); }
+
+            inline char operator [] (unsigned int i) const { return i < __s__.length () ? __s__ [i] : 0; }
+            inline char& operator [] (unsigned int i) { return __s__ [i]; }
+
+            inline String& operator += (const String& s) { __s__ += s.__s__; return *this; }
+            inline String& operator += (const char *s) { if (s) __s__ += s; return *this; }
+            inline String& operator += (char c) { __s__ += c; return *this; }
+            inline String& operator += (int i) { __s__ += std::to_string (i); return *this; }
+            inline String& operator += (unsigned int i) { __s__ += std::to_string (i); return *this; }
+            inline String& operator += (long i) { __s__ += std::to_string (i); return *this; }
+            inline String& operator += (unsigned long i) { __s__ += std::to_string (i); return *this; }
+
+            inline bool operator == (const String& s) const { return __s__ == s.__s__; }
+            inline bool operator == (const char *s) const { return __s__ == (s ? s : ""); }
+            inline bool operator != (const String& s) const { return __s__ != s.__s__; }
+            inline bool operator != (const char *s) const { return __s__ != (s ? s : ""); }
+
+            friend String operator + (const String& a, const String& b) { return String (a.__s__ + b.__s__); }
+            friend String operator + (const String& a, const char *b) { return String (a.__s__ + (b ? b : "")); }
+            friend String operator + (const char *a, const String& b) { return String ((a ? a : "") + b.__s__); }
+            friend String operator + (const String& a, char b) { return String (a.__s__ + b); }
+
+        private:
+
+            std::string __s__;
+
+            void __format__ (double f, unsigned int decimals) { char b [64]; snprintf (b, sizeof (b), "%.*f", decimals, f); __s__ = b; }
+    };
+
+
+    class IPAddress {
+
+        public:
+
+            IPAddress () {}
+            IPAddress (uint8_t a, uint8_t b, uint8_t c, uint8_t d) : __b__ { a, b, c, d } {}
+            IPAddress (uint32_t address) { memcpy (__b__, &address, 4); }
+            IPAddress (const char *s) { fromString (s); }
+
+            bool fromString (const char *s) { return s && inet_pton (AF_INET, s, __b__) == 1; }
+            String toString () const { char s [INET_ADDRSTRLEN]; inet_ntop (AF_INET, __b__, s, sizeof (s)); return s; }
+            inline uint8_t operator [] (int i) const { return __b__ [i]; }
+            inline operator uint32_t () const { uint32_t a; memcpy (&a, __b__, 4); return a; }
+
+        private:
+
+            uint8_t __b__ [4] = {};
+    };
+
+
+    class HardwareSerial {
+
+        public:
+
+            void begin (unsigned long) {}
+            inline operator bool () { return true; }
+            size_t print (const char *s) { return fputs (s, stdout) < 0 ? 0 : strlen (s); }
+            size_t print (const String& s) { return print (s.c_str ()); }
+            size_t print (int i) { return ::printf ("%i", i); }
+            size_t println (const char *s = "") { return ::printf ("%s\n", s); }
+            size_t println (const String& s) { return println (s.c_str ()); }
+            size_t println (const IPAddress& a) { return println (a.toString ()); }
+            size_t printf (const char *format, ...) __attribute__ ((format (printf, 2, 3))) {
+                va_list args;
+                va_start (args, format);
+                int l = vprintf (format, args);
+                va_end (args);
+                return l < 0 ? 0 : l;
+            }
+    };
+
+    extern HardwareSerial Serial;
+
+
+    // the heap figures are simulated: HOST_HEAP_SIZE minus the bytes currently allocated by the process (see hostAlloc.cpp)
+    #define HOST_HEAP_SIZE (320 * 1024)
+
+    class EspClass {
+
+        public:
+
+            uint32_t getFreeHeap ();
+            uint32_t getMinFreeHeap ();
+            uint32_t getHeapSize () { return HOST_HEAP_SIZE; }
+            uint32_t getCpuFreqMHz () { return 240; }
+            const char *getChipModel () { return "host"; }
+            void restart () { exit (0); }
+    };
+
+    extern EspClass ESP;
+
+
+    #define MALLOC_CAP_EXEC         (1 << 0)
+    #define MALLOC_CAP_32BIT        (1 << 1)
+    #define MALLOC_CAP_8BIT         (1 << 2)
+    #define MALLOC_CAP_DMA          (1 << 3)
+    #define MALLOC_CAP_SPIRAM       (1 << 10)
+    #define MALLOC_CAP_INTERNAL     (1 << 11)
+    #define MALLOC_CAP_DEFAULT      (1 << 12)
+
+    inline void *heap_caps_malloc (size_t size, uint32_t) { return malloc (size); }
+    inline void *heap_caps_aligned_alloc (size_t alignment, size_t size, uint32_t) { return aligned_alloc (alignment, (size + alignment - 1) / alignment * alignment); }
+    inline void heap_caps_free (void *p) { free (p); }
+    size_t heap_caps_get_free_size (uint32_t caps);
+    size_t heap_caps_get_largest_free_block (uint32_t caps);
+    inline bool psramFound () { return false; }
+
+#endif
@@ -0,0 +1,94 @@
+/*
+
+    Cstring.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of LightweightSTL's Cstring that this project uses. Cstring<N> keeps N characters and the
+    terminating 0 in place, without heap allocation, and sets an error flag instead of overflowing. The characters are
+    the first member, so (char *) &cstring works as it does with the library.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __CSTRING_HPP__
+    #define __CSTRING_HPP__
+
+    #include <Arduino.h>
+    #include <ostream.hpp> // as LightweightSTL's Cstring.hpp does, some modules get cout from here
+
+
+    #define OVERFLOW 1  // error flag
+
+
+    template<size_t N> class Cstring {
+
+        public:
+
+            Cstring () {}
+            Cstring (const char *s) { *this = s; }
+            explicit Cstring (char c) { __c_str__ [0] = c; }
+            template<size_t M> Cstring (const Cstring<M>& other) { *this = other.c_str (); }
+            Cstring (const String& s) { *this = s.c_str (); }
+            explicit Cstring (int i) { snprintf (__c_str__, sizeof (__c_str__), "%i", i); }
+            explicit Cstring (unsigned int i) { snprintf (__c_str__, sizeof (__c_str__), "%u", i); }
+            explicit Cstring (long i) { snprintf (__c_str__, sizeof (__c_str__), "%li", i); }
+            explicit Cstring (unsigned long i) { snprintf (__c_str__, sizeof (__c_str__), "%lu", i); }
+            explicit Cstring (float f) { snprintf (__c_str__, sizeof (__c_str__), "%f", f); }
+            explicit Cstring (double f) { snprintf (__c_str__, sizeof (__c_str__), "%f", f); }
+
+            Cstring& operator = (const char *s) {
+                __c_str__ [0] = 0;
+                __errorFlags__ = 0;
+                return *this += s;
+            }
+
+            template<size_t M> Cstring& operator = (const Cstring<M>& other) { return *this = other.c_str (); }
+
+            Cstring& operator += (const char *s) {
+                if (!s)
+                    return *this;
+                size_t l = strlen (__c_str__);
+                while (*s && l < N)
+                    __c_str__ [l++] = *s++;
+                __c_str__ [l] = 0;
+                if (*s)
+                    __errorFlags__ |= OVERFLOW;
+                return *this;
+            }
+
+            Cstring& operator += (char c) { char s [2] = { c, 0 }; return *this += s; }
+            template<size_t M> Cstring& operator += (const Cstring<M>& other) { return *this += other.c_str (); }
+
+            Cstring operator + (const char *s) const { Cstring r = *this; r += s; return r; }
+            template<size_t M> Cstring operator + (const Cstring<M>& other) const { Cstring r = *this; r += other.c_str (); return r; }
+
+            inline bool operator == (const char *s) const __attribute__((always_inline)) { return !strcmp (__c_str__, s ? s : ""); }
+            inline bool operator != (const char *s) const __attribute__((always_inline)) { return strcmp (__c_str__, s ? s : ""); }
+            template<size_t M> bool operator == (const Cstring<M>& other) const { return !strcmp (__c_str__, other.c_str ()); }
+            template<size_t M> bool operator != (const Cstring<M>& other) const { return strcmp (__c_str__, other.c_str ()); }
+            inline bool operator < (const char *s) const __attribute__((always_inline)) { return strcmp (__c_str__, s) < 0; }
+            inline bool operator > (const char *s) const __attribute__((always_inline)) { return strcmp (__c_str__, s) > 0; }
+
+            inline operator char * () __attribute__((always_inline)) { return __c_str__; }
+            inline operator const char * () const __attribute__((always_inline)) { return __c_str__; }
+            inline const char *c_str () const __attribute__((always_inline)) { return __c_str__; }
+
+            inline char& operator [] (size_t i) __attribute__((always_inline)) { return __c_str__ [i]; }
+            inline char operator [] (size_t i) const __attribute__((always_inline)) { return __c_str__ [i]; }
+
+            inline size_t length () const __attribute__((always_inline)) { return strlen (__c_str__); }
+            inline size_t max_size () const __attribute__((always_inline)) { return N; }
+            inline unsigned char errorFlags () const __attribute__((always_inline)) { return __errorFlags__; }
+            inline void clearErrorFlags () __attribute__((always_inline)) { __errorFlags__ = 0; }
+
+        private:
+
+            char __c_str__ [N + 1] = {};
+            unsigned char __errorFlags__ = 0;
+    };
+
+#endif
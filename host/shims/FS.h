@@ -0,0 +1,50 @@
+/*
+
+    FS.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: a file system is a directory on the host's disk. The directory is taken from ESP32_HOST_FS environment
+    variable (./littlefs if it is not set) and created when the file system is mounted.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FS_H__
+    #define __HOST_FS_H__
+
+    #include <stdint.h>
+    #include <string>
+
+
+    namespace fs {
+
+        class FS {
+
+            public:
+
+                // mounts the directory, creates it if it doesn't exist yet
+                bool begin (bool formatOnFail = false, const char *basePath = NULL, uint8_t maxOpenFiles = 10, const char *partitionLabel = NULL);
+
+                // deletes everything in the directory
+                bool format ();
+
+                void end () { __mounted__ = false; }
+
+                // the host's path of path in this file system
+                std::string hostPath (const char *path);
+
+            private:
+
+                std::string __root__;
+                bool __mounted__ = false;
+
+                void __setRoot__ ();
+        };
+
+    }
+
+#endif
@@ -0,0 +1,24 @@
+/*
+
+    LittleFS.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: LittleFS is the directory from ESP32_HOST_FS environment variable (see FS.h).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_LITTLEFS_H__
+    #define __HOST_LITTLEFS_H__
+
+    #include <FS.h>
+
+    class LittleFSFS : public fs::FS {};
+
+    extern LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,70 @@
+/*
+
+    ThreadSafePing.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: ICMP sockets need privileges on most hosts, so a ping is a TCP connection attempt to port 80 (or 53)
+    instead. A refused connection also counts as a reply: the host is reachable.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __THREAD_SAFE_PING_H__
+    #define __THREAD_SAFE_PING_H__
+
+    #include <Arduino.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <errno.h>
+
+
+    class ThreadSafePing_t {
+
+        public:
+
+            ThreadSafePing_t (IPAddress target) : __target__ (target) {}
+
+            void ping (int count = 4, int interval = 1, int timeout = 1) {
+                for (int i = 0; i < count; i++) {
+                    __sent__ ++;
+                    if (__reachable__ (80, timeout * 1000) || __reachable__ (53, timeout * 1000))
+                        __received__ ++;
+                    if (i < count - 1)
+                        delay (interval * 1000);
+                }
+            }
+
+            inline int sent () __attribute__((always_inline)) { return __sent__; }
+            inline int received () __attribute__((always_inline)) { return __received__; }
+
+        private:
+
+            IPAddress __target__;
+            int __sent__ = 0;
+            int __received__ = 0;
+
+            bool __reachable__ (uint16_t port, int timeoutMs) {
+                int s = socket (AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+                if (s < 0)
+                    return false;
+                struct sockaddr_in a = {};
+                a.sin_family = AF_INET;
+                a.sin_port = htons (port);
+                a.sin_addr.s_addr = (uint32_t) __target__;
+                bool reachable = !connect (s, (struct sockaddr *) &a, sizeof (a)) || errno == ECONNREFUSED;
+                if (!reachable && errno == EINPROGRESS) {
+                    struct pollfd p = { s, POLLOUT, 0 };
+                    int error = 0;
+                    socklen_t l = sizeof (error);
+                    reachable = poll (&p, 1, timeoutMs) == 1 && !getsockopt (s, SOL_SOCKET, SO_ERROR, &error, &l) && (!error || error == ECONNREFUSED);
+                }
+                close (s);
+                return reachable;
+            }
+    };
+
+#endif
@@ -0,0 +1,82 @@
+/*
+
+    WiFi.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: WiFi is the host's network. begin () "connects" at once (the events are fired from a separate task, as
+    they are on ESP32), localIP () is the first IPv4 address of the host that is not the loopback (or 127.0.0.1 if
+    there is none) and RSSI () is simulated around -60 dBm. The servers listen on all the host's addresses anyway.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_WIFI_H__
+    #define __HOST_WIFI_H__
+
+    #include <Arduino.h>
+    #include <esp_wifi.h>
+    #include <functional>
+
+
+    typedef enum {
+        ARDUINO_EVENT_WIFI_READY = 0,
+        ARDUINO_EVENT_WIFI_STA_START,
+        ARDUINO_EVENT_WIFI_STA_STOP,
+        ARDUINO_EVENT_WIFI_STA_CONNECTED,
+        ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+        ARDUINO_EVENT_WIFI_STA_GOT_IP,
+        ARDUINO_EVENT_WIFI_STA_LOST_IP,
+        ARDUINO_EVENT_WIFI_AP_START,
+        ARDUINO_EVENT_WIFI_AP_STOP
+    } WiFiEvent_t;
+
+    typedef struct { int reason; } WiFiEventInfo_t;
+
+    typedef std::function<void (WiFiEvent_t event, WiFiEventInfo_t info)> WiFiEventFuncCb;
+
+    typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+
+    class WiFiClass {
+
+        public:
+
+            bool mode (wifi_mode_t m);
+            wifi_mode_t getMode ();
+
+            wl_status_t begin (const char *ssid = NULL, const char *password = NULL);
+            bool config (IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress (), IPAddress dns2 = IPAddress ());
+            bool disconnect (bool wifiOff = false, bool eraseAp = false);
+            bool reconnect ();
+            wl_status_t status () { return __connected__ ? WL_CONNECTED : WL_DISCONNECTED; }
+
+            bool softAP (const char *ssid, const char *password = NULL) { return ssid && *ssid; }
+            bool softAPConfig (IPAddress localIP, IPAddress gateway, IPAddress subnet) { __softAPIP__ = localIP; return true; }
+            IPAddress softAPIP () { return __softAPIP__; }
+
+            IPAddress localIP ();
+            IPAddress gatewayIP ();
+            IPAddress subnetMask () { return IPAddress (255, 255, 255, 0); }
+            int8_t RSSI ();
+
+            void onEvent (WiFiEventFuncCb callback) { __callback__ = callback; }
+
+        private:
+
+            WiFiEventFuncCb __callback__;
+            bool __connected__ = false;
+            IPAddress __staticIP__;
+            IPAddress __gateway__;
+            IPAddress __softAPIP__;
+
+            void __fire__ (WiFiEvent_t event);
+            static void __connectTask__ (void *wifi);
+    };
+
+    extern WiFiClass WiFi;
+
+#endif
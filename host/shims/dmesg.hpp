@@ -0,0 +1,110 @@
+/*
+
+    dmesg.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of the network suite's dmesg that this project uses. dmesgQueue << ... << ... collects the
+    message into a line, which is stored (with the time since boot) when the expression ends. cout << (dmesgQueue << ...)
+    also prints it.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __DMESG__
+    #define __DMESG__
+
+    #include <Arduino.h>
+    #include <ostream.hpp>
+    #include <mutex>
+    #include <string>
+
+
+    // TUNING PARAMETERS
+    #define DMESG_CIRCULAR_QUEUE_LENGTH 64  // lines kept
+
+
+    class dmesgQueue_t {
+
+        public:
+
+            class line_t {
+
+                public:
+
+                    line_t (dmesgQueue_t& queue) : __queue__ (queue) {}
+                    line_t (line_t&& other) : __queue__ (other.__queue__), __text__ (std::move (other.__text__)) { other.__moved__ = true; }
+                    ~line_t () { if (!__moved__) __queue__.__push__ (__text__); }
+
+                    line_t& operator << (const char *s) { if (s) __text__ += s; return *this; }
+                    line_t& operator << (const String& s) { __text__ += s.c_str (); return *this; }
+                    line_t& operator << (char c) { __text__ += c; return *this; }
+                    line_t& operator << (int i) { __text__ += std::to_string (i); return *this; }
+                    line_t& operator << (unsigned int i) { __text__ += std::to_string (i); return *this; }
+                    line_t& operator << (long i) { __text__ += std::to_string (i); return *this; }
+                    line_t& operator << (unsigned long i) { __text__ += std::to_string (i); return *this; }
+                    line_t& operator << (double f) { __text__ += std::to_string (f); return *this; }
+                    line_t& operator << (const IPAddress& a) { __text__ += a.toString ().c_str (); return *this; }
+
+                    inline const char *c_str () const __attribute__((always_inline)) { return __text__.c_str (); }
+
+                private:
+
+                    dmesgQueue_t& __queue__;
+                    std::string __text__;
+                    bool __moved__ = false;
+            };
+
+            template<typename T> line_t operator << (const T& value) {
+                line_t l (*this);
+                l << value;
+                return l;
+            }
+
+            // the stored lines, the oldest first, each with its time since boot
+            String toText () {
+                std::lock_guard<std::mutex> lock (__mutex__);
+                String s;
+                for (size_t i = 0; i < __count__; i++) {
+                    const __entry__& e = __entries__ [(__first__ + i) % DMESG_CIRCULAR_QUEUE_LENGTH];
+                    char t [24];
+                    snprintf (t, sizeof (t), "[%10lu] ", e.milliseconds);
+                    s += t;
+                    s += e.text.c_str ();
+                    s += "\r\n";
+                }
+                return s;
+            }
+
+        private:
+
+            struct __entry__ {
+                unsigned long milliseconds;
+                std::string text;
+            };
+
+            __entry__ __entries__ [DMESG_CIRCULAR_QUEUE_LENGTH];
+            size_t __first__ = 0;
+            size_t __count__ = 0;
+            std::mutex __mutex__;
+
+            void __push__ (std::string& text) {
+                std::lock_guard<std::mutex> lock (__mutex__);
+                if (__count__ == DMESG_CIRCULAR_QUEUE_LENGTH) {
+                    __first__ = (__first__ + 1) % DMESG_CIRCULAR_QUEUE_LENGTH;
+                    __count__ --;
+                }
+                __entry__& e = __entries__ [(__first__ + __count__ ++) % DMESG_CIRCULAR_QUEUE_LENGTH];
+                e.milliseconds = millis ();
+                e.text.swap (text);
+            }
+    };
+
+    inline dmesgQueue_t dmesgQueue;
+
+    inline ostream& operator << (ostream& o, const dmesgQueue_t::line_t& l) { o << l.c_str () << "\r\n"; return o; }
+
+#endif
@@ -0,0 +1,35 @@
+/*
+
+    driver/adc.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the simulated ADC. Each ADC1 channel reads a 12 bit sine wave around the middle of the range, channel n
+    at (n + 1) * 50 Hz, with a few LSB of noise, so the oscilloscope has something to show and trigger on.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_DRIVER_ADC_H__
+    #define __HOST_DRIVER_ADC_H__
+
+    #include <esp_system.h>
+
+    typedef enum { ADC_UNIT_1 = 1, ADC_UNIT_2 = 2 } adc_unit_t;
+
+    typedef enum {
+        ADC1_CHANNEL_0 = 0, ADC1_CHANNEL_1, ADC1_CHANNEL_2, ADC1_CHANNEL_3, ADC1_CHANNEL_4,
+        ADC1_CHANNEL_5, ADC1_CHANNEL_6, ADC1_CHANNEL_7, ADC1_CHANNEL_8, ADC1_CHANNEL_9, ADC1_CHANNEL_MAX
+    } adc1_channel_t;
+
+    typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+    typedef enum { ADC_ATTEN_DB_0 = 0, ADC_ATTEN_DB_11 = 3 } adc_atten_t;
+
+    int adc1_get_raw (adc1_channel_t channel);
+    inline esp_err_t adc1_config_width (adc_bits_width_t) { return ESP_OK; }
+    inline esp_err_t adc1_config_channel_atten (adc1_channel_t, adc_atten_t) { return ESP_OK; }
+
+#endif
@@ -0,0 +1,26 @@
+/*
+
+    driver/gpio.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: GPIO numbers of the ESP32 (the host build maps the ADC channels as an ESP32 does).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_DRIVER_GPIO_H__
+    #define __HOST_DRIVER_GPIO_H__
+
+    #include <esp_system.h>
+
+    #define CONFIG_IDF_TARGET_ESP32 1
+    #define CONFIG_IDF_TARGET "esp32"
+
+    typedef enum { GPIO_NUM_NC = -1, GPIO_NUM_0 = 0, GPIO_NUM_MAX = 40 } gpio_num_t;
+    typedef enum { GPIO_PORT_0 = 0 } gpio_port_t;
+
+#endif
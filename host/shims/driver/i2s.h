@@ -0,0 +1,48 @@
+/*
+
+    driver/i2s.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: there is no I2S, the driver can not be installed, so the oscilloscope reports it if USE_I2S_INTERFACE is
+    defined (it samples with adc1_get_raw otherwise).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_DRIVER_I2S_H__
+    #define __HOST_DRIVER_I2S_H__
+
+    #include <esp_system.h>
+    #include <driver/adc.h>
+
+    typedef enum { I2S_NUM_0 = 0 } i2s_port_t;
+    typedef enum { I2S_MODE_MASTER = 1, I2S_MODE_RX = 8, I2S_MODE_ADC_BUILT_IN = 32 } i2s_mode_t;
+    typedef enum { I2S_BITS_PER_SAMPLE_16BIT = 16 } i2s_bits_per_sample_t;
+    typedef enum { I2S_CHANNEL_FMT_RIGHT_LEFT = 0, I2S_CHANNEL_FMT_ONLY_LEFT = 4 } i2s_channel_fmt_t;
+    typedef enum { I2S_COMM_FORMAT_STAND_I2S = 1, I2S_COMM_FORMAT_I2S_MSB = 2 } i2s_comm_format_t;
+
+    typedef struct {
+        i2s_mode_t mode;
+        uint32_t sample_rate;
+        i2s_bits_per_sample_t bits_per_sample;
+        i2s_channel_fmt_t channel_format;
+        i2s_comm_format_t communication_format;
+        int intr_alloc_flags;
+        int dma_buf_count;
+        int dma_buf_len;
+        bool use_apll;
+        bool tx_desc_auto_clear;
+        int fixed_mclk;
+    } i2s_config_t;
+
+    inline esp_err_t i2s_driver_install (i2s_port_t, const i2s_config_t *, int, void *) { return ESP_FAIL; }
+    inline esp_err_t i2s_driver_uninstall (i2s_port_t) { return ESP_OK; }
+    inline esp_err_t i2s_set_adc_mode (adc_unit_t, adc1_channel_t) { return ESP_FAIL; }
+    inline esp_err_t i2s_adc_enable (i2s_port_t) { return ESP_FAIL; }
+    inline esp_err_t i2s_read (i2s_port_t, void *, size_t, size_t *bytesRead, uint32_t) { if (bytesRead) *bytesRead = 0; return ESP_FAIL; }
+
+#endif
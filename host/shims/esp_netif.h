@@ -0,0 +1,25 @@
+/*
+
+    esp_netif.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the host's network interfaces are not renamed, so there are no esp_netif adapters.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ESP_NETIF_H__
+    #define __HOST_ESP_NETIF_H__
+
+    #include <esp_system.h>
+
+    typedef struct esp_netif_obj esp_netif_t;
+
+    inline esp_netif_t *esp_netif_next_unsafe (esp_netif_t *) { return NULL; }
+    inline esp_err_t esp_netif_set_hostname (esp_netif_t *, const char *) { return ESP_OK; }
+
+#endif
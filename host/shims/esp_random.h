@@ -0,0 +1,24 @@
+/*
+
+    esp_random.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: random numbers from the kernel (getrandom) instead of the hardware RNG.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ESP_RANDOM_H__
+    #define __HOST_ESP_RANDOM_H__
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    uint32_t esp_random ();
+    void esp_fill_random (void *buf, size_t len);
+
+#endif
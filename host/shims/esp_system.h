@@ -0,0 +1,28 @@
+/*
+
+    esp_system.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: each run of the process is a power-on reset.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ESP_SYSTEM_H__
+    #define __HOST_ESP_SYSTEM_H__
+
+    #include <esp_random.h>
+
+    typedef int esp_err_t;
+    #define ESP_OK 0
+    #define ESP_FAIL -1
+
+    typedef enum { ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO } esp_reset_reason_t;
+
+    inline esp_reset_reason_t esp_reset_reason () { return ESP_RST_POWERON; }
+
+#endif
@@ -0,0 +1,22 @@
+/*
+
+    esp_timer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: microseconds since the process started, which is what the host build considers the boot.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ESP_TIMER_H__
+    #define __HOST_ESP_TIMER_H__
+
+    #include <stdint.h>
+
+    int64_t esp_timer_get_time ();
+
+#endif
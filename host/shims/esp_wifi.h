@@ -0,0 +1,34 @@
+/*
+
+    esp_wifi.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: WiFi mode and power saving settings, kept in memory.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ESP_WIFI_H__
+    #define __HOST_ESP_WIFI_H__
+
+    #include <esp_system.h>
+
+
+    typedef enum { WIFI_MODE_NULL = 0, WIFI_MODE_STA, WIFI_MODE_AP, WIFI_MODE_APSTA } wifi_mode_t;
+
+    #define WIFI_OFF    WIFI_MODE_NULL
+    #define WIFI_STA    WIFI_MODE_STA
+    #define WIFI_AP     WIFI_MODE_AP
+    #define WIFI_AP_STA WIFI_MODE_APSTA
+
+    typedef enum { WIFI_PS_NONE = 0, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+    esp_err_t esp_wifi_get_mode (wifi_mode_t *mode);
+    esp_err_t esp_wifi_get_ps (wifi_ps_type_t *type);
+    esp_err_t esp_wifi_set_ps (wifi_ps_type_t type);
+
+#endif
@@ -0,0 +1,53 @@
+/*
+
+    freertos/FreeRTOS.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: FreeRTOS tasks, queues, semaphores and event groups on pthreads (see hostFreeRTOS.cpp). A tick is 1 ms,
+    priorities and core affinity are kept but not enforced, all the tasks are scheduled by the host's kernel.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FREERTOS_H__
+    #define __HOST_FREERTOS_H__
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    typedef int BaseType_t;
+    typedef unsigned int UBaseType_t;
+    typedef uint32_t TickType_t;
+    typedef uint32_t StackType_t;
+    typedef uint32_t configSTACK_DEPTH_TYPE;
+
+    #define pdPASS 1
+    #define pdFAIL 0
+    #define pdTRUE 1
+    #define pdFALSE 0
+    #define portMAX_DELAY ((TickType_t) 0xffffffff)
+    #define portTICK_PERIOD_MS 1
+    #define pdMS_TO_TICKS(ms) ((TickType_t) (ms))
+    #define pdTICKS_TO_MS(ticks) ((uint32_t) (ticks))
+    #define portNUM_PROCESSORS 2
+    #define tskNO_AFFINITY 0x7fffffff
+
+    #define configMAX_PRIORITIES 25
+    #define configMAX_TASK_NAME_LEN 16
+    #define configUSE_TRACE_FACILITY 1
+    #define configGENERATE_RUN_TIME_STATS 1
+    #define configTASKLIST_INCLUDE_COREID 1
+
+    // critical sections are only used around a few instructions, a single process-wide lock is good enough
+    typedef struct { int owner; int count; } portMUX_TYPE;
+    #define portMUX_INITIALIZER_UNLOCKED { 0, 0 }
+    void vPortEnterCritical (portMUX_TYPE *mux);
+    void vPortExitCritical (portMUX_TYPE *mux);
+    #define portENTER_CRITICAL(mux) vPortEnterCritical (mux)
+    #define portEXIT_CRITICAL(mux) vPortExitCritical (mux)
+
+#endif
@@ -0,0 +1,30 @@
+/*
+
+    freertos/event_groups.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: event groups, as used by startupScheduler_t.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FREERTOS_EVENT_GROUPS_H__
+    #define __HOST_FREERTOS_EVENT_GROUPS_H__
+
+    #include "FreeRTOS.h"
+
+    typedef struct hostEventGroup *EventGroupHandle_t;
+    typedef uint32_t EventBits_t;
+
+    EventGroupHandle_t xEventGroupCreate ();
+    EventBits_t xEventGroupSetBits (EventGroupHandle_t group, EventBits_t bits);
+    EventBits_t xEventGroupClearBits (EventGroupHandle_t group, EventBits_t bits);
+    EventBits_t xEventGroupGetBits (EventGroupHandle_t group);
+    EventBits_t xEventGroupWaitBits (EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit, BaseType_t waitForAllBits, TickType_t ticksToWait);
+    void vEventGroupDelete (EventGroupHandle_t group);
+
+#endif
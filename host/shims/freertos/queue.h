@@ -0,0 +1,28 @@
+/*
+
+    freertos/queue.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: fixed size queues of items copied by value, with a mutex and a condition variable.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FREERTOS_QUEUE_H__
+    #define __HOST_FREERTOS_QUEUE_H__
+
+    #include "FreeRTOS.h"
+
+    typedef struct hostQueue *QueueHandle_t;
+
+    QueueHandle_t xQueueCreate (UBaseType_t length, UBaseType_t itemSize);
+    BaseType_t xQueueSend (QueueHandle_t queue, const void *item, TickType_t ticksToWait);
+    BaseType_t xQueueReceive (QueueHandle_t queue, void *item, TickType_t ticksToWait);
+    UBaseType_t uxQueueMessagesWaiting (QueueHandle_t queue);
+    void vQueueDelete (QueueHandle_t queue);
+
+#endif
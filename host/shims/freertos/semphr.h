@@ -0,0 +1,30 @@
+/*
+
+    freertos/semphr.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: semaphores are queues of empty items, as they are in FreeRTOS, a mutex starts with one item.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FREERTOS_SEMPHR_H__
+    #define __HOST_FREERTOS_SEMPHR_H__
+
+    #include "FreeRTOS.h"
+    #include "queue.h"
+
+    typedef QueueHandle_t SemaphoreHandle_t;
+
+    SemaphoreHandle_t xSemaphoreCreateCounting (UBaseType_t maxCount, UBaseType_t initialCount);
+    SemaphoreHandle_t xSemaphoreCreateBinary ();
+    SemaphoreHandle_t xSemaphoreCreateMutex ();
+    BaseType_t xSemaphoreTake (SemaphoreHandle_t semaphore, TickType_t ticksToWait);
+    BaseType_t xSemaphoreGive (SemaphoreHandle_t semaphore);
+    void vSemaphoreDelete (SemaphoreHandle_t semaphore);
+
+#endif
@@ -0,0 +1,54 @@
+/*
+
+    freertos/task.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: each task is a pthread. vTaskDelete (NULL) ends the calling thread, deleting another task cancels its
+    thread. uxTaskGetSystemState reports the CPU time of each thread in us, as FreeRTOS' run time counter does.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_FREERTOS_TASK_H__
+    #define __HOST_FREERTOS_TASK_H__
+
+    #include "FreeRTOS.h"
+
+    typedef struct hostTask *TaskHandle_t;
+    typedef void (*TaskFunction_t) (void *);
+
+    typedef enum { eRunning = 0, eReady, eBlocked, eSuspended, eDeleted, eInvalid } eTaskState;
+
+    typedef struct {
+        TaskHandle_t xHandle;
+        const char *pcTaskName;
+        UBaseType_t xTaskNumber;
+        eTaskState eCurrentState;
+        UBaseType_t uxCurrentPriority;
+        UBaseType_t uxBasePriority;
+        uint32_t ulRunTimeCounter;
+        StackType_t *pxStackBase;
+        configSTACK_DEPTH_TYPE usStackHighWaterMark;
+        BaseType_t xCoreID;
+    } TaskStatus_t;
+
+    BaseType_t xTaskCreatePinnedToCore (TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameters, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+    inline BaseType_t xTaskCreate (TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameters, UBaseType_t priority, TaskHandle_t *handle) {
+        return xTaskCreatePinnedToCore (function, name, stackDepth, parameters, priority, handle, tskNO_AFFINITY);
+    }
+    void vTaskDelete (TaskHandle_t task);
+    void vTaskDelay (TickType_t ticks);
+    void vTaskDelayUntil (TickType_t *previousWakeTime, TickType_t increment);
+    TickType_t xTaskGetTickCount ();
+    TaskHandle_t xTaskGetCurrentTaskHandle ();
+    const char *pcTaskGetName (TaskHandle_t task);
+    UBaseType_t uxTaskGetNumberOfTasks ();
+    UBaseType_t uxTaskGetSystemState (TaskStatus_t *statusArray, UBaseType_t arraySize, uint32_t *totalRunTime);
+    UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t task);
+    BaseType_t xPortGetCoreID ();
+
+#endif
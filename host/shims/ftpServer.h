@@ -0,0 +1,39 @@
+/*
+
+    ftpServer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: ftpServer_t comes from the network suite library, which is not part of this project, so it never
+    listens on the host (operator bool is false). getUserHomeDirectoryCallback can still be called directly.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __FTP_SERVER__
+    #define __FTP_SERVER__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <Cstring.hpp>
+
+
+    class ftpServer_t {
+
+        public:
+
+            ftpServer_t (threadSafeFS::FS& fileSystem,
+                         Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL,
+                         int serverPort = 21,
+                         bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                         bool runListenerInItsOwnTask = true) {}
+
+            inline operator bool () __attribute__((always_inline)) { return false; }
+
+            void accept () {}
+    };
+
+#endif
@@ -0,0 +1,30 @@
+/*
+
+    hal/gpio_hal.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: reading the level of a GPIO goes to the simulated pins (see hostArduino.cpp): the level written last by
+    digitalWrite, or, for the pins that were never written, a 50 Hz square wave.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_HAL_GPIO_HAL_H__
+    #define __HOST_HAL_GPIO_HAL_H__
+
+    #include <driver/gpio.h>
+
+    typedef struct { int dev; } gpio_hal_context_t;
+
+    #define GPIO_HAL_GET_HW(port) (port)
+
+    int hostGpioLevel (int gpio);
+
+    inline void gpio_hal_input_enable (gpio_hal_context_t *, int) {}
+    inline int gpio_hal_get_level (gpio_hal_context_t *, int gpio) { return hostGpioLevel (gpio); }
+
+#endif
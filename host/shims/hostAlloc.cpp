@@ -0,0 +1,80 @@
+/*
+
+    hostAlloc.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: replaces glibc's malloc family with counting wrappers around the __libc_ functions.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "hostAlloc.h"
+#include <atomic>
+#include <errno.h>
+#include <stddef.h>
+#include <malloc.h>
+
+
+extern "C" {
+    void *__libc_malloc (size_t size);
+    void *__libc_calloc (size_t n, size_t size);
+    void *__libc_realloc (void *p, size_t size);
+    void *__libc_memalign (size_t alignment, size_t size);
+    void __libc_free (void *p);
+}
+
+static std::atomic<uint64_t> __allocations__ { 0 };
+static std::atomic<int64_t> __inUse__ { 0 };
+static std::atomic<int64_t> __baseline__ { 0 };
+static std::atomic<int64_t> __maxInUse__ { 0 };
+
+static inline void *__allocated__ (void *p) {
+    if (p) {
+        __allocations__.fetch_add (1, std::memory_order_relaxed);
+        int64_t inUse = __inUse__.fetch_add (malloc_usable_size (p), std::memory_order_relaxed) + malloc_usable_size (p);
+        int64_t max = __maxInUse__.load (std::memory_order_relaxed);
+        while (inUse > max && !__maxInUse__.compare_exchange_weak (max, inUse, std::memory_order_relaxed));
+    }
+    return p;
+}
+
+static inline void __freed__ (void *p) {
+    if (p)
+        __inUse__.fetch_sub (malloc_usable_size (p), std::memory_order_relaxed);
+}
+
+extern "C" {
+
+    void *malloc (size_t size) { return __allocated__ (__libc_malloc (size)); }
+    void *calloc (size_t n, size_t size) { return __allocated__ (__libc_calloc (n, size)); }
+    void free (void *p) { __freed__ (p); __libc_free (p); }
+
+    void *realloc (void *p, size_t size) {
+        __freed__ (p);
+        void *q = __libc_realloc (p, size);
+        if (!q && p && size)
+            __inUse__.fetch_add (malloc_usable_size (p), std::memory_order_relaxed); // p is still allocated
+        return __allocated__ (q);
+    }
+
+    void *memalign (size_t alignment, size_t size) { return __allocated__ (__libc_memalign (alignment, size)); }
+    void *aligned_alloc (size_t alignment, size_t size) { return memalign (alignment, size); }
+
+    int posix_memalign (void **p, size_t alignment, size_t size) {
+        *p = memalign (alignment, size);
+        return *p ? 0 : ENOMEM;
+    }
+
+}
+
+uint64_t hostAllocations () { return __allocations__.load (); }
+int64_t hostHeapInUse () { return __inUse__.load () - __baseline__.load (); }
+int64_t hostHeapMaxInUse () { return __maxInUse__.load () - __baseline__.load (); }
+
+void hostHeapBaseline () {
+    __baseline__ = __inUse__.load ();
+    __maxInUse__ = __inUse__.load ();
+}
@@ -0,0 +1,27 @@
+/*
+
+    hostAlloc.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: malloc, calloc, realloc, free (and new and delete, which call them) are counted, so the benchmark can
+    tell how many heap allocations each request makes. The simulated free heap is HOST_HEAP_SIZE minus the bytes
+    allocated since hostHeapBaseline () was called.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_ALLOC_H__
+    #define __HOST_ALLOC_H__
+
+    #include <stdint.h>
+
+    uint64_t hostAllocations ();    // calls of malloc, calloc, realloc, ... so far, in all the threads
+    int64_t hostHeapInUse ();       // bytes allocated since hostHeapBaseline ()
+    int64_t hostHeapMaxInUse ();
+    void hostHeapBaseline ();
+
+#endif
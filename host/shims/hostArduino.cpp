@@ -0,0 +1,129 @@
+/*
+
+    hostArduino.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: time, random numbers, heap figures, the simulated pins and the simulated ADC.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <hal/gpio_hal.h>
+#include <sys/random.h>
+#include <atomic>
+#include "hostAlloc.h"
+
+
+HardwareSerial Serial;
+EspClass ESP;
+
+
+// ----- time -----
+
+static int64_t __monotonicUs__ () {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const int64_t __boot__ = __monotonicUs__ ();
+
+int64_t esp_timer_get_time () {
+    return __monotonicUs__ () - __boot__;
+}
+
+
+// ----- random numbers -----
+
+void esp_fill_random (void *buf, size_t len) {
+    uint8_t *p = (uint8_t *) buf;
+    while (len) {
+        ssize_t l = getrandom (p, len, 0);
+        if (l <= 0)
+            continue; // interrupted, the kernel's pool is always initialized once the system runs
+        p += l;
+        len -= l;
+    }
+}
+
+uint32_t esp_random () {
+    uint32_t r;
+    esp_fill_random (&r, sizeof (r));
+    return r;
+}
+
+
+// ----- heap -----
+
+uint32_t EspClass::getFreeHeap () {
+    int64_t f = HOST_HEAP_SIZE - hostHeapInUse ();
+    return f < 0 ? 0 : (uint32_t) f;
+}
+
+uint32_t EspClass::getMinFreeHeap () {
+    int64_t f = HOST_HEAP_SIZE - hostHeapMaxInUse ();
+    return f < 0 ? 0 : (uint32_t) f;
+}
+
+size_t heap_caps_get_free_size (uint32_t) {
+    return ESP.getFreeHeap ();
+}
+
+size_t heap_caps_get_largest_free_block (uint32_t) {
+    return ESP.getFreeHeap (); // the host's heap is not fragmented the way the ESP32's is
+}
+
+
+// ----- pins -----
+
+static std::atomic<int8_t> __pins__ [GPIO_NUM_MAX]; // -1 = never written
+
+static struct __pinsInitializer__ {
+    __pinsInitializer__ () { for (auto& p : __pins__) p = -1; }
+} __pinsInitializer__;
+
+void pinMode (uint8_t, uint8_t) {}
+
+void digitalWrite (uint8_t pin, uint8_t value) {
+    if (pin < GPIO_NUM_MAX)
+        __pins__ [pin] = value ? HIGH : LOW;
+}
+
+int hostGpioLevel (int gpio) {
+    if (gpio >= 0 && gpio < GPIO_NUM_MAX && __pins__ [gpio] >= 0)
+        return __pins__ [gpio];
+    return (esp_timer_get_time () / 10000) & 1; // 50 Hz square wave
+}
+
+int digitalRead (uint8_t pin) {
+    return hostGpioLevel (pin);
+}
+
+
+// ----- ADC -----
+
+int adc1_get_raw (adc1_channel_t channel) {
+    double t = esp_timer_get_time () / 1000000.0;
+    double v = 2048 + 1800 * sin (2 * M_PI * 50 * (channel + 1) * t) + (int) (esp_random () % 17) - 8;
+    return v < 0 ? 0 : v > 4095 ? 4095 : (int) v;
+}
+
+uint16_t analogRead (uint8_t pin) {
+    // ADC1 channels of ESP32's GPIOs, the other pins read channel 0
+    switch (pin) {
+        case 36: return adc1_get_raw (ADC1_CHANNEL_0);
+        case 37: return adc1_get_raw (ADC1_CHANNEL_1);
+        case 38: return adc1_get_raw (ADC1_CHANNEL_2);
+        case 39: return adc1_get_raw (ADC1_CHANNEL_3);
+        case 32: return adc1_get_raw (ADC1_CHANNEL_4);
+        case 33: return adc1_get_raw (ADC1_CHANNEL_5);
+        case 34: return adc1_get_raw (ADC1_CHANNEL_6);
+        case 35: return adc1_get_raw (ADC1_CHANNEL_7);
+        default: return adc1_get_raw (ADC1_CHANNEL_0);
+    }
+}
@@ -0,0 +1,317 @@
+/*
+
+    hostFS.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: file systems in directories of the host's disk.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <LittleFS.h>
+#include <threadSafeFS.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ftw.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mutex>
+
+
+LittleFSFS LittleFS;
+
+
+// ----- fs::FS -----
+
+void fs::FS::__setRoot__ () {
+    if (__root__.empty ()) {
+        const char *root = getenv ("ESP32_HOST_FS");
+        __root__ = root && *root ? root : "./littlefs";
+        while (__root__.length () > 1 && __root__.back () == '/')
+            __root__.pop_back ();
+    }
+}
+
+bool fs::FS::begin (bool, const char *, uint8_t, const char *) {
+    __setRoot__ ();
+    struct stat st;
+    if (stat (__root__.c_str (), &st) && ::mkdir (__root__.c_str (), 0755))
+        return false;
+    return __mounted__ = !stat (__root__.c_str (), &st) && S_ISDIR (st.st_mode);
+}
+
+static int __removeEntry__ (const char *path, const struct stat *, int, struct FTW *ftw) {
+    return ftw->level ? ::remove (path) : 0; // keep the root
+}
+
+bool fs::FS::format () {
+    __setRoot__ ();
+    return !nftw (__root__.c_str (), __removeEntry__, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+std::string fs::FS::hostPath (const char *path) {
+    __setRoot__ ();
+    std::string p = __root__;
+    if (!path || *path != '/')
+        p += '/';
+    if (path)
+        p += path;
+    while (p.length () > __root__.length () + 1 && p.back () == '/')
+        p.pop_back ();
+    return p;
+}
+
+
+// ----- power loss simulation -----
+
+static std::mutex __powerLossMutex__;
+static long __powerLossSteps__ = -1;    // steps left until the power is cut, -1 if it is not simulated
+static long __stepsMade__ = 0;
+
+void hostFSPowerLossAfter (long steps) {
+    std::lock_guard<std::mutex> lock (__powerLossMutex__);
+    __powerLossSteps__ = steps;
+}
+
+long hostFSSteps () {
+    std::lock_guard<std::mutex> lock (__powerLossMutex__);
+    return __stepsMade__;
+}
+
+static bool __powerLossSimulated__ () {
+    std::lock_guard<std::mutex> lock (__powerLossMutex__);
+    return __powerLossSteps__ >= 0;
+}
+
+// returns how many of n steps are made before the power is cut
+static size_t __makeSteps__ (size_t n) {
+    std::lock_guard<std::mutex> lock (__powerLossMutex__);
+    if (__powerLossSteps__ >= 0) {
+        if ((long) n > __powerLossSteps__)
+            n = __powerLossSteps__;
+        __powerLossSteps__ -= n;
+    }
+    __stepsMade__ += n;
+    return n;
+}
+
+void threadSafeFS::File::__handle__::commit () {
+    if (pending.empty () || !file)
+        return;
+    if (__makeSteps__ (1)) {
+        long position = ftell (file);
+        for (auto& p : pending)
+            if (fseek (file, p.first, SEEK_SET) || fwrite (p.second.data (), 1, p.second.size (), file) != p.second.size ())
+                break;
+        fseek (file, position, SEEK_SET);
+    }
+    pending.clear ();
+}
+
+
+// ----- threadSafeFS::File -----
+
+int threadSafeFS::File::read (uint8_t *buf, size_t size) {
+    if (!__h__ || !__h__->file)
+        return -1;
+    size_t l = fread (buf, 1, size, __h__->file);
+    return l == 0 && ferror (__h__->file) ? -1 : (int) l;
+}
+
+int threadSafeFS::File::read () {
+    uint8_t c;
+    return read (&c, 1) == 1 ? c : -1;
+}
+
+size_t threadSafeFS::File::write (const uint8_t *buf, size_t size) {
+    if (!__h__ || !__h__->file)
+        return 0;
+    if (__h__->inPlace && __powerLossSimulated__ ()) {
+        long position = ftell (__h__->file);
+        __h__->pending.push_back ({ position, std::string ((const char *) buf, size) });
+        fseek (__h__->file, position + size, SEEK_SET);
+        return size;
+    }
+    size_t n = __makeSteps__ (size);
+    size_t written = fwrite (buf, 1, n, __h__->file);
+    if (n < size)
+        fflush (__h__->file); // what has been written before the power was cut stays on the disk
+    return written;
+}
+
+size_t threadSafeFS::File::print (const char *s) {
+    return write ((const uint8_t *) s, strlen (s));
+}
+
+size_t threadSafeFS::File::printf (const char *format, ...) {
+    if (!__h__ || !__h__->file)
+        return 0;
+    va_list args;
+    va_start (args, format);
+    char *s = NULL;
+    int l = vasprintf (&s, format, args);
+    va_end (args);
+    if (l < 0)
+        return 0;
+    size_t written = write ((const uint8_t *) s, l);
+    free (s);
+    return written;
+}
+
+bool threadSafeFS::File::seek (uint32_t position) {
+    return __h__ && __h__->file && !fseek (__h__->file, position, SEEK_SET);
+}
+
+size_t threadSafeFS::File::position () {
+    if (!__h__ || !__h__->file)
+        return 0;
+    long p = ftell (__h__->file);
+    return p < 0 ? 0 : p;
+}
+
+size_t threadSafeFS::File::size () {
+    if (!__h__ || !__h__->file)
+        return 0;
+    fflush (__h__->file);
+    struct stat st;
+    return fstat (fileno (__h__->file), &st) ? 0 : st.st_size;
+}
+
+void threadSafeFS::File::flush () {
+    if (__h__ && __h__->file) {
+        __h__->commit ();
+        fflush (__h__->file);
+    }
+}
+
+void threadSafeFS::File::close () {
+    if (__h__) {
+        __h__->commit ();
+        if (__h__->file)
+            fclose (__h__->file);
+        if (__h__->dir)
+            closedir (__h__->dir);
+        __h__->file = NULL;
+        __h__->dir = NULL;
+        __h__.reset ();
+    }
+}
+
+const char *threadSafeFS::File::name () const {
+    if (!__h__)
+        return "";
+    const char *s = strrchr (__h__->path.c_str (), '/');
+    return s ? s + 1 : __h__->path.c_str ();
+}
+
+time_t threadSafeFS::File::getLastWrite () {
+    struct stat st;
+    if (!__h__ || stat (__h__->hostPath.c_str (), &st))
+        return 0;
+    return st.st_mtime;
+}
+
+threadSafeFS::File threadSafeFS::File::openNextFile (const char *mode) {
+    File f;
+    if (!__h__ || !__h__->dir)
+        return f;
+    struct dirent *e;
+    while ((e = readdir (__h__->dir)) && (!strcmp (e->d_name, ".") || !strcmp (e->d_name, "..")));
+    if (!e)
+        return f;
+
+    f.__h__ = std::make_shared<__handle__> ();
+    f.__h__->path = __h__->path + (__h__->path.length () > 1 ? "/" : "") + e->d_name;
+    f.__h__->hostPath = __h__->hostPath + "/" + e->d_name;
+    struct stat st;
+    if (!stat (f.__h__->hostPath.c_str (), &st) && S_ISDIR (st.st_mode))
+        f.__h__->dir = opendir (f.__h__->hostPath.c_str ());
+    else
+        f.__h__->file = fopen (f.__h__->hostPath.c_str (), *mode == 'r' ? "rb" : "r+b");
+    if (!f.__h__->file && !f.__h__->dir)
+        f.__h__.reset ();
+    return f;
+}
+
+
+// ----- threadSafeFS::FS -----
+
+threadSafeFS::File threadSafeFS::FS::open (const char *path, const char *mode, bool) {
+    File f;
+    f.__h__ = std::make_shared<File::__handle__> ();
+    f.__h__->path = path;
+    f.__h__->hostPath = __fileSystem__.hostPath (path);
+    struct stat st;
+    if (*mode == 'r' && !stat (f.__h__->hostPath.c_str (), &st) && S_ISDIR (st.st_mode)) {
+        f.__h__->dir = opendir (f.__h__->hostPath.c_str ());
+    } else if (*mode == 'r' || __makeSteps__ (1)) { // "w" and "a" create or truncate the file
+        char m [4] = { mode [0], 'b', mode [1] == '+' ? '+' : '\0', '\0' };
+        f.__h__->file = fopen (f.__h__->hostPath.c_str (), m);
+        f.__h__->inPlace = !strcmp (mode, "r+");
+    }
+    if (!f.__h__->file && !f.__h__->dir)
+        f.__h__.reset ();
+    return f;
+}
+
+bool threadSafeFS::FS::exists (const char *path) {
+    struct stat st;
+    return !stat (__fileSystem__.hostPath (path).c_str (), &st);
+}
+
+bool threadSafeFS::FS::isFile (const char *path) {
+    struct stat st;
+    return !stat (__fileSystem__.hostPath (path).c_str (), &st) && S_ISREG (st.st_mode);
+}
+
+bool threadSafeFS::FS::isDirectory (const char *path) {
+    struct stat st;
+    return !stat (__fileSystem__.hostPath (path).c_str (), &st) && S_ISDIR (st.st_mode);
+}
+
+bool threadSafeFS::FS::mkdir (const char *path) {
+    return __makeSteps__ (1) && !::mkdir (__fileSystem__.hostPath (path).c_str (), 0755);
+}
+
+bool threadSafeFS::FS::rmdir (const char *path) {
+    return __makeSteps__ (1) && !::rmdir (__fileSystem__.hostPath (path).c_str ());
+}
+
+bool threadSafeFS::FS::remove (const char *path) {
+    return __makeSteps__ (1) && !::unlink (__fileSystem__.hostPath (path).c_str ());
+}
+
+bool threadSafeFS::FS::rename (const char *pathFrom, const char *pathTo) {
+    return __makeSteps__ (1) && !::rename (__fileSystem__.hostPath (pathFrom).c_str (), __fileSystem__.hostPath (pathTo).c_str ());
+}
+
+bool threadSafeFS::FS::readConfiguration (char *buffer, size_t bufferSize, const char *path) {
+    FILE *f = fopen (__fileSystem__.hostPath (path).c_str (), "rb");
+    if (!f)
+        return false;
+    size_t i = 0;
+    char line [256];
+    while (fgets (line, sizeof (line), f)) {
+        char *comment = strchr (line, '#');
+        if (comment)
+            *comment = 0;
+        char *s = line;
+        while (*s && *s <= ' ')
+            s++;
+        char *e = s + strlen (s);
+        while (e > s && e [-1] <= ' ')
+            *--e = 0;
+        if (!*s)
+            continue;
+        if (i && i < bufferSize)
+            buffer [i++] = '\n';
+        for (; *s && i < bufferSize; s++)
+            buffer [i++] = *s;
+    }
+    buffer [i] = 0;
+    fclose (f);
+    return true;
+}
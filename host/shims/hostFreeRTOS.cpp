@@ -0,0 +1,303 @@
+/*
+
+    hostFreeRTOS.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: FreeRTOS tasks on pthreads, queues, semaphores and event groups on mutexes and condition variables.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/event_groups.h>
+#include <esp_timer.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+
+// ----- tasks -----
+
+struct hostTask {
+    pthread_t thread;
+    TaskFunction_t function;
+    void *parameters;
+    char name [configMAX_TASK_NAME_LEN];
+    UBaseType_t number;
+    UBaseType_t priority;
+    BaseType_t core;
+    uint32_t stackDepth;
+};
+
+static std::mutex __tasksMutex__;
+static std::vector<hostTask *> __tasks__;
+static UBaseType_t __lastTaskNumber__ = 0;
+static thread_local hostTask *__currentTask__ = NULL;
+
+// setup () and loop () run in loopTask, which is the main thread of the process
+static struct __loopTask__ {
+    hostTask task;
+    __loopTask__ () {
+        task = { pthread_self (), NULL, NULL, "loopTask", ++ __lastTaskNumber__, 1, 1, 8192 };
+        __currentTask__ = &task;
+        __tasks__.push_back (&task);
+    }
+} __loopTask__;
+
+static void __unregister__ (hostTask *t) {
+    std::lock_guard<std::mutex> lock (__tasksMutex__);
+    __tasks__.erase (std::remove (__tasks__.begin (), __tasks__.end (), t), __tasks__.end ());
+}
+
+static void *__taskEntry__ (void *p) {
+    hostTask *t = (hostTask *) p;
+    __currentTask__ = t;
+    // runs when the function returns, when vTaskDelete (NULL) ends the thread and when the thread is cancelled
+    struct cleanup { hostTask *t; ~cleanup () { __unregister__ (t); delete t; } } c { t };
+    t->function (t->parameters);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore (TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameters, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core) {
+    hostTask *t = new (std::nothrow) hostTask {};
+    if (!t)
+        return pdFAIL;
+    t->function = function;
+    t->parameters = parameters;
+    strncpy (t->name, name ? name : "", sizeof (t->name) - 1);
+    t->priority = priority;
+    t->core = core;
+    t->stackDepth = stackDepth;
+
+    // the host's code needs more stack than the ESP32's, so the default pthread stack is used instead of stackDepth
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    std::unique_lock<std::mutex> lock (__tasksMutex__);
+        t->number = ++ __lastTaskNumber__;
+        __tasks__.push_back (t);
+        bool created = pthread_create (&t->thread, &attr, __taskEntry__, t) == 0;
+        if (!created)
+            __tasks__.pop_back ();
+    lock.unlock ();
+    pthread_attr_destroy (&attr);
+    if (!created) {
+        delete t;
+        return pdFAIL;
+    }
+    if (handle)
+        *handle = t;
+    return pdPASS;
+}
+
+void vTaskDelete (TaskHandle_t task) {
+    if (!task || task == __currentTask__)
+        pthread_exit (NULL);
+    std::lock_guard<std::mutex> lock (__tasksMutex__);
+    if (std::find (__tasks__.begin (), __tasks__.end (), task) != __tasks__.end ())
+        pthread_cancel (task->thread); // the thread ends at its next blocking call
+}
+
+void vTaskDelay (TickType_t ticks) {
+    struct timespec t = { (time_t) (ticks / 1000), (long) (ticks % 1000) * 1000000 };
+    while (nanosleep (&t, &t) && errno == EINTR);
+}
+
+TickType_t xTaskGetTickCount () {
+    return (TickType_t) (esp_timer_get_time () / 1000);
+}
+
+void vTaskDelayUntil (TickType_t *previousWakeTime, TickType_t increment) {
+    *previousWakeTime += increment;
+    TickType_t now = xTaskGetTickCount ();
+    if ((int32_t) (*previousWakeTime - now) > 0)
+        vTaskDelay (*previousWakeTime - now);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle () {
+    return __currentTask__;
+}
+
+const char *pcTaskGetName (TaskHandle_t task) {
+    if (!task)
+        task = __currentTask__;
+    return task ? task->name : "";
+}
+
+UBaseType_t uxTaskGetNumberOfTasks () {
+    std::lock_guard<std::mutex> lock (__tasksMutex__);
+    return __tasks__.size ();
+}
+
+UBaseType_t uxTaskGetSystemState (TaskStatus_t *statusArray, UBaseType_t arraySize, uint32_t *totalRunTime) {
+    std::lock_guard<std::mutex> lock (__tasksMutex__);
+    if (__tasks__.size () > arraySize)
+        return 0;
+    UBaseType_t n = 0;
+    for (hostTask *t : __tasks__) {
+        uint64_t us = 0;
+        clockid_t clock;
+        struct timespec ts;
+        if (!pthread_getcpuclockid (t->thread, &clock) && !clock_gettime (clock, &ts))
+            us = (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+        statusArray [n++] = { t, t->name, t->number, t == __currentTask__ ? eRunning : eBlocked, t->priority, t->priority, (uint32_t) us, NULL, 0, t->core };
+    }
+    if (totalRunTime)
+        *totalRunTime = (uint32_t) esp_timer_get_time ();
+    return n;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t) {
+    return 0; // the host's threads don't run on the ESP32's stack sizes, there is nothing to measure
+}
+
+BaseType_t xPortGetCoreID () {
+    if (__currentTask__ && __currentTask__->core != tskNO_AFFINITY)
+        return __currentTask__->core;
+    int cpu = sched_getcpu ();
+    return cpu < 0 ? 0 : cpu % portNUM_PROCESSORS;
+}
+
+
+// ----- critical sections -----
+
+static std::recursive_mutex __criticalMutex__;
+
+void vPortEnterCritical (portMUX_TYPE *) { __criticalMutex__.lock (); }
+void vPortExitCritical (portMUX_TYPE *) { __criticalMutex__.unlock (); }
+
+
+// ----- queues and semaphores -----
+
+struct hostQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t count = 0;
+    UBaseType_t first = 0;
+    std::vector<uint8_t> items;
+};
+
+template<class predicate_t> static bool __wait__ (hostQueue *q, std::unique_lock<std::mutex>& lock, TickType_t ticksToWait, predicate_t ready) {
+    if (ticksToWait == portMAX_DELAY) {
+        q->changed.wait (lock, ready);
+        return true;
+    }
+    return q->changed.wait_for (lock, std::chrono::milliseconds (ticksToWait), ready);
+}
+
+QueueHandle_t xQueueCreate (UBaseType_t length, UBaseType_t itemSize) {
+    hostQueue *q = new (std::nothrow) hostQueue;
+    if (q) {
+        q->length = length;
+        q->itemSize = itemSize;
+        q->items.resize ((size_t) length * itemSize);
+    }
+    return q;
+}
+
+BaseType_t xQueueSend (QueueHandle_t q, const void *item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock (q->mutex);
+    if (!__wait__ (q, lock, ticksToWait, [q] { return q->count < q->length; }))
+        return pdFALSE;
+    if (q->itemSize)
+        memcpy (&q->items [(size_t) ((q->first + q->count) % q->length) * q->itemSize], item, q->itemSize);
+    q->count ++;
+    q->changed.notify_all ();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive (QueueHandle_t q, void *item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock (q->mutex);
+    if (!__wait__ (q, lock, ticksToWait, [q] { return q->count > 0; }))
+        return pdFALSE;
+    if (q->itemSize)
+        memcpy (item, &q->items [(size_t) q->first * q->itemSize], q->itemSize);
+    q->first = (q->first + 1) % q->length;
+    q->count --;
+    q->changed.notify_all ();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting (QueueHandle_t q) {
+    std::lock_guard<std::mutex> lock (q->mutex);
+    return q->count;
+}
+
+void vQueueDelete (QueueHandle_t q) {
+    delete q;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting (UBaseType_t maxCount, UBaseType_t initialCount) {
+    hostQueue *q = xQueueCreate (maxCount, 0);
+    if (q)
+        q->count = initialCount;
+    return q;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary () { return xSemaphoreCreateCounting (1, 0); }
+SemaphoreHandle_t xSemaphoreCreateMutex () { return xSemaphoreCreateCounting (1, 1); }
+BaseType_t xSemaphoreTake (SemaphoreHandle_t s, TickType_t ticksToWait) { return xQueueReceive (s, NULL, ticksToWait); }
+BaseType_t xSemaphoreGive (SemaphoreHandle_t s) { return xQueueSend (s, NULL, 0); }
+void vSemaphoreDelete (SemaphoreHandle_t s) { vQueueDelete (s); }
+
+
+// ----- event groups -----
+
+struct hostEventGroup {
+    std::mutex mutex;
+    std::condition_variable changed;
+    EventBits_t bits = 0;
+};
+
+EventGroupHandle_t xEventGroupCreate () {
+    return new (std::nothrow) hostEventGroup;
+}
+
+EventBits_t xEventGroupSetBits (EventGroupHandle_t g, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock (g->mutex);
+    g->bits |= bits;
+    g->changed.notify_all ();
+    return g->bits;
+}
+
+EventBits_t xEventGroupClearBits (EventGroupHandle_t g, EventBits_t bits) {
+    std::lock_guard<std::mutex> lock (g->mutex);
+    EventBits_t previous = g->bits;
+    g->bits &= ~bits;
+    return previous;
+}
+
+EventBits_t xEventGroupGetBits (EventGroupHandle_t g) {
+    std::lock_guard<std::mutex> lock (g->mutex);
+    return g->bits;
+}
+
+EventBits_t xEventGroupWaitBits (EventGroupHandle_t g, EventBits_t bits, BaseType_t clearOnExit, BaseType_t waitForAllBits, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock (g->mutex);
+    auto ready = [&] { return waitForAllBits ? (g->bits & bits) == bits : (g->bits & bits) != 0; };
+    bool satisfied = ticksToWait == portMAX_DELAY ? (g->changed.wait (lock, ready), true) : g->changed.wait_for (lock, std::chrono::milliseconds (ticksToWait), ready);
+    EventBits_t value = g->bits;
+    if (satisfied && clearOnExit)
+        g->bits &= ~bits;
+    return value;
+}
+
+void vEventGroupDelete (EventGroupHandle_t g) {
+    delete g;
+}
@@ -0,0 +1,82 @@
+/*
+
+    hostMbedtls.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: SHA-1 (FIPS 180-4) and base64 (RFC 4648), the only parts of mbedTLS that the servers use directly.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <mbedtls/sha1.h>
+#include <mbedtls/base64.h>
+#include <stdint.h>
+#include <string.h>
+
+
+static inline uint32_t __rol__ (uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+static void __sha1Block__ (uint32_t h [5], const unsigned char *p) {
+    uint32_t w [80];
+    for (int i = 0; i < 16; i++)
+        w [i] = (uint32_t) p [4 * i] << 24 | (uint32_t) p [4 * i + 1] << 16 | (uint32_t) p [4 * i + 2] << 8 | p [4 * i + 3];
+    for (int i = 16; i < 80; i++)
+        w [i] = __rol__ (w [i - 3] ^ w [i - 8] ^ w [i - 14] ^ w [i - 16], 1);
+    uint32_t a = h [0], b = h [1], c = h [2], d = h [3], e = h [4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20)      { f = (b & c) | (~b & d);           k = 0x5a827999; }
+        else if (i < 40) { f = b ^ c ^ d;                    k = 0x6ed9eba1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d);  k = 0x8f1bbcdc; }
+        else             { f = b ^ c ^ d;                    k = 0xca62c1d6; }
+        uint32_t t = __rol__ (a, 5) + f + e + k + w [i];
+        e = d; d = c; c = __rol__ (b, 30); b = a; a = t;
+    }
+    h [0] += a; h [1] += b; h [2] += c; h [3] += d; h [4] += e;
+}
+
+int mbedtls_sha1 (const unsigned char *input, size_t length, unsigned char output [20]) {
+    uint32_t h [5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+        __sha1Block__ (h, input + i);
+    unsigned char last [128] = {};
+    size_t rest = length - i;
+    memcpy (last, input + i, rest);
+    last [rest] = 0x80;
+    size_t blocks = rest < 56 ? 1 : 2;
+    uint64_t bits = (uint64_t) length * 8;
+    for (int j = 0; j < 8; j++)
+        last [blocks * 64 - 1 - j] = (unsigned char) (bits >> (8 * j));
+    for (size_t j = 0; j < blocks; j++)
+        __sha1Block__ (h, last + 64 * j);
+    for (int j = 0; j < 5; j++) {
+        output [4 * j] = h [j] >> 24;
+        output [4 * j + 1] = h [j] >> 16;
+        output [4 * j + 2] = h [j] >> 8;
+        output [4 * j + 3] = h [j];
+    }
+    return 0;
+}
+
+int mbedtls_base64_encode (unsigned char *dst, size_t dlen, size_t *olen, const unsigned char *src, size_t slen) {
+    static const char alphabet [] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t n = (slen + 2) / 3 * 4;
+    *olen = n + 1;
+    if (dlen < n + 1)
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    unsigned char *d = dst;
+    for (size_t i = 0; i < slen; i += 3) {
+        uint32_t v = (uint32_t) src [i] << 16 | (i + 1 < slen ? (uint32_t) src [i + 1] << 8 : 0) | (i + 2 < slen ? src [i + 2] : 0);
+        *d++ = alphabet [v >> 18 & 63];
+        *d++ = alphabet [v >> 12 & 63];
+        *d++ = i + 1 < slen ? alphabet [v >> 6 & 63] : '=';
+        *d++ = i + 2 < slen ? alphabet [v & 63] : '=';
+    }
+    *d = 0;
+    *olen = n;
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*
+
+    hostSocket.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the servers bind to the ESP32's ports (80, 21, 23), which need privileges on the host. If
+    ESP32_HOST_PORT_OFFSET environment variable is set, it is added to the port of each bind (the linker redirects
+    bind to __wrap_bind), so with ESP32_HOST_PORT_OFFSET=8000 HTTP server listens on 8080.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hostSocket.h"
+
+
+extern "C" int __real_bind (int s, const struct sockaddr *address, socklen_t length);
+
+int hostPortOffset () {
+    static const int offset = getenv ("ESP32_HOST_PORT_OFFSET") ? atoi (getenv ("ESP32_HOST_PORT_OFFSET")) : 0;
+    return offset;
+}
+
+extern "C" int __wrap_bind (int s, const struct sockaddr *address, socklen_t length) {
+    int offset = hostPortOffset ();
+    if (offset && address && address->sa_family == AF_INET && length >= sizeof (struct sockaddr_in)) {
+        struct sockaddr_in a;
+        memcpy (&a, address, sizeof (a));
+        if (a.sin_port)
+            a.sin_port = htons (ntohs (a.sin_port) + offset);
+        return __real_bind (s, (struct sockaddr *) &a, sizeof (a));
+    }
+    if (offset && address && address->sa_family == AF_INET6 && length >= sizeof (struct sockaddr_in6)) {
+        struct sockaddr_in6 a;
+        memcpy (&a, address, sizeof (a));
+        if (a.sin6_port)
+            a.sin6_port = htons (ntohs (a.sin6_port) + offset);
+        return __real_bind (s, (struct sockaddr *) &a, sizeof (a));
+    }
+    return __real_bind (s, address, length);
+}
@@ -0,0 +1,20 @@
+/*
+
+    hostSocket.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the offset added to the ports that the servers bind to (ESP32_HOST_PORT_OFFSET, see hostSocket.cpp).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_SOCKET_H__
+    #define __HOST_SOCKET_H__
+
+    int hostPortOffset ();
+
+#endif
@@ -0,0 +1,108 @@
+/*
+
+    hostWiFi.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: WiFi on top of the host's network interfaces.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include <WiFi.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <atomic>
+
+
+WiFiClass WiFi;
+
+static std::atomic<wifi_mode_t> __mode__ (WIFI_MODE_NULL);
+static std::atomic<wifi_ps_type_t> __powerSaving__ (WIFI_PS_NONE);
+
+esp_err_t esp_wifi_get_mode (wifi_mode_t *mode) { *mode = __mode__; return ESP_OK; }
+esp_err_t esp_wifi_get_ps (wifi_ps_type_t *type) { *type = __powerSaving__; return ESP_OK; }
+esp_err_t esp_wifi_set_ps (wifi_ps_type_t type) { __powerSaving__ = type; return ESP_OK; }
+
+
+bool WiFiClass::mode (wifi_mode_t m) {
+    __mode__ = m;
+    if (m == WIFI_MODE_NULL)
+        __connected__ = false;
+    return true;
+}
+
+wifi_mode_t WiFiClass::getMode () {
+    return __mode__;
+}
+
+void WiFiClass::__fire__ (WiFiEvent_t event) {
+    if (__callback__)
+        __callback__ (event, {});
+}
+
+void WiFiClass::__connectTask__ (void *wifi) {
+    WiFiClass *w = (WiFiClass *) wifi;
+    delay (10); // let the caller continue first, as it does on ESP32
+    w->__connected__ = true;
+    w->__fire__ (ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    w->__fire__ (ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    vTaskDelete (NULL);
+}
+
+wl_status_t WiFiClass::begin (const char *ssid, const char *) {
+    if (!ssid || __connected__)
+        return status ();
+    if (__mode__ == WIFI_MODE_NULL)
+        __mode__ = WIFI_MODE_STA;
+    xTaskCreate (__connectTask__, "wifi", 4096, this, 1, NULL);
+    return WL_IDLE_STATUS;
+}
+
+bool WiFiClass::config (IPAddress localIP, IPAddress gateway, IPAddress, IPAddress, IPAddress) {
+    __staticIP__ = localIP;
+    __gateway__ = gateway;
+    return true;
+}
+
+bool WiFiClass::disconnect (bool, bool) {
+    if (__connected__) {
+        __connected__ = false;
+        __fire__ (ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+    return true;
+}
+
+bool WiFiClass::reconnect () {
+    return begin ("host") != WL_DISCONNECTED;
+}
+
+IPAddress WiFiClass::localIP () {
+    // the address configured in /network/interfaces may not be the host's, so the host's own address is always reported
+    struct ifaddrs *interfaces;
+    IPAddress ip (127, 0, 0, 1);
+    if (getifaddrs (&interfaces))
+        return ip;
+    for (struct ifaddrs *i = interfaces; i; i = i->ifa_next)
+        if (i->ifa_addr && i->ifa_addr->sa_family == AF_INET && !(i->ifa_flags & IFF_LOOPBACK) && (i->ifa_flags & IFF_UP)) {
+            ip = IPAddress ((uint32_t) ((struct sockaddr_in *) i->ifa_addr)->sin_addr.s_addr);
+            break;
+        }
+    freeifaddrs (interfaces);
+    return ip;
+}
+
+IPAddress WiFiClass::gatewayIP () {
+    if ((uint32_t) __gateway__)
+        return __gateway__;
+    IPAddress ip = localIP ();
+    return IPAddress (ip [0], ip [1], ip [2], 1); // the usual place of the router
+}
+
+int8_t WiFiClass::RSSI () {
+    if (!__connected__)
+        return 0;
+    return -60 + (int) (esp_random () % 7) - 3;
+}
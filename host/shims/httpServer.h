@@ -0,0 +1,176 @@
+/*
+
+    httpServer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: httpServer_t comes from the network suite library, which is not part of this project. The host build
+    serves HTTP with eventHttpServer_t instead, httpServer_t never listens (operator bool is false).
+
+    httpConnection_t is an in-memory connection: the request (with its header fields) is given to the constructor and
+    the reply is collected in a fixed buffer, without a socket and without heap allocation. It lets the benchmark call
+    httpRequestHandlerCallback<httpServer_t::httpConnection_t> directly, also as if the request came through HTTPS
+    (cipherName), which POST /login/ requires. A connection can also be given a socket, then it sends the reply to it
+    like the real one does, which the file transfer benchmark needs (GET /download/..., PUT /upload/...).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HTTP_SERVER__
+    #define __HTTP_SERVER__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <strings.h>
+    #include <sys/socket.h>
+
+
+    // TUNING PARAMETERS
+    #define HOST_HTTP_CONNECTION_REPLY_SIZE 4096   // bytes of the reply an in-memory connection keeps, the rest is counted but discarded
+
+
+    #ifndef HTTP_REPLY_ALREADY_SENT
+        #define HTTP_REPLY_ALREADY_SENT "\r"
+    #endif
+
+
+    class httpServer_t {
+
+        public:
+
+            class httpConnection_t {
+
+                public:
+
+                    httpConnection_t (const char *httpRequest = "", const char *cipherName = "", const char *clientIP = "127.0.0.1", int socket = -1) : __request__ (httpRequest), __cipherName__ (cipherName), __clientIP__ (clientIP), __socket__ (socket) {}
+
+                    inline int getSocket () __attribute__((always_inline)) { return __socket__; }
+
+                    int sendBlock (const byte *buf, size_t len) {
+                        if (__socket__ >= 0) {
+                            ssize_t sent = send (__socket__, buf, len, MSG_NOSIGNAL);
+                            if (sent > 0)
+                                __sent__ += sent;
+                            return (int) sent;
+                        }
+                        size_t l = __replyLength__ < sizeof (__reply__) - 1 ? sizeof (__reply__) - 1 - __replyLength__ : 0;
+                        if (l > len)
+                            l = len;
+                        memcpy (__reply__ + __replyLength__, buf, l);
+                        __replyLength__ += l;
+                        __reply__ [__replyLength__] = 0;
+                        __sent__ += len;
+                        return len;
+                    }
+
+                    int sendString (const char *s) { return sendBlock ((const byte *) s, strlen (s)); }
+
+                    const char *getHttpRequestHeaderField (const char *fieldName) {
+                        *__field__ = 0;
+                        size_t l = strlen (fieldName);
+                        for (const char *line = strstr (__request__, "\r\n"); line && line [2] != '\r' && line [2]; line = strstr (line + 2, "\r\n"))
+                            if (!strncasecmp (line + 2, fieldName, l) && line [2 + l] == ':') {
+                                const char *v = line + 3 + l;
+                                while (*v == ' ')
+                                    v++;
+                                size_t i = 0;
+                                for (; v [i] && v [i] != '\r' && i < sizeof (__field__) - 1; i++)
+                                    __field__ [i] = v [i];
+                                __field__ [i] = 0;
+                                break;
+                            }
+                        return __field__;
+                    }
+
+                    const char *getHttpRequestCookie (const char *cookieName) {
+                        getHttpRequestHeaderField ("Cookie"); // name1=value1; name2=value2
+                        size_t l = strlen (cookieName);
+                        for (char *p = __field__; *p; ) {
+                            while (*p == ' ' || *p == ';')
+                                p++;
+                            char *end = strchr (p, ';');
+                            if (!end)
+                                end = p + strlen (p);
+                            if (!strncmp (p, cookieName, l) && p [l] == '=') {
+                                memmove (__field__, p + l + 1, end - (p + l + 1));
+                                __field__ [end - (p + l + 1)] = 0;
+                                return __field__;
+                            }
+                            p = end;
+                        }
+                        *__field__ = 0;
+                        return __field__;
+                    }
+
+                    void setHttpReplyHeaderField (const char *fieldName, const char *fieldValue) {
+                        size_t l = strlen (__replyHeaderFields__);
+                        snprintf (__replyHeaderFields__ + l, sizeof (__replyHeaderFields__) - l, "%s: %s\r\n", fieldName, fieldValue);
+                    }
+
+                    void setHttpReplyCookie (const char *cookieName, const char *cookieValue, time_t expires = 0) {
+                        char s [300];
+                        snprintf (s, sizeof (s), "%s=%s%s", cookieName, cookieValue, expires ? "; Max-Age=86400" : "");
+                        setHttpReplyHeaderField ("Set-Cookie", s);
+                    }
+
+                    void setHttpReplyStatus (const char *status) { snprintf (__replyStatus__, sizeof (__replyStatus__), "%s", status); }
+
+                    inline const char *cipherName () __attribute__((always_inline)) { return __cipherName__; }
+                    inline const char *getClientIP () __attribute__((always_inline)) { return __clientIP__; }
+
+                    // what the handler has set and sent
+                    inline const char *replyStatus () __attribute__((always_inline)) { return __replyStatus__; }
+                    inline const char *replyHeaderFields () __attribute__((always_inline)) { return __replyHeaderFields__; }
+                    inline const char *reply () __attribute__((always_inline)) { return __reply__; }
+                    inline size_t bytesSent () __attribute__((always_inline)) { return __sent__; }
+
+                private:
+
+                    const char *__request__;
+                    const char *__cipherName__;
+                    const char *__clientIP__;
+                    int __socket__;
+                    char __field__ [300];
+                    char __replyStatus__ [64] = "";
+                    char __replyHeaderFields__ [512] = "";
+                    char __reply__ [HOST_HTTP_CONNECTION_REPLY_SIZE];
+                    size_t __replyLength__ = 0;
+                    size_t __sent__ = 0;
+            };
+
+
+            // a WebSocket that has already been closed by the other side
+            class webSocket_t : public httpConnection_t {
+
+                public:
+
+                    using httpConnection_t::httpConnection_t;
+
+                    int recvBlock (byte *buf, size_t len) { return 0; }
+                    bool recvString (char *buf, size_t len) { if (len) *buf = 0; return false; }
+                    int peek () { return -1; }
+                    bool sendString (const char *s) { return httpConnection_t::sendString (s) > 0; }
+                    bool sendBlock (const byte *buf, size_t len) { return httpConnection_t::sendBlock (buf, len) > 0; }
+                    void closeWebSocket () {}
+            };
+
+
+            typedef String (*httpRequestHandler_t) (const char *httpRequest, httpConnection_t *hcn);
+            typedef void (*wsRequestHandler_t) (const char *httpRequest, webSocket_t *webSck);
+
+            httpServer_t (threadSafeFS::FS& fileSystem,
+                          httpRequestHandler_t httpRequestHandler = NULL,
+                          wsRequestHandler_t wsRequestHandler = NULL,
+                          int serverPort = 80,
+                          bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                          bool runListenerInItsOwnTask = true) {}
+
+            inline operator bool () __attribute__((always_inline)) { return false; }
+
+            void accept () {}
+    };
+
+#endif
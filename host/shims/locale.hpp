@@ -0,0 +1,22 @@
+/*
+
+    locale.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the host's own locale is kept, the host build only formats the output for the console.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __LOCALE_HPP__
+    #define __LOCALE_HPP__
+
+    enum lc_t { lc_all, lc_numeric, lc_time };
+
+    inline bool setlocale (lc_t, const char *) { return true; }
+
+#endif
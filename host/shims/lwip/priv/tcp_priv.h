@@ -0,0 +1,31 @@
+/*
+
+    lwip/priv/tcp_priv.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the host's TCP connections are not lwIP's, so the list of active PCBs is empty and the connection gauges
+    of GET /metrics read 0.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_LWIP_TCP_PRIV_H__
+    #define __HOST_LWIP_TCP_PRIV_H__
+
+    #include <stdint.h>
+
+    enum tcp_state { CLOSED = 0, LISTEN, SYN_SENT, SYN_RCVD, ESTABLISHED, FIN_WAIT_1, FIN_WAIT_2, CLOSE_WAIT, CLOSING, LAST_ACK, TIME_WAIT };
+
+    struct tcp_pcb {
+        struct tcp_pcb *next;
+        uint16_t local_port;
+        enum tcp_state state;
+    };
+
+    inline struct tcp_pcb *tcp_active_pcbs = NULL;
+
+#endif
@@ -0,0 +1,26 @@
+/*
+
+    lwip/tcpip.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: there is no tcpip thread, tcpip_api_call calls the function directly.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_LWIP_TCPIP_H__
+    #define __HOST_LWIP_TCPIP_H__
+
+    typedef signed char err_t;
+    #define ERR_OK 0
+
+    struct tcpip_api_call_data { int unused; };
+    typedef err_t (*tcpip_api_call_fn) (struct tcpip_api_call_data *call);
+
+    inline err_t tcpip_api_call (tcpip_api_call_fn fn, struct tcpip_api_call_data *call) { return fn (call); }
+
+#endif
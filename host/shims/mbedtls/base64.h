@@ -0,0 +1,24 @@
+/*
+
+    mbedtls/base64.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: base64 encoding, used for WebSocket handshakes.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_MBEDTLS_BASE64_H__
+    #define __HOST_MBEDTLS_BASE64_H__
+
+    #include <stddef.h>
+
+    #define MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL -0x002A
+
+    int mbedtls_base64_encode (unsigned char *dst, size_t dlen, size_t *olen, const unsigned char *src, size_t slen);
+
+#endif
@@ -0,0 +1,20 @@
+/*
+
+    mbedtls/md.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: webSessionTokens.h includes this header but doesn't use message digests.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_MBEDTLS_MD_H__
+    #define __HOST_MBEDTLS_MD_H__
+
+    typedef enum { MBEDTLS_MD_NONE = 0, MBEDTLS_MD_SHA1 = 4, MBEDTLS_MD_SHA256 = 6 } mbedtls_md_type_t;
+
+#endif
@@ -0,0 +1,22 @@
+/*
+
+    mbedtls/sha1.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: SHA-1 in software, used for WebSocket handshakes.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_MBEDTLS_SHA1_H__
+    #define __HOST_MBEDTLS_SHA1_H__
+
+    #include <stddef.h>
+
+    int mbedtls_sha1 (const unsigned char *input, size_t length, unsigned char output [20]);
+
+#endif
@@ -0,0 +1,37 @@
+/*
+
+    ntpClient.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the host's clock is already synchronized, so syncTime () always succeeds without asking NTP servers.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __NTP_CLIENT__
+    #define __NTP_CLIENT__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+
+
+    class ntpClient_t {
+
+        public:
+
+            ntpClient_t () {}
+            ntpClient_t (threadSafeFS::FS& fileSystem, const char *ntpServer1 = NULL, const char *ntpServer2 = NULL, const char *ntpServer3 = NULL) {}
+            ntpClient_t (const char *ntpServer1, const char *ntpServer2 = NULL, const char *ntpServer3 = NULL) {}
+
+            // returns an error message or "" if the time is set
+            const char *syncTime () { return time (NULL) > 1600000000 ? "" : "host clock is not set"; } // 1600000000 ~2020
+
+            // seconds since boot
+            inline time_t getUpTime () __attribute__((always_inline)) { return millis () / 1000; }
+    };
+
+#endif
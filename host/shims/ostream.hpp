@@ -0,0 +1,76 @@
+/*
+
+    ostream.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of LightweightSTL's ostream that this project uses, cout writes to stdout.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __OSTREAM_HPP__
+    #define __OSTREAM_HPP__
+
+    #include <Arduino.h>
+    #include <mutex>
+
+
+    class ostream {
+
+        public:
+
+            ostream& operator << (const char *s) { if (s) __write__ (s); return *this; }
+            ostream& operator << (const String& s) { __write__ (s.c_str ()); return *this; }
+            ostream& operator << (char c) { char s [2] = { c, 0 }; __write__ (s); return *this; }
+            ostream& operator << (bool b) { __write__ (b ? "1" : "0"); return *this; }
+            ostream& operator << (int i) { return __format__ ("%i", i); }
+            ostream& operator << (unsigned int i) { return __format__ ("%u", i); }
+            ostream& operator << (long i) { return __format__ ("%li", i); }
+            ostream& operator << (unsigned long i) { return __format__ ("%lu", i); }
+            ostream& operator << (long long i) { return __format__ ("%lli", i); }
+            ostream& operator << (unsigned long long i) { return __format__ ("%llu", i); }
+            ostream& operator << (double f) { return __showpoint__ ? __format__ ("%f", f) : __format__ ("%g", f); }
+            ostream& operator << (const IPAddress& a) { return *this << a.toString (); }
+            ostream& operator << (const struct tm& st) {
+                char s [32];
+                strftime (s, sizeof (s), "%Y/%m/%d %T", &st);
+                __write__ (s);
+                return *this;
+            }
+            ostream& operator << (ostream& (*manipulator) (ostream&)) { return manipulator (*this); }
+
+            inline void showpoint (bool on) __attribute__((always_inline)) { __showpoint__ = on; }
+
+        private:
+
+            bool __showpoint__ = false;
+
+            void __write__ (const char *s) {
+                static std::mutex m;
+                std::lock_guard<std::mutex> lock (m);
+                fputs (s, stdout);
+            }
+
+            template<typename T> ostream& __format__ (const char *format, T value) {
+                char s [48];
+                snprintf (s, sizeof (s), format, value);
+                __write__ (s);
+                return *this;
+            }
+    };
+
+    inline ostream& endl (ostream& o) { o << "\r\n"; fflush (stdout); return o; }
+    inline ostream& showpoint (ostream& o) { o.showpoint (true); return o; }
+    inline ostream& noshowpoint (ostream& o) { o.showpoint (false); return o; }
+
+    inline ostream cout;
+
+    inline void cinit (bool waitForSerial = false, unsigned int waitAfterSerial = 100, unsigned int serialSpeed = 115200) {
+        setvbuf (stdout, NULL, _IOLBF, 0);
+    }
+
+#endif
@@ -0,0 +1,67 @@
+/*
+
+    telnetServer.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: telnetServer_t comes from the network suite library, which is not part of this project, so it never
+    listens on the host (operator bool is false). telnetConnection_t is an in-memory connection of a logged-in user,
+    the output is written to stdout (or to the socket given to the constructor) and there is no input, so
+    telnetCommandHandlerCallback can still be called directly.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __TELNET_SERVER__
+    #define __TELNET_SERVER__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <Cstring.hpp>
+    #include <sys/socket.h>
+
+
+    class telnetServer_t {
+
+        public:
+
+            class telnetConnection_t {
+
+                public:
+
+                    telnetConnection_t (const char *userName = "root", int socket = -1) : __userName__ (userName), __socket__ (socket) {}
+
+                    inline const char *getUserName () __attribute__((always_inline)) { return __userName__; }
+                    inline int getSocket () __attribute__((always_inline)) { return __socket__; }
+
+                    int sendBlock (const byte *buf, size_t len) { return __socket__ >= 0 ? (int) send (__socket__, buf, len, MSG_NOSIGNAL) : (int) fwrite (buf, 1, len, stdout); }
+                    int sendString (const char *s) { return sendBlock ((const byte *) s, strlen (s)); }
+
+                    // returns the character that ended the line (13 for Enter) or 0 if the connection is closed
+                    char recvLine (char *buf, size_t len, bool trim = true) { if (len) *buf = 0; return 0; }
+
+                    void dontEcho () {}
+                    void doEcho () {}
+
+                private:
+
+                    const char *__userName__;
+                    int __socket__;
+            };
+
+            telnetServer_t (threadSafeFS::FS& fileSystem,
+                            Cstring<255> (*getUserHomeDirectory) (const Cstring<64>& userName, const Cstring<64>& password) = NULL,
+                            String (*telnetCommandHandlerCallback) (int argc, char *argv [], telnetConnection_t *tcn) = NULL,
+                            int serverPort = 23,
+                            bool (*firewallCallback) (char *clientIP, char *serverIP) = NULL,
+                            bool runListenerInItsOwnTask = true) {}
+
+            inline operator bool () __attribute__((always_inline)) { return false; }
+
+            void accept () {}
+    };
+
+#endif
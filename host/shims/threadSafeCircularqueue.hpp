@@ -0,0 +1,87 @@
+/*
+
+    threadSafeCircularqueue.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of LightweightSTL's threadSafeCircularQueue that this project uses. The oldest element is
+    popped when a new one is pushed into a full queue, the derived classes are notified through pushed_back and
+    popped_front. The lock is recursive, so the derived classes may call push_back while they hold it, and the
+    iterator holds it while it exists.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __THREAD_SAFE_CIRCULAR_QUEUE_HPP__
+    #define __THREAD_SAFE_CIRCULAR_QUEUE_HPP__
+
+    #include <mutex>
+    #include <stddef.h>
+
+
+    template<class T, size_t maxSize> class threadSafeCircularQueue {
+
+        public:
+
+            virtual ~threadSafeCircularQueue () {}
+
+            inline void Lock () __attribute__((always_inline)) { __mutex__.lock (); }
+            inline void Unlock () __attribute__((always_inline)) { __mutex__.unlock (); }
+
+            void push_back (T element) {
+                Lock ();
+                    if (__size__ == maxSize)
+                        __popFront__ ();
+                    T& e = __elements__ [(__first__ + __size__) % maxSize] = element;
+                    __size__ ++;
+                    pushed_back (e);
+                Unlock ();
+            }
+
+            void pop_front () {
+                Lock ();
+                    if (__size__)
+                        __popFront__ ();
+                Unlock ();
+            }
+
+            inline size_t size () __attribute__((always_inline)) { return __size__; }
+            inline bool empty () __attribute__((always_inline)) { return __size__ == 0; }
+
+            virtual void pushed_back (T& element) {}
+            virtual void popped_front (T& element) {}
+
+            class iterator {
+                public:
+                    iterator (threadSafeCircularQueue *q, size_t i) : __q__ (q), __i__ (i) { __q__->Lock (); }
+                    iterator (const iterator& other) : __q__ (other.__q__), __i__ (other.__i__) { __q__->Lock (); }
+                    ~iterator () { __q__->Unlock (); }
+                    inline bool operator != (const iterator& other) const { return __i__ != other.__i__; }
+                    inline T& operator * () { return __q__->__elements__ [(__q__->__first__ + __i__) % maxSize]; }
+                    inline iterator& operator ++ () { __i__ ++; return *this; }
+                private:
+                    threadSafeCircularQueue *__q__;
+                    size_t __i__;
+            };
+
+            iterator begin () { return iterator (this, 0); }
+            iterator end () { Lock (); size_t s = __size__; Unlock (); return iterator (this, s); }
+
+        private:
+
+            T __elements__ [maxSize] = {};
+            size_t __first__ = 0;
+            size_t __size__ = 0;
+            std::recursive_mutex __mutex__;
+
+            void __popFront__ () {
+                popped_front (__elements__ [__first__]);
+                __first__ = (__first__ + 1) % maxSize;
+                __size__ --;
+            }
+    };
+
+#endif
@@ -0,0 +1,141 @@
+/*
+
+    threadSafeFS.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of ThreadSafeFS library that this project uses, on top of stdio and dirent. The host's C library
+    is already thread-safe, so no additional locking is needed.
+
+    File is a shared handle, like the library's: copies refer to the same open file, which is closed by close () or
+    when the last copy goes out of scope. It also converts to FILE *, so fprintf (f, ...) works as it does on ESP32.
+
+    The tests can cut the power: after hostFSPowerLossAfter (n) the file system makes n more steps and then ignores all
+    the changes (and reports them as failed) until hostFSPowerLossAfter (-1). A step is a byte written, opening a file
+    with "w" or "a", rename, remove, mkdir or rmdir. Changes of files opened with "r+" are kept aside and written in a
+    single step by flush () or close (), since LittleFS commits them atomically, so a change in place is either all
+    there or not at all. hostFSSteps () counts the steps made so far.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __THREAD_SAFE_FS__
+    #define __THREAD_SAFE_FS__
+
+    #include <stdio.h>
+    #include <stdarg.h>
+    #include <dirent.h>
+    #include <time.h>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <FS.h>
+
+
+    void hostFSPowerLossAfter (long steps);     // -1 = the power is never cut
+    long hostFSSteps ();
+
+
+    namespace threadSafeFS {
+
+        class File {
+
+            friend class FS;
+
+            public:
+
+                File () {}
+
+                inline operator bool () const __attribute__((always_inline)) { return __h__ && (__h__->file || __h__->dir); }
+                inline operator FILE * () const __attribute__((always_inline)) { return __h__ ? __h__->file : NULL; }
+
+                int read (uint8_t *buf, size_t size);
+                int read ();
+                size_t write (const uint8_t *buf, size_t size);
+                size_t write (uint8_t c) { return write (&c, 1); }
+                size_t print (const char *s);
+                size_t printf (const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+                bool seek (uint32_t position);
+                size_t position ();
+                size_t size ();
+                int available () { return (int) (size () - position ()); }
+                void flush ();
+                void close ();
+
+                bool isDirectory () const { return __h__ && __h__->dir; }
+                const char *name () const;  // the last part of the path, as LittleFS returns it
+                const char *path () const { return __h__ ? __h__->path.c_str () : ""; }
+                time_t getLastWrite ();
+
+                // the next entry of a directory, skips . and ..
+                File openNextFile (const char *mode = "r");
+
+                // directory entries with range-based for
+                class iterator;
+                iterator begin ();
+                iterator end ();
+
+            private:
+
+                struct __handle__ {
+                    FILE *file = NULL;
+                    DIR *dir = NULL;
+                    std::string path;       // in the file system
+                    std::string hostPath;
+                    bool inPlace = false;   // opened with "r+"
+                    std::vector<std::pair<long, std::string>> pending; // changes in place while the power loss is simulated, with their positions
+                    void commit ();
+                    ~__handle__ () { commit (); if (file) fclose (file); if (dir) closedir (dir); }
+                };
+
+                std::shared_ptr<__handle__> __h__;
+        };
+
+
+        class File::iterator {
+            public:
+                iterator (File *dir) : __dir__ (dir) { if (__dir__) __next__ (); }
+                inline bool operator != (const iterator& other) const { return (bool) __current__ != (bool) other.__current__; }
+                inline File& operator * () { return __current__; }
+                inline iterator& operator ++ () { __next__ (); return *this; }
+            private:
+                File *__dir__;
+                File __current__;
+                void __next__ () { __current__ = __dir__->openNextFile (); }
+        };
+
+        inline File::iterator File::begin () { return iterator (isDirectory () ? this : NULL); }
+        inline File::iterator File::end () { return iterator (NULL); }
+
+
+        class FS {
+
+            public:
+
+                FS (fs::FS& fileSystem) : __fileSystem__ (fileSystem) {}
+
+                // mode is "r", "w", "a", "r+", "w+" or "a+", create is ignored, fopen creates the files anyway
+                File open (const char *path, const char *mode = "r", bool create = false);
+
+                bool exists (const char *path);
+                bool isFile (const char *path);
+                bool isDirectory (const char *path);
+                bool mkdir (const char *path);
+                bool rmdir (const char *path);
+                bool remove (const char *path);
+                bool rename (const char *pathFrom, const char *pathTo);
+
+                // reads configuration file into buffer, without comments, empty lines and leading and trailing spaces, the lines are separated by \n
+                bool readConfiguration (char *buffer, size_t bufferSize, const char *path);
+
+            private:
+
+                fs::FS& __fileSystem__;
+        };
+
+    }
+
+#endif
@@ -0,0 +1,51 @@
+/*
+
+    vector.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: the part of LightweightSTL's vector that this project uses, on top of std::vector. As in the library,
+    push_back returns an error flag (0 = OK) instead of throwing.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __VECTOR_HPP__
+    #define __VECTOR_HPP__
+
+    #include <vector>
+    #include <new>
+
+    #define BAD_ALLOC 2 // error flag
+
+
+    template<class T> class vector {
+
+        public:
+
+            signed char push_back (const T& element) {
+                try {
+                    __v__.push_back (element);
+                } catch (const std::bad_alloc&) {
+                    return BAD_ALLOC;
+                }
+                return 0;
+            }
+
+            inline size_t size () const __attribute__((always_inline)) { return __v__.size (); }
+            inline bool empty () const __attribute__((always_inline)) { return __v__.empty (); }
+            inline void clear () __attribute__((always_inline)) { __v__.clear (); }
+            inline T& operator [] (size_t i) __attribute__((always_inline)) { return __v__ [i]; }
+
+            inline typename std::vector<T>::iterator begin () __attribute__((always_inline)) { return __v__.begin (); }
+            inline typename std::vector<T>::iterator end () __attribute__((always_inline)) { return __v__.end (); }
+
+        private:
+
+            std::vector<T> __v__;
+    };
+
+#endif
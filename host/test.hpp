@@ -0,0 +1,544 @@
+/*
+
+    test.hpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Host build: runs setup () of the sketch and checks the parts of it that can't be seen from the benchmark results:
+
+        dmesg ring                      4 tasks logging with DMESG while 2 others drain the ring, all the records must
+                                        arrive, in the order each task logged them
+        dmesg reset                     the records that survive a reset (the constructor running again over the same
+                                        ring) and the logging after it
+        event loop                      a listening socket closed under eventLoop_t, it must be polled instead of
+                                        select () failing in a busy loop, and an IPv6 listening socket must be found
+        crypto                          SHA-256 against the FIPS 180-4 examples, AES-GCM against the test cases of NIST
+                                        SP 800-38D's GCM specification, and the HARDWARE and SOFTWARE backends giving the
+                                        same output for all the key sizes and lengths around the block boundaries (on the
+                                        host HARDWARE falls back to SOFTWARE, on ESP32 it checks the accelerators)
+        power loss                      passwd, useradd, userdel and the rounds of new passwords, with the power cut
+                                        (see threadSafeFS.h) at each step of the writes: after the restart /etc/passwd,
+                                        /etc/shadow and /etc/login.defs must each be the old or the new file, and the
+                                        records must be found through the indexes
+        user files                      SHA-crypt against the test vectors of its specification and /etc/login.defs
+                                        written through a temporary file
+        telnet cat                      the home directory check of coalescedCat, the coalescing of the output into
+                                        full segments (also with 0 bytes in it) and the lastCat record shared by the
+                                        Telnet sessions
+
+    The dmesg, event loop, crypto and power loss tests run before setup (), while nothing else logs into the ring, opens sockets
+    or writes files. Each test prints its name and passed or
+    failed, with the checks that failed. ctest runs them on an empty file system (see CMakeLists.txt).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HOST_TEST_HPP__
+    #define __HOST_TEST_HPP__
+
+    #include <atomic>
+    #include <thread>
+    #include <vector>
+    #include <new>
+    #include <sys/socket.h>
+
+
+    #define TEST_CHECK(X) __testCheck__ ((X), #X, __LINE__)
+
+    static bool __testPassed__;
+
+    static void __testCheck__ (bool ok, const char *expression, int line) {
+        if (!ok) {
+            printf ("    line %i: %s\n", line, expression);
+            __testPassed__ = false;
+        }
+    }
+
+    #define TEST_DMESG_PRODUCERS 4
+    #define TEST_DMESG_RECORDS 10000            // by each producer
+
+    static uint32_t __testDmesgNext__ [TEST_DMESG_PRODUCERS];   // the next record expected from each producer, only accessed by output (under dmesgRing's lock)
+    static int __testDmesgOutOfOrder__;
+
+    static void __testDmesgOutput__ (const char *text) {
+        int producer;
+        unsigned record;
+        if (sscanf (text, "[test] producer %i record %u", &producer, &record) == 2 && producer >= 0 && producer < TEST_DMESG_PRODUCERS)
+            if (record != __testDmesgNext__ [producer] ++)
+                __testDmesgOutOfOrder__ ++;
+    }
+
+    static void __testDmesgRing__ () {
+        dmesgRing.drain (__testDmesgOutput__);
+        std::atomic<int> producing (TEST_DMESG_PRODUCERS);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < TEST_DMESG_PRODUCERS; p++)
+            threads.push_back (std::thread ([p, &producing] () {
+                for (uint32_t i = 0; i < TEST_DMESG_RECORDS; i++)
+                    while (!DMESG ("[test] producer %i record %u", p, i)) // the ring is full, wait for the drainers
+                        std::this_thread::yield ();
+                producing --;
+            }));
+        threads.push_back (std::thread ([&producing] () { // as the dmesg Telnet command
+            while (producing)
+                dmesgRing.drain (__testDmesgOutput__);
+        }));
+        threads.push_back (std::thread ([&producing] () { // as loop ()
+            while (producing)
+                dmesgRing.drainIfNeeded (__testDmesgOutput__);
+        }));
+        for (auto& t : threads)
+            t.join ();
+        dmesgRing.drain (__testDmesgOutput__);
+
+        TEST_CHECK (__testDmesgOutOfOrder__ == 0);
+        for (int p = 0; p < TEST_DMESG_PRODUCERS; p++)
+            TEST_CHECK (__testDmesgNext__ [p] == TEST_DMESG_RECORDS);
+        TEST_CHECK (dmesgRing.logged () == TEST_DMESG_PRODUCERS * TEST_DMESG_RECORDS);
+    }
+
+    static String __testDmesgLast__;
+
+    static void __testDmesgReset__ () {
+        DMESG ("[test] before reset %i", 1);
+        dmesgRing.drain ([] (const char *text) {});
+        DMESG ("[test] before reset %i", 2);
+        DMESG ("[test] before reset %i", 3); // the last two have not been drained
+
+        // what a software reset does: the constructor finds the ring of the previous run in no-init RAM
+        new (&dmesgRing) dmesgRing_t ();
+
+        TEST_CHECK (dmesgRing.previousRunRecords () == DMESG_RING_SIZE); // the ring was full after the previous test
+        String s = dmesgRing.previousRun ();
+        const char *p1 = strstr (s.c_str (), "[test] before reset 1");
+        const char *p2 = strstr (s.c_str (), "[test] before reset 2");
+        const char *p3 = strstr (s.c_str (), "[test] before reset 3");
+        TEST_CHECK (p1 && p2 && p3 && p1 < p2 && p2 < p3 && !strstr (p3, "\r\n"));
+
+        // the new run starts empty and continues numbering after the old records
+        TEST_CHECK (dmesgRing.logged () == 0);
+        TEST_CHECK (dmesgRing.drain ([] (const char *text) {}) == 0);
+        TEST_CHECK (DMESG ("[test] after reset %i", 1));
+        TEST_CHECK (dmesgRing.drain ([] (const char *text) { __testDmesgLast__ = text; }) == 1);
+        TEST_CHECK (__testDmesgLast__ == "[test] after reset 1");
+        TEST_CHECK (dmesgRing.logged () == 1 && dmesgRing.dropped () == 0);
+    }
+
+    static int __testEventLoopAccepts__;
+
+    static void __testEventLoop__ () {
+        int s = socket (AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in a = {};
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+        socklen_t l = sizeof (a);
+        TEST_CHECK (s >= 0 && !bind (s, (struct sockaddr *) &a, sizeof (a)) && !listen (s, 1) && !getsockname (s, (struct sockaddr *) &a, &l));
+
+        eventLoop_t loop;
+        TEST_CHECK (loop.addListener (ntohs (a.sin_port), [] () { __testEventLoopAccepts__ ++; }));
+        TEST_CHECK (!strstr (loop.toText ().c_str (), "(polled)"));
+
+        close (s); // as a server that stops
+        unsigned long start = millis ();
+        int passes = 0;
+        while (millis () - start < 5 * EVENT_LOOP_POLL_INTERVAL) {
+            loop.run (1000);
+            passes ++;
+        }
+        TEST_CHECK (strstr (loop.toText ().c_str (), "(polled)"));
+        TEST_CHECK (passes <= 6); // the first pass finds out that the socket is gone, then one pass for each poll
+        TEST_CHECK (__testEventLoopAccepts__ >= 3);
+
+        // a dual-stack IPv6 socket, like eventHttpServer_t's
+        s = socket (AF_INET6, SOCK_STREAM, 0);
+        if (s >= 0) { // the host may not have IPv6
+            struct sockaddr_in6 a6 = {};
+            a6.sin6_family = AF_INET6;
+            a6.sin6_addr = in6addr_loopback;
+            l = sizeof (a6);
+            if (!bind (s, (struct sockaddr *) &a6, sizeof (a6)) && !listen (s, 1) && !getsockname (s, (struct sockaddr *) &a6, &l))
+                TEST_CHECK (eventLoop_t::listeningSocket (ntohs (a6.sin6_port)) == s);
+            close (s);
+        }
+    }
+
+    static std::vector<uint8_t> __testBytes__ (const char *hex) {
+        std::vector<uint8_t> v;
+        for (; hex [0] && hex [1]; hex += 2) {
+            unsigned b;
+            sscanf (hex, "%2x", &b);
+            v.push_back (b);
+        }
+        return v;
+    }
+
+    static std::string __testHex__ (const uint8_t *data, size_t length) {
+        std::string s;
+        char h [3];
+        for (size_t i = 0; i < length; i++) {
+            snprintf (h, sizeof (h), "%02x", data [i]);
+            s += h;
+        }
+        return s;
+    }
+
+    static void __testCrypto__ () {
+        // FIPS 180-4 examples (NIST CSRC), the message with 56 characters needs a second block for the padding
+        struct { std::string message; const char *hash; } shaVectors [] = {
+            { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+            { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+            { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+            { std::string (1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" }
+        };
+        uint8_t hash [32];
+        for (auto& v : shaVectors)
+            for (auto backend : { cryptoBackend_t::HARDWARE, cryptoBackend_t::SOFTWARE }) {
+                cryptoBackend_t::sha256 (v.message.data (), v.message.size (), hash, backend);
+                TEST_CHECK (__testHex__ (hash, sizeof (hash)) == v.hash);
+            }
+
+        // the test cases of the GCM specification that NIST SP 800-38D refers to (1 - 4 with AES-128, 13 - 16 with AES-256)
+        struct { const char *key, *iv, *plaintext, *aad, *ciphertext, *tag; } gcmVectors [] = {
+            { "00000000000000000000000000000000", "000000000000000000000000", "", "", "", "58e2fccefa7e3061367f1d57a4e7455a" },
+            { "00000000000000000000000000000000", "000000000000000000000000", "00000000000000000000000000000000", "", "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf" },
+            { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+              "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255", "",
+              "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985", "4d5c2af327cd64a62cf35abd2ba6fab4" },
+            { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+              "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39", "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+              "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091", "5bc94fbc3221a5db94fae95ae7121a47" },
+            { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "", "", "", "530f8afbc74536b9a963b4f1c4cb738b" },
+            { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "00000000000000000000000000000000", "", "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919" },
+            { "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+              "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255", "",
+              "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad", "b094dac5d93471bdec1a502270e3cc6c" },
+            { "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+              "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39", "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+              "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662", "76fc6ece0f4e1768cddf8853bb2d551b" }
+        };
+        for (auto& v : gcmVectors)
+            for (auto backend : { cryptoBackend_t::HARDWARE, cryptoBackend_t::SOFTWARE }) {
+                std::vector<uint8_t> key = __testBytes__ (v.key), iv = __testBytes__ (v.iv), plaintext = __testBytes__ (v.plaintext), aad = __testBytes__ (v.aad);
+                std::vector<uint8_t> output (plaintext.size () + 1);
+                uint8_t tag [16];
+                TEST_CHECK (cryptoBackend_t::aesGcmEncrypt (key.data (), key.size (), iv.data (), aad.data (), aad.size (), plaintext.data (), plaintext.size (), output.data (), tag, backend));
+                TEST_CHECK (__testHex__ (output.data (), plaintext.size ()) == v.ciphertext && __testHex__ (tag, sizeof (tag)) == v.tag);
+                TEST_CHECK (cryptoBackend_t::aesGcmDecrypt (key.data (), key.size (), iv.data (), aad.data (), aad.size (), output.data (), plaintext.size (), output.data (), tag, backend));
+                TEST_CHECK (std::equal (plaintext.begin (), plaintext.end (), output.begin ()));
+                tag [15] ^= 1;
+                TEST_CHECK (!cryptoBackend_t::aesGcmDecrypt (key.data (), key.size (), iv.data (), aad.data (), aad.size (), output.data (), plaintext.size (), output.data (), tag, backend));
+            }
+
+        // both backends give the same output, for all the lengths up to 3 blocks (SHA-256's padding, partial AES blocks) and longer ones
+        uint32_t seed = 2026; // the same data at each run, so a failure can be repeated
+        auto next = [&seed] () -> uint8_t { seed = seed * 1103515245 + 12345; return seed >> 16; };
+        uint8_t key [32], iv [12], aad [40], input [1100], output [2][1100], tag [2][16];
+        int differences = 0;
+        for (size_t length = 0; length <= 1100; length += length < 200 ? 1 : 97) {
+            for (auto& b : input) b = next ();
+            for (auto& b : key) b = next ();
+            for (auto& b : iv) b = next ();
+            for (auto& b : aad) b = next ();
+            uint8_t hashes [2][32];
+            cryptoBackend_t::sha256 (input, length, hashes [0], cryptoBackend_t::HARDWARE);
+            cryptoBackend_t::sha256 (input, length, hashes [1], cryptoBackend_t::SOFTWARE);
+            differences += memcmp (hashes [0], hashes [1], 32) != 0;
+            size_t keyLength = 16 + 8 * (length % 3), aadLength = length % sizeof (aad);
+            cryptoBackend_t::aesGcmEncrypt (key, keyLength, iv, aad, aadLength, input, length, output [0], tag [0], cryptoBackend_t::HARDWARE);
+            cryptoBackend_t::aesGcmEncrypt (key, keyLength, iv, aad, aadLength, input, length, output [1], tag [1], cryptoBackend_t::SOFTWARE);
+            differences += memcmp (output [0], output [1], length) != 0 || memcmp (tag [0], tag [1], 16) != 0;
+            differences += !cryptoBackend_t::aesGcmDecrypt (key, keyLength, iv, aad, aadLength, output [0], length, output [1], tag [0], cryptoBackend_t::SOFTWARE);
+            differences += memcmp (input, output [1], length) != 0;
+        }
+        TEST_CHECK (differences == 0);
+    }
+
+    static const char *__testPowerLossFiles__ [] = { "/etc/passwd", "/etc/shadow", "/etc/login.defs", "/etc/passwd.idx", "/etc/shadow.idx" };
+    #define TEST_POWER_LOSS_CHECKED 3 // the indexes are checked through the lookups
+
+    static std::string __testReadFile__ (const char *path) {
+        std::string s;
+        File f = TSFS.open (path, "r");
+        if (!f)
+            return "(missing)";
+        char buf [256];
+        int l;
+        while ((l = f.read ((uint8_t *) buf, sizeof (buf))) > 0)
+            s.append (buf, l);
+        return s;
+    }
+
+    // the salts are random, so the new hashes can't be compared
+    static std::string __testWithoutHashes__ (std::string s) {
+        for (size_t i = s.find ("$5$"); i != std::string::npos; i = s.find ("$5$", i + 4))
+            s.replace (i, s.find (':', i) - i, "$5$*");
+        return s;
+    }
+
+    // the home directory in /etc/passwd, read line by line, "" if the user is not there
+    static std::string __testHomeDirectory__ (const std::string& passwd, const char *userName) {
+        std::string prefix = std::string ("\n") + userName + ":";
+        size_t i = ("\n" + passwd).find (prefix);
+        if (i == std::string::npos)
+            return "";
+        size_t e = passwd.find_first_of ("\r\n", i);
+        std::string line = passwd.substr (i, e == std::string::npos ? std::string::npos : e - i);
+        for (int field = 0; field < 5; field++)
+            line.erase (0, line.find (':') + 1);
+        return line.substr (0, line.find (':'));
+    }
+
+    static void __testPowerLoss__ () {
+        struct {
+            const char *name;
+            void (*change) (userManagement_t& um);
+            const char *userName;
+            const char *oldPassword;    // NULL if the user doesn't exist before the change
+            const char *newPassword;    // NULL if the user doesn't exist after it
+        } changes [] = {
+            { "passwd", [] (userManagement_t& um) { um.passwd ("webadmin", "new password"); }, "webadmin", DEFAULT_WEBADMIN_PASSWORD, "new password" },
+            { "useradd", [] (userManagement_t& um) { um.userAdd ("fuzz", "/home/fuzz/"); }, "fuzz", NULL, DEFAULT_USER_PASSWORD },
+            { "userdel", [] (userManagement_t& um) { um.userDel ("webadmin"); }, "webadmin", DEFAULT_WEBADMIN_PASSWORD, NULL },
+            { "rounds", [] (userManagement_t& um) { um.setRounds (2000); }, "root", DEFAULT_ROOT_PASSWORD, DEFAULT_ROOT_PASSWORD }
+        };
+
+        // the files before each change, with the fewest rounds, so that the passwords are checked quickly
+        userManagement_t *um = new userManagement_t (TSFS);
+        TEST_CHECK (um->setRounds (USER_PASSWORD_MIN_ROUNDS) && um->passwd ("root", DEFAULT_ROOT_PASSWORD) && um->passwd ("webadmin", DEFAULT_WEBADMIN_PASSWORD));
+        delete um;
+        std::string before [5];
+        for (int i = 0; i < 5; i++)
+            before [i] = __testReadFile__ (__testPowerLossFiles__ [i]);
+        auto restore = [&] () {
+            for (int i = 0; i < 5; i++) {
+                File f = TSFS.open (__testPowerLossFiles__ [i], "w");
+                f.write ((const uint8_t *) before [i].data (), before [i].size ());
+                f.close ();
+                TSFS.remove ((std::string (__testPowerLossFiles__ [i]) + ".tmp").c_str ());
+            }
+        };
+
+        for (auto& c : changes) {
+            // the files after the change and the number of steps it takes
+            um = new userManagement_t (TSFS);
+            long start = hostFSSteps ();
+            c.change (*um);
+            long steps = hostFSSteps () - start;
+            delete um;
+            std::string after [TEST_POWER_LOSS_CHECKED];
+            for (int i = 0; i < TEST_POWER_LOSS_CHECKED; i++)
+                after [i] = __testWithoutHashes__ (__testReadFile__ (__testPowerLossFiles__ [i]));
+            TEST_CHECK (steps > 0);
+
+            int failures = 0;
+            for (long cut = 0; cut <= steps && failures < 3; cut++) {
+                restore ();
+                um = new userManagement_t (TSFS);
+                hostFSPowerLossAfter (cut);
+                c.change (*um);
+                hostFSPowerLossAfter (-1);
+                delete um;
+
+                // restart
+                um = new userManagement_t (TSFS);
+                bool ok = true;
+                bool isNew [TEST_POWER_LOSS_CHECKED];
+                for (int i = 0; i < TEST_POWER_LOSS_CHECKED; i++) {
+                    std::string s = __testReadFile__ (__testPowerLossFiles__ [i]);
+                    isNew [i] = s != before [i];
+                    ok &= !isNew [i] || __testWithoutHashes__ (s) == after [i];
+                }
+                std::string passwd = __testReadFile__ ("/etc/passwd");
+                for (const char *userName : { "root", "webadmin", "fuzz" })
+                    ok &= __testHomeDirectory__ (passwd, userName) == (const char *) um->getHomeDirectory (userName);
+                const char *password = isNew [1] ? c.newPassword : c.oldPassword;
+                if (password)
+                    ok &= um->checkUserNameAndPassword (c.userName, password);
+                else
+                    ok &= !um->checkUserNameAndPassword (c.userName, isNew [1] ? c.oldPassword : c.newPassword);
+                ok &= um->getRounds () == (isNew [2] ? 2000 : USER_PASSWORD_MIN_ROUNDS);
+                delete um;
+
+                if (!ok) {
+                    printf ("    %s, power cut after %li of %li steps: passwd %s, shadow %s, login.defs %s\n", c.name, cut, steps, isNew [0] ? "new" : "old", isNew [1] ? "new" : "old", isNew [2] ? "new" : "old");
+                    __testPassed__ = false;
+                    failures ++;
+                }
+            }
+            restore ();
+        }
+    }
+
+    static void __testUserFiles__ () {
+        char hash [USER_PASSWORD_HASH_LENGTH];
+        TEST_CHECK (userManagement_t::shaCrypt (hash, sizeof (hash), "Hello world!", "$5$saltstring") && !strcmp (hash, "$5$saltstring$5B8vYYiY.CVt1RlTTf8KbXBH3hsxY/GNooZaBBGWEc5"));
+        TEST_CHECK (userManagement_t::shaCrypt (hash, sizeof (hash), "This is just a test", "$5$rounds=5000$toolongsaltstring") && !strcmp (hash, "$5$rounds=5000$toolongsaltstrin$Un/5jzAHMgOGZ5.mWJpuVolil07guHPvOW8mGRcvxa5"));
+
+        uint32_t rounds = userManagement->getRounds ();
+        TEST_CHECK (userManagement->setRounds (7000));
+        TEST_CHECK (!TSFS.isFile ("/etc/login.defs.tmp"));
+        userManagement_t *um = new userManagement_t (TSFS); // reads /etc/login.defs, as at the next start
+        TEST_CHECK (um->getRounds () == 7000);
+        delete um;
+
+        // a reset during the write leaves the old file and a partial .tmp, the old one is kept
+        File f = TSFS.open ("/etc/login.defs.tmp", "w");
+        f.print ("# SHA-crypt rou");
+        f.close ();
+        um = new userManagement_t (TSFS);
+        TEST_CHECK (um->getRounds () == 7000 && !TSFS.isFile ("/etc/login.defs.tmp"));
+        delete um;
+
+        // a reset while the file is written for the first time leaves only a partial .tmp, which is discarded, not renamed into its place
+        TSFS.remove ("/etc/login.defs");
+        f = TSFS.open ("/etc/login.defs.tmp", "w");
+        f.print ("SHA_CRYPT_ROUNDS 70");
+        f.close ();
+        um = new userManagement_t (TSFS);
+        TEST_CHECK (um->getRounds () == USER_PASSWORD_ROUNDS && !TSFS.isFile ("/etc/login.defs") && !TSFS.isFile ("/etc/login.defs.tmp"));
+        delete um;
+
+        // a complete .new (renamed from .tmp on the file systems that don't rename over an existing file) replaces the file
+        f = TSFS.open ("/etc/login.defs.new", "w");
+        f.print ("SHA_CRYPT_ROUNDS 7000\r\n");
+        f.close ();
+        um = new userManagement_t (TSFS);
+        TEST_CHECK (um->getRounds () == 7000 && TSFS.isFile ("/etc/login.defs") && !TSFS.isFile ("/etc/login.defs.new"));
+        delete um;
+
+        TEST_CHECK (userManagement->setRounds (rounds));
+    }
+
+    // writes lines lines of lineLength characters (including \n), returns false if it can't
+    static bool __testWriteLines__ (const char *path, int lines, int lineLength) {
+        File f = TSFS.open (path, "w");
+        if (!f)
+            return false;
+        char line [256];
+        memset (line, 'x', lineLength - 1);
+        line [lineLength - 1] = '\n';
+        for (int i = 0; i < lines; i++)
+            if (f.write ((const uint8_t *) line, lineLength) != (size_t) lineLength)
+                return false;
+        return true;
+    }
+
+    // calls coalescedCat as userName through a socket, returns what has been sent followed by what has been returned
+    static String __testCat__ (const char *path, const char *userName, size_t *sent = NULL) {
+        int s [2];
+        if (socketpair (AF_UNIX, SOCK_STREAM, 0, s))
+            return "socketpair failed";
+        std::string received;
+        std::thread reader ([&] () {
+            char buf [4096];
+            ssize_t l;
+            while ((l = recv (s [1], buf, sizeof (buf), 0)) > 0)
+                received.append (buf, l);
+        });
+        telnetServer_t::telnetConnection_t tcn (userName, s [0]);
+        String returned = coalescedCat (path, &tcn);
+        shutdown (s [0], SHUT_WR);
+        reader.join ();
+        close (s [0]);
+        close (s [1]);
+        if (sent)
+            *sent = received.size ();
+        return String (received.c_str ()) + returned;
+    }
+
+    static void __testTelnetCat__ () {
+        TEST_CHECK (isInHomeDirectory ("/var/www/html/index.html", "/var/www/html/"));
+        TEST_CHECK (isInHomeDirectory ("/var/www/html/index.html", "/var/www/html"));
+        TEST_CHECK (isInHomeDirectory ("/var/www/html", "/var/www/html"));
+        TEST_CHECK (!isInHomeDirectory ("/var/www/html2/index.html", "/var/www/html"));
+        TEST_CHECK (!isInHomeDirectory ("/var/www/html/../../../etc/shadow", "/var/www/html/"));
+        TEST_CHECK (isInHomeDirectory ("/etc/shadow", "/"));
+        TEST_CHECK (!isInHomeDirectory ("/etc/shadow", ""));
+
+        if (!TSFS.isDirectory ("/var")) TSFS.mkdir ("/var");
+        if (!TSFS.isDirectory ("/var/www")) TSFS.mkdir ("/var/www");
+        if (!TSFS.isDirectory ("/var/www/html")) TSFS.mkdir ("/var/www/html");
+        if (!TSFS.isDirectory ("/var/www/html2")) TSFS.mkdir ("/var/www/html2");
+        TEST_CHECK (__testWriteLines__ ("/var/www/html2/secret.txt", 1, 10));
+        TEST_CHECK (__testCat__ ("/var/www/html2/secret.txt", "webadmin") == "Access denied");
+        TEST_CHECK (__testCat__ ("/etc/passwd", "webadmin") == "Access denied");
+        TEST_CHECK (__testCat__ ("/var/www/html/../../../etc/passwd", "webadmin") == "Access denied");
+        TEST_CHECK (__testCat__ ("/var/www/html2/secret.txt", "root") == "xxxxxxxxx\r\n");
+
+        // 820 lines of 80 characters, each of them would be a send of its own without coalescing
+        TEST_CHECK (__testWriteLines__ ("/var/www/html/long.txt", 820, 80));
+        size_t sent;
+        String s = __testCat__ ("/var/www/html/long.txt", "webadmin", &sent);
+        TEST_CHECK (s.length () == 820 * 81);
+        TEST_CHECK (lastCat.bytes == 820 * 81 && lastCat.lines == 820);
+        TEST_CHECK (lastCat.segments <= 820 * 81 / TELNET_OUTPUT_BUFFER_SIZE * 2); // the segment is sent when the next 512 bytes read from the file don't fit into it
+        TEST_CHECK (sent + TELNET_OUTPUT_BUFFER_SIZE >= 820 * 81); // only the last segment is returned
+
+        // concurrent sessions must not mix the records of the two files in lastCat
+        TEST_CHECK (__testWriteLines__ ("/var/www/html/short.txt", 3, 20));
+        std::atomic<bool> running (true);
+        std::atomic<int> torn (0);
+        std::thread observer ([&] () {
+            while (running) {
+                portENTER_CRITICAL (&lastCatMux);
+                    lastCat_t c = lastCat;
+                portEXIT_CRITICAL (&lastCatMux);
+                if (!(c.bytes == 820 * 81 && c.lines == 820) && !(c.bytes == 3 * 21 && c.lines == 3))
+                    torn ++;
+            }
+        });
+        std::vector<std::thread> sessions;
+        for (int i = 0; i < 4; i++)
+            sessions.push_back (std::thread ([i] () {
+                for (int j = 0; j < 25; j++)
+                    __testCat__ (i % 2 ? "/var/www/html/short.txt" : "/var/www/html/long.txt", "root");
+            }));
+        for (auto& t : sessions)
+            t.join ();
+        running = false;
+        observer.join ();
+        TEST_CHECK (torn == 0);
+
+        TSFS.remove ("/var/www/html/long.txt");
+        TSFS.remove ("/var/www/html/short.txt");
+        TSFS.remove ("/var/www/html2/secret.txt");
+
+        // a 0 byte doesn't cut what end () returns
+        File f = TSFS.open ("/var/www/html/zero.bin", "w");
+        TEST_CHECK (f && f.write ((const uint8_t *) "ab\0cd\n", 6) == 6);
+        f.close ();
+        TEST_CHECK (__testCat__ ("/var/www/html/zero.bin", "webadmin").length () == 7);
+        TSFS.remove ("/var/www/html/zero.bin");
+    }
+
+    int test () {
+        struct { const char *name; void (*function) (); bool afterSetup; } tests [] = {
+            { "dmesg ring", __testDmesgRing__, false },
+            { "dmesg reset", __testDmesgReset__, false },
+            { "event loop", __testEventLoop__, false },
+            { "crypto", __testCrypto__, false },
+            { "power loss", __testPowerLoss__, false },
+            { "user files", __testUserFiles__, true },
+            { "telnet cat", __testTelnetCat__, true }
+        };
+        LittleFS.begin (true); // the tests before setup () need the file system too
+        int failed = 0;
+        bool setupDone = false;
+        for (auto t : tests) {
+            if (t.afterSetup && !setupDone) {
+                setup ();
+                setupDone = true;
+            }
+            __testPassed__ = true;
+            t.function ();
+            printf ("%-30s  %s\n", t.name, __testPassed__ ? "passed" : "failed");
+            if (!__testPassed__)
+                failed ++;
+        }
+        return failed;
+    }
+
+#endif
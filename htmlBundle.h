@@ -0,0 +1,129 @@
+/*
+
+    htmlBundle.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Sends the files from html/ that were compiled into the firmware by tools/bundleHtml.py.
+
+    Each file is stored in flash as an HTTP reply: precomputed header (Content-Type, Content-Length,
+    Content-Encoding, ETag) followed by the gzip-compressed content. The path is found with a perfect hash
+    (one hash calculation and one strcmp). Connection field, which depends on the connection, is added to the
+    header when it is sent and the content is sent directly from the flash-mapped memory, so nothing has to be
+    uploaded to /var/www/html and the file system is not accessed.
+
+    Clients that do not accept gzip and files that are not in the bundle are left to httpServer_t (and to
+    staticAssetCache) which read them from /var/www/html as before.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HTML_BUNDLE_H__
+    #define __HTML_BUNDLE_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <Cstring.hpp>
+    #include "httpReplyStream.h"
+
+
+    // TUNING PARAMETERS
+    #define HTML_BUNDLE_MAX_PATH 64 // maximum length of the path in the URL
+
+
+    struct htmlBundleAsset_t {
+        const char *path;
+        const char *reply;      // HTTP reply header without Connection field and the empty line, followed by the content
+        size_t replyLength;
+        size_t headerLength;
+        const char *etag;
+        bool gzip;
+    };
+
+    #include "htmlBundleData.h" // generated by tools/bundleHtml.py
+
+
+    class htmlBundle_t {
+
+        public:
+
+            // sends the reply from flash and returns HTTP_REPLY_ALREADY_SENT, or returns NULL if the request should be handled by httpServer_t
+            template<class connection_t> const char *reply (const char *httpRequest, connection_t *hcn) {
+                if (strncmp (httpRequest, "GET /", 5))
+                    return NULL;
+
+                // extract the path from the request line: GET /path?query HTTP/1.1
+                char path [HTML_BUNDLE_MAX_PATH + 1];
+                size_t i = 0;
+                for (const char *p = httpRequest + 4; *p > ' ' && *p != '?'; p++) {
+                    if (i == HTML_BUNDLE_MAX_PATH)
+                        return NULL;
+                    path [i++] = *p;
+                }
+                path [i] = 0;
+
+                const htmlBundleAsset_t *a = find (path);
+                if (!a)
+                    return NULL;
+                if (a->gzip) {
+                    Cstring<64> acceptEncoding = hcn->getHttpRequestHeaderField ("Accept-Encoding");
+                    if (!strstr (acceptEncoding.c_str (), "gzip"))
+                        return NULL;
+                }
+
+                httpReplyStream_t<connection_t> reply (hcn);
+                Cstring<64> ifNoneMatch = hcn->getHttpRequestHeaderField ("If-None-Match");
+                if (ifNoneMatch == a->etag) {
+                    __notModified__ ++;
+                    reply.printf ("HTTP/1.1 304 Not Modified\r\nETag: %s\r\n%s%s\r\n", a->etag, a->gzip ? "Vary: Accept-Encoding\r\n" : "", httpReplyStream_t<connection_t>::connectionField (hcn));
+                } else {
+                    __hits__ ++;
+                    reply.write (a->reply, a->headerLength);
+                    reply.print (httpReplyStream_t<connection_t>::connectionField (hcn));
+                    reply.print ("\r\n");
+                    reply.write (a->reply + a->headerLength, a->replyLength - a->headerLength); // usually larger than the stream buffer, so it goes directly from flash to the socket
+                }
+                return reply.end ();
+            }
+
+            // returns the bundled file or NULL if path is not in the bundle
+            static const htmlBundleAsset_t *find (const char *path) {
+                int16_t i = __htmlBundleTable__ [__hash__ (path) & (HTML_BUNDLE_TABLE_SIZE - 1)];
+                if (i < 0 || strcmp (__htmlBundleAssets__ [i].path, path))
+                    return NULL;
+                return &__htmlBundleAssets__ [i];
+            }
+
+            inline uint32_t hits () __attribute__((always_inline)) { return __hits__; }
+            inline uint32_t notModified () __attribute__((always_inline)) { return __notModified__; }
+
+            String toText () {
+                char buf [120];
+                snprintf (buf, sizeof (buf), "html bundle: %u paths, sent %lu, not modified %lu", (unsigned) (sizeof (__htmlBundleAssets__) / sizeof (__htmlBundleAssets__ [0])),
+                                                                                                     (unsigned long) __hits__, (unsigned long) __notModified__);
+                String s = buf;
+                for (const htmlBundleAsset_t& a : __htmlBundleAssets__) {
+                    snprintf (buf, sizeof (buf), "\r\n  %-40s %6u B%s", a.path, (unsigned) a.replyLength, a.gzip ? " gzip" : "");
+                    s += buf;
+                }
+                return s;
+            }
+
+        private:
+
+            std::atomic<uint32_t> __hits__ = {};
+            std::atomic<uint32_t> __notModified__ = {};
+
+            // FNV-1a with the seed that tools/bundleHtml.py has found to give no collisions
+            static uint32_t __hash__ (const char *s) {
+                uint32_t h = HTML_BUNDLE_SEED;
+                while (*s)
+                    h = (h ^ (uint8_t) *s++) * 16777619;
+                return h;
+            }
+    };
+
+#endif
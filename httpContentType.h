@@ -0,0 +1,45 @@
+/*
+
+    httpContentType.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Content-Type of the files served from /var/www/html, shared by staticAssetCache_t and eventHttpServer_t.
+
+    The type is chosen by the file name extension. file.html.gz has the type of file.html (it is sent with
+    Content-Encoding: gzip) and a path that ends with / has the type of its index.html.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HTTP_CONTENT_TYPE_H__
+    #define __HTTP_CONTENT_TYPE_H__
+
+    #include <string.h>
+
+
+    inline const char *httpContentType (const char *fileName) {
+        static const struct { const char *extension; const char *contentType; } contentTypes [] = {
+            { ".html", "text/html" },               { ".htm", "text/html" },            { ".css", "text/css" },
+            { ".js", "application/javascript" },    { ".json", "application/json" },    { ".txt", "text/plain" },
+            { ".png", "image/png" },                { ".jpg", "image/jpeg" },           { ".jpeg", "image/jpeg" },
+            { ".gif", "image/gif" },                { ".ico", "image/x-icon" },         { ".svg", "image/svg+xml" },
+            { ".xml", "text/xml" },                 { ".pdf", "application/pdf" }
+        };
+        size_t l = strlen (fileName);
+        if (l && fileName [l - 1] == '/')
+            return "text/html"; // index.html
+        if (l > 3 && !strcmp (fileName + l - 3, ".gz"))
+            l -= 3;
+        for (auto ct : contentTypes) {
+            size_t e = strlen (ct.extension);
+            if (l > e && !strncmp (fileName + l - e, ct.extension, e))
+                return ct.contentType;
+        }
+        return "application/octet-stream";
+    }
+
+#endif
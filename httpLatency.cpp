@@ -0,0 +1,120 @@
+/*
+
+    httpLatency.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Per-route latency histograms of httpRequestHandlerCallback and wsRequestHandlerCallback.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "httpLatency.h"
+
+
+uint32_t latencyHistogram_t::count () {
+    uint32_t c = 0;
+    for (int b = 0; b < HTTP_LATENCY_BUCKETS; b++)
+        c += __buckets__ [b].load (std::memory_order_relaxed);
+    return c;
+}
+
+uint32_t latencyHistogram_t::percentile (int percent) {
+    uint32_t c = count ();
+    if (c == 0)
+        return 0;
+    uint32_t threshold = (uint32_t) (((uint64_t) c * percent + 99) / 100); // rounded up
+    uint32_t cumulative = 0;
+    for (int b = 0; b < HTTP_LATENCY_BUCKETS; b++) {
+        cumulative += __buckets__ [b].load (std::memory_order_relaxed);
+        if (cumulative >= threshold)
+            return (uint32_t) 1 << b;
+    }
+    return (uint32_t) 1 << (HTTP_LATENCY_BUCKETS - 1);
+}
+
+void latencyHistogram_t::reset () {
+    for (int b = 0; b < HTTP_LATENCY_BUCKETS; b++)
+        __buckets__ [b].store (0, std::memory_order_relaxed);
+    __max__.store (0, std::memory_order_relaxed);
+}
+
+
+bool httpLatency_t::addRoute (const char *requestBeginsWith) {
+    int i = __routeCount__.load (std::memory_order_relaxed);
+    if (i >= HTTP_LATENCY_MAX_ROUTES)
+        return false;
+    __routes__ [i] = requestBeginsWith;
+    __routeCount__.store (i + 1, std::memory_order_release); // routes are normally added in setup (), before requests arrive
+    return true;
+}
+
+int httpLatency_t::__findRoute__ (const char *httpRequest) {
+    int count = __routeCount__.load (std::memory_order_acquire);
+    for (int i = 1; i < count; i++)
+        if (strstr (httpRequest, __routes__ [i]) == httpRequest)
+            return i;
+    return 0; // other
+}
+
+void httpLatency_t::reset () {
+    for (int i = 0; i < HTTP_LATENCY_MAX_ROUTES; i++) {
+        __timeToFirstByte__ [i].reset ();
+        __total__ [i].reset ();
+    }
+}
+
+String httpLatency_t::toJson () {
+    String s = "{\"unit\":\"us\",\"routes\":[";
+    int count = __routeCount__.load (std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        char buf [300];
+        snprintf (buf, sizeof (buf), "%s{\"route\":\"%s\",\"requests\":%lu,"
+                                     "\"timeToFirstByte\":{\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"max\":%lu},"
+                                     "\"total\":{\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"max\":%lu}}",
+                                     i ? "," : "", __routes__ [i], (unsigned long) __total__ [i].count (),
+                                     (unsigned long) __timeToFirstByte__ [i].percentile (50), (unsigned long) __timeToFirstByte__ [i].percentile (90), (unsigned long) __timeToFirstByte__ [i].percentile (99), (unsigned long) __timeToFirstByte__ [i].max (),
+                                     (unsigned long) __total__ [i].percentile (50), (unsigned long) __total__ [i].percentile (90), (unsigned long) __total__ [i].percentile (99), (unsigned long) __total__ [i].max ());
+        s += buf;
+    }
+    s += "]}\r\n";
+    return s;
+}
+
+String httpLatency_t::toText () {
+    String s = "route                       requests   first byte [us] p50/p99/max    total [us] p50/p99/max";
+    int count = __routeCount__.load (std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        char buf [200];
+        snprintf (buf, sizeof (buf), "\r\n%-26.26s %9lu   <%-8lu <%-8lu %-9lu <%-8lu <%-8lu %lu",
+                                     __routes__ [i], (unsigned long) __total__ [i].count (),
+                                     (unsigned long) __timeToFirstByte__ [i].percentile (50), (unsigned long) __timeToFirstByte__ [i].percentile (99), (unsigned long) __timeToFirstByte__ [i].max (),
+                                     (unsigned long) __total__ [i].percentile (50), (unsigned long) __total__ [i].percentile (99), (unsigned long) __total__ [i].max ());
+        s += buf;
+    }
+    return s;
+}
+
+String httpLatency_t::benchmark () {
+    // use a separate instance with the same routes so that the statistics are not affected
+    httpLatency_t *bench = new (std::nothrow) httpLatency_t;
+    if (!bench)
+        return "Out of memory";
+    int count = __routeCount__.load (std::memory_order_acquire);
+    for (int i = 1; i < count; i++)
+        bench->addRoute (__routes__ [i]);
+
+    int64_t start = esp_timer_get_time ();
+    for (int i = 0; i < HTTP_LATENCY_BENCHMARK_REQUESTS; i++) {
+        httpLatency_t::timer_t t (*bench, "GET /benchmark HTTP/1.1"); // worst case: no route matches
+    }
+    int64_t end = esp_timer_get_time ();
+    delete bench;
+
+    char buf [120];
+    snprintf (buf, sizeof (buf), "%i requests measured in %lu us, overhead %lu ns per request",
+                                 HTTP_LATENCY_BENCHMARK_REQUESTS, (unsigned long) (end - start), (unsigned long) ((end - start) * 1000 / HTTP_LATENCY_BENCHMARK_REQUESTS));
+    return buf;
+}
@@ -0,0 +1,123 @@
+/*
+
+    httpLatency.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Per-route latency histograms of httpRequestHandlerCallback and wsRequestHandlerCallback.
+
+    Each route keeps two histograms with power-of-two microsecond buckets: time to first byte and total time.
+    Time to first byte ends when httpReplyStream_t sends the first bytes or when the handler returns (after
+    which httpServer_t starts sending the returned String). Total time ends when the handler returns, so for
+    replies returned in a String it does not include the sending itself, and for WebSockets it is the length
+    of the session.
+
+    Time is taken with esp_timer_get_time rather than the cycle counter, since the handler may be moved to the
+    other core while it runs. Recording a request costs two timer reads and a few relaxed atomic increments,
+    run the httpstat bench Telnet command to measure it on your board.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HTTP_LATENCY_H__
+    #define __HTTP_LATENCY_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <esp_timer.h>
+    #include "httpReplyStream.h"
+
+
+    // TUNING PARAMETERS
+    #define HTTP_LATENCY_MAX_ROUTES 12  // including route 0 which collects all the requests that do not match any registered route
+    #define HTTP_LATENCY_BUCKETS 24     // bucket b counts durations < 2^b us, the last one also counts all the longer durations (> 8 s)
+    #define HTTP_LATENCY_BENCHMARK_REQUESTS 10000 // requests measured by httpstat bench
+
+
+    class latencyHistogram_t {
+
+        public:
+
+            // durations are clamped to 32 bits, so a WebSocket session longer than ~71 minutes is counted as 4294967295 us
+            inline void add (int64_t duration) __attribute__((always_inline)) {
+                uint32_t microseconds = duration <= 0 ? 0 : duration >= UINT32_MAX ? UINT32_MAX : (uint32_t) duration;
+                int b = microseconds ? 32 - __builtin_clz (microseconds) : 0;
+                if (b >= HTTP_LATENCY_BUCKETS)
+                    b = HTTP_LATENCY_BUCKETS - 1;
+                __buckets__ [b].fetch_add (1, std::memory_order_relaxed);
+                uint32_t m = __max__.load (std::memory_order_relaxed);
+                while (microseconds > m && !__max__.compare_exchange_weak (m, microseconds, std::memory_order_relaxed));
+            }
+
+            uint32_t count ();
+
+            // returns the upper bound (in us) of the bucket that contains the percentile
+            uint32_t percentile (int percent);
+
+            inline uint32_t max () __attribute__((always_inline)) { return __max__.load (std::memory_order_relaxed); }
+
+            void reset ();
+
+        private:
+
+            std::atomic<uint32_t> __buckets__ [HTTP_LATENCY_BUCKETS] = {};
+            std::atomic<uint32_t> __max__ = {};
+    };
+
+
+    class httpLatency_t {
+
+        public:
+
+            // measures one request from construction to destruction, create it at the beginning of the handler
+            class timer_t {
+
+                public:
+
+                    timer_t (httpLatency_t& httpLatency, const char *httpRequest) : __httpLatency__ (httpLatency) {
+                        __route__ = __httpLatency__.__findRoute__ (httpRequest);
+                        httpReplyFirstByteTime = 0;
+                        __start__ = esp_timer_get_time ();
+                    }
+
+                    ~timer_t () {
+                        int64_t end = esp_timer_get_time ();
+                        int64_t firstByte = httpReplyFirstByteTime ? httpReplyFirstByteTime : end;
+                        __httpLatency__.__timeToFirstByte__ [__route__].add (firstByte - __start__);
+                        __httpLatency__.__total__ [__route__].add (end - __start__);
+                    }
+
+                private:
+
+                    httpLatency_t& __httpLatency__;
+                    int __route__;
+                    int64_t __start__;
+            };
+
+            // registers the beginning of HTTP requests, like "GET /state ", that are measured separately, returns false if there is no more space
+            bool addRoute (const char *requestBeginsWith);
+
+            void reset ();
+
+            String toJson ();
+
+            String toText ();
+
+            // measures the overhead of timer_t, returns the result as text
+            String benchmark ();
+
+        private:
+
+            const char *__routes__ [HTTP_LATENCY_MAX_ROUTES] = { "other" };
+            std::atomic<int> __routeCount__ = { 1 };
+
+            latencyHistogram_t __timeToFirstByte__ [HTTP_LATENCY_MAX_ROUTES];
+            latencyHistogram_t __total__ [HTTP_LATENCY_MAX_ROUTES];
+
+            int __findRoute__ (const char *httpRequest);
+    };
+
+#endif
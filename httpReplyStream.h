@@ -0,0 +1,153 @@
+/*
+
+    httpReplyStream.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Sends a HTTP reply directly to the socket through a small stack buffer, without building a String first.
+
+    httpRequestHandlerCallback normally returns the whole reply content in a String, which httpServer_t then
+    sends. For larger or generated replies the handler may instead write the reply itself:
+
+        httpReplyStream_t<httpServer_t::httpConnection_t> reply (hcn);
+        reply.sendHeader ("200 OK", "text/plain");
+        reply.printf ("%i\n", 42);
+        return reply.end (); // returns HTTP_REPLY_ALREADY_SENT
+
+    end () shuts down the sending side of the connection so the client sees the end of the reply and whatever
+    httpServer_t would still try to send afterwards is discarded. eventHttpServer_t connections may be kept alive
+    instead, the Connection header field then says so if the reply has Content-Length.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __HTTP_REPLY_STREAM_H__
+    #define __HTTP_REPLY_STREAM_H__
+
+    #include <Arduino.h>
+    #include <stdarg.h>
+    #include <stdio.h>
+    #include <string.h>
+    #include <sys/socket.h>
+    #include <esp_timer.h>
+
+
+    // TUNING PARAMETERS
+    #define HTTP_REPLY_STREAM_BUFFER_SIZE 1024  // bytes collected on the stack before they are sent, a little less than one TCP segment
+
+
+    // httpRequestHandlerCallback returns this when the reply has already been sent through httpReplyStream_t
+    #define HTTP_REPLY_ALREADY_SENT "\r"
+
+
+    // when the first bytes of the current reply were sent (esp_timer_get_time), kept per task for latency statistics (see httpLatency.h)
+    inline thread_local int64_t httpReplyFirstByteTime = 0;
+
+
+    template<class connection_t> class httpReplyStream_t {
+
+        public:
+
+            httpReplyStream_t (connection_t *connection) : __connection__ (connection) {}
+
+            // sends status line and header fields, contentLength < 0 means that the length is not known in advance and the end of the reply is marked by closing the connection
+            bool sendHeader (const char *status, const char *contentType, long contentLength = -1, const char *additionalHeaderFields = "") {
+                printf ("HTTP/1.1 %s\r\nContent-Type: %s\r\n", status, contentType);
+                if (contentLength >= 0)
+                    printf ("Content-Length: %li\r\n", contentLength);
+                print (contentLength >= 0 ? connectionField (__connection__) : "Connection: close\r\n");
+                print (additionalHeaderFields);
+                return print ("\r\n");
+            }
+
+            bool write (const char *buf, size_t len) {
+                if (__error__)
+                    return false;
+                if (__length__ + len > sizeof (__buffer__)) {
+                    if (!flush ())
+                        return false;
+                    if (len > sizeof (__buffer__)) // too large to buffer, send it directly
+                        return __send__ (buf, len);
+                }
+                memcpy (__buffer__ + __length__, buf, len);
+                __length__ += len;
+                return true;
+            }
+
+            inline bool print (const char *s) __attribute__((always_inline)) { return write (s, strlen (s)); }
+
+            bool printf (const char *format, ...) __attribute__((format (printf, 2, 3))) {
+                if (__error__)
+                    return false;
+                for (int attempt = 0; attempt < 2; attempt++) {
+                    va_list args;
+                    va_start (args, format);
+                    int l = vsnprintf (__buffer__ + __length__, sizeof (__buffer__) - __length__, format, args);
+                    va_end (args);
+                    if (l < 0)
+                        return false;
+                    if (__length__ + l < sizeof (__buffer__)) { // it fits
+                        __length__ += l;
+                        return true;
+                    }
+                    if (!flush ()) // make space and try once more
+                        return false;
+                }
+                return false; // the formatted text is longer than the whole buffer
+            }
+
+            bool flush () {
+                if (__error__)
+                    return false;
+                if (__length__ == 0)
+                    return true;
+                bool sent = __send__ (__buffer__, __length__);
+                __length__ = 0;
+                return sent;
+            }
+
+            // flushes the buffer and closes the sending side of the connection, the result should be returned from httpRequestHandlerCallback
+            const char *end () {
+                flush ();
+                __endOfReply__ (__connection__, 0);
+                return HTTP_REPLY_ALREADY_SENT;
+            }
+
+            inline size_t bytesSent () __attribute__((always_inline)) { return __bytesSent__; }
+
+            inline bool error () __attribute__((always_inline)) { return __error__; }
+
+            // Connection header field for a reply with Content-Length, for handlers and caches that write the header themselves
+            static const char *connectionField (connection_t *connection) { return __keepAlive__ (connection, 0) ? "Connection: keep-alive\r\n" : "Connection: close\r\n"; }
+
+        private:
+
+            connection_t *__connection__;
+            char __buffer__ [HTTP_REPLY_STREAM_BUFFER_SIZE];
+            size_t __length__ = 0;
+            size_t __bytesSent__ = 0;
+            bool __error__ = false;
+
+            bool __send__ (const char *buf, size_t len) {
+                if (!httpReplyFirstByteTime)
+                    httpReplyFirstByteTime = esp_timer_get_time ();
+                if (__connection__->sendBlock ((byte *) buf, len) <= 0) {
+                    __error__ = true; // the client has probably closed the connection, don't try to send anything more
+                    return false;
+                }
+                __bytesSent__ += len;
+                return true;
+            }
+
+            // connections that buffer the reply (eventHttpServer_t) close themselves or wait for the next request when the buffer is sent, the others are shut down here
+            template<class C> static auto __endOfReply__ (C *connection, int) -> decltype (connection->replyComplete (), void ()) { connection->replyComplete (); }
+            template<class C> static void __endOfReply__ (C *connection, long) { shutdown (connection->getSocket (), SHUT_WR); }
+
+            template<class C> static auto __keepAlive__ (C *connection, int) -> decltype (connection->keepAlive ()) { return connection->keepAlive (); }
+            template<class C> static bool __keepAlive__ (C *, long) { return false; }
+    };
+
+#endif
@@ -0,0 +1,71 @@
+/*
+
+    metrics.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Registry of counters and gauges that can be scraped in OpenMetrics (Prometheus) text format.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "metrics.h"
+
+#include <lwip/tcpip.h>
+#include <lwip/priv/tcp_priv.h> // tcp_active_pcbs
+
+
+metrics_t::metric_t& metrics_t::addCounter (const char *name, const char *help) {
+    return __add__ (name, help, COUNTER, NULL);
+}
+
+metrics_t::metric_t& metrics_t::addCounter (const char *name, const char *help, double (*callback) ()) {
+    return __add__ (name, help, COUNTER, callback);
+}
+
+metrics_t::metric_t& metrics_t::addGauge (const char *name, const char *help) {
+    return __add__ (name, help, GAUGE, NULL);
+}
+
+metrics_t::metric_t& metrics_t::addGauge (const char *name, const char *help, double (*callback) ()) {
+    return __add__ (name, help, GAUGE, callback);
+}
+
+metrics_t::metric_t& metrics_t::__add__ (const char *name, const char *help, metricType_t type, double (*callback) ()) {
+    int i = __reserved__.fetch_add (1, std::memory_order_acq_rel);
+    if (i >= METRICS_MAX_COUNT)
+        return __overflow__;
+
+    metric_t& m = __metrics__ [i];
+    m.__help__ = help ? help : "";
+    m.__type__ = type;
+    m.__callback__ = callback;
+    m.__name__.store (name, std::memory_order_release); // publish
+    return m;
+}
+
+
+// tcp_active_pcbs may only be accessed from lwIP's tcpip thread
+struct __tcpConnectionsCall__ {
+    struct tcpip_api_call_data call; // must be the first member
+    uint16_t localPort;
+    int count;
+};
+
+static err_t __countTcpConnections__ (struct tcpip_api_call_data *call) {
+    __tcpConnectionsCall__ *c = (__tcpConnectionsCall__ *) call;
+    for (struct tcp_pcb *pcb = tcp_active_pcbs; pcb; pcb = pcb->next)
+        if (pcb->local_port == c->localPort && pcb->state == ESTABLISHED)
+            c->count ++;
+    return ERR_OK;
+}
+
+int metrics_t::tcpConnections (uint16_t localPort) {
+    __tcpConnectionsCall__ c = {};
+    c.localPort = localPort;
+    if (tcpip_api_call (__countTcpConnections__, &c.call) != ERR_OK)
+        return -1;
+    return c.count;
+}
@@ -0,0 +1,119 @@
+/*
+
+    metrics.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Registry of counters and gauges that can be scraped in OpenMetrics (Prometheus) text format.
+
+    Metrics are registered once, usually as global variables, and then updated with a single atomic
+    operation. Scraping streams the registry directly to the socket, so it allocates nothing:
+
+        metrics_t metrics;
+        metrics_t::metric_t& requests = metrics.addCounter ("esp32_requests", "Requests handled");
+        metrics.addGauge ("esp32_free_heap_bytes", "Free heap", [] () -> double { return ESP.getFreeHeap (); });
+
+        requests.increase ();
+        ...
+        if (httpRequestIs ("GET /metrics ")) return metrics.writeOpenMetrics (hcn);
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __METRICS_H__
+    #define __METRICS_H__
+
+    #include <atomic>
+    #include <math.h>
+    #include "httpReplyStream.h"
+
+
+    // TUNING PARAMETERS
+    #define METRICS_MAX_COUNT 48 // maximum number of registered metrics
+
+
+    class metrics_t {
+
+        public:
+
+            enum metricType_t { COUNTER, GAUGE };
+
+            class metric_t {
+
+                friend class metrics_t;
+
+                public:
+
+                    inline void increase (int32_t by = 1) __attribute__((always_inline)) { __value__.fetch_add (by, std::memory_order_relaxed); }
+
+                    inline void set (int32_t value) __attribute__((always_inline)) { __value__.store (value, std::memory_order_relaxed); }
+
+                    inline int32_t value () __attribute__((always_inline)) { return __value__.load (std::memory_order_relaxed); }
+
+                private:
+
+                    std::atomic<const char *> __name__ = {}; // set last, when the metric is ready to be scraped
+                    const char *__help__ = "";
+                    metricType_t __type__ = GAUGE;
+                    double (*__callback__) () = NULL;      // metrics may be read through a callback function instead of being set
+                    std::atomic<int32_t> __value__ = {};
+            };
+
+            // counter names should not end with _total, the suffix is added when counters are scraped
+            metric_t& addCounter (const char *name, const char *help);
+
+            metric_t& addCounter (const char *name, const char *help, double (*callback) ());
+
+            metric_t& addGauge (const char *name, const char *help);
+
+            metric_t& addGauge (const char *name, const char *help, double (*callback) ());
+
+            // number of established TCP connections on local port, used for gauges of active HTTP, FTP and Telnet connections
+            static int tcpConnections (uint16_t localPort);
+
+            template<class connection_t> const char *writeOpenMetrics (connection_t *connection) {
+                httpReplyStream_t<connection_t> reply (connection);
+                reply.sendHeader ("200 OK", "application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+                int count = __reserved__.load (std::memory_order_acquire);
+                if (count > METRICS_MAX_COUNT)
+                    count = METRICS_MAX_COUNT;
+                for (int i = 0; i < count && !reply.error (); i++) {
+                    metric_t& m = __metrics__ [i];
+                    const char *name = m.__name__.load (std::memory_order_acquire);
+                    if (!name)
+                        continue; // still being registered
+
+                    if (m.__type__ == COUNTER) {
+                        if (m.__callback__)
+                            reply.printf ("# TYPE %s counter\n# HELP %s %s\n%s_total %.10g\n", name, name, m.__help__, name, m.__callback__ ());
+                        else
+                            reply.printf ("# TYPE %s counter\n# HELP %s %s\n%s_total %lu\n", name, name, m.__help__, name, (unsigned long) (uint32_t) m.value ());
+                    } else if (m.__callback__) {
+                        double d = m.__callback__ ();
+                        if (isnan (d))
+                            reply.printf ("# TYPE %s gauge\n# HELP %s %s\n%s NaN\n", name, name, m.__help__, name);
+                        else
+                            reply.printf ("# TYPE %s gauge\n# HELP %s %s\n%s %.10g\n", name, name, m.__help__, name, d);
+                    } else {
+                        reply.printf ("# TYPE %s gauge\n# HELP %s %s\n%s %li\n", name, name, m.__help__, name, (long) m.value ());
+                    }
+                }
+
+                reply.print ("# EOF\n");
+                return reply.end ();
+            }
+
+        private:
+
+            metric_t __metrics__ [METRICS_MAX_COUNT];
+            std::atomic<int> __reserved__ = {};
+            metric_t __overflow__; // returned when there is no more space in the registry so that the caller never gets a NULL, it is not scraped
+
+            metric_t& __add__ (const char *name, const char *help, metricType_t type, double (*callback) ());
+    };
+
+#endif
@@ -0,0 +1,124 @@
+/*
+
+    startupScheduler.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Runs the initialization steps of setup () as parallel tasks, each one as soon as the steps it depends on are done.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "startupScheduler.h"
+#include <esp_timer.h>
+#include <assert.h>
+
+
+startupScheduler_t::startupScheduler_t () {
+    __ready__ = xEventGroupCreate ();
+}
+
+startupScheduler_t::~startupScheduler_t () {
+    if (__ready__)
+        vEventGroupDelete (__ready__);
+}
+
+startupScheduler_t::step_t startupScheduler_t::add (const char *name, void (*init) (), step_t dependsOn, BaseType_t core, uint32_t stackSize) {
+    assert (__count__ < STARTUP_MAX_STEPS && init); // increase STARTUP_MAX_STEPS (at most 24, the bits of an event group)
+    if (__count__ == STARTUP_MAX_STEPS || !init)
+        return 0;
+    __step__& s = __steps__ [__count__];
+    s.scheduler = this;
+    s.name = name;
+    s.init = init;
+    s.bit = (step_t) 1 << __count__;
+    s.dependsOn = dependsOn & (s.bit - 1); // only the steps added before
+    s.core = core;
+    s.stackSize = stackSize;
+    __count__ ++;
+    return s.bit;
+}
+
+bool startupScheduler_t::run (TickType_t timeout) {
+    if (!__ready__) { // no event group, run the steps one after another
+        for (int i = 0; i < __count__; i++) {
+            __steps__ [i].added = esp_timer_get_time ();
+            __runStep__ (__steps__ [i]);
+        }
+        return true;
+    }
+
+    step_t all = 0;
+    for (int i = 0; i < __count__; i++) {
+        all |= __steps__ [i].bit;
+        __steps__ [i].added = esp_timer_get_time ();
+    }
+
+    // start the steps whose dependencies are done, while there are free task slots, and wait for one of the running ones to finish
+    // (the first step not started yet only depends on the steps before it, which have all been started, so this can't get stuck)
+    TickType_t start = xTaskGetTickCount ();
+    step_t started = 0;
+    while (started != all) {
+        step_t done = xEventGroupGetBits (__ready__);
+        int running = __builtin_popcount (started & ~done);
+        for (int i = 0; i < __count__ && running < STARTUP_MAX_TASKS; i++) {
+            __step__& s = __steps__ [i];
+            if ((started & s.bit) || (done & s.dependsOn) != s.dependsOn)
+                continue;
+            started |= s.bit;
+            if (xTaskCreatePinnedToCore (__task__, s.name, s.stackSize, &s, STARTUP_TASK_PRIORITY, NULL, s.core) == pdPASS) {
+                running ++;
+            } else { // run it here
+                __runStep__ (s);
+                xEventGroupSetBits (__ready__, s.bit);
+                done |= s.bit;
+            }
+        }
+        if (started != all && running) {
+            TickType_t waited = xTaskGetTickCount () - start;
+            if (timeout != portMAX_DELAY && waited >= timeout)
+                return false;
+            xEventGroupWaitBits (__ready__, started & ~done, pdFALSE, pdFALSE, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - waited); // any of them
+        }
+    }
+    TickType_t waited = xTaskGetTickCount () - start;
+    if (timeout != portMAX_DELAY && waited >= timeout)
+        return waitFor (all, 0);
+    return waitFor (all, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - waited);
+}
+
+bool startupScheduler_t::waitFor (step_t steps, TickType_t timeout) {
+    if (!__ready__)
+        return true;
+    return (xEventGroupWaitBits (__ready__, steps, pdFALSE, pdTRUE, timeout) & steps) == steps;
+}
+
+void startupScheduler_t::__task__ (void *parameter) {
+    __step__& s = *(__step__ *) parameter; // its dependencies are already done
+    __runStep__ (s);
+    xEventGroupSetBits (s.scheduler->__ready__, s.bit);
+    vTaskDelete (NULL);
+}
+
+void startupScheduler_t::__runStep__ (__step__& s) {
+    s.started = esp_timer_get_time ();
+    s.ranOnCore = xPortGetCoreID ();
+    s.init ();
+    s.finished = esp_timer_get_time ();
+}
+
+String startupScheduler_t::toText () {
+    String s = "step                     waited ms    ran ms  core";
+    for (int i = 0; i < __count__; i++) {
+        const __step__& st = __steps__ [i];
+        char line [96];
+        if (st.finished)
+            snprintf (line, sizeof (line), "\r\n%-24.24s %9.1f %9.1f %5i", st.name, (st.started - st.added) / 1000.0, (st.finished - st.started) / 1000.0, st.ranOnCore);
+        else
+            snprintf (line, sizeof (line), "\r\n%-24.24s %s", st.name, st.started ? "  running" : "  waiting");
+        s += line;
+    }
+    return s;
+}
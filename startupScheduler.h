@@ -0,0 +1,91 @@
+/*
+
+    startupScheduler.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Runs the initialization steps of setup () as parallel tasks, each one as soon as the steps it depends on are done.
+
+    Each step is a function with the steps it depends on, the core to run on and the stack size of its task. add ()
+    returns the step's readiness bit, so a step can only depend on the steps added before it, which also excludes cycles:
+
+        startupScheduler_t startup;
+        startupScheduler_t::step_t fs = startup.add ("LittleFS", [] () { LittleFS.begin (true); });
+        startupScheduler_t::step_t wifi = startup.add ("WiFi", [] () { WiFi_start (TSFS); }, fs, 0);
+        startup.add ("ftpServer", [] () { ftpServer = new ... }, fs | wifi);
+        startup.run (); // returns when all the steps are done
+
+    Readiness is kept in a FreeRTOS event group. run () creates a step's task only when all its dependencies' bits are
+    set and fewer than STARTUP_MAX_TASKS step tasks are running, so their stacks are not all allocated at once. The task
+    runs the function, sets its own bit and deletes itself. A server therefore starts accepting connections as soon as
+    its own dependencies are ready, not when the whole setup () is done. If a task can't be created the step runs in
+    the calling task instead.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __STARTUP_SCHEDULER_H__
+    #define __STARTUP_SCHEDULER_H__
+
+    #include <Arduino.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/event_groups.h>
+
+
+    // TUNING PARAMETERS
+    #define STARTUP_MAX_STEPS 24                // bits of a FreeRTOS event group
+    #define STARTUP_STACK_SIZE (6 * 1024)       // default stack size of a step's task
+    #define STARTUP_MAX_TASKS 4                 // step tasks running at the same time, each one needs its stack
+    #define STARTUP_TASK_PRIORITY 2             // a bit above loop (), so the steps finish before it continues
+
+
+    class startupScheduler_t {
+
+        public:
+
+            typedef EventBits_t step_t;
+
+            startupScheduler_t ();
+            ~startupScheduler_t ();
+
+            // returns the step's readiness bit (to be used in dependsOn of the later steps), more than STARTUP_MAX_STEPS steps
+            // fail an assertion, since the steps depending on the missing one would not wait for it
+            step_t add (const char *name, void (*init) (), step_t dependsOn = 0, BaseType_t core = tskNO_AFFINITY, uint32_t stackSize = STARTUP_STACK_SIZE);
+
+            // starts all the steps and waits until they are done, returns false on timeout
+            bool run (TickType_t timeout = portMAX_DELAY);
+
+            // waits until the steps are done, can be called from any task during run ()
+            bool waitFor (step_t steps, TickType_t timeout = portMAX_DELAY);
+
+            // step name: waited for dependencies, ran, core
+            String toText ();
+
+        private:
+
+            struct __step__ {
+                startupScheduler_t *scheduler;
+                const char *name;
+                void (*init) ();
+                step_t bit;
+                step_t dependsOn;
+                BaseType_t core;
+                uint32_t stackSize;
+                int64_t added;          // us since boot, when run () started
+                int64_t started;        // us since boot, when its dependencies were ready
+                int64_t finished;       // us since boot
+                int8_t ranOnCore;
+            };
+
+            __step__ __steps__ [STARTUP_MAX_STEPS] = {};
+            int __count__ = 0;
+            EventGroupHandle_t __ready__ = NULL;
+
+            static void __task__ (void *parameter);
+            static void __runStep__ (__step__& step);
+    };
+
+#endif
@@ -0,0 +1,307 @@
+/*
+
+    staticAssetCache.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    LRU cache of small, frequently requested files from /var/www/html, kept in RAM (or PSRAM when present).
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "staticAssetCache.h"
+
+
+staticAssetCache_t::staticAssetCache_t (threadSafeFS::FS& fileSystem, const char *documentRoot) : __fileSystem__ (fileSystem), __documentRoot__ (documentRoot) {
+    __semaphore__ = xSemaphoreCreateMutex ();
+    __capacity__ = 0; // PSRAM is not initialized yet when global objects are constructed, decide later
+}
+
+staticAssetCache_t::__entry__ *staticAssetCache_t::__acquire__ (const char *path, bool acceptsGzip) {
+    if (strstr (path, ".."))
+        return NULL;
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        if (!__capacity__) {
+            __capacity__ = psramFound () ? STATIC_ASSET_CACHE_PSRAM_SIZE : STATIC_ASSET_CACHE_SIZE;
+            __allocCaps__ = psramFound () ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+        }
+
+        __entry__ *e = NULL;
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_ENTRIES; i++)
+            if (__entries__ [i].data && !__entries__ [i].stale && !strcmp (__entries__ [i].path, path)) {
+                e = &__entries__ [i];
+                break;
+            }
+
+        if (e && e->gzip && !acceptsGzip) { // only the compressed form is cached, let httpServer_t handle this client
+            xSemaphoreGive (__semaphore__);
+            return NULL;
+        }
+
+        bool revalidate = false;
+        if (e) {
+            e->users ++; // so that it is not freed while being checked or sent
+            e->lastUsed = ++ __clock__;
+            revalidate = millis () - e->validated >= STATIC_ASSET_CACHE_REVALIDATE;
+        } else {
+            __uncached__ *u = __findUncached__ (path, acceptsGzip);
+            if (u && millis () - u->validated < STATIC_ASSET_CACHE_REVALIDATE) { // known not to be cacheable, don't open the file again
+                u->lastUsed = ++ __clock__;
+                if (u->tooLarge)
+                    __tooLarge__ ++;
+                else
+                    __notFound__ ++;
+                xSemaphoreGive (__semaphore__);
+                return NULL;
+            }
+            if (u)
+                *u->path = 0; // check the file again
+        }
+    xSemaphoreGive (__semaphore__);
+
+    if (e && revalidate) {
+        if (__fileChanged__ (e)) {
+            xSemaphoreTake (__semaphore__, portMAX_DELAY);
+                e->stale = true;
+            xSemaphoreGive (__semaphore__);
+            __release__ (e);
+            e = NULL; // load it again
+        } else {
+            e->validated = millis ();
+        }
+    }
+    if (e) {
+        __hits__ ++;
+        return e;
+    }
+
+    // load the file outside of the critical section
+    __entry__ loaded = {};
+    __loadResult__ result = __load__ (&loaded, path, acceptsGzip);
+    if (result == NOT_FOUND || result == TOO_LARGE) {
+        if (result == TOO_LARGE)
+            __tooLarge__ ++;
+        else
+            __notFound__ ++;
+        xSemaphoreTake (__semaphore__, portMAX_DELAY);
+            __addUncached__ (path, acceptsGzip, result == TOO_LARGE);
+        xSemaphoreGive (__semaphore__);
+        return NULL;
+    }
+    __misses__ ++;
+    if (result != LOADED)
+        return NULL;
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        // another task may have loaded the same file in the meantime, keep only the latest
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_ENTRIES; i++)
+            if (__entries__ [i].data && !__entries__ [i].stale && !strcmp (__entries__ [i].path, path)) {
+                __entries__ [i].stale = true;
+                if (!__entries__ [i].users)
+                    __free__ (&__entries__ [i]);
+            }
+
+        e = __makeRoom__ (loaded.size);
+        if (e) {
+            *e = loaded;
+            e->users = 1;
+            e->lastUsed = ++ __clock__;
+            __bytesUsed__ += e->size;
+        }
+    xSemaphoreGive (__semaphore__);
+
+    if (!e)
+        heap_caps_free (loaded.data); // could not make room, let httpServer_t handle the request
+    return e;
+}
+
+void staticAssetCache_t::__release__ (__entry__ *e) {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        e->users --;
+        if (e->stale && !e->users)
+            __free__ (e);
+    xSemaphoreGive (__semaphore__);
+}
+
+// reads the file into a newly allocated block, right after the space reserved for the header
+staticAssetCache_t::__loadResult__ staticAssetCache_t::__load__ (__entry__ *e, const char *path, bool acceptsGzip) {
+    Cstring<255> fileName = __fileName__ (path);
+    e->gzip = false;
+    if (acceptsGzip) {
+        Cstring<255> gzFileName = fileName;
+        gzFileName += ".gz";
+        if (__fileSystem__.isFile (gzFileName)) {
+            fileName = gzFileName;
+            e->gzip = true;
+        }
+    }
+    if (fileName.errorFlags ())
+        return FAILED;
+
+    threadSafeFS::File f = __fileSystem__.open (fileName, "r");
+    if (!f || f.isDirectory ())
+        return NOT_FOUND;
+    size_t fileSize = f.size ();
+    if (fileSize > STATIC_ASSET_CACHE_MAX_FILE_SIZE || STATIC_ASSET_CACHE_HEADER_SIZE + fileSize > __capacity__)
+        return TOO_LARGE;
+
+    char *data = (char *) heap_caps_malloc (STATIC_ASSET_CACHE_HEADER_SIZE + fileSize, __allocCaps__);
+    if (!data)
+        return FAILED;
+    if ((size_t) f.read ((uint8_t *) data + STATIC_ASSET_CACHE_HEADER_SIZE, fileSize) != fileSize) {
+        heap_caps_free (data);
+        return FAILED;
+    }
+    e->fileSize = fileSize;
+    e->fileLastWrite = f.getLastWrite ();
+    f.close ();
+
+    // ETag is FNV-1a hash of the content
+    uint32_t h = 2166136261;
+    for (size_t i = 0; i < fileSize; i++)
+        h = (h ^ (uint8_t) data [STATIC_ASSET_CACHE_HEADER_SIZE + i]) * 16777619;
+    snprintf (e->etag, sizeof (e->etag), "\"%08lx%s\"", (unsigned long) h, e->gzip ? "-gz" : "");
+
+    char header [STATIC_ASSET_CACHE_HEADER_SIZE];
+    int l = snprintf (header, sizeof (header), "HTTP/1.1 200 OK\r\n"
+                                               "Content-Type: %s\r\n"
+                                               "Content-Length: %u\r\n"
+                                               "%s"
+                                               "ETag: %s\r\n"
+                                               "Cache-Control: no-cache\r\n" // the browser may keep the file but must check the ETag before using it
+                                               "Vary: Accept-Encoding\r\n"   // so that caches on the way don't send the gzip form to clients that didn't accept it
+                                               "Connection: close\r\n\r\n",
+                                               httpContentType (path), (unsigned) fileSize, e->gzip ? "Content-Encoding: gzip\r\n" : "", e->etag);
+    if (l <= 0 || l >= (int) sizeof (header)) {
+        heap_caps_free (data);
+        return FAILED;
+    }
+
+    // place the header right in front of the content
+    e->reply = data + STATIC_ASSET_CACHE_HEADER_SIZE - l;
+    memcpy (e->reply, header, l);
+    e->replyLength = l + fileSize;
+    e->contentOffset = l;
+    e->connectionFieldOffset = l - strlen ("Connection: close\r\n\r\n");
+    e->data = data;
+    e->size = STATIC_ASSET_CACHE_HEADER_SIZE + fileSize;
+    strcpy (e->path, path);
+    e->validated = millis ();
+    return LOADED;
+}
+
+bool staticAssetCache_t::__fileChanged__ (__entry__ *e) {
+    Cstring<255> fileName = __fileName__ (e->path);
+    if (e->gzip)
+        fileName += ".gz";
+    threadSafeFS::File f = __fileSystem__.open (fileName, "r");
+    if (!f || f.isDirectory ())
+        return true; // deleted
+    return f.size () != e->fileSize || f.getLastWrite () != e->fileLastWrite;
+}
+
+staticAssetCache_t::__uncached__ *staticAssetCache_t::__findUncached__ (const char *path, bool acceptsGzip) {
+    for (int i = 0; i < STATIC_ASSET_CACHE_MAX_UNCACHED; i++)
+        if (__uncachedEntries__ [i].acceptsGzip == acceptsGzip && !strcmp (__uncachedEntries__ [i].path, path))
+            return &__uncachedEntries__ [i];
+    return NULL;
+}
+
+// remembers a file that __load__ didn't find or found too large, in place of the least recently used entry if all of them are used
+void staticAssetCache_t::__addUncached__ (const char *path, bool acceptsGzip, bool tooLarge) {
+    __uncached__ *u = __findUncached__ (path, acceptsGzip); // another task may have added it in the meantime
+    for (int i = 0; i < STATIC_ASSET_CACHE_MAX_UNCACHED && !u; i++)
+        if (!*__uncachedEntries__ [i].path)
+            u = &__uncachedEntries__ [i];
+    if (!u) {
+        u = &__uncachedEntries__ [0];
+        for (int i = 1; i < STATIC_ASSET_CACHE_MAX_UNCACHED; i++)
+            if ((int32_t) (__uncachedEntries__ [i].lastUsed - u->lastUsed) < 0)
+                u = &__uncachedEntries__ [i];
+    }
+    strcpy (u->path, path);
+    u->acceptsGzip = acceptsGzip;
+    u->tooLarge = tooLarge;
+    u->validated = millis ();
+    u->lastUsed = ++ __clock__;
+}
+
+void staticAssetCache_t::__free__ (__entry__ *e) {
+    heap_caps_free (e->data);
+    __bytesUsed__ -= e->size;
+    e->data = NULL;
+    e->stale = false;
+    e->users = 0;
+}
+
+// evicts least recently used entries until size bytes and a free entry are available, returns the free entry or NULL
+staticAssetCache_t::__entry__ *staticAssetCache_t::__makeRoom__ (size_t size) {
+    while (true) {
+        __entry__ *freeEntry = NULL;
+        __entry__ *lru = NULL;
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_ENTRIES; i++) {
+            __entry__ *e = &__entries__ [i];
+            if (!e->data) {
+                if (!freeEntry)
+                    freeEntry = e;
+            } else if (!e->users && (!lru || (int32_t) (e->lastUsed - lru->lastUsed) < 0)) {
+                lru = e;
+            }
+        }
+        if (freeEntry && __bytesUsed__ + size <= __capacity__)
+            return freeEntry;
+        if (!lru)
+            return NULL; // everything else is being sent at the moment
+        __free__ (lru);
+        __evictions__ ++;
+    }
+}
+
+void staticAssetCache_t::clear () {
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_ENTRIES; i++)
+            if (__entries__ [i].data) {
+                __entries__ [i].stale = true;
+                if (!__entries__ [i].users)
+                    __free__ (&__entries__ [i]);
+            }
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_UNCACHED; i++)
+            *__uncachedEntries__ [i].path = 0;
+    xSemaphoreGive (__semaphore__);
+}
+
+Cstring<255> staticAssetCache_t::__fileName__ (const char *path) {
+    Cstring<255> fileName = __documentRoot__;
+    fileName += path;
+    if (path [strlen (path) - 1] == '/')
+        fileName += "index.html";
+    return fileName;
+}
+
+String staticAssetCache_t::toText () {
+    char buf [200];
+    uint32_t h = __hits__, m = __misses__;
+    snprintf (buf, sizeof (buf), "static asset cache is %s, %u of %u KB of %s used\r\n"
+                                 "hits %lu, misses %lu, not modified %lu, evictions %lu, hit rate %.1f %%, not found %lu, too large %lu",
+                                 __enabled__ ? "on" : "off", (unsigned) (__bytesUsed__ / 1024), (unsigned) (__capacity__ / 1024), __allocCaps__ == MALLOC_CAP_SPIRAM ? "PSRAM" : "RAM",
+                                 (unsigned long) h, (unsigned long) m, (unsigned long) __notModified__, (unsigned long) __evictions__, h + m ? 100.0 * h / (h + m) : 0.0,
+                                 (unsigned long) __notFound__, (unsigned long) __tooLarge__);
+    String s = buf;
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_ENTRIES; i++)
+            if (__entries__ [i].data && !__entries__ [i].stale) {
+                snprintf (buf, sizeof (buf), "\r\n  %-40s %6u B%s", __entries__ [i].path, (unsigned) __entries__ [i].fileSize, __entries__ [i].gzip ? " gzip" : "");
+                s += buf;
+            }
+        for (int i = 0; i < STATIC_ASSET_CACHE_MAX_UNCACHED; i++)
+            if (*__uncachedEntries__ [i].path) {
+                snprintf (buf, sizeof (buf), "\r\n  %-40s %s", __uncachedEntries__ [i].path, __uncachedEntries__ [i].tooLarge ? "too large" : "not found");
+                s += buf;
+            }
+    xSemaphoreGive (__semaphore__);
+    return s;
+}
@@ -0,0 +1,173 @@
+/*
+
+    staticAssetCache.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    LRU cache of small, frequently requested files from /var/www/html, kept in RAM (or PSRAM when present).
+
+    Each entry holds the complete reply: precomputed HTTP header (Content-Type, Content-Length, Content-Encoding,
+    ETag, Vary) followed by the file content, so a hit is sent with a single sendBlock and without file system access.
+    If the client sends a matching If-None-Match header only 304 Not Modified is sent. When file.html.gz exists
+    and the client accepts gzip, the compressed form is cached.
+
+    The files are checked for changes (size and modification time) at most every STATIC_ASSET_CACHE_REVALIDATE
+    ms, so files uploaded through FTP replace the cached ones shortly after.
+
+    Paths of files that don't exist or are too large to cache are remembered too (STATIC_ASSET_CACHE_MAX_UNCACHED of
+    them), so they are not opened again at each request but only when they are checked for changes. Such requests are
+    counted as not found or too large, not as misses.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __STATIC_ASSET_CACHE_H__
+    #define __STATIC_ASSET_CACHE_H__
+
+    #include <Arduino.h>
+    #include <atomic>
+    #include <Cstring.hpp>
+    #include <threadSafeFS.h>
+    #include <freertos/semphr.h>
+    #include "httpReplyStream.h"
+    #include "httpContentType.h"
+
+
+    // TUNING PARAMETERS
+    #define STATIC_ASSET_CACHE_MAX_ENTRIES 16
+    #define STATIC_ASSET_CACHE_MAX_UNCACHED 16              // remembered paths of files that don't exist or are too large
+    #define STATIC_ASSET_CACHE_SIZE (48 * 1024)             // bytes of internal RAM used for the cache
+    #define STATIC_ASSET_CACHE_PSRAM_SIZE (1024 * 1024)     // bytes of PSRAM used for the cache if the board has PSRAM
+    #define STATIC_ASSET_CACHE_MAX_FILE_SIZE (16 * 1024)    // larger files are not cached
+    #define STATIC_ASSET_CACHE_REVALIDATE 10000             // ms, how often the cached files are checked for changes
+    #define STATIC_ASSET_CACHE_MAX_PATH 64                  // maximum length of the path in the URL
+    #define STATIC_ASSET_CACHE_HEADER_SIZE 256              // space reserved for the HTTP reply header of each entry
+
+
+    class staticAssetCache_t {
+
+        public:
+
+            staticAssetCache_t (threadSafeFS::FS& fileSystem, const char *documentRoot = "/var/www/html");
+
+            // sends the reply from the cache and returns HTTP_REPLY_ALREADY_SENT, or returns NULL if the request should be handled by httpServer_t
+            template<class connection_t> const char *reply (const char *httpRequest, connection_t *hcn) {
+                if (!__enabled__ || strncmp (httpRequest, "GET /", 5))
+                    return NULL;
+
+                // extract the path from the request line: GET /path?query HTTP/1.1
+                char path [STATIC_ASSET_CACHE_MAX_PATH + 1];
+                size_t i = 0;
+                for (const char *p = httpRequest + 4; *p > ' ' && *p != '?'; p++) {
+                    if (i == STATIC_ASSET_CACHE_MAX_PATH)
+                        return NULL;
+                    path [i++] = *p;
+                }
+                path [i] = 0;
+
+                Cstring<64> acceptEncoding = hcn->getHttpRequestHeaderField ("Accept-Encoding");
+                __entry__ *e = __acquire__ (path, strstr (acceptEncoding.c_str (), "gzip") != NULL);
+                if (!e)
+                    return NULL;
+
+                httpReplyStream_t<connection_t> reply (hcn);
+                const char *connectionField = httpReplyStream_t<connection_t>::connectionField (hcn);
+                Cstring<64> ifNoneMatch = hcn->getHttpRequestHeaderField ("If-None-Match");
+                if (ifNoneMatch == e->etag) {
+                    __notModified__ ++;
+                    reply.printf ("HTTP/1.1 304 Not Modified\r\nETag: %s\r\nVary: Accept-Encoding\r\n%s\r\n", e->etag, connectionField);
+                } else if (!strcmp (connectionField, "Connection: close\r\n")) {
+                    reply.write (e->reply, e->replyLength); // header and content in one block
+                } else { // kept-alive eventHttpServer_t connection, which collects the reply in its buffer anyway
+                    reply.write (e->reply, e->connectionFieldOffset);
+                    reply.print (connectionField);
+                    reply.print ("\r\n");
+                    reply.write (e->reply + e->contentOffset, e->replyLength - e->contentOffset);
+                }
+                __release__ (e);
+                return reply.end ();
+            }
+
+            inline void setEnabled (bool enabled) __attribute__((always_inline)) { __enabled__ = enabled; }
+
+            inline bool isEnabled () __attribute__((always_inline)) { return __enabled__; }
+
+            // removes all the entries (the ones being sent at the moment are freed afterwards)
+            void clear ();
+
+            inline uint32_t hits () __attribute__((always_inline)) { return __hits__; }
+            inline uint32_t misses () __attribute__((always_inline)) { return __misses__; }
+            inline uint32_t notFound () __attribute__((always_inline)) { return __notFound__; }
+            inline uint32_t tooLarge () __attribute__((always_inline)) { return __tooLarge__; }
+            inline uint32_t notModified () __attribute__((always_inline)) { return __notModified__; }
+            inline uint32_t evictions () __attribute__((always_inline)) { return __evictions__; }
+            inline size_t bytesUsed () __attribute__((always_inline)) { return __bytesUsed__; }
+            inline size_t capacity () __attribute__((always_inline)) { return __capacity__; }
+
+            String toText ();
+
+        private:
+
+            struct __entry__ {
+                char path [STATIC_ASSET_CACHE_MAX_PATH + 1];
+                char *data;                 // allocated block, NULL if the entry is not used
+                size_t size;                // of allocated block
+                char *reply;                // HTTP reply header followed by the content, inside data
+                size_t replyLength;
+                size_t connectionFieldOffset;   // of "Connection: close\r\n\r\n" at the end of the header
+                size_t contentOffset;
+                char etag [24];
+                bool gzip;
+                size_t fileSize;            // to detect changes
+                time_t fileLastWrite;
+                unsigned long validated;    // millis () when the file was last checked for changes
+                uint32_t lastUsed;
+                int users;                  // number of tasks sending this entry at the moment, it can not be freed while > 0
+                bool stale;                 // free it as soon as users reaches 0
+            };
+
+            // a file that is not cached
+            struct __uncached__ {
+                char path [STATIC_ASSET_CACHE_MAX_PATH + 1]; // "" if the entry is not used
+                bool acceptsGzip;           // whether .gz was looked for
+                bool tooLarge;              // or it doesn't exist
+                unsigned long validated;    // millis () when the file was last checked, it is checked again after STATIC_ASSET_CACHE_REVALIDATE
+                uint32_t lastUsed;
+            };
+
+            enum __loadResult__ { LOADED, NOT_FOUND, TOO_LARGE, FAILED };
+
+            threadSafeFS::FS& __fileSystem__;
+            const char *__documentRoot__;
+            bool __enabled__ = true;
+            size_t __capacity__;
+            uint32_t __allocCaps__;
+
+            __entry__ __entries__ [STATIC_ASSET_CACHE_MAX_ENTRIES] = {};
+            __uncached__ __uncachedEntries__ [STATIC_ASSET_CACHE_MAX_UNCACHED] = {};
+            size_t __bytesUsed__ = 0;
+            uint32_t __clock__ = 0;         // LRU clock
+            SemaphoreHandle_t __semaphore__ = NULL;
+
+            std::atomic<uint32_t> __hits__ = {};
+            std::atomic<uint32_t> __misses__ = {};
+            std::atomic<uint32_t> __notFound__ = {};
+            std::atomic<uint32_t> __tooLarge__ = {};
+            std::atomic<uint32_t> __notModified__ = {};
+            std::atomic<uint32_t> __evictions__ = {};
+
+            __entry__ *__acquire__ (const char *path, bool acceptsGzip);
+            void __release__ (__entry__ *e);
+            __loadResult__ __load__ (__entry__ *e, const char *path, bool acceptsGzip);
+            __uncached__ *__findUncached__ (const char *path, bool acceptsGzip);
+            void __addUncached__ (const char *path, bool acceptsGzip, bool tooLarge);
+            bool __fileChanged__ (__entry__ *e);
+            void __free__ (__entry__ *e);
+            __entry__ *__makeRoom__ (size_t size);
+            Cstring<255> __fileName__ (const char *path);
+    };
+
+#endif
@@ -0,0 +1,262 @@
+/*
+
+    syslogExporter.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Ships log messages to a central collector over UDP, as RFC 5424 syslog or as compact binary datagrams.
+
+    Binary datagram layout (little endian):
+
+        "DL", version (1), number of messages (1), messages dropped so far (4), host name length (1), host name
+        then for each message: sequence (4), up time in ms (4), time in ms since 1970 or 0 (8), text length (1), text
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "syslogExporter.h"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <time.h>
+#include <unistd.h>
+
+
+syslogExporter_t::syslogExporter_t () {
+    __semaphore__ = xSemaphoreCreateMutex ();
+}
+
+syslogExporter_t::~syslogExporter_t () {
+    if (__socket__ >= 0)
+        close (__socket__);
+    vSemaphoreDelete (__semaphore__);
+}
+
+bool syslogExporter_t::begin (threadSafeFS::FS& fileSystem, const char *hostName) {
+    if (!fileSystem.isFile ("/etc/syslog.conf")) {
+        if (!fileSystem.isDirectory ("/etc"))
+            fileSystem.mkdir ("/etc");
+        threadSafeFS::File f = fileSystem.open ("/etc/syslog.conf", "w");
+        if (f) {
+            f.print ("# syslog exporter - reboot for changes to take effect\r\n\r\n"
+                     "# send DMESG messages to this collector (uncomment and set its IP address)\r\n"
+                     "#  collector 10.18.1.10\r\n"
+                     "   port 514\r\n"
+                     "# rfc5424 or binary (see tools/syslogcollector.py)\r\n"
+                     "   format rfc5424\r\n"
+                     "# messages per second and burst size for each subsystem\r\n"
+                     "   rate 10\r\n"
+                     "   burst 30\r\n");
+            f.close ();
+        }
+    }
+
+    char buffer [512] = "\n";
+    if (!fileSystem.readConfiguration (buffer + 1, sizeof (buffer) - 3, "/etc/syslog.conf"))
+        return false;
+    strcat (buffer, "\n");
+
+    char collector [64] = "";
+    unsigned port = 514;
+    char format [16] = "rfc5424";
+    float rate = SYSLOG_DEFAULT_RATE;
+    float burst = SYSLOG_DEFAULT_BURST;
+    char *p;
+    if ((p = strstr (buffer, "\ncollector"))) sscanf (p + 10, "%*[ =]%63[^ \r\n#]", collector);
+    if ((p = strstr (buffer, "\nport")))      sscanf (p + 5, "%*[ =]%u", &port);
+    if ((p = strstr (buffer, "\nformat")))    sscanf (p + 7, "%*[ =]%15[a-z0-9]", format);
+    if ((p = strstr (buffer, "\nrate")))      sscanf (p + 5, "%*[ =]%f", &rate);
+    if ((p = strstr (buffer, "\nburst")))     sscanf (p + 6, "%*[ =]%f", &burst);
+    if (!*collector)
+        return false;
+    return begin (hostName, collector, port, strcmp (format, "binary") ? RFC5424 : BINARY, rate, burst);
+}
+
+bool syslogExporter_t::begin (const char *hostName, const char *collector, uint16_t port, format_t format, float rate, float burst) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo *result = NULL;
+    if (getaddrinfo (collector, NULL, &hints, &result) != 0 || !result)
+        return false;
+    __collector__ = *(struct sockaddr_in *) result->ai_addr;
+    __collector__.sin_port = htons (port);
+    freeaddrinfo (result);
+
+    int s = socket (AF_INET, SOCK_DGRAM, 0);
+    if (s < 0)
+        return false;
+    if (__socket__ >= 0)
+        close (__socket__);
+    __socket__ = s;
+    snprintf (__collectorName__, sizeof (__collectorName__), "%s:%u", collector, port);
+    strncpy (__hostName__, hostName, sizeof (__hostName__) - 1);
+    __format__ = format;
+    __rate__ = rate > 0 ? rate : SYSLOG_DEFAULT_RATE;
+    __burst__ = burst >= 1 ? burst : 1;
+    return true;
+}
+
+void syslogExporter_t::add (const char *text) {
+    if (__socket__ < 0)
+        return;
+    unsigned long now = millis ();
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __sequence__ ++; // also for the dropped messages, so the collector sees the gaps
+        if (!__takeToken__ (text, now)) {
+            __droppedRateLimit__ ++;
+        } else if (__count__ == SYSLOG_QUEUE_LENGTH) {
+            __droppedQueueFull__ ++;
+        } else {
+            __message__& m = __queue__ [(__first__ + __count__) % SYSLOG_QUEUE_LENGTH];
+            m.sequence = __sequence__;
+            m.upTime = now;
+            m.time = tv.tv_sec > 1600000000 ? (int64_t) tv.tv_sec * 1000 + tv.tv_usec / 1000 : 0; // 1600000000 ~2020, the time is not set before
+            strncpy (m.text, text, sizeof (m.text) - 1);
+            m.text [sizeof (m.text) - 1] = 0;
+            __count__ ++;
+        }
+    xSemaphoreGive (__semaphore__);
+}
+
+// token bucket of the message's subsystem, the tag is the first [...] of the message
+bool syslogExporter_t::__takeToken__ (const char *text, unsigned long now) {
+    char tag [16] = "";
+    if (*text == '[') {
+        const char *e = strchr (text, ']');
+        size_t l = e ? e - text - 1 : 0;
+        if (l >= sizeof (tag))
+            l = sizeof (tag) - 1;
+        memcpy (tag, text + 1, l);
+        tag [l] = 0;
+    }
+
+    __bucket__ *b = NULL;
+    __bucket__ *leastRecentlyUsed = &__buckets__ [0];
+    for (int i = 0; i < SYSLOG_TAGS; i++) {
+        if (__buckets__ [i].lastUsed && !strcmp (__buckets__ [i].tag, tag)) {
+            b = &__buckets__ [i];
+            break;
+        }
+        if (__buckets__ [i].lastUsed < leastRecentlyUsed->lastUsed)
+            leastRecentlyUsed = &__buckets__ [i];
+    }
+    if (!b) {
+        b = leastRecentlyUsed;
+        strcpy (b->tag, tag);
+        b->tokens = __burst__;
+        b->lastRefill = now;
+    }
+    b->lastUsed = now | 1; // 0 means unused
+
+    b->tokens += (now - b->lastRefill) * __rate__ / 1000;
+    if (b->tokens > __burst__)
+        b->tokens = __burst__;
+    b->lastRefill = now;
+    if (b->tokens < 1)
+        return false;
+    b->tokens -= 1;
+    return true;
+}
+
+void syslogExporter_t::sendIfNeeded () {
+    if (__socket__ < 0 || !__count__) // reading __count__ without the lock is good enough here
+        return;
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        bool itsTime = __count__ >= SYSLOG_QUEUE_LENGTH / 2 || millis () - __queue__ [__first__].upTime >= SYSLOG_BATCH_TIME;
+    xSemaphoreGive (__semaphore__);
+    if (!itsTime)
+        return;
+
+    char datagram [SYSLOG_MAX_DATAGRAM];
+    for (int d = 0; d < SYSLOG_MAX_DATAGRAMS; d++) {
+        size_t length = 0;
+        int messages = 0;
+
+        // take the messages out of the queue while holding the lock, send them without it
+        xSemaphoreTake (__semaphore__, portMAX_DELAY);
+            if (__format__ == RFC5424) {
+                if (__count__) {
+                    length = __rfc5424__ (__queue__ [__first__], datagram, sizeof (datagram));
+                    __first__ = (__first__ + 1) % SYSLOG_QUEUE_LENGTH;
+                    __count__ --;
+                    messages = 1;
+                }
+            } else {
+                uint32_t dropped = __droppedRateLimit__ + __droppedQueueFull__ + __sendErrors__;
+                uint8_t hostLength = strlen (__hostName__);
+                memcpy (datagram, "DL\x01", 3);
+                memcpy (datagram + 4, &dropped, 4);
+                datagram [8] = hostLength;
+                memcpy (datagram + 9, __hostName__, hostLength);
+                length = 9 + hostLength;
+                while (__count__ && messages < 255) {
+                    const __message__& m = __queue__ [__first__];
+                    uint8_t textLength = strlen (m.text);
+                    if (length + 17 + textLength > sizeof (datagram))
+                        break;
+                    memcpy (datagram + length, &m.sequence, 4);
+                    memcpy (datagram + length + 4, &m.upTime, 4);
+                    memcpy (datagram + length + 8, &m.time, 8);
+                    datagram [length + 16] = textLength;
+                    memcpy (datagram + length + 17, m.text, textLength);
+                    length += 17 + textLength;
+                    __first__ = (__first__ + 1) % SYSLOG_QUEUE_LENGTH;
+                    __count__ --;
+                    messages ++;
+                }
+                datagram [3] = messages;
+            }
+        xSemaphoreGive (__semaphore__);
+
+        if (!messages)
+            return;
+        if (__send__ (datagram, length)) {
+            __sent__ += messages;
+            __datagrams__ ++;
+        } else {
+            __sendErrors__ += messages; // the messages are lost, retrying would only put more load on the network stack
+        }
+    }
+}
+
+size_t syslogExporter_t::__rfc5424__ (const __message__& m, char *datagram, size_t size) {
+    // <local0.info>1 TIMESTAMP HOSTNAME APP-NAME PROCID MSGID [meta sequenceId sysUpTime] MSG
+    char timestamp [32] = "-";
+    if (m.time) {
+        time_t t = m.time / 1000;
+        struct tm st;
+        gmtime_r (&t, &st);
+        size_t l = strftime (timestamp, sizeof (timestamp), "%Y-%m-%dT%H:%M:%S", &st);
+        snprintf (timestamp + l, sizeof (timestamp) - l, ".%03uZ", (unsigned) (m.time % 1000));
+    }
+    int l = snprintf (datagram, size, "<134>1 %s %s dmesg - - [meta sequenceId=\"%lu\" sysUpTime=\"%lu\"] %s",
+                      timestamp, __hostName__, (unsigned long) m.sequence, (unsigned long) (m.upTime / 10), m.text);
+    return l < (int) size ? l : size - 1;
+}
+
+bool syslogExporter_t::__send__ (const void *datagram, size_t length) {
+    return sendto (__socket__, datagram, length, MSG_DONTWAIT, (struct sockaddr *) &__collector__, sizeof (__collector__)) == (int) length;
+}
+
+String syslogExporter_t::toText () {
+    if (__socket__ < 0)
+        return "syslog exporter is not running, set the collector in /etc/syslog.conf";
+    char s [320];
+    snprintf (s, sizeof (s), "collector:               %s (%s)\r\n"
+                             "messages sent:           %lu in %lu datagrams\r\n"
+                             "dropped by rate limit:   %lu (%.1f/s, burst %.0f per subsystem)\r\n"
+                             "dropped, queue full:     %lu\r\n"
+                             "lost, send errors:       %lu",
+                             __collectorName__, __format__ == RFC5424 ? "rfc5424" : "binary",
+                             (unsigned long) __sent__, (unsigned long) __datagrams__,
+                             (unsigned long) __droppedRateLimit__, __rate__, __burst__,
+                             (unsigned long) __droppedQueueFull__, (unsigned long) __sendErrors__);
+    return s;
+}
@@ -0,0 +1,119 @@
+/*
+
+    syslogExporter.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Ships log messages to a central collector over UDP, as RFC 5424 syslog or as compact binary datagrams.
+
+    add () is called for each message that goes to dmesgQueue through DMESG (see dmesgRing.h). It only copies the
+    message into a fixed queue, sendIfNeeded () (called from loop ()) sends the queue when it is half full or its
+    oldest message is older than SYSLOG_BATCH_TIME:
+
+        - rfc5424: one datagram per message (what syslog collectors expect), at most SYSLOG_MAX_DATAGRAMS per call,
+        - binary: as many messages as fit into one datagram, see tools/syslogcollector.py for the layout.
+
+    Each subsystem (the first [tag] of the message) has its own token bucket, so a subsystem that logs too much
+    loses its own messages without starving the others or the network stack. Every message gets a sequence
+    number, also the dropped ones, so the collector sees the gaps. The settings are read from /etc/syslog.conf.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __SYSLOG_EXPORTER_H__
+    #define __SYSLOG_EXPORTER_H__
+
+    #include <Arduino.h>
+    #include <threadSafeFS.h>
+    #include <netinet/in.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+
+
+    // TUNING PARAMETERS
+    #define SYSLOG_QUEUE_LENGTH 32          // messages waiting to be sent, the newer ones are dropped when it is full
+    #define SYSLOG_MAX_TEXT 160             // bytes, longer messages are truncated
+    #define SYSLOG_MAX_DATAGRAM 1200        // bytes, stays below the path MTU
+    #define SYSLOG_MAX_DATAGRAMS 8          // datagrams sent by one sendIfNeeded call
+    #define SYSLOG_BATCH_TIME 1000          // ms, how long a message may wait for others to be sent together
+    #define SYSLOG_TAGS 8                   // subsystems with their own token bucket, the least recently used one is reused
+    #define SYSLOG_DEFAULT_RATE 10          // messages per second per subsystem
+    #define SYSLOG_DEFAULT_BURST 30         // messages a subsystem may send at once
+
+
+    class syslogExporter_t {
+
+        public:
+
+            enum format_t { RFC5424, BINARY };
+
+            syslogExporter_t ();
+            ~syslogExporter_t ();
+
+            // reads /etc/syslog.conf (and creates the default one if it doesn't exist), returns false if no collector is configured
+            bool begin (threadSafeFS::FS& fileSystem, const char *hostName);
+
+            bool begin (const char *hostName, const char *collector, uint16_t port = 514, format_t format = RFC5424, float rate = SYSLOG_DEFAULT_RATE, float burst = SYSLOG_DEFAULT_BURST);
+
+            // queues the message if its subsystem has a token left and the queue is not full, never waits for the network
+            void add (const char *text);
+
+            // sends the queued messages if it is time to, call it frequently (from loop ())
+            void sendIfNeeded ();
+
+            inline bool isRunning () __attribute__((always_inline)) { return __socket__ >= 0; }
+
+            inline uint32_t sent () __attribute__((always_inline)) { return __sent__; }
+            inline uint32_t datagrams () __attribute__((always_inline)) { return __datagrams__; }
+            inline uint32_t droppedRateLimit () __attribute__((always_inline)) { return __droppedRateLimit__; }
+            inline uint32_t droppedQueueFull () __attribute__((always_inline)) { return __droppedQueueFull__; }
+            inline uint32_t sendErrors () __attribute__((always_inline)) { return __sendErrors__; }
+
+            String toText ();
+
+        private:
+
+            struct __message__ {
+                uint32_t sequence;
+                uint32_t upTime;            // ms
+                int64_t time;               // ms since 1970 or 0 if the time is not known yet
+                char text [SYSLOG_MAX_TEXT];
+            };
+
+            struct __bucket__ {
+                char tag [16];
+                float tokens;
+                unsigned long lastRefill;   // millis
+                unsigned long lastUsed;     // millis
+            };
+
+            int __socket__ = -1;
+            struct sockaddr_in __collector__ = {};
+            char __collectorName__ [64] = "";
+            char __hostName__ [32] = "";
+            format_t __format__ = RFC5424;
+            float __rate__ = SYSLOG_DEFAULT_RATE;
+            float __burst__ = SYSLOG_DEFAULT_BURST;
+
+            __message__ __queue__ [SYSLOG_QUEUE_LENGTH];
+            int __first__ = 0;
+            int __count__ = 0;
+            __bucket__ __buckets__ [SYSLOG_TAGS] = {};
+            SemaphoreHandle_t __semaphore__ = NULL;     // protects the queue and the buckets
+
+            uint32_t __sequence__ = 0;
+            uint32_t __sent__ = 0;
+            uint32_t __datagrams__ = 0;
+            uint32_t __droppedRateLimit__ = 0;
+            uint32_t __droppedQueueFull__ = 0;
+            uint32_t __sendErrors__ = 0;
+
+            bool __takeToken__ (const char *text, unsigned long now);
+            size_t __rfc5424__ (const __message__& m, char *datagram, size_t size);
+            bool __send__ (const void *datagram, size_t length);
+    };
+
+#endif
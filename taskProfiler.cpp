@@ -0,0 +1,147 @@
+/*
+
+    taskProfiler.cpp
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Sampling profiler of FreeRTOS tasks: CPU usage and stack high-water marks, shown by the top Telnet command.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#include "taskProfiler.h"
+
+
+taskProfiler_t::taskProfiler_t () {
+    __semaphore__ = xSemaphoreCreateMutex ();
+}
+
+unsigned long taskProfiler_t::nextSampleIn () {
+    unsigned long sinceLastSample = millis () - __lastSampleMillis__;
+    if (__newest__ < 0 || sinceLastSample >= TASK_PROFILER_SAMPLE_INTERVAL)
+        return 0;
+    return TASK_PROFILER_SAMPLE_INTERVAL - sinceLastSample;
+}
+
+void taskProfiler_t::sample () {
+    #if configUSE_TRACE_FACILITY
+        if (nextSampleIn ())
+            return;
+        __lastSampleMillis__ = millis ();
+
+        static TaskStatus_t taskStatus [TASK_PROFILER_MAX_TASKS]; // only used here, in the task that calls sample ()
+        uint32_t totalRunTime = 0;
+        UBaseType_t count = uxTaskGetSystemState (taskStatus, TASK_PROFILER_MAX_TASKS, &totalRunTime); // returns 0 if there are more tasks than TASK_PROFILER_MAX_TASKS
+
+        // store the new snapshot in the circular buffer, overwriting the oldest one
+        int newest = (__newest__ + 1) % (TASK_PROFILER_WINDOW + 1);
+        __snapshot__& s = __snapshots__ [newest];
+        s.totalRunTime = totalRunTime;
+        s.taskCount = count;
+        for (UBaseType_t i = 0; i < count; i++)
+            s.tasks [i] = { taskStatus [i].xTaskNumber, taskStatus [i].ulRunTimeCounter };
+        if (__snapshotCount__ < TASK_PROFILER_WINDOW + 1)
+            __snapshotCount__ ++;
+        int previous = __newest__;
+        int oldest = (newest + TASK_PROFILER_WINDOW + 2 - __snapshotCount__) % (TASK_PROFILER_WINDOW + 1);
+        __newest__ = newest;
+
+        xSemaphoreTake (__semaphore__, portMAX_DELAY);
+            __tooManyTasks__ = count == 0;
+            __taskCount__ = count;
+            for (UBaseType_t i = 0; i < count; i++) {
+                __taskInfo__& t = __tasks__ [i];
+                strncpy (t.name, taskStatus [i].pcTaskName, sizeof (t.name) - 1); // copy the name, the task may be deleted before it is shown
+                t.name [sizeof (t.name) - 1] = 0;
+                #if configTASKLIST_INCLUDE_COREID
+                    t.core = taskStatus [i].xCoreID == tskNO_AFFINITY ? -1 : taskStatus [i].xCoreID;
+                #else
+                    t.core = -1;
+                #endif
+                t.priority = taskStatus [i].uxCurrentPriority;
+                t.stackHighWaterMark = taskStatus [i].usStackHighWaterMark; // ESP-IDF reports stack in bytes
+                t.cpuLastInterval = previous < 0 ? -1 : __cpu__ (__snapshots__ [previous], s, taskStatus [i].xTaskNumber, taskStatus [i].ulRunTimeCounter);
+                t.cpuWindow = oldest == newest ? -1 : __cpu__ (__snapshots__ [oldest], s, taskStatus [i].xTaskNumber, taskStatus [i].ulRunTimeCounter);
+            }
+        xSemaphoreGive (__semaphore__);
+    #endif
+}
+
+// CPU usage of the task between two snapshots in % of one core, < 0 if it can not be calculated
+float taskProfiler_t::__cpu__ (const __snapshot__& from, const __snapshot__& to, UBaseType_t taskNumber, uint32_t runTime) {
+    #if configGENERATE_RUN_TIME_STATS
+        uint32_t total = to.totalRunTime - from.totalRunTime;
+        if (total == 0)
+            return -1;
+        for (int i = 0; i < from.taskCount; i++)
+            if (from.tasks [i].taskNumber == taskNumber)
+                return (float) (runTime - from.tasks [i].runTime) * 100 / total;
+        return -1; // the task did not exist yet
+    #else
+        return -1;
+    #endif
+}
+
+String taskProfiler_t::toText () {
+    #if configUSE_TRACE_FACILITY
+        char line [100];
+        snprintf (line, sizeof (line), "task              core  prio  cpu%% %2lus  cpu%% %2lus  min free stack [B]",
+                                       (unsigned long) (TASK_PROFILER_SAMPLE_INTERVAL / 1000), (unsigned long) (TASK_PROFILER_SAMPLE_INTERVAL * TASK_PROFILER_WINDOW / 1000));
+        String s = line;
+
+        xSemaphoreTake (__semaphore__, portMAX_DELAY);
+            if (__tooManyTasks__) {
+                xSemaphoreGive (__semaphore__);
+                return "More than " + String (TASK_PROFILER_MAX_TASKS) + " tasks are running, increase TASK_PROFILER_MAX_TASKS";
+            }
+
+            // show the busiest tasks first
+            int order [TASK_PROFILER_MAX_TASKS];
+            for (int i = 0; i < __taskCount__; i++) {
+                int j = i;
+                for (; j > 0 && __tasks__ [order [j - 1]].cpuWindow < __tasks__ [i].cpuWindow; j--)
+                    order [j] = order [j - 1];
+                order [j] = i;
+            }
+
+            for (int i = 0; i < __taskCount__; i++) {
+                __taskInfo__& t = __tasks__ [order [i]];
+                char core [12] = "any";
+                if (t.core >= 0)
+                    snprintf (core, sizeof (core), "%i", t.core);
+                char cpu1 [8] = "-";
+                if (t.cpuLastInterval >= 0)
+                    snprintf (cpu1, sizeof (cpu1), "%.1f", t.cpuLastInterval);
+                char cpuW [8] = "-";
+                if (t.cpuWindow >= 0)
+                    snprintf (cpuW, sizeof (cpuW), "%.1f", t.cpuWindow);
+                snprintf (line, sizeof (line), "\r\n%-16s  %4s  %4u  %8s  %8s  %8lu%s",
+                                               t.name, core, (unsigned) t.priority, cpu1, cpuW, (unsigned long) t.stackHighWaterMark, t.stackHighWaterMark < TASK_PROFILER_LOW_STACK ? " low!" : "");
+                s += line;
+            }
+        xSemaphoreGive (__semaphore__);
+
+        return s;
+    #else
+        return "FreeRTOS is not configured with configUSE_TRACE_FACILITY";
+    #endif
+}
+
+String taskProfiler_t::toJson () {
+    String s = "{\"interval\":" + String (TASK_PROFILER_SAMPLE_INTERVAL) + ",\"window\":" + String (TASK_PROFILER_SAMPLE_INTERVAL * TASK_PROFILER_WINDOW) + ",\"tasks\":[";
+
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        for (int i = 0; i < __taskCount__; i++) {
+            __taskInfo__& t = __tasks__ [i];
+            char buf [200];
+            snprintf (buf, sizeof (buf), "%s{\"name\":\"%s\",\"core\":%i,\"priority\":%u,\"cpuInterval\":%.1f,\"cpuWindow\":%.1f,\"stackHighWaterMark\":%lu}",
+                                         i ? "," : "", t.name, t.core, (unsigned) t.priority, t.cpuLastInterval, t.cpuWindow, (unsigned long) t.stackHighWaterMark);
+            s += buf;
+        }
+    xSemaphoreGive (__semaphore__);
+
+    s += "]}\r\n";
+    return s;
+}
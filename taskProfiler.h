@@ -0,0 +1,91 @@
+/*
+
+    taskProfiler.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Sampling profiler of FreeRTOS tasks: CPU usage and stack high-water marks, shown by the top Telnet command.
+
+    sample () should be called frequently (from loop ()), it collects uxTaskGetSystemState run time counters
+    once every TASK_PROFILER_SAMPLE_INTERVAL ms and returns immediately otherwise. CPU usage is calculated over
+    the last sample interval and over the sliding window of the last TASK_PROFILER_WINDOW intervals, in percent
+    of one core. The memory used is fixed, the cost of each sample is proportional to the number of tasks.
+
+    CPU usage is only available if FreeRTOS is configured with configGENERATE_RUN_TIME_STATS.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __TASK_PROFILER_H__
+    #define __TASK_PROFILER_H__
+
+    #include <Arduino.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include <freertos/semphr.h>
+
+
+    // TUNING PARAMETERS
+    #define TASK_PROFILER_MAX_TASKS 24              // tasks above this number are not profiled
+    #define TASK_PROFILER_SAMPLE_INTERVAL 1000      // ms
+    #define TASK_PROFILER_WINDOW 10                 // number of sample intervals in the sliding window
+    #define TASK_PROFILER_LOW_STACK 512             // bytes, tasks with less free stack are marked in top output
+
+
+    class taskProfiler_t {
+
+        public:
+
+            taskProfiler_t ();
+
+            // takes a sample if TASK_PROFILER_SAMPLE_INTERVAL has passed since the last one
+            void sample ();
+
+            // time in ms until the next sample is due
+            unsigned long nextSampleIn ();
+
+            String toText ();
+
+            String toJson ();
+
+        private:
+
+            struct __taskRunTime__ {
+                UBaseType_t taskNumber;
+                uint32_t runTime;
+            };
+
+            struct __snapshot__ {
+                uint32_t totalRunTime;
+                int taskCount;
+                __taskRunTime__ tasks [TASK_PROFILER_MAX_TASKS];
+            };
+
+            struct __taskInfo__ {
+                char name [configMAX_TASK_NAME_LEN];
+                int core;                       // -1 if not pinned to a core
+                UBaseType_t priority;
+                uint32_t stackHighWaterMark;    // minimum free stack since the task started, in bytes
+                float cpuLastInterval;          // %, < 0 if not known yet
+                float cpuWindow;                // %, < 0 if not known yet
+            };
+
+            // the last TASK_PROFILER_WINDOW + 1 snapshots in a circular buffer
+            __snapshot__ __snapshots__ [TASK_PROFILER_WINDOW + 1];
+            int __newest__ = -1;
+            int __snapshotCount__ = 0;
+            unsigned long __lastSampleMillis__ = 0;
+
+            // result of the latest sample, protected with a semaphore while being read or written
+            __taskInfo__ __tasks__ [TASK_PROFILER_MAX_TASKS];
+            int __taskCount__ = 0;
+            bool __tooManyTasks__ = false;
+            SemaphoreHandle_t __semaphore__ = NULL;
+
+            static float __cpu__ (const __snapshot__& from, const __snapshot__& to, UBaseType_t taskNumber, uint32_t runTime);
+    };
+
+#endif
@@ -0,0 +1,167 @@
+/*
+
+    telnetOutputStream.h
+
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+
+    Collects the output of a Telnet command into full TCP segments instead of sending each piece separately.
+
+    Every tcn->sendString call becomes its own TCP segment, so a command that writes its output line by line
+    needs as many round trips (with Nagle's algorithm) or segments (without it) as there are lines. A command
+    handler may instead write through telnetOutputStream_t:
+
+        telnetOutputStream_t<telnetServer_t::telnetConnection_t> out (tcn);
+        out.printf ("%i\r\n", 42);
+        return out.end (); // the rest of the output is returned to telnetServer_t, which sends it together with the prompt
+
+    The buffer is sent when it is full, when the oldest unsent byte is older than TELNET_OUTPUT_FLUSH_TIME (checked
+    at the next write), before reading from the connection (recvLine) and by flush (). Since the stream only sends
+    full segments or deliberately flushed data, Nagle's algorithm is switched off while it exists, so that the last
+    partial segment isn't held back waiting for the ACK of the previous one.
+
+    October 18, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __TELNET_OUTPUT_STREAM_H__
+    #define __TELNET_OUTPUT_STREAM_H__
+
+    #include <atomic>
+    #include <stdarg.h>
+    #include <stdio.h>
+    #include <string.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <esp_timer.h>
+
+
+    // TUNING PARAMETERS
+    #define TELNET_OUTPUT_BUFFER_SIZE 1436      // bytes, one TCP segment (MSS of lwIP on Ethernet sized links)
+    #define TELNET_OUTPUT_FLUSH_TIME 100        // ms, unsent output older than this is sent at the next write, so slow commands still show progress
+
+
+    // totals of all Telnet output streams, exported as metrics
+    inline std::atomic<uint64_t> telnetOutputBytes = {};
+    inline std::atomic<uint64_t> telnetOutputSegments = {};
+
+
+    template<class connection_t> class telnetOutputStream_t {
+
+        public:
+
+            telnetOutputStream_t (connection_t *connection) : __connection__ (connection) {
+                socklen_t l = sizeof (__noDelay__);
+                if (getsockopt (__connection__->getSocket (), IPPROTO_TCP, TCP_NODELAY, &__noDelay__, &l) == -1)
+                    __noDelay__ = -1;
+                int on = 1;
+                setsockopt (__connection__->getSocket (), IPPROTO_TCP, TCP_NODELAY, &on, sizeof (on));
+                __startTime__ = esp_timer_get_time ();
+            }
+
+            ~telnetOutputStream_t () {
+                flush ();
+                if (__noDelay__ >= 0)
+                    setsockopt (__connection__->getSocket (), IPPROTO_TCP, TCP_NODELAY, &__noDelay__, sizeof (__noDelay__));
+            }
+
+            bool write (const char *buf, size_t len) {
+                if (__error__)
+                    return false;
+                if (__length__ && esp_timer_get_time () - __oldestByteTime__ > TELNET_OUTPUT_FLUSH_TIME * 1000)
+                    if (!flush ())
+                        return false;
+                if (__length__ + len > TELNET_OUTPUT_BUFFER_SIZE) {
+                    if (!flush ())
+                        return false;
+                    if (len > TELNET_OUTPUT_BUFFER_SIZE) // too large to buffer, send it directly
+                        return __send__ (buf, len);
+                }
+                if (!__length__)
+                    __oldestByteTime__ = esp_timer_get_time ();
+                memcpy (__buffer__ + __length__, buf, len);
+                __length__ += len;
+                return true;
+            }
+
+            inline bool print (const char *s) __attribute__((always_inline)) { return write (s, strlen (s)); }
+
+            bool printf (const char *format, ...) __attribute__((format (printf, 2, 3))) {
+                char s [256];
+                va_list args;
+                va_start (args, format);
+                int l = vsnprintf (s, sizeof (s), format, args);
+                va_end (args);
+                if (l < 0)
+                    return false;
+                return write (s, l < (int) sizeof (s) ? l : sizeof (s) - 1);
+            }
+
+            bool flush () {
+                if (__error__)
+                    return false;
+                if (__length__ == 0)
+                    return true;
+                bool sent = __send__ (__buffer__, __length__);
+                __length__ = 0;
+                return sent;
+            }
+
+            // the user must see the question before answering it
+            int recvLine (char *buf, size_t len, bool trim = true) {
+                flush ();
+                return __connection__->recvLine (buf, len, trim);
+            }
+
+            // returns what is still in the buffer, telnetServer_t sends it together with the prompt, the result should be returned from telnetCommandHandlerCallback
+            String end () {
+                String s;
+                if (!__error__ && __length__) {
+                    s.concat (__buffer__, __length__); // the output may contain 0 bytes (cat of a binary file)
+                    __bytes__ += __length__;
+                    __segments__ ++;
+                    telnetOutputBytes += __length__;
+                    telnetOutputSegments ++;
+                }
+                __length__ = 0;
+                __milliseconds__ = (esp_timer_get_time () - __startTime__) / 1000;
+                if (s == "")
+                    s = "\r\n"; // returning "" would mean that the command has not been handled
+                return s;
+            }
+
+            inline size_t bytes () __attribute__((always_inline)) { return __bytes__; }
+            inline size_t segments () __attribute__((always_inline)) { return __segments__; }
+            inline unsigned long milliseconds () __attribute__((always_inline)) { return __milliseconds__; } // from construction to end ()
+
+            inline bool error () __attribute__((always_inline)) { return __error__; }
+
+        private:
+
+            connection_t *__connection__;
+            char __buffer__ [TELNET_OUTPUT_BUFFER_SIZE];
+            size_t __length__ = 0;
+            int64_t __oldestByteTime__ = 0;
+            int64_t __startTime__ = 0;
+            int __noDelay__ = -1;
+            size_t __bytes__ = 0;
+            size_t __segments__ = 0;
+            unsigned long __milliseconds__ = 0;
+            bool __error__ = false;
+
+            bool __send__ (const char *buf, size_t len) {
+                if (__connection__->sendBlock ((byte *) buf, len) <= 0) {
+                    __error__ = true; // the client has probably closed the connection, don't try to send anything more
+                    return false;
+                }
+                __bytes__ += len;
+                __segments__ ++;
+                telnetOutputBytes += len;
+                telnetOutputSegments ++;
+                return true;
+            }
+    };
+
+#endif
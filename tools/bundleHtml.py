@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+
+#   bundleHtml.py
+#
+#   This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+#
+#   Compiles the html/ directory into htmlBundleData.h: one const array per file that holds the complete HTTP reply
+#   (precomputed header followed by the gzip-compressed content) and a perfect hash table for looking up the paths.
+#   The arrays stay in flash, htmlBundle.h sends them with a single sendBlock, without any file system access.
+#
+#   Run it before compiling the sketch with USE_HTML_BUNDLE defined, each time something in html/ changes:
+#
+#       python3 tools/bundleHtml.py
+#
+#   or let Arduino IDE run it before each build by adding to platform.local.txt:
+#
+#       recipe.hooks.prebuild.1.pattern=python3 "{build.source.path}/tools/bundleHtml.py"
+#
+#   October 18, 2026, Bojan Jurca
+
+
+import argparse
+import gzip
+import os
+import sys
+
+
+CONTENT_TYPES = {
+    ".html": "text/html", ".htm": "text/html", ".css": "text/css", ".js": "application/javascript",
+    ".json": "application/json", ".txt": "text/plain", ".png": "image/png", ".jpg": "image/jpeg",
+    ".jpeg": "image/jpeg", ".gif": "image/gif", ".ico": "image/x-icon", ".svg": "image/svg+xml",
+    ".xml": "text/xml", ".pdf": "application/pdf"
+}
+
+# these are already compressed, gzip would only make them larger
+NOT_COMPRESSED = {".png", ".jpg", ".jpeg", ".gif", ".ico", ".pdf"}
+
+
+# must be the same as __hash__ in htmlBundle.h
+def fnv1a(data, seed=2166136261):
+    h = seed
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def perfectHash(paths):
+    size = 1
+    while size < len(paths):
+        size *= 2
+    while True:
+        for seed in range(1, 100000):
+            slots = {}
+            for i, p in enumerate(paths):
+                s = fnv1a(p.encode(), seed) & (size - 1)
+                if s in slots:
+                    break
+                slots[s] = i
+            else:
+                return seed, size, [slots.get(s, -1) for s in range(size)]
+        size *= 2
+
+
+def collectFiles(root):
+    files = {}
+    for directory, _, names in os.walk(root):
+        for name in sorted(names):
+            path = "/" + os.path.relpath(os.path.join(directory, name), root).replace(os.sep, "/")
+            files[path] = os.path.join(directory, name)
+    # file.gz is only used when file itself is not there, otherwise the fresh compression of file is used
+    return {p: f for p, f in files.items() if not (p.endswith(".gz") and p[:-3] in files)}
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="compile html directory into htmlBundleData.h")
+    parser.add_argument("--html", default=os.path.join(here, "..", "html"), help="directory with the files, it corresponds to /var/www/html")
+    parser.add_argument("--output", default=os.path.join(here, "..", "htmlBundleData.h"))
+    args = parser.parse_args()
+
+    assets = []  # (path, reply, headerLength, etag, gzip)
+    for path, fileName in sorted(collectFiles(args.html).items()):
+        with open(fileName, "rb") as f:
+            content = f.read()
+        compressed = False
+        if path.endswith(".gz"):
+            path, compressed = path[:-3], True
+        extension = os.path.splitext(path)[1].lower()
+        if not compressed and extension not in NOT_COMPRESSED:
+            packed = gzip.compress(content, 9, mtime=0)
+            if len(packed) < len(content):
+                content, compressed = packed, True
+        etag = '"%08x%s"' % (fnv1a(content), "-gz" if compressed else "")
+        # without Connection field and the empty line, htmlBundle_t adds them for each connection (it may be kept alive)
+        header = ("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: %s\r\n"
+                  "Content-Length: %i\r\n"
+                  "%s"
+                  "ETag: %s\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "%s") % (CONTENT_TYPES.get(extension, "application/octet-stream"), len(content),
+                           "Content-Encoding: gzip\r\n" if compressed else "", etag,
+                           "Vary: Accept-Encoding\r\n" if compressed else "")
+        reply = header.encode() + content
+        assets.append((path, reply, len(header), etag, compressed))
+        if path.endswith("/index.html"):
+            assets.append((path[:-len("index.html")], reply, len(header), etag, compressed))
+
+    if not assets:
+        sys.exit("no files found in " + args.html)
+    seed, size, table = perfectHash([a[0] for a in assets])
+
+    out = ["// generated by tools/bundleHtml.py from html/ - do not edit, run the script again instead", "",
+           "#define HTML_BUNDLE_SEED %uu" % seed,
+           "#define HTML_BUNDLE_TABLE_SIZE %i" % size, ""]
+    arrays = {}
+    for path, reply, _, _, _ in assets:
+        if reply in arrays:
+            continue  # the same reply (index.html and /) is stored only once
+        name = "__htmlBundle%i__" % len(arrays)
+        arrays[reply] = name
+        out.append("static const uint8_t %s [] = { // %s, %i bytes" % (name, path, len(reply)))
+        for i in range(0, len(reply), 24):
+            out.append("    " + ",".join("0x%02x" % b for b in reply[i:i + 24]) + ",")
+        out.append("};")
+    out.append("")
+    out.append("static const htmlBundleAsset_t __htmlBundleAssets__ [] = {")
+    for path, reply, headerLength, etag, compressed in assets:
+        out.append('    { "%s", (const char *) %s, %i, %i, "%s", %s },' % (path, arrays[reply], len(reply), headerLength, etag.replace('"', '\\"'), "true" if compressed else "false"))
+    out.append("};")
+    out.append("")
+    out.append("static const int16_t __htmlBundleTable__ [HTML_BUNDLE_TABLE_SIZE] = { %s };" % ", ".join(str(i) for i in table))
+    out.append("")
+
+    with open(args.output, "w", newline="\r\n") as f:
+        f.write("\n".join(out))
+    print("%i files, %i bytes bundled into %s" % (len(arrays), sum(len(r) for r in arrays), os.path.normpath(args.output)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+
+#   httpbench.py
+#
+#   This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+#
+#   Simple HTTP load generator, it requests the same URLs over and over from a number of concurrent connections
+#   (one request per connection, like browsers do with ESP32) and reports requests per second and latency percentiles.
+#
+#   Example - compare the static asset cache turned on and off (assetcache on | off Telnet command):
+#
+#       python3 tools/httpbench.py http://10.18.1.200/ /index.html /login.html --connections 4 --duration 20
+#
+#   With --keep-alive each connection is kept open for the next request (USE_EVENT_HTTP_SERVER), --pipeline of them are sent
+#   at a time without waiting for the replies. Compare with GET /state over new connections:
+#
+#       python3 tools/httpbench.py http://10.18.1.200/ /state --connections 4
+#       python3 tools/httpbench.py http://10.18.1.200/ /state --connections 4 --keep-alive --pipeline 4
+#
+#   October 18, 2026, Bojan Jurca
+
+
+import argparse
+import http.client
+import socket
+import threading
+import time
+import urllib.parse
+
+
+def worker(host, port, paths, headers, deadline, latencies, errors, lock):
+    i = 0
+    while time.time() < deadline:
+        path = paths[i % len(paths)]
+        i += 1
+        start = time.perf_counter()
+        try:
+            connection = http.client.HTTPConnection(host, port, timeout=10)
+            connection.request("GET", path, headers=headers)
+            response = connection.getresponse()
+            response.read()
+            connection.close()
+            ok = response.status in (200, 304)
+        except (OSError, http.client.HTTPException):
+            ok = False
+        elapsed = time.perf_counter() - start
+        with lock:
+            if ok:
+                latencies.append(elapsed)
+            else:
+                errors[0] += 1
+
+
+def readReply(s, buffer):
+    # returns the status, whether the server keeps the connection open and the bytes after the reply
+    while b"\r\n\r\n" not in buffer:
+        chunk = s.recv(4096)
+        if not chunk:
+            raise OSError("connection closed")
+        buffer += chunk
+    headerEnd = buffer.index(b"\r\n\r\n") + 4
+    header = buffer[:headerEnd].decode(errors="replace").lower()
+    status = int(header.split(" ", 2)[1])
+    if "content-length:" not in header:
+        raise OSError("reply without Content-Length")
+    length = int(header.split("content-length:", 1)[1].split("\r\n", 1)[0])
+    while len(buffer) < headerEnd + length:
+        chunk = s.recv(4096)
+        if not chunk:
+            raise OSError("connection closed")
+        buffer += chunk
+    return status, "connection: close" not in header, buffer[headerEnd + length:]
+
+
+def keepAliveWorker(host, port, paths, headers, pipeline, deadline, latencies, errors, connections, lock):
+    # sends the requests through a kept-alive connection, pipeline of them at a time without waiting for the replies
+    i = 0
+    while time.time() < deadline:
+        try:
+            s = socket.create_connection((host, port), timeout=10)
+            with lock:
+                connections[0] += 1
+            buffer, sent, keptOpen, replies = b"", [], True, 0
+            while keptOpen and time.time() < deadline:
+                try:
+                    while len(sent) < pipeline:
+                        request = "GET %s HTTP/1.1\r\nHost: %s\r\n" % (paths[i % len(paths)], host)
+                        request += "".join("%s: %s\r\n" % field for field in headers.items()) + "\r\n"
+                        i += 1
+                        s.sendall(request.encode())
+                        sent.append(time.perf_counter())
+                    status, keptOpen, buffer = readReply(s, buffer)
+                except (ConnectionResetError, BrokenPipeError):
+                    if not replies:
+                        raise
+                    break # the server has closed the connection with pipelined requests still unread, the unanswered ones are not counted
+                replies += 1
+                elapsed = time.perf_counter() - sent.pop(0)
+                with lock:
+                    if status in (200, 304):
+                        latencies.append(elapsed)
+                    else:
+                        errors[0] += 1
+            s.close()
+        except (OSError, ValueError, IndexError):
+            with lock:
+                errors[0] += 1
+
+
+def percentile(sortedValues, percent):
+    if not sortedValues:
+        return 0.0
+    return sortedValues[min(len(sortedValues) - 1, int(len(sortedValues) * percent / 100))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="HTTP load generator for ESP32 HTTP server")
+    parser.add_argument("url", help="server URL, for example http://10.18.1.200/")
+    parser.add_argument("paths", nargs="*", default=["/"], help="paths to request in turn")
+    parser.add_argument("--connections", type=int, default=4, help="number of concurrent connections")
+    parser.add_argument("--duration", type=float, default=10, help="seconds")
+    parser.add_argument("--gzip", action="store_true", help="send Accept-Encoding: gzip")
+    parser.add_argument("--etag", help="send If-None-Match with this ETag")
+    parser.add_argument("--keep-alive", action="store_true", help="keep the connections open for the next request")
+    parser.add_argument("--pipeline", type=int, default=1, help="requests sent through a kept-alive connection without waiting for the replies")
+    args = parser.parse_args()
+
+    url = urllib.parse.urlparse(args.url)
+    headers = {}
+    if args.gzip:
+        headers["Accept-Encoding"] = "gzip"
+    if args.etag:
+        headers["If-None-Match"] = args.etag
+
+    port = url.port or 80
+
+    latencies, errors, connections, lock = [], [0], [0], threading.Lock()
+    start = time.time()
+    deadline = start + args.duration
+    if args.keep_alive:
+        threads = [threading.Thread(target=keepAliveWorker, args=(url.hostname, port, args.paths, headers, args.pipeline, deadline, latencies, errors, connections, lock)) for _ in range(args.connections)]
+    else:
+        threads = [threading.Thread(target=worker, args=(url.hostname, port, args.paths, headers, deadline, latencies, errors, lock)) for _ in range(args.connections)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.time() - start
+
+    latencies.sort()
+    print("requests %i, errors %i, %.1f requests/s" % (len(latencies), errors[0], len(latencies) / elapsed))
+    if args.keep_alive:
+        print("connections %i, %.1f requests per connection" % (connections[0], len(latencies) / max(connections[0], 1)))
+    print("latency p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms" % (percentile(latencies, 50) * 1000, percentile(latencies, 90) * 1000,
+                                                                        percentile(latencies, 99) * 1000, (latencies[-1] if latencies else 0) * 1000))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+#   syslogcollector.py
+#
+#   This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+#
+#   A minimal collector for syslogExporter_t: listens on a UDP port, prints the messages of both formats (RFC 5424 and
+#   binary) with the sending host and reports the messages that didn't arrive (gaps in the sequence numbers, the messages
+#   dropped by the rate limit included). Set collector to this computer's address in ESP32's /etc/syslog.conf.
+#
+#       python3 tools/syslogcollector.py --port 5514
+#
+#   October 18, 2026, Bojan Jurca
+
+
+import argparse
+import re
+import socket
+import struct
+import time
+
+
+rfc5424 = re.compile(r'<(\d+)>1 (\S+) (\S+) (\S+) \S+ \S+ (?:\[meta sequenceId="(\d+)"[^\]]*\]|-) ?(.*)', re.S)
+
+
+def parseBinary(datagram):
+    # "DL", version, count, dropped (4), host name length, host name, then sequence (4), up time (4), time (8), text length, text
+    if len(datagram) < 9 or datagram[:2] != b"DL" or datagram[2] != 1:
+        raise ValueError("not a syslogExporter_t binary datagram")
+    count = datagram[3]
+    dropped, = struct.unpack_from("<I", datagram, 4)
+    host = datagram[9:9 + datagram[8]].decode(errors="replace")
+    offset = 9 + datagram[8]
+    messages = []
+    for _ in range(count):
+        sequence, upTime, t, length = struct.unpack_from("<IIqB", datagram, offset)
+        offset += 17
+        text = datagram[offset:offset + length].decode(errors="replace")
+        offset += length
+        timestamp = time.strftime("%Y-%m-%dT%H:%M:%S", time.gmtime(t / 1000)) + ".%03iZ" % (t % 1000) if t else "-"
+        messages.append((host, sequence, timestamp, "%10i ms %s" % (upTime, text)))
+    return messages, dropped
+
+
+def main():
+    parser = argparse.ArgumentParser(description="UDP syslog collector for ESP32 syslogExporter_t")
+    parser.add_argument("--port", type=int, default=514, help="UDP port to listen on")
+    parser.add_argument("--count", type=int, default=0, help="exit after this many datagrams (0 = never)")
+    args = parser.parse_args()
+
+    s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    s.bind(("", args.port))
+    lastSequence = {}
+    received = {}
+    missing = {}
+    datagrams = 0
+    while not args.count or datagrams < args.count:
+        datagram, address = s.recvfrom(65536)
+        datagrams += 1
+        try:
+            if datagram[:2] == b"DL":
+                messages, _ = parseBinary(datagram)
+            else:
+                m = rfc5424.match(datagram.decode(errors="replace"))
+                if not m:
+                    print("%s: %s" % (address[0], datagram))
+                    continue
+                messages = [(m.group(3), int(m.group(5) or 0), m.group(2), m.group(6))]
+        except (ValueError, struct.error) as e:
+            print("%s: %s" % (address[0], e))
+            continue
+        for host, sequence, timestamp, text in messages:
+            if sequence and host in lastSequence and sequence > lastSequence[host] + 1:
+                missing[host] = missing.get(host, 0) + sequence - lastSequence[host] - 1
+            if sequence:
+                lastSequence[host] = sequence
+            received[host] = received.get(host, 0) + 1
+            print("%s %s #%i %s" % (host, timestamp, sequence, text))
+    for host in received:
+        print("%s: %i messages received, %i missing" % (host, received[host], missing.get(host, 0)))
+
+
+if __name__ == "__main__":
+    main()
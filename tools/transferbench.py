@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+
+#   transferbench.py
+#
+#   This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+#
+#   Measures the throughput of large file transfers: uploads files of 1 KB to 1 MB with PUT /upload/<path>, downloads them
+#   back with GET /download/<path>, checks that they are the same and reports MB/s in each direction. The transfers need
+#   a logged-in session, pass its cookie with --session. The last transfers are also shown by transfers Telnet command.
+#   With --segments N each file is uploaded and downloaded in N parts through N parallel connections (Content-Range and Range).
+#
+#       python3 tools/transferbench.py http://10.18.1.200/ --session <token>
+#       python3 tools/transferbench.py http://10.18.1.200/ --session <token> --segments 2
+#
+#   October 18, 2026, Bojan Jurca
+
+
+import argparse
+import http.client
+import os
+import socket
+import threading
+import time
+import urllib.parse
+
+
+def upload(host, port, path, data, cookie, contentRange=""):
+    # http.client does not wait for 100 Continue, so the request is sent by hand
+    s = socket.create_connection((host, port), timeout=30)
+    try:
+        if contentRange:
+            contentRange = "Content-Range: bytes %s\r\n" % contentRange
+        s.sendall(("PUT /upload%s HTTP/1.1\r\nHost: %s\r\nCookie: %s\r\nContent-Length: %i\r\nExpect: 100-continue\r\n%s\r\n" % (path, host, cookie, len(data), contentRange)).encode())
+        reply = b""
+        while b"\r\n\r\n" not in reply:
+            chunk = s.recv(4096)
+            if not chunk:
+                raise OSError("connection closed")
+            reply += chunk
+        if not reply.startswith(b"HTTP/1.1 100"):
+            raise OSError(reply.split(b"\r\n")[0].decode() + " " + reply.split(b"\r\n\r\n", 1)[1].decode(errors="replace"))
+        s.sendall(data)
+        reply = reply.split(b"\r\n\r\n", 1)[1]
+        while True:
+            chunk = s.recv(4096)
+            if not chunk:
+                break
+            reply += chunk
+        if not reply.startswith(b"HTTP/1.1 200"):
+            raise OSError(reply.split(b"\r\n")[0].decode())
+    finally:
+        s.close()
+
+
+def download(host, port, path, cookie, byteRange=""):
+    headers = {"Cookie": cookie}
+    if byteRange:
+        headers["Range"] = "bytes=" + byteRange
+    connection = http.client.HTTPConnection(host, port, timeout=30)
+    connection.request("GET", "/download" + path, headers=headers)
+    response = connection.getresponse()
+    data = response.read()
+    connection.close()
+    if response.status != (206 if byteRange else 200):
+        raise OSError("%i %s" % (response.status, response.reason))
+    return data
+
+
+def inParallel(jobs):
+    # runs the jobs in threads, returns their results in the same order
+    results = [None] * len(jobs)
+    errors = []
+
+    def run(i):
+        try:
+            results[i] = jobs[i]()
+        except OSError as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(len(jobs))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    if errors:
+        raise errors[0]
+    return results
+
+
+def segmentedUpload(host, port, path, data, cookie, segments):
+    step = (len(data) + segments - 1) // segments
+    inParallel([lambda f=f: upload(host, port, path, data[f:f + step], cookie, "%i-%i/%i" % (f, min(f + step, len(data)) - 1, len(data)))
+                for f in range(0, len(data), step)])
+
+
+def segmentedDownload(host, port, path, cookie, size, segments):
+    step = (size + segments - 1) // segments
+    return b"".join(inParallel([lambda f=f: download(host, port, path, cookie, "%i-%i" % (f, min(f + step, size) - 1))
+                                for f in range(0, size, step)]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="File transfer benchmark for ESP32 HTTP server")
+    parser.add_argument("url", help="server URL, for example http://10.18.1.200/")
+    parser.add_argument("--session", required=True, help="session token of a logged-in user")
+    parser.add_argument("--path", default="/transferbench.bin", help="file on ESP32 used for the test")
+    parser.add_argument("--sizes", default="1,4,16,64,256,1024", help="file sizes in KB")
+    parser.add_argument("--segments", type=int, default=1, help="parallel connections per file")
+    args = parser.parse_args()
+
+    url = urllib.parse.urlparse(args.url)
+    port = url.port or 80
+    cookie = "session=" + args.session
+
+    print("%9s %14s %14s" % ("size", "upload", "download"))
+    for size in (int(kb) * 1024 for kb in args.sizes.split(",")):
+        data = os.urandom(size)
+        start = time.perf_counter()
+        if args.segments > 1:
+            segmentedUpload(url.hostname, port, args.path, data, cookie, args.segments)
+        else:
+            upload(url.hostname, port, args.path, data, cookie)
+        uploadTime = time.perf_counter() - start
+        start = time.perf_counter()
+        if args.segments > 1:
+            received = segmentedDownload(url.hostname, port, args.path, cookie, size, args.segments)
+        else:
+            received = download(url.hostname, port, args.path, cookie)
+        downloadTime = time.perf_counter() - start
+        if received != data:
+            print("%7i B downloaded file differs from the uploaded one" % size)
+            continue
+        print("%7i B %9.3f MB/s %9.3f MB/s" % (size, size / 1048576 / uploadTime, size / 1048576 / downloadTime))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,349 +1,829 @@
-/*
-  
-    userManagement.cpp
-  
-    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
-  
-    UNIX-like user management.
-  
-    April 27, 2026, Bojan Jurca
-
-*/
-
-
-#include "userManagement.h"
-
-
-userManagement_t::userManagement_t (threadSafeFS::FS& fileSystem) : __fileSystem__ (fileSystem) {
-    // create /etc/passwd if it doesn't exist
-    if (!__fileSystem__.isFile ("/etc/passwd")) {
-        // create /etc directory
-        if (!__fileSystem__.isDirectory ("/etc"))
-            __fileSystem__.mkdir ("/etc"); 
-
-        bool created = __writePasswd__ ("root:::::/:\r\n" 
-                                        "webadmin:::::/var/www/html/:");
-
-        cout << (created ? "/etc/passwd created\n" : "error creating /etc/passwd\n");
-    }
-
-    // create /etc/shadow if it doesn't exist
-    if (!__fileSystem__.isFile ("/etc/shadow")) {
-        // /etc directory already exists
-
-        bool created = __writeShadow__ ("root:$5$" DEFAULT_ROOT_PASSWORD_SHA ":::::::\r\n"
-                                        "webadmin:$5$" DEFAULT_WEBADMIN_PASSWORD_SHA ":::::::");
-
-        cout << (created ? "/etc/shadow created\n" : "error creating /etc/shadow\n");
-    }
-};
-
-// scan through /etc/shadow file for (user name, pasword) pair and return true if found
-bool userManagement_t::checkUserNameAndPassword (const char *userName, const char *password) {
-    // initial checking
-    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH || strlen (password) > USER_PASSWORD_MAX_LENGTH) 
-        return false;
-
-    // read /etc/shadow
-    char buffer [MAX_ETC_SHADOW_SIZE + 2] = {};
-    buffer [0] = '\n';
-    if (!__readShadow__ (buffer + 1))
-        return false;
-
-    // find user's record in the buffer
-    char srchStr [USER_PASSWORD_MAX_LENGTH + 65 + 7];
-    sprintf (srchStr, "\n%s:$5$", userName);
-    __sha256__ (srchStr + strlen (srchStr), 65, password);
-    strcat (srchStr, ":"); // we get something like "\nroot:$5$de362bbdf11f2df30d12f318eeed87b8ee9e0c69c8ba61ed9a57695bbd91e481:"
-
-    if (strstr (buffer, srchStr)) // the beginning of the line matches the user name and sha of password
-        return true; // success
-
-    return false;
-}
-
-// returns        "/" for full access
-// something like "/home/name" for limited access
-//                "" for no access
-Cstring<255> userManagement_t::getHomeDirectory (const char *userName) {
-    Cstring<255> homeDirectory;
-    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)
-        return "";
-
-    // read /etc/passwd
-    char buffer [MAX_ETC_PASSWD_SIZE + 3] = {}; 
-    buffer [0] = '\n';
-    if (!__readPasswd__ (buffer + 1))
-        return "";
-
-    // find user's record in the buffer
-    char srchStr [USER_PASSWORD_MAX_LENGTH + 2]; 
-    sprintf (srchStr, "\n%s:", userName); // we get something like \nroot:$5$
-
-    char *p = strstr (buffer, srchStr);
-    if (!p)
-        return ""; // user not found in /etc/passwd
-
-    for (int i = 0; i < 5; i++)
-        if (!(p = strchr (p + 1, ':')))
-            return "";
-
-    // the following uses too much stack:
-     if (sscanf (p + 1, "%255[^:]", (char *) (homeDirectory.c_str ())) <= 0)
-        return "";
-
-    return homeDirectory;
-}
-
-// bool passwd (userName, newPassword) assignes a new password for the user by writing it's SHA value into /etc/shadow file, return success
-bool userManagement_t::passwd (const char *userName, const char *newPassword) {
-    // initial checking
-    if (strlen (newPassword) > USER_PASSWORD_MAX_LENGTH) 
-        return false;
-
-    // read /etc/shadow
-    char buffer [MAX_ETC_SHADOW_SIZE + 2] = {};
-    buffer [0] = '\n';
-    if (!__readShadow__ (buffer + 1))
-        return false;
-
-    // find user's record in the buffer
-    char srchStr [USER_PASSWORD_MAX_LENGTH + 6];
-    sprintf (srchStr, "\n%s:$5$", userName);
-
-    char *p = strstr (buffer, srchStr);
-    if (!p || p - buffer > MAX_ETC_SHADOW_SIZE - 65)
-        return false; // user not found in /etc/shadow
-
-    // replace SHA of old password with SHA of new password
-    char newPasswordSHA [65];
-    __sha256__ (newPasswordSHA, 65, newPassword);
-    memcpy (p + strlen (srchStr), newPasswordSHA, 64);
-
-    // write /etc/shadow
-    if (!__writeShadow__ (buffer + 1))
-        return false;
-
-    return true; // success      
-}
-
-// char *userAdd (userName, userId, userHomeDirectory) adds userName, userId, userHomeDirectory to /etc/passwd and /etc/shadow, returns success or error message
-const char *userManagement_t::userAdd (const char *userName, const char *userHomeDirectory) {
-
-    if (!userName || strlen (userName) < 1)                     return "Missing user name";
-    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)           return "User name too long";
-    if (strstr (userName, ":"))                                 return "User name may not contain ':' character";
-    if (!userHomeDirectory || strlen (userHomeDirectory) < 1)   return "Missing user's home directory";
-    if (strlen (userHomeDirectory) > 255)                       return "User's home directory name too long";
-
-    Cstring<255> homeDirectory = userHomeDirectory;
-
-    {
-        // read /etc/passwd
-        Cstring<MAX_ETC_PASSWD_SIZE + 1> buffer = "\n";
-        if (!__readPasswd__ ((char *) (buffer.c_str () + 1)))
-            return "Can't read /etc/passwd";
-
-        // find user's record in the buffer
-        char srchStr [USER_PASSWORD_MAX_LENGTH + 2]; 
-        sprintf (srchStr, "\n%s:", userName); // we get something like \nroot:$5$
-
-        char *p = strstr (buffer.c_str (), srchStr);
-        if (p)
-            return "User with this name already exists";
-
-        buffer += "\r\n";
-        buffer += userName;
-        buffer += ":::::";
-        buffer += homeDirectory;
-        buffer += ":";
-
-        if (buffer.errorFlags ())
-            return "Not enough space in /etc/passwd";
-
-        // write /etc/passwd
-        if (!__writePasswd__ ((char *) (buffer.c_str () + 1)))
-            return "Can't write /etc/passwd";
-    }
-
-    {
-        Cstring<MAX_ETC_SHADOW_SIZE + 1> buffer = "\n";
-        if (!__readShadow__ ((char *) (buffer.c_str () + 1)))
-            return "Can't read /etc/shadow";
-
-        // find user's record in the buffer
-        char srchStr [USER_PASSWORD_MAX_LENGTH + 2]; 
-        sprintf (srchStr, "\n%s:", userName); // we get something like \nroot:$5$
-
-        char *p = strstr (buffer.c_str (), srchStr);
-        if (p) {
-            memcpy (p + strlen (srchStr), DEFAULT_USER_PASSWORD_SHA, 65);
-        } else {
-            buffer += "\r\n";
-            buffer += userName;
-            buffer += ":$5$";
-            buffer += DEFAULT_USER_PASSWORD_SHA;
-            buffer += ":::::::";
-
-            if (buffer.errorFlags ())
-                return "Not enough space in /etc/shadow";
-
-            // write /etc/passwd
-            if (!__writeShadow__ ((char *) (buffer.c_str () + 1)))
-                return "Can't write /etc/shadow";
-        }
-
-    }
-    return "User created with default password '" DEFAULT_USER_PASSWORD "'";
-}
-
-// char *userDel (userName) deletes userName from /etc/passwd and /etc/shadow, returns success or error message
-const char *userManagement_t::userDel (const char *userName) {
-
-    if (!userName || strlen (userName) < 1)                     return "Missing user name";
-    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)           return "User name too long";
-
-    {
-        // read /etc/passwd
-        char buffer [MAX_ETC_PASSWD_SIZE + 3] = {}; 
-        buffer [0] = '\n';
-        if (!__readPasswd__ (buffer + 1))
-            return "";
-
-        // find user's record in the buffer
-        char srchStr [USER_PASSWORD_MAX_LENGTH + 2]; 
-        sprintf (srchStr, "\n%s:", userName); // we get something like \nroot:$5$
-
-        char *p = strstr (buffer, srchStr);
-        if (!p)
-            return "User with this name doesn't exist";
-
-        p++; // p now points directly to username
-
-        // find the end of the line
-        char *q = p;
-        while (*q > '\n')
-            q++;
-        if (*q) {
-            // end of line found
-            while (*q && *q < ' ')
-                q++;
-            strcpy (p, q);
-        } else {
-            // end of line not found - this is the last record, close and rtrim the buffer
-            for (*p = 0; p > buffer && *p <= ' '; p--)
-                *p = 0;
-        }
-
-        // write /etc/passwd
-        if (!__writePasswd__ (buffer + 1))
-            return "Can't write /etc/passwd";
-    }
-
-    {
-        // read /etc/shadow
-        char buffer [MAX_ETC_SHADOW_SIZE + 2] = {};
-        buffer [0] = '\n';
-        if (!__readShadow__ (buffer + 1))
-            return "Can't read /etc/shadow";
-
-        // find user's record in the buffer
-        char srchStr [USER_PASSWORD_MAX_LENGTH + 6];
-        sprintf (srchStr, "\n%s:$5$", userName);
-
-        char *p = strstr (buffer, srchStr);
-        if (p) {
-            p++; // p now points directly to username
-
-            // find the end of the line
-            char *q = p;
-            while (*q > '\n')
-                q++;
-            if (*q) {
-                // end of line found
-                while (*q && *q < ' ')
-                    q++;
-                strcpy (p, q);
-            } else {
-                // end of line not found - this is the last record, close and rtrim the buffer
-                for (*p = 0; p > buffer && *p <= ' '; p--)
-                    *p = 0;
-            }
-
-            // write /etc/shadow
-            if (!__writeShadow__ (buffer + 1))
-                return "Can't write /etc/shadow";
-        }
-    }
-    return "User deleted";
-}
-
-// converts clearText to 256 bit SHA, returns character representation in hexadecimal format of hash value
-bool userManagement_t::__sha256__ (char *buffer, size_t bufferSize, const char *clearText) {
-    *buffer = 0;
-    byte shaByteResult [32];
-    char shaCharResult [65];
-    mbedtls_md_context_t ctx;
-    mbedtls_md_type_t md_type = MBEDTLS_MD_SHA256;
-    mbedtls_md_init (&ctx);
-    mbedtls_md_setup (&ctx, mbedtls_md_info_from_type (md_type), 0);
-    mbedtls_md_starts (&ctx);
-    mbedtls_md_update (&ctx, (const unsigned char *) clearText, strlen (clearText));
-    mbedtls_md_finish (&ctx, shaByteResult);
-    mbedtls_md_free (&ctx);
-    for (int i = 0; i < 32; i++) 
-        sprintf (shaCharResult + 2 * i, "%02x", (int) shaByteResult [i]);
-    if (bufferSize > strlen (shaCharResult)) { 
-        strcpy (buffer, shaCharResult); 
-        return true; 
-    }
-    return false; 
-}
-
-bool userManagement_t::__writePasswd__ (const char *buffer) { // buffer of MAX_ETC_PASSWD_SIZE bytes
-    threadSafeFS::File f = __fileSystem__.open ("/etc/passwd", "w");
-    if (f && !f.isDirectory ())
-        if (f.print (buffer) > 0)
-            return true;
-    return false;
-}
-
-bool userManagement_t::__readPasswd__ (char *buffer) { // buffer of MAX_ETC_PASSWD_SIZE bytes
-    threadSafeFS::File f = __fileSystem__.open ("/etc/passwd", "r");
-    if (!f || f.isDirectory ())
-        return false;
-
-    size_t bytesRead = f.read ((byte *) buffer, MAX_ETC_PASSWD_SIZE);
-    if (bytesRead == MAX_ETC_PASSWD_SIZE)
-        return false; // file contet too long for buffer
-    // buffer [bytesRead] = 0; // close C string        
-    // close and rtrim buffer
-    for (char *p = buffer + bytesRead; p > buffer && *p <= ' '; p--)
-        *p = 0;
-
-    return true;
-}
-
-bool userManagement_t::__writeShadow__ (const char *buffer) { // buffer of MAX_ETC_SHADOW_SIZE bytes
-    threadSafeFS::File f = __fileSystem__.open ("/etc/shadow", "w");
-    if (f && !f.isDirectory ())
-        if (f.print (buffer) > 0)
-            return true;
-    return false;
-}
-
-bool userManagement_t::__readShadow__ (char *buffer) { // buffer of MAX_ETC_SHADOW_SIZE bytes
-    threadSafeFS::File f = __fileSystem__.open ("/etc/shadow", "r");
-    if (!f || f.isDirectory ())
-        return false;
-
-    size_t bytesRead = f.read ((byte *) buffer, MAX_ETC_SHADOW_SIZE);
-    if (bytesRead == MAX_ETC_SHADOW_SIZE)
-        return false; // file contet too long for buffer
-    // buffer [bytesRead] = 0; // close C string
-    // close and rtrim buffer
-    for (char *p = buffer + bytesRead; p > buffer && *p <= ' '; p--)
-        *p = 0;
-
-    return true;
-}
+/*
+  
+    userManagement.cpp
+  
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+  
+    UNIX-like user management.
+  
+    April 27, 2026, Bojan Jurca
+
+*/
+
+
+#include "userManagement.h"
+#include <esp_random.h>
+
+
+// reads a file line by line through a small buffer, instead of loading it all at once
+class __lineReader__ {
+
+    public:
+
+        __lineReader__ (threadSafeFS::File& f, size_t offset = 0) : __f__ (f), __offset__ (offset) {}
+
+        // the next line that is not empty (cut to lineSize - 1 characters), its offset and full length without the line end, false at the end of file
+        bool readLine (char *line, size_t lineSize, size_t& offset, size_t& length) {
+            int c;
+            do {
+                offset = __offset__ + __position__;
+                c = __next__ ();
+            } while (c == '\r' || c == '\n');
+            if (c < 0)
+                return false;
+            size_t l = 0;
+            for (length = 0; c >= 0 && c != '\r' && c != '\n'; length ++, c = __next__ ())
+                if (l < lineSize - 1)
+                    line [l ++] = c;
+            line [l] = 0;
+            return true;
+        }
+
+    private:
+
+        threadSafeFS::File& __f__;
+        char __buffer__ [USER_FILE_BUFFER];
+        size_t __offset__;          // of __buffer__ [0] in the file
+        size_t __position__ = 0;
+        size_t __length__ = 0;
+
+        int __next__ () {
+            if (__position__ == __length__) {
+                __offset__ += __length__;
+                __length__ = __f__.read ((uint8_t *) __buffer__, sizeof (__buffer__));
+                __position__ = 0;
+                if (!__length__)
+                    return -1;
+            }
+            return (uint8_t) __buffer__ [__position__ ++];
+        }
+};
+
+// index entry, path.idx holds a header and the entries sorted by hash
+struct __indexEntry__ {
+    uint32_t hash;                  // of the user name
+    uint32_t offset;                // of the record in path
+};
+
+struct __indexHeader__ {
+    uint32_t magic;                 // USER_INDEX_MAGIC
+    uint32_t size;                  // of path when it was indexed
+    uint32_t lastWrite;             // of path when it was indexed, checked at each lookup
+    uint32_t checksum;              // FNV-1a of path's content when it was indexed, checked at start-up
+    uint32_t count;                 // entries
+};
+
+#define USER_INDEX_MAGIC 0x32444955 // "UID2"
+#define USER_PATH_LENGTH 40         // bytes of path.idx, path.tmp, path.new and path.idx.tmp names
+
+static uint32_t __nameHash__ (const char *name, size_t length) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < length; i++)
+        h = (h ^ (uint8_t) name [i]) * 16777619u;
+    return h;
+}
+
+// FNV-1a of the whole file
+static uint32_t __checksum__ (threadSafeFS::File& f) {
+    uint32_t h = 2166136261u;
+    uint8_t buffer [USER_FILE_BUFFER];
+    size_t l;
+    f.seek (0);
+    while ((l = f.read (buffer, sizeof (buffer))))
+        for (size_t i = 0; i < l; i++)
+            h = (h ^ buffer [i]) * 16777619u;
+    f.seek (0);
+    return h;
+}
+
+static bool __copy__ (threadSafeFS::File& from, threadSafeFS::File& to, size_t length) {
+    char buffer [USER_FILE_BUFFER];
+    while (length) {
+        size_t l = from.read ((uint8_t *) buffer, length < sizeof (buffer) ? length : sizeof (buffer));
+        if (!l)
+            return length == (size_t) -1 || length == 0; // until the end of file
+        if (to.write ((const uint8_t *) buffer, l) != l)
+            return false;
+        if (length != (size_t) -1)
+            length -= l;
+    }
+    return true;
+}
+
+static const char __itoa64__ [] = "./0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"; // SHA-crypt base 64
+
+// compares the whole strings, so the time doesn't tell where they differ
+static bool __equal__ (const char *a, const char *b) {
+    size_t l = strlen (a);
+    if (l != strlen (b))
+        return false;
+    uint8_t d = 0;
+    for (size_t i = 0; i < l; i++)
+        d |= a [i] ^ b [i];
+    return !d;
+}
+
+
+userManagement_t::userManagement_t (threadSafeFS::FS& fileSystem) : __fileSystem__ (fileSystem) {
+    __semaphore__ = xSemaphoreCreateMutex ();
+    __fileSemaphore__ = xSemaphoreCreateMutex ();
+    esp_fill_random (__cacheKey__, sizeof (__cacheKey__));
+
+    // finish the writes that were interrupted by a reset, before the missing files are created with default passwords
+    __recover__ ("/etc/login.defs");
+    __recover__ ("/etc/passwd");
+    __recover__ ("/etc/shadow");
+
+    // SHA-crypt rounds of new passwords
+    if (__fileSystem__.isFile ("/etc/login.defs")) {
+        char buffer [256] = "\n";
+        if (__fileSystem__.readConfiguration (buffer + 1, sizeof (buffer) - 3, "/etc/login.defs")) {
+            strcat (buffer, "\n");
+            unsigned long rounds;
+            char *p = strstr (buffer, "\nSHA_CRYPT_ROUNDS");
+            if (p && sscanf (p + 17, "%*[ =]%lu", &rounds) == 1 && rounds >= USER_PASSWORD_MIN_ROUNDS && rounds <= USER_PASSWORD_MAX_ROUNDS)
+                __rounds__ = rounds;
+        }
+    }
+
+    // create /etc/passwd if it doesn't exist
+    if (!__fileSystem__.isFile ("/etc/passwd")) {
+        // create /etc directory
+        if (!__fileSystem__.isDirectory ("/etc"))
+            __fileSystem__.mkdir ("/etc"); 
+
+        bool created = __writeFile__ ("/etc/passwd", "root:::::/:\r\n" 
+                                                     "webadmin:::::/var/www/html/:");
+
+        cout << (created ? "/etc/passwd created\n" : "error creating /etc/passwd\n");
+    }
+
+    // create /etc/shadow if it doesn't exist
+    if (!__fileSystem__.isFile ("/etc/shadow")) {
+        // /etc directory already exists
+
+        char rootHash [USER_PASSWORD_HASH_LENGTH];
+        char webadminHash [USER_PASSWORD_HASH_LENGTH];
+        char buffer [2 * USER_PASSWORD_HASH_LENGTH + 32];
+        bool created = __newHash__ (rootHash, sizeof (rootHash), DEFAULT_ROOT_PASSWORD) && __newHash__ (webadminHash, sizeof (webadminHash), DEFAULT_WEBADMIN_PASSWORD);
+        if (created) {
+            sprintf (buffer, "root:%s:::::::\r\n"
+                             "webadmin:%s:::::::", rootHash, webadminHash);
+            created = __writeFile__ ("/etc/shadow", buffer);
+        }
+
+        cout << (created ? "/etc/shadow created\n" : "error creating /etc/shadow\n");
+    }
+
+    // index the files if they have been changed since they were indexed (through FTP, for example)
+    if (USER_INDEX) {
+        __buildIndex__ ("/etc/passwd", false);
+        __buildIndex__ ("/etc/shadow", false);
+    }
+};
+
+userManagement_t::~userManagement_t () {
+    vSemaphoreDelete (__semaphore__);
+    vSemaphoreDelete (__fileSemaphore__);
+}
+
+// find the user's record in /etc/shadow file and return true if the password matches its hash
+bool userManagement_t::checkUserNameAndPassword (const char *userName, const char *password) {
+    // initial checking
+    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH || strlen (password) > USER_PASSWORD_MAX_LENGTH) 
+        return false;
+
+    // find user's record in /etc/shadow
+    char line [USER_RECORD_LENGTH];
+    size_t offset, length;
+    if (!__findRecord__ ("/etc/shadow", userName, line, sizeof (line), offset, length))
+        return false; // user not found in /etc/shadow
+
+    // copy the hash, we get something like "$5$rounds=5000$toolongsaltstrin$Un/5jzAHMgOGZ5.mWJpuVolil07guHPvOW8mGRcvxa5" (the password is "This is just a test")
+    char *p = line + strlen (userName) + 1;
+    size_t l = strcspn (p, ":");
+    if (strncmp (p, "$5$", 3) || l >= USER_PASSWORD_HASH_LENGTH)
+        return false;
+    char hash [USER_PASSWORD_HASH_LENGTH];
+    memcpy (hash, p, l);
+    hash [l] = 0;
+
+    // was the same password verified against the same hash recently?
+    uint8_t digest [32];
+    __credentialDigest__ (digest, userName, hash, password);
+    unsigned long now = millis ();
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __logins__ ++;
+        for (__credential__& c : __cache__)
+            if (c.expires && (long) (c.expires - now) > 0 && !memcmp (c.digest, digest, sizeof (digest))) {
+                __cacheHits__ ++;
+                xSemaphoreGive (__semaphore__);
+                return true; // success
+            }
+    xSemaphoreGive (__semaphore__);
+
+    if (l == 3 + 64 && strspn (hash + 3, "0123456789abcdef") == 64) {
+        // the older unsalted SHA-256 in hexadecimal format, replace it with SHA-crypt
+        char sha [65];
+        __sha256__ (sha, sizeof (sha), password);
+        if (!__equal__ (hash + 3, sha))
+            return false;
+        if (!passwd (userName, password))
+            cout << "couldn't replace the unsalted password hash in /etc/shadow\n";
+        return true; // success, but not cached since the hash has just changed
+    }
+
+    char computed [USER_PASSWORD_HASH_LENGTH];
+    if (!shaCrypt (computed, sizeof (computed), password, hash) || !__equal__ (computed, hash))
+        return false;
+
+    // remember it, in place of an empty or expired entry or the one that expires first
+    xSemaphoreTake (__semaphore__, portMAX_DELAY);
+        __credential__ *c = &__cache__ [0];
+        for (__credential__& e : __cache__) {
+            if (!e.expires || (long) (e.expires - now) <= 0) {
+                c = &e;
+                break;
+            }
+            if ((long) (e.expires - c->expires) < 0)
+                c = &e;
+        }
+        memcpy (c->digest, digest, sizeof (digest));
+        c->expires = (now + USER_CREDENTIAL_CACHE_TIME * 1000UL) | 1; // 0 means empty
+    xSemaphoreGive (__semaphore__);
+    return true; // success
+}
+
+// returns        "/" for full access
+// something like "/home/name" for limited access
+//                "" for no access
+Cstring<255> userManagement_t::getHomeDirectory (const char *userName) {
+    Cstring<255> homeDirectory;
+    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)
+        return "";
+
+    // find user's record in /etc/passwd
+    char line [USER_RECORD_LENGTH];
+    size_t offset, length;
+    if (!__findRecord__ ("/etc/passwd", userName, line, sizeof (line), offset, length))
+        return ""; // user not found in /etc/passwd
+
+    char *p = line;
+    for (int i = 0; i < 5; i++)
+        if (!(p = strchr (p + 1, ':')))
+            return "";
+
+    if (sscanf (p + 1, "%255[^:]", (char *) (homeDirectory.c_str ())) <= 0)
+        return "";
+
+    return homeDirectory;
+}
+
+// bool passwd (userName, newPassword) assignes a new password for the user by writing it's SHA-crypt hash into /etc/shadow file, return success
+bool userManagement_t::passwd (const char *userName, const char *newPassword) {
+    // initial checking
+    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH || strlen (newPassword) > USER_PASSWORD_MAX_LENGTH) 
+        return false;
+
+    // hash the new password before the file is read, it takes a while
+    char newPasswordHash [USER_PASSWORD_HASH_LENGTH];
+    if (!__newHash__ (newPasswordHash, sizeof (newPasswordHash), newPassword))
+        return false;
+
+    xSemaphoreTake (__fileSemaphore__, portMAX_DELAY);
+
+        // find user's record in /etc/shadow
+        char line [USER_RECORD_LENGTH];
+        size_t offset, length;
+        size_t nameLength = strlen (userName);
+        bool changed = __findRecord__ ("/etc/shadow", userName, line, sizeof (line), offset, length) && length < sizeof (line) && !strncmp (line + nameLength + 1, "$5$", 3);
+
+        if (changed) {
+            char *oldHash = line + nameLength + 1;
+            size_t oldLength = strcspn (oldHash, ":");
+            size_t newLength = strlen (newPasswordHash);
+            if (USER_IN_PLACE_UPDATE && oldLength == newLength) {
+                // if the new hash is as long as the old one (the same rounds), only overwrite it in /etc/shadow
+                changed = __updateFile__ ("/etc/shadow", offset + nameLength + 1, newPasswordHash, newLength);
+            } else {
+                // replace the hash of old password with the hash of new password
+                char newLine [USER_RECORD_LENGTH];
+                changed = snprintf (newLine, sizeof (newLine), "%s:%s%s", userName, newPasswordHash, oldHash + oldLength) < (int) sizeof (newLine)
+                          && __rewriteFile__ ("/etc/shadow", userName, newLine);
+            }
+        }
+
+    xSemaphoreGive (__fileSemaphore__);
+    return changed;
+}
+
+// char *userAdd (userName, userId, userHomeDirectory) adds userName, userId, userHomeDirectory to /etc/passwd and /etc/shadow, returns success or error message
+const char *userManagement_t::userAdd (const char *userName, const char *userHomeDirectory) {
+
+    if (!userName || strlen (userName) < 1)                     return "Missing user name";
+    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)           return "User name too long";
+    if (strstr (userName, ":"))                                 return "User name may not contain ':' character";
+    if (!userHomeDirectory || strlen (userHomeDirectory) < 1)   return "Missing user's home directory";
+    if (strlen (userHomeDirectory) > 255)                       return "User's home directory name too long";
+
+    char defaultPasswordHash [USER_PASSWORD_HASH_LENGTH];
+    if (!__newHash__ (defaultPasswordHash, sizeof (defaultPasswordHash), DEFAULT_USER_PASSWORD))
+        return "Can't hash the default password";
+
+    const char *result = "User created with default password '" DEFAULT_USER_PASSWORD "'";
+    xSemaphoreTake (__fileSemaphore__, portMAX_DELAY);
+
+        char line [USER_RECORD_LENGTH];
+        size_t offset, length;
+        if (__findRecord__ ("/etc/passwd", userName, line, sizeof (line), offset, length)) {
+            result = "User with this name already exists";
+        } else {
+            // append the record to /etc/passwd
+            snprintf (line, sizeof (line), "%s:::::%s:", userName, userHomeDirectory);
+            if (!__rewriteFile__ ("/etc/passwd", userName, line)) {
+                result = "Can't write /etc/passwd";
+            } else {
+                // append the record to /etc/shadow or replace the one that is left there
+                snprintf (line, sizeof (line), "%s:%s:::::::", userName, defaultPasswordHash);
+                if (!__rewriteFile__ ("/etc/shadow", userName, line))
+                    result = "Can't write /etc/shadow";
+            }
+        }
+
+    xSemaphoreGive (__fileSemaphore__);
+    return result;
+}
+
+// char *userDel (userName) deletes userName from /etc/passwd and /etc/shadow, returns success or error message
+const char *userManagement_t::userDel (const char *userName) {
+
+    if (!userName || strlen (userName) < 1)                     return "Missing user name";
+    if (strlen (userName) > USER_PASSWORD_MAX_LENGTH)           return "User name too long";
+
+    const char *result = "User deleted";
+    xSemaphoreTake (__fileSemaphore__, portMAX_DELAY);
+
+        char line [USER_RECORD_LENGTH];
+        size_t offset, length;
+        if (!__findRecord__ ("/etc/passwd", userName, line, sizeof (line), offset, length))
+            result = "User with this name doesn't exist";
+        else if (!__rewriteFile__ ("/etc/passwd", userName, NULL))
+            result = "Can't write /etc/passwd";
+        else if (!__rewriteFile__ ("/etc/shadow", userName, NULL))
+            result = "Can't write /etc/shadow";
+
+    xSemaphoreGive (__fileSemaphore__);
+    return result;
+}
+
+// converts clearText to 256 bit SHA, returns character representation in hexadecimal format of hash value (the older, unsalted /etc/shadow records)
+bool userManagement_t::__sha256__ (char *buffer, size_t bufferSize, const char *clearText) {
+    *buffer = 0;
+    if (bufferSize < 65)
+        return false;
+    byte shaByteResult [32];
+    cryptoBackend_t::sha256 (clearText, strlen (clearText), shaByteResult); // SHA accelerator or software, see cryptoBackend.h
+    for (int i = 0; i < 32; i++) {
+        buffer [2 * i] = "0123456789abcdef" [shaByteResult [i] >> 4];
+        buffer [2 * i + 1] = "0123456789abcdef" [shaByteResult [i] & 0x0f];
+    }
+    buffer [64] = 0;
+    return true;
+}
+
+// SHA-crypt with SHA-256 as specified in https://www.akkadia.org/drepper/SHA-crypt.txt, SHA-256 is calculated by cryptoBackend (SHA accelerator)
+bool userManagement_t::shaCrypt (char *buffer, size_t bufferSize, const char *password, const char *setting) {
+    if (strncmp (setting, "$5$", 3))
+        return false;
+    const char *salt = setting + 3;
+    unsigned long rounds = 5000;
+    bool roundsGiven = false;
+    if (!strncmp (salt, "rounds=", 7)) {
+        char *end;
+        rounds = strtoul (salt + 7, &end, 10);
+        if (end == salt + 7 || *end != '$')
+            return false;
+        rounds = rounds < USER_PASSWORD_MIN_ROUNDS ? USER_PASSWORD_MIN_ROUNDS : rounds > USER_PASSWORD_MAX_ROUNDS ? USER_PASSWORD_MAX_ROUNDS : rounds;
+        roundsGiven = true;
+        salt = end + 1;
+    }
+    size_t saltLength = strcspn (salt, "$:");
+    if (saltLength > USER_PASSWORD_SALT_LENGTH)
+        saltLength = USER_PASSWORD_SALT_LENGTH;
+    size_t passwordLength = strlen (password);
+    if (passwordLength > USER_PASSWORD_MAX_LENGTH)
+        return false;
+
+    // the salt is hashed up to 16 + 255 times and the password as many times as it is long
+    const size_t scratchSize = USER_PASSWORD_SALT_LENGTH * (16 + 255) > USER_PASSWORD_MAX_LENGTH * USER_PASSWORD_MAX_LENGTH ? USER_PASSWORD_SALT_LENGTH * (16 + 255) : USER_PASSWORD_MAX_LENGTH * USER_PASSWORD_MAX_LENGTH;
+    uint8_t *scratch = (uint8_t *) malloc (scratchSize);
+    if (!scratch)
+        return false;
+    size_t l;
+    auto add = [&] (const void *data, size_t length) { memcpy (scratch + l, data, length); l += length; };
+
+    // digest B = SHA (password salt password)
+    uint8_t b [32];
+    l = 0;
+    add (password, passwordLength); add (salt, saltLength); add (password, passwordLength);
+    cryptoBackend_t::sha256 (scratch, l, b);
+
+    // digest A = SHA (password salt, B for each byte of password, B or password for each bit of password length)
+    uint8_t a [32];
+    l = 0;
+    add (password, passwordLength); add (salt, saltLength);
+    size_t n;
+    for (n = passwordLength; n > 32; n -= 32)
+        add (b, 32);
+    add (b, n);
+    for (n = passwordLength; n; n >>= 1)
+        if (n & 1)
+            add (b, 32);
+        else
+            add (password, passwordLength);
+    cryptoBackend_t::sha256 (scratch, l, a);
+
+    // byte sequence P from digest DP = SHA (password repeated as many times as it is long)
+    uint8_t p [USER_PASSWORD_MAX_LENGTH];
+    l = 0;
+    for (n = 0; n < passwordLength; n++)
+        add (password, passwordLength);
+    cryptoBackend_t::sha256 (scratch, l, b);
+    for (n = 0; n < passwordLength; n++)
+        p [n] = b [n % 32];
+
+    // byte sequence S from digest DS = SHA (salt repeated 16 + A [0] times)
+    uint8_t s [USER_PASSWORD_SALT_LENGTH];
+    l = 0;
+    for (n = 0; n < 16u + a [0]; n++)
+        add (salt, saltLength);
+    cryptoBackend_t::sha256 (scratch, l, b);
+    memcpy (s, b, saltLength);
+
+    // the rounds, each one hashes at most 3 blocks of 64 bytes
+    uint8_t *c = a;
+    for (unsigned long r = 0; r < rounds; r++) {
+        l = 0;
+        if (r & 1) add (p, passwordLength); else add (c, 32);
+        if (r % 3) add (s, saltLength);
+        if (r % 7) add (p, passwordLength);
+        if (r & 1) add (c, 32); else add (p, passwordLength);
+        cryptoBackend_t::sha256 (scratch, l, c);
+    }
+    free (scratch);
+
+    // $5$rounds=N$salt$hash
+    int prefixLength = roundsGiven ? snprintf (buffer, bufferSize, "$5$rounds=%lu$%.*s$", rounds, (int) saltLength, salt)
+                                   : snprintf (buffer, bufferSize, "$5$%.*s$", (int) saltLength, salt);
+    if (prefixLength < 0 || prefixLength + 43 >= (int) bufferSize)
+        return false;
+    char *o = buffer + prefixLength;
+    auto encode = [&] (uint8_t b2, uint8_t b1, uint8_t b0, int chars) {
+        uint32_t w = (b2 << 16) | (b1 << 8) | b0;
+        while (chars --) {
+            *o ++ = __itoa64__ [w & 0x3f];
+            w >>= 6;
+        }
+    };
+    for (int i = 0; i < 10; i++) // the bytes are taken in the order 0 10 20, 21 1 11, 12 22 2, ...
+        encode (c [(i * 21) % 30], c [(i * 21 + 10) % 30], c [(i * 21 + 20) % 30], 4);
+    encode (0, c [31], c [30], 3);
+    *o = 0;
+    return true;
+}
+
+// $5$rounds=N$salt$hash of password with random salt and __rounds__
+bool userManagement_t::__newHash__ (char *buffer, size_t bufferSize, const char *password) {
+    uint8_t random [USER_PASSWORD_SALT_LENGTH];
+    esp_fill_random (random, sizeof (random));
+    char setting [32 + USER_PASSWORD_SALT_LENGTH];
+    int l = sprintf (setting, "$5$rounds=%lu$", (unsigned long) __rounds__);
+    for (int i = 0; i < USER_PASSWORD_SALT_LENGTH; i++)
+        setting [l ++] = __itoa64__ [random [i] & 0x3f];
+    setting [l] = 0;
+    return shaCrypt (buffer, bufferSize, password, setting);
+}
+
+// keyed SHA-256 of the verified credentials, so the cache doesn't keep the passwords
+void userManagement_t::__credentialDigest__ (uint8_t digest [32], const char *userName, const char *hash, const char *password) {
+    uint8_t buffer [sizeof (__cacheKey__) + USER_PASSWORD_MAX_LENGTH + USER_PASSWORD_HASH_LENGTH + USER_PASSWORD_MAX_LENGTH + 2];
+    size_t l = sizeof (__cacheKey__);
+    memcpy (buffer, __cacheKey__, l);
+    l += sprintf ((char *) buffer + l, "%s:%s:%s", userName, hash, password);
+    cryptoBackend_t::sha256 (buffer, l, digest);
+    memset (buffer, 0, sizeof (buffer));
+}
+
+bool userManagement_t::setRounds (uint32_t rounds) {
+    if (rounds < USER_PASSWORD_MIN_ROUNDS || rounds > USER_PASSWORD_MAX_ROUNDS)
+        return false;
+    __rounds__ = rounds;
+
+    // write /etc/login.defs, through /etc/login.defs.tmp like /etc/passwd and /etc/shadow
+    char buffer [160];
+    sprintf (buffer, "# SHA-crypt rounds of new passwords, passwdbench <target ms> sets them for the target login latency\r\n"
+                     "SHA_CRYPT_ROUNDS %lu\r\n", (unsigned long) rounds);
+    xSemaphoreTake (__fileSemaphore__, portMAX_DELAY);
+        bool written = __writeFile__ ("/etc/login.defs", buffer);
+    xSemaphoreGive (__fileSemaphore__);
+    return written;
+}
+
+uint32_t userManagement_t::calibrate (unsigned long targetMs) {
+    char hash [USER_PASSWORD_HASH_LENGTH];
+    unsigned long start = micros ();
+    shaCrypt (hash, sizeof (hash), DEFAULT_USER_PASSWORD, "$5$rounds=10000$calibrate");
+    unsigned long elapsed = micros () - start;
+    uint64_t rounds = 10000ULL * targetMs * 1000 / (elapsed ? elapsed : 1);
+    return rounds < USER_PASSWORD_MIN_ROUNDS ? USER_PASSWORD_MIN_ROUNDS : rounds > USER_PASSWORD_MAX_ROUNDS ? USER_PASSWORD_MAX_ROUNDS : rounds;
+}
+
+String userManagement_t::bench () {
+    // SHA-256 of one block, what each round mostly consists of
+    uint8_t block [64] = {};
+    uint8_t digest [32];
+    unsigned long count = 0;
+    unsigned long start = micros (), elapsed;
+    do {
+        cryptoBackend_t::sha256 (block, sizeof (block), digest);
+        count ++;
+        elapsed = micros () - start;
+    } while (elapsed < CRYPTO_BENCH_DURATION * 1000UL);
+    float shaPerSecond = count * 1000000.0f / elapsed;
+    delay (1); // let the idle task run between the measurements
+
+    // login without the cache: finding the record in /etc/shadow and SHA-crypt with __rounds__
+    char hash [USER_PASSWORD_HASH_LENGTH];
+    char setting [48];
+    sprintf (setting, "$5$rounds=%lu$passwdbench", (unsigned long) __rounds__);
+    start = micros ();
+    char line [USER_RECORD_LENGTH];
+    size_t offset, length;
+    __findRecord__ ("/etc/shadow", "root", line, sizeof (line), offset, length);
+    unsigned long readTime = micros () - start;
+    start = micros ();
+    shaCrypt (hash, sizeof (hash), DEFAULT_USER_PASSWORD, setting);
+    unsigned long shaCryptTime = micros () - start;
+    delay (1);
+
+    // login with the cache: finding the record in /etc/shadow and the digest of the credentials
+    start = micros ();
+    __credentialDigest__ (digest, "root", hash, DEFAULT_USER_PASSWORD);
+    unsigned long digestTime = micros () - start;
+
+    char s [512];
+    snprintf (s, sizeof (s), "SHA-256 (64 bytes):      %.0f hashes/s\r\n"
+                             "SHA-crypt (%lu rounds): %.2f hashes/s\r\n"
+                             "login without cache:     %.1f ms\r\n"
+                             "login with cache:        %.2f ms (%.2f ms of it finding the record)\r\n"
+                             "logins:                  %lu, %lu of them verified by the cache (%i s)",
+                             shaPerSecond,
+                             (unsigned long) __rounds__, 1000000.0f / (shaCryptTime ? shaCryptTime : 1),
+                             (readTime + shaCryptTime) / 1000.0f,
+                             (readTime + digestTime) / 1000.0f, readTime / 1000.0f,
+                             (unsigned long) __logins__, (unsigned long) __cacheHits__, USER_CREDENTIAL_CACHE_TIME);
+    return s;
+}
+
+// finds the line that starts with "userName:" in path, through path.idx if it is there
+bool userManagement_t::__findRecord__ (const char *path, const char *userName, char *line, size_t lineSize, size_t& offset, size_t& length) {
+    threadSafeFS::File f = __fileSystem__.open (path, "r");
+    if (!f || f.isDirectory ())
+        return false;
+    size_t nameLength = strlen (userName);
+
+    if (USER_INDEX) {
+        int found = __findInIndex__ (path, f, userName, line, lineSize, offset, length);
+        if (found >= 0)
+            return found; // else the index doesn't match path, read it all
+        f.seek (0);
+    }
+
+    __lineReader__ reader (f);
+    while (reader.readLine (line, lineSize, offset, length))
+        if (!strncmp (line, userName, nameLength) && line [nameLength] == ':')
+            return true;
+    return false;
+}
+
+// binary search of path.idx, returns 1 if the record is found, 0 if it is not there, -1 if path.idx doesn't match path (or may not)
+int userManagement_t::__findInIndex__ (const char *path, threadSafeFS::File& f, const char *userName, char *line, size_t lineSize, size_t& offset, size_t& length) {
+    char indexPath [USER_PATH_LENGTH];
+    snprintf (indexPath, sizeof (indexPath), "%s.idx", path);
+    threadSafeFS::File index = __fileSystem__.open (indexPath, "r");
+    if (!index || index.isDirectory ())
+        return -1;
+    __indexHeader__ header;
+    if (index.read ((uint8_t *) &header, sizeof (header)) != sizeof (header) || header.magic != USER_INDEX_MAGIC || header.size != f.size () || header.lastWrite != (uint32_t) f.getLastWrite ())
+        return -1;
+
+    // the first entry with the hash of userName
+    size_t nameLength = strlen (userName);
+    uint32_t hash = __nameHash__ (userName, nameLength);
+    uint32_t first = 0, last = header.count;
+    __indexEntry__ e;
+    while (first < last) {
+        uint32_t middle = (first + last) / 2;
+        if (!index.seek (sizeof (header) + middle * sizeof (e)) || index.read ((uint8_t *) &e, sizeof (e)) != sizeof (e))
+            return -1;
+        if (e.hash < hash)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    // the entries with the same hash, there is usually only one
+    bool hashFound = false;
+    for (index.seek (sizeof (header) + first * sizeof (e)); index.read ((uint8_t *) &e, sizeof (e)) == sizeof (e) && e.hash == hash; ) {
+        if (!f.seek (e.offset))
+            return -1;
+        __lineReader__ reader (f, e.offset);
+        if (!reader.readLine (line, lineSize, offset, length) || offset != e.offset)
+            return -1;
+        if (!strncmp (line, userName, nameLength) && line [nameLength] == ':')
+            return 1;
+        hashFound = true;
+    }
+    return hashFound ? -1 : 0; // a record with userName's hash but another name is a hash collision or a stale index, read it all
+}
+
+// writes path.idx with the hashes of the user names in path sorted, if always is false only when path.idx doesn't match path's size, time of the last write or checksum
+bool userManagement_t::__buildIndex__ (const char *path, bool always) {
+    threadSafeFS::File f = __fileSystem__.open (path, "r");
+    if (!f || f.isDirectory ())
+        return false;
+    char indexPath [USER_PATH_LENGTH];
+    snprintf (indexPath, sizeof (indexPath), "%s.idx", path);
+    __indexHeader__ header = { USER_INDEX_MAGIC, (uint32_t) f.size (), (uint32_t) f.getLastWrite (), __checksum__ (f), 0 };
+    if (!always) {
+        threadSafeFS::File index = __fileSystem__.open (indexPath, "r");
+        __indexHeader__ h;
+        if (index && !index.isDirectory () && index.read ((uint8_t *) &h, sizeof (h)) == sizeof (h) && h.magic == USER_INDEX_MAGIC && h.size == header.size && h.lastWrite == header.lastWrite && h.checksum == header.checksum)
+            return true;
+    }
+
+    // collect the entries
+    __indexEntry__ *entries = NULL;
+    uint32_t capacity = 0;
+    char line [USER_PASSWORD_MAX_LENGTH + 2];
+    size_t offset, length;
+    __lineReader__ reader (f);
+    while (reader.readLine (line, sizeof (line), offset, length)) {
+        size_t nameLength = strcspn (line, ":");
+        if (!line [nameLength])
+            continue; // not a record
+        if (header.count == capacity) {
+            capacity = capacity ? 2 * capacity : 32;
+            __indexEntry__ *e = (__indexEntry__ *) realloc (entries, capacity * sizeof (__indexEntry__));
+            if (!e) {
+                free (entries);
+                return false;
+            }
+            entries = e;
+        }
+        entries [header.count ++] = { __nameHash__ (line, nameLength), (uint32_t) offset };
+    }
+    f.close ();
+    qsort (entries, header.count, sizeof (__indexEntry__), [] (const void *a, const void *b) -> int {
+        const __indexEntry__ *x = (const __indexEntry__ *) a, *y = (const __indexEntry__ *) b;
+        return x->hash != y->hash ? (x->hash < y->hash ? -1 : 1) : (x->offset < y->offset ? -1 : x->offset > y->offset);
+    });
+
+    // write path.idx
+    char tmpPath [USER_PATH_LENGTH];
+    snprintf (tmpPath, sizeof (tmpPath), "%s.idx.tmp", path);
+    threadSafeFS::File index = __fileSystem__.open (tmpPath, "w");
+    bool written = index && !index.isDirectory ()
+                   && index.write ((const uint8_t *) &header, sizeof (header)) == sizeof (header)
+                   && (!header.count || index.write ((const uint8_t *) entries, header.count * sizeof (__indexEntry__)) == header.count * sizeof (__indexEntry__));
+    free (entries);
+    if (!written) {
+        __fileSystem__.remove (indexPath); // it doesn't match path any more
+        return false;
+    }
+    index.flush ();
+    index.close ();
+    return __commit__ (indexPath);
+}
+
+// copies path into path.tmp with userName's record replaced with newLine (appended if there is none, removed if newLine is NULL), then replaces path with it
+bool userManagement_t::__rewriteFile__ (const char *path, const char *userName, const char *newLine) {
+    char line [USER_PASSWORD_MAX_LENGTH + 2];
+    size_t offset, length;
+    bool found = __findRecord__ (path, userName, line, sizeof (line), offset, length);
+    if (!found && !newLine)
+        return true; // nothing to remove
+
+    threadSafeFS::File from = __fileSystem__.open (path, "r");
+    if (!from || from.isDirectory ())
+        return false;
+    size_t size = from.size ();
+    char tmpPath [USER_PATH_LENGTH];
+    snprintf (tmpPath, sizeof (tmpPath), "%s.tmp", path);
+    threadSafeFS::File to = __fileSystem__.open (tmpPath, "w");
+    if (!to || to.isDirectory ())
+        return false;
+
+    bool copied;
+    if (found) {
+        copied = __copy__ (from, to, offset);
+        if (copied && newLine)
+            copied = to.print (newLine) == strlen (newLine);
+        // skip the old record, and its line end if it is removed
+        size_t rest = offset + length;
+        if (!newLine) {
+            char c;
+            while (rest < size && from.seek (rest) && from.read ((uint8_t *) &c, 1) == 1 && (c == '\r' || c == '\n'))
+                rest ++;
+        }
+        copied = copied && from.seek (rest) && __copy__ (from, to, (size_t) -1);
+    } else {
+        copied = __copy__ (from, to, (size_t) -1);
+        // append the record in a new line
+        char last = '\n';
+        if (copied && size && from.seek (size - 1))
+            from.read ((uint8_t *) &last, 1);
+        if (copied && last != '\n')
+            copied = to.print ("\r\n") == 2;
+        copied = copied && to.print (newLine) == strlen (newLine);
+    }
+    from.close ();
+    if (!copied) {
+        to.close ();
+        __fileSystem__.remove (tmpPath);
+        return false;
+    }
+    to.flush (); // fsync
+    to.close ();
+
+    if (!__commit__ (path))
+        return false;
+    if (USER_INDEX)
+        __buildIndex__ (path, true);
+    return true;
+}
+
+// writes buffer into path.tmp first and renames it to path when it is safely on flash, so a reset leaves either the old or the new file
+bool userManagement_t::__writeFile__ (const char *path, const char *buffer) {
+    char tmpPath [USER_PATH_LENGTH];
+    snprintf (tmpPath, sizeof (tmpPath), "%s.tmp", path);
+    threadSafeFS::File f = __fileSystem__.open (tmpPath, "w");
+    if (!f || f.isDirectory ())
+        return false;
+    size_t length = strlen (buffer);
+    if (!length || f.print (buffer) != length) {
+        f.close ();
+        __fileSystem__.remove (tmpPath);
+        return false;
+    }
+    f.flush (); // fsync
+    f.close ();
+    return __commit__ (path);
+}
+
+// replaces path with path.tmp, which must be complete and flushed
+bool userManagement_t::__commit__ (const char *path) {
+    char tmpPath [USER_PATH_LENGTH];
+    snprintf (tmpPath, sizeof (tmpPath), "%s.tmp", path);
+    if (__fileSystem__.rename (tmpPath, path))
+        return true; // LittleFS replaces the old file atomically
+    // the file systems that don't rename over an existing file: path.tmp is renamed to path.new first, which marks it complete,
+    // so if a reset comes before it replaces path, __recover__ can tell it from a .tmp that was being written and finish this
+    char newPath [USER_PATH_LENGTH];
+    snprintf (newPath, sizeof (newPath), "%s.new", path);
+    if (!__fileSystem__.rename (tmpPath, newPath)) {
+        __fileSystem__.remove (tmpPath);
+        return false;
+    }
+    __fileSystem__.remove (path);
+    return __fileSystem__.rename (newPath, path);
+}
+
+// writes length bytes of data at position in path, without rewriting the rest of the file
+bool userManagement_t::__updateFile__ (const char *path, size_t position, const char *data, size_t length) {
+    threadSafeFS::File f = __fileSystem__.open (path, "r+");
+    if (!f || f.isDirectory ())
+        return false;
+    if (!f.seek (position) || f.write ((const uint8_t *) data, length) != length)
+        return false;
+    f.flush (); // fsync, LittleFS commits the change atomically
+    f.close ();
+    if (USER_INDEX)
+        __buildIndex__ (path, true); // the offsets are the same, but the time of the last write isn't
+    return true;
+}
+
+// path.tmp is left over from an interrupted write and may be incomplete, even if path doesn't exist (yet), so it is discarded and the
+// constructor creates the missing file with the defaults, path.new is complete (see __commit__) and replaces path
+void userManagement_t::__recover__ (const char *path) {
+    char tmpPath [USER_PATH_LENGTH];
+    snprintf (tmpPath, sizeof (tmpPath), "%s.tmp", path);
+    if (__fileSystem__.isFile (tmpPath))
+        __fileSystem__.remove (tmpPath);
+    char newPath [USER_PATH_LENGTH];
+    snprintf (newPath, sizeof (newPath), "%s.new", path);
+    if (__fileSystem__.isFile (newPath) && !__fileSystem__.rename (newPath, path)) {
+        __fileSystem__.remove (path);
+        __fileSystem__.rename (newPath, path);
+    }
+}
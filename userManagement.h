@@ -1,69 +1,137 @@
-/*
-  
-    userManagement.h 
-  
-    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
-  
-    UNIX-like user management.
-  
-    April 27, 2026, Bojan Jurca
-
-*/
-
-
-#pragma once
-#ifndef __USER_MANAGEMENT_H__
-    #define __USER_MANAGEMENT_H__
-
-    //#include <cstddef>
-    #include <mbedtls/md.h>
-    #include <time.h>
-    #include <string.h>
-    #include <Cstring.hpp>
-    #include <threadSafeFS.h>
-
-
-    // TUNING PARAMETERS
-    #define USER_PASSWORD_MAX_LENGTH 64
-    #define MAX_ETC_PASSWD_SIZE (1024 + 512)
-    #define MAX_ETC_SHADOW_SIZE (1024 + 512)
-    #define DEFAULT_ROOT_PASSWORD "rootpassword"
-    #define DEFAULT_ROOT_PASSWORD_SHA "de362bbdf11f2df30d12f318eeed87b8ee9e0c69c8ba61ed9a57695bbd91e481" // = __SHA256__ ("rootpassword")
-    #define DEFAULT_WEBADMIN_PASSWORD "webadminpassword"
-    #define DEFAULT_WEBADMIN_PASSWORD_SHA "40c6af3d1540ca2af132e1e93e7f5a5f624280b9d4d552a0bb103afe17c75c53" // = __SHA256__ ("webadminpassword")
-    #define DEFAULT_USER_PASSWORD "changeimmediatelly"
-    #define DEFAULT_USER_PASSWORD_SHA "ef286dbce1c8edcb4db441e0b717942a90e7f26264fc46e0a518d446ef8da48c" // = __SHA256__ ("changeimmediatelly")
-
-
-    class userManagement_t {
-
-        public:
-
-            // Singleton accessor
-            static userManagement_t &getInstance ();
-
-            bool checkUserNameAndPassword (const char *userName, const char *password);
-
-            Cstring<255> getHomeDirectory (const char *userName);
-
-            bool passwd (const char *userName, const char *newPassword);
-
-            const char *userAdd (const char *userName, const char *userHomeDirectory);
-
-            const char *userDel (const char *userName);
-
-            userManagement_t (threadSafeFS::FS& fileSystem);
-
-        private:
-
-            threadSafeFS::FS& __fileSystem__;
-
-            bool __writePasswd__ (const char *buffer); 
-            bool __readPasswd__ (char *buffer);
-            bool __writeShadow__ (const char *buffer); 
-            bool __readShadow__ (char *buffer);
-
-            static bool __sha256__ (char *buffer, size_t bufferSize, const char *clearText);
-    };
-
-#endif
+/*
+  
+    userManagement.h 
+  
+    This file is part of Multitasking Esp32 HTTP FTP Telnet servers for Arduino project: https://github.com/BojanJurca/Multitasking-Esp32-HTTP-FTP-Telnet-servers-for-Arduino
+  
+    UNIX-like user management.
+
+    Passwords are stored in /etc/shadow as SHA-crypt (SHA-256) hashes: $5$rounds=N$salt$hash, with 16 random characters
+    of salt and N rounds of SHA-256 (SHA accelerator, see cryptoBackend.h). N for new passwords is SHA_CRYPT_ROUNDS from
+    /etc/login.defs (USER_PASSWORD_ROUNDS if it is not set), passwdbench Telnet command measures the login latency and
+    sets N for a target latency. The older unsalted $5$<SHA-256 in hex> records are still accepted and replaced with
+    SHA-crypt at the first successful login.
+
+    /etc/passwd and /etc/shadow are written into a .tmp file first, which replaces the old file only after it is flushed
+    to flash, so a reset while writing can't leave them empty or partial. A .tmp found at start-up is discarded. passwd with unchanged rounds only overwrites the hash.
+
+    The files are never loaded as a whole, they are read line by line through a USER_FILE_BUFFER buffer and copied the
+    same way when a record changes, so the stack used doesn't depend on the number of users. With USER_INDEX each
+    file has an index (path.idx) with the hashes of the user names sorted and the offsets of their records, so a record
+    is found with a binary search instead of reading the file up to it. The index is rebuilt when userManagement_t
+    changes the file. A lookup uses it only if the file's size and time of the last write are the indexed ones, and at
+    start-up it is also rebuilt if the file's checksum differs. Each record found through it is checked, and a record
+    with the same hash but another name also falls back to reading the file, so a stale index only costs a full read.
+
+    Verified (user name, password) pairs are cached for USER_CREDENTIAL_CACHE_TIME seconds, so that clients which log in
+    again for each connection (like FTP) don't pay the rounds each time. The cache only keeps a keyed SHA-256 of the user
+    name, its hash from /etc/shadow and the password, so a changed password no longer matches.
+  
+    April 27, 2026, Bojan Jurca
+
+*/
+
+
+#pragma once
+#ifndef __USER_MANAGEMENT_H__
+    #define __USER_MANAGEMENT_H__
+
+    //#include <cstddef>
+    #include "cryptoBackend.h"
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+    #include <time.h>
+    #include <string.h>
+    #include <Cstring.hpp>
+    #include <threadSafeFS.h>
+
+
+    // TUNING PARAMETERS
+    #define USER_PASSWORD_MAX_LENGTH 64
+    #define USER_RECORD_LENGTH 384                 // bytes, the longest line of /etc/passwd or /etc/shadow that can be parsed or changed
+    #define USER_FILE_BUFFER 128                    // bytes, /etc/passwd and /etc/shadow are read and copied through a buffer of this size
+    #define USER_INDEX true                         // keep /etc/passwd.idx and /etc/shadow.idx for O (log n) lookups
+    #define DEFAULT_ROOT_PASSWORD "rootpassword"
+    #define DEFAULT_WEBADMIN_PASSWORD "webadminpassword"
+    #define DEFAULT_USER_PASSWORD "changeimmediatelly"
+    #define USER_PASSWORD_ROUNDS 5000               // SHA-crypt rounds of new passwords if SHA_CRYPT_ROUNDS is not set in /etc/login.defs
+    #define USER_PASSWORD_MIN_ROUNDS 1000           // SHA-crypt limits
+    #define USER_PASSWORD_MAX_ROUNDS 999999999
+    #define USER_PASSWORD_SALT_LENGTH 16            // characters, SHA-crypt uses at most 16
+    #define USER_PASSWORD_HASH_LENGTH 128           // bytes, $5$rounds=N$salt$hash including the terminating 0
+    #define USER_CREDENTIAL_CACHE 8                 // verified (user name, password) pairs
+    #define USER_CREDENTIAL_CACHE_TIME 60           // s
+    #define USER_IN_PLACE_UPDATE true               // passwd overwrites only the hash if the new one is as long as the old one, LittleFS commits this atomically, set to false on FAT
+
+
+    class userManagement_t {
+
+        public:
+
+            // Singleton accessor
+            static userManagement_t &getInstance ();
+
+            bool checkUserNameAndPassword (const char *userName, const char *password);
+
+            Cstring<255> getHomeDirectory (const char *userName);
+
+            bool passwd (const char *userName, const char *newPassword);
+
+            const char *userAdd (const char *userName, const char *userHomeDirectory);
+
+            const char *userDel (const char *userName);
+
+            userManagement_t (threadSafeFS::FS& fileSystem);
+            ~userManagement_t ();
+
+            // SHA-crypt rounds of new passwords, setRounds also writes them into /etc/login.defs
+            inline uint32_t getRounds () __attribute__((always_inline)) { return __rounds__; }
+            bool setRounds (uint32_t rounds);
+
+            // rounds that take about targetMs to hash, measured on this chip
+            uint32_t calibrate (unsigned long targetMs);
+
+            // SHA-256 and SHA-crypt hashes per second, login latency with and without the cache
+            String bench ();
+
+            inline uint32_t logins () __attribute__((always_inline)) { return __logins__; }
+            inline uint32_t cacheHits () __attribute__((always_inline)) { return __cacheHits__; }
+
+            // $5$rounds=N$salt$hash of password, setting is $5$rounds=N$salt or $5$salt (5000 rounds), returns false if setting is not valid
+            static bool shaCrypt (char *buffer, size_t bufferSize, const char *password, const char *setting);
+
+        private:
+
+            threadSafeFS::FS& __fileSystem__;
+
+            uint32_t __rounds__ = USER_PASSWORD_ROUNDS;
+
+            struct __credential__ {
+                uint8_t digest [32];        // SHA-256 of __cacheKey__, user name, hash from /etc/shadow and password
+                unsigned long expires;      // millis, 0 = empty
+            };
+
+            __credential__ __cache__ [USER_CREDENTIAL_CACHE] = {};
+            uint8_t __cacheKey__ [16];      // random, so the digests can't be computed outside of this run
+            SemaphoreHandle_t __semaphore__ = NULL; // protects the cache
+            SemaphoreHandle_t __fileSemaphore__ = NULL; // one change of /etc/passwd, /etc/shadow or /etc/login.defs at a time
+
+            uint32_t __logins__ = 0;
+            uint32_t __cacheHits__ = 0;
+
+            bool __findRecord__ (const char *path, const char *userName, char *line, size_t lineSize, size_t& offset, size_t& length);
+            int __findInIndex__ (const char *path, threadSafeFS::File& f, const char *userName, char *line, size_t lineSize, size_t& offset, size_t& length);
+            bool __buildIndex__ (const char *path, bool always);
+            bool __rewriteFile__ (const char *path, const char *userName, const char *newLine);
+            bool __writeFile__ (const char *path, const char *buffer);
+            bool __updateFile__ (const char *path, size_t position, const char *data, size_t length);
+            bool __commit__ (const char *path);
+            void __recover__ (const char *path);
+
+            bool __newHash__ (char *buffer, size_t bufferSize, const char *password);
+            void __credentialDigest__ (uint8_t digest [32], const char *userName, const char *hash, const char *password);
+
+            static bool __sha256__ (char *buffer, size_t bufferSize, const char *clearText);
+    };
+
+#endif